@@ -0,0 +1,116 @@
+#ifndef IRODS_BATCH_EXECUTE_H
+#define IRODS_BATCH_EXECUTE_H
+
+/// \file
+
+struct RcComm;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Executes many independent API requests in a single round trip.
+///
+/// Each request names an API number and carries the input structure of that API, packed as it
+/// would be by procApiRequest. The server executes the requests in order through its API table,
+/// applying the same version, permission and client allowlist checks as for requests sent on their
+/// own. This makes it suitable for clients issuing many small operations, e.g. a stat of every entry
+/// shown on a page.
+///
+/// APIs carrying a byte stream, the data transfer APIs, and APIs which exchange messages with the
+/// client before returning cannot be executed as part of a batch. The latter include collection
+/// replication, rule execution and recursive collection removal. Such requests fail with
+/// SYS_NOT_SUPPORTED.
+///
+/// \p json_input must have the following JSON structure:
+/// \code{.js}
+/// {
+///   "stop_on_error": boolean,
+///   "requests": [
+///     {
+///       "api_number": integer,
+///       "input": string
+///     }
+///   ]
+/// }
+/// \endcode
+///
+/// \p stop_on_error is optional and defaults to false, in which case every request is executed.
+/// Otherwise, execution stops at the first request which fails.
+///
+/// \p input is the base64 encoding of the packed input structure. It must be empty or omitted for
+/// APIs which take no input. Use irods::experimental::api::pack_batch_request_input to produce it.
+///
+/// \p json_output will have the following JSON structure:
+/// \code{.js}
+/// {
+///   "results": [
+///     {
+///       "api_number": integer,
+///       "status": integer,
+///       "output": string
+///     }
+///   ],
+///   "error_message": string
+/// }
+/// \endcode
+///
+/// \p results holds one entry per executed request, in the order of \p requests. \p status is the
+/// value returned by the API. \p output is the base64 encoding of the packed output structure and is
+/// empty for APIs without output. Use irods::experimental::api::unpack_batch_request_output to
+/// unpack it. \p error_message is only present if the batch itself was rejected.
+///
+/// \param[in]  _comm        A pointer to a RcComm.
+/// \param[in]  _json_input  A JSON string containing the requests.
+/// \param[out] _json_output A JSON string containing the result of each request.
+///
+/// \return An integer.
+/// \retval 0        If every request succeeded.
+/// \retval non-zero The status of the first request which failed, or the error which caused the batch
+///                  to be rejected.
+///
+/// \since 4.3.0
+int rc_batch_execute(struct RcComm* _comm, const char* _json_input, char** _json_output);
+
+#ifdef __cplusplus
+} // extern "C"
+
+#include <string>
+
+namespace irods::experimental::api
+{
+    /// Packs the input structure of a request so that it can be added to a batch.
+    ///
+    /// \param[in]  _comm         The connection the batch will be sent on.
+    /// \param[in]  _api_number   The API number of the request.
+    /// \param[in]  _input        A pointer to the input structure of the API.
+    /// \param[out] _packed_input The value of the "input" property of the request.
+    ///
+    /// \return An integer.
+    /// \retval 0        On success.
+    /// \retval non-zero On failure.
+    ///
+    /// \since 4.3.0
+    auto pack_batch_request_input(RcComm& _comm, int _api_number, const void* _input, std::string& _packed_input)
+        -> int;
+
+    /// Unpacks the output structure of a request executed as part of a batch.
+    ///
+    /// \param[in]  _comm          The connection the batch was sent on.
+    /// \param[in]  _api_number    The API number of the request.
+    /// \param[in]  _packed_output The value of the "output" property of the result.
+    /// \param[out] _output        A pointer which receives the output structure. The caller owns it.
+    ///
+    /// \return An integer.
+    /// \retval 0        On success.
+    /// \retval non-zero On failure.
+    ///
+    /// \since 4.3.0
+    auto unpack_batch_request_output(RcComm& _comm,
+                                     int _api_number,
+                                     const std::string& _packed_output,
+                                     void** _output) -> int;
+} // namespace irods::experimental::api
+#endif // __cplusplus
+
+#endif // IRODS_BATCH_EXECUTE_H
@@ -0,0 +1,87 @@
+#ifndef IRODS_BULK_APPLY_METADATA_OPERATIONS_H
+#define IRODS_BULK_APPLY_METADATA_OPERATIONS_H
+
+/// \file
+
+struct RcComm;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Executes metadata operations on many objects in a single request.
+///
+/// This is the bulk counterpart of rc_atomic_apply_metadata_operations. Object ids are resolved
+/// and permissions are checked with set-based queries, missing AVUs are inserted and links are
+/// added or removed with multi-row statements, all inside a single transaction. This makes it
+/// suitable for tagging large numbers of objects, e.g. after an ingest.
+///
+/// The operations of each entity are applied all-or-nothing. An entity which does not exist, which
+/// the user is not allowed to modify, or which has an invalid operation is skipped and reported in
+/// \p json_output. The remaining entities are still applied. If a database error occurs, all
+/// updates are rolled back.
+///
+/// A data object or collection the user cannot read is reported with CAT_NO_ROWS_FOUND, so that its
+/// existence is not revealed. One the user can read but not modify is reported with
+/// CAT_NO_ACCESS_PERMISSION.
+///
+/// Operations are applied as if they were executed in order, entity by entity.
+///
+/// \p json_input must have the following JSON structure:
+/// \code{.js}
+/// {
+///   "admin_mode": boolean,
+///   "entities": [
+///     {
+///       "entity_name": string,
+///       "entity_type": string,
+///       "operations": [
+///         {
+///           "operation": string,
+///           "attribute": string,
+///           "value": string,
+///           "units": string
+///         }
+///       ]
+///     }
+///   ]
+/// }
+/// \endcode
+///
+/// \p admin_mode, \p entity_name, \p entity_type, \p operation and \p units have the same meaning
+/// as for rc_atomic_apply_metadata_operations.
+///
+/// \p json_output will have the following JSON structure:
+/// \code{.js}
+/// {
+///   "errors": [
+///     {
+///       "entity_index": integer,
+///       "operation_index": integer,
+///       "entity_name": string,
+///       "error_code": integer,
+///       "error_message": string
+///     }
+///   ]
+/// }
+/// \endcode
+///
+/// \p entity_index and \p operation_index identify the item which failed. An \p operation_index of
+/// -1 means the error applies to the whole entity. An \p entity_index of -1 means the error applies
+/// to the whole request, in which case nothing was applied.
+///
+/// \param[in]  _comm        A pointer to a RcComm.
+/// \param[in]  _json_input  A JSON string containing the entities and their metadata operations.
+/// \param[out] _json_output A JSON string containing the list of errors.
+///
+/// \return An integer.
+/// \retval 0        If every operation was applied.
+/// \retval non-zero The error code of the first item which failed.
+///
+/// \since 4.3.0
+int rc_bulk_apply_metadata_operations(struct RcComm* _comm, const char* _json_input, char** _json_output);
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // IRODS_BULK_APPLY_METADATA_OPERATIONS_H
@@ -0,0 +1,80 @@
+#ifndef IRODS_GET_DATA_OBJECT_OPEN_PLAN_H
+#define IRODS_GET_DATA_OBJECT_OPEN_PLAN_H
+
+/// \file
+
+struct RcComm;
+struct BytesBuf;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Returns everything the server needs to open or create a data object in a single round trip.
+///
+/// The server uses this API to avoid several separate catalog lookups when opening data objects.
+/// It is not affected by policy.
+///
+/// \p _json_input must have the following JSON structure:
+/// \code{.js}
+/// {
+///   "logical_path": string,
+///   "access_level": string
+/// }
+/// \endcode
+///
+/// "access_level" is the permission to check for (e.g. "read_object" or "modify_object").
+///
+/// On success, \p _output will hold the following JSON structure:
+/// \code{.js}
+/// {
+///   // The parent collection, or null if it does not exist.
+///   "collection": {
+///     "coll_id": string,
+///     "coll_type": string
+///   },
+///
+///   // Whether the logical path names a collection.
+///   "is_collection": boolean,
+///
+///   // Whether the client has the requested access to the data object. Always false if the
+///   // data object does not exist.
+///   "permission_granted": boolean,
+///
+///   // The replicas of the data object, ordered by replica number. Each replica uses the
+///   // column names of R_DATA_MAIN. The list is empty if the data object does not exist.
+///   "replicas": [
+///     {
+///       "data_id": string,
+///       "coll_id": string,
+///       "data_repl_num": string,
+///       // ...
+///       "resc_id": string
+///     }
+///   ]
+/// }
+/// \endcode
+///
+/// \param[in]     _comm       A pointer to a RcComm.
+/// \param[in]     _json_input A JSON string describing the data object and the access level.
+/// \param[in,out] _output     The address to a BytesBuf pointer. On success, it will point
+///                            to a JSON string containing the plan. The buffer will be
+///                            allocated on the heap and must be free'd by the caller using
+///                            freeBBuf(). On failure, the pointer is not modified.
+///
+/// \return An integer.
+/// \retval  0                        On success.
+/// \retval  CAT_NO_ACCESS_PERMISSION If the data object exists but the client lacks the
+///                                   requested access.
+/// \retval  SYS_NOT_SUPPORTED        If a ticket or strict access control is in effect. The
+///                                   caller must fall back to the individual lookups.
+/// \retval <0                        On failure.
+///
+/// \since 4.3.1
+int rc_get_data_object_open_plan(struct RcComm* _comm, const char* _json_input, BytesBuf** _output);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // IRODS_GET_DATA_OBJECT_OPEN_PLAN_H
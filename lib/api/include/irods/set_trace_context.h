@@ -0,0 +1,33 @@
+#ifndef IRODS_SET_TRACE_CONTEXT_H
+#define IRODS_SET_TRACE_CONTEXT_H
+
+/// \file
+
+struct RcComm;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Sets the trace context of the server's agent.
+///
+/// Every request received by the agent after this call is attributed to the trace, replacing the
+/// trace context sent in the startup pack. Servers use this to attribute requests on a connection
+/// leased from the connection broker to the trace of the agent which leased it.
+///
+/// \param[in] _comm        A pointer to a RcComm.
+/// \param[in] _traceparent A W3C traceparent header value, e.g. produced by
+///                         irods::experimental::tracing::to_traceparent.
+///
+/// \return An integer.
+/// \retval 0        On success.
+/// \retval Non-zero On failure.
+///
+/// \since 4.3.0
+int rc_set_trace_context(struct RcComm* _comm, const char* _traceparent);
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // IRODS_SET_TRACE_CONTEXT_H
@@ -0,0 +1,136 @@
+#include "irods/batch_execute.h"
+
+#include "irods/base64.hpp"
+#include "irods/irods_client_api_table.hpp"
+#include "irods/packStruct.h"
+#include "irods/plugins/api/api_plugin_number.h"
+#include "irods/procApiRequest.h"
+#include "irods/rcConnect.h"
+#include "irods/rcGlobalExtern.h"
+#include "irods/rodsErrorTable.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+
+namespace
+{
+    auto get_api_entry(int _api_number) -> irods::api_entry*
+    {
+        auto& api_table = irods::get_client_api_table();
+
+        if (const auto iter = api_table.find(_api_number); iter != std::end(api_table)) {
+            return iter->second.get();
+        }
+
+        return nullptr;
+    } // get_api_entry
+} // anonymous namespace
+
+auto rc_batch_execute(RcComm* _comm, const char* _json_input, char** _json_output) -> int
+{
+    if (!_json_input || !_json_output) {
+        return SYS_INVALID_INPUT_PARAM;
+    }
+
+    bytesBuf_t input_buf{};
+    input_buf.buf = const_cast<char*>(_json_input);
+    input_buf.len = static_cast<int>(std::strlen(_json_input)) + 1;
+
+    bytesBuf_t* output_buf{};
+
+    const int ec = procApiRequest(_comm, BATCH_EXECUTE_APN,
+                                  &input_buf, nullptr,
+                                  reinterpret_cast<void**>(&output_buf), nullptr);
+
+    *_json_output = static_cast<char*>(output_buf->buf);
+    std::free(output_buf);
+
+    return ec;
+}
+
+namespace irods::experimental::api
+{
+    auto pack_batch_request_input(RcComm& _comm, int _api_number, const void* _input, std::string& _packed_input)
+        -> int
+    {
+        const auto* api_entry = get_api_entry(_api_number);
+
+        if (!api_entry) {
+            return SYS_UNMATCHED_API_NUM;
+        }
+
+        _packed_input.clear();
+
+        if (!api_entry->inPackInstruct) {
+            return _input ? USER_API_INPUT_ERR : 0;
+        }
+
+        if (!_input) {
+            return USER_API_INPUT_ERR;
+        }
+
+        bytesBuf_t* packed{};
+
+        const auto ec = pack_struct(_input, &packed, api_entry->inPackInstruct, RodsPackTable, 0,
+                                    _comm.irodsProt, _comm.svrVersion->relVersion);
+
+        if (ec < 0) {
+            return ec;
+        }
+
+        unsigned long size = 4 * ((static_cast<unsigned long>(packed->len) + 2) / 3) + 1;
+        _packed_input.assign(size, '\0');
+
+        const auto* in = static_cast<const unsigned char*>(packed->buf);
+        auto* out = reinterpret_cast<unsigned char*>(_packed_input.data());
+        const auto encode_ec = irods::base64_encode(in, packed->len, out, &size);
+
+        freeBBuf(packed);
+
+        if (encode_ec != 0) {
+            _packed_input.clear();
+            return SYS_INTERNAL_ERR;
+        }
+
+        _packed_input.resize(size);
+
+        return 0;
+    } // pack_batch_request_input
+
+    auto unpack_batch_request_output(RcComm& _comm,
+                                     int _api_number,
+                                     const std::string& _packed_output,
+                                     void** _output) -> int
+    {
+        if (!_output) {
+            return SYS_INVALID_INPUT_PARAM;
+        }
+
+        const auto* api_entry = get_api_entry(_api_number);
+
+        if (!api_entry) {
+            return SYS_UNMATCHED_API_NUM;
+        }
+
+        *_output = nullptr;
+
+        if (!api_entry->outPackInstruct || _packed_output.empty()) {
+            return 0;
+        }
+
+        // The decoded buffer is null-terminated so that packed XML can be unpacked safely.
+        unsigned long size = _packed_output.size() / 4 * 3 + 1;
+        std::string packed(size, '\0');
+
+        const auto* in = reinterpret_cast<const unsigned char*>(_packed_output.data());
+        auto* out = reinterpret_cast<unsigned char*>(packed.data());
+
+        if (irods::base64_decode(in, _packed_output.size(), out, &size) != 0) {
+            return USER_API_INPUT_ERR;
+        }
+
+        return unpack_struct(packed.data(), _output, api_entry->outPackInstruct, RodsPackTable,
+                             _comm.irodsProt, _comm.svrVersion->relVersion);
+    } // unpack_batch_request_output
+} // namespace irods::experimental::api
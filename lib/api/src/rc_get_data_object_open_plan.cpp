@@ -0,0 +1,19 @@
+#include "irods/get_data_object_open_plan.h"
+
+#include "irods/plugins/api/api_plugin_number.h"
+#include "irods/procApiRequest.h"
+#include "irods/rodsErrorTable.h"
+
+auto rc_get_data_object_open_plan(RcComm* _comm, const char* _json_input, BytesBuf** _output) -> int
+{
+    if (!_json_input || !_output) {
+        return SYS_INVALID_INPUT_PARAM;
+    }
+
+    return procApiRequest(_comm,
+                          GET_DATA_OBJECT_OPEN_PLAN_APN,
+                          const_cast<char*>(_json_input), // NOLINT(cppcoreguidelines-pro-type-const-cast)
+                          nullptr,
+                          reinterpret_cast<void**>(_output), // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+                          nullptr);
+}
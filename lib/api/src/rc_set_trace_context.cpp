@@ -0,0 +1,20 @@
+#include "irods/set_trace_context.h"
+
+#include "irods/plugins/api/api_plugin_number.h"
+#include "irods/procApiRequest.h"
+#include "irods/rodsErrorTable.h"
+
+#include <cstring>
+
+auto rc_set_trace_context(RcComm* _comm, const char* _traceparent) -> int
+{
+    if (!_traceparent) {
+        return SYS_INVALID_INPUT_PARAM;
+    }
+
+    bytesBuf_t input{};
+    input.buf = const_cast<char*>(_traceparent);
+    input.len = static_cast<int>(std::strlen(_traceparent)) + 1;
+
+    return procApiRequest(_comm, SET_TRACE_CONTEXT_APN, &input, nullptr, nullptr, nullptr);
+}
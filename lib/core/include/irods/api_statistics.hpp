@@ -0,0 +1,134 @@
+#ifndef IRODS_API_STATISTICS_HPP
+#define IRODS_API_STATISTICS_HPP
+
+/// \file
+///
+/// \brief Server-wide counters and latency histograms for every API number.
+///
+/// The main server creates a shared memory segment on startup. Agents inherit the mapping and
+/// record each request handled by rsApiHandler into it. Recording only uses atomic operations on
+/// fixed slots, so agents never wait on each other.
+///
+/// \since 4.3.0
+
+#include <nlohmann/json.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace irods::experimental::api_statistics
+{
+    /// The number of latency buckets.
+    ///
+    /// Bucket \p i counts requests which took less than 2^i microseconds. The last bucket counts
+    /// every request which took longer than the bucket before it.
+    ///
+    /// \since 4.3.0
+    inline constexpr std::size_t latency_bucket_count = 26;
+
+    /// The counters recorded for a single API number.
+    ///
+    /// \since 4.3.0
+    struct api_counters
+    {
+        int api_number;
+
+        /// The operation name of the API. Not stored in shared memory. Filled in by the caller.
+        std::string api_name;
+
+        std::uint64_t requests;
+
+        /// The number of requests which returned a negative error code.
+        std::uint64_t errors;
+
+        /// The number of bytes received in the input structure and byte stream.
+        std::uint64_t bytes_in;
+
+        /// The number of bytes sent in the output byte stream.
+        std::uint64_t bytes_out;
+
+        std::uint64_t latency_sum_in_microseconds;
+
+        /// The number of requests in each latency bucket. The buckets are not cumulative.
+        std::array<std::uint64_t, latency_bucket_count> latency_buckets;
+    }; // struct api_counters
+
+    /// The counters recorded by a single server.
+    ///
+    /// \since 4.3.0
+    struct host_counters
+    {
+        std::string hostname;
+        std::vector<api_counters> apis;
+    }; // struct host_counters
+
+    /// Initializes the API statistics.
+    ///
+    /// This function should only be called on startup of the server.
+    ///
+    /// \param[in] _shm_name The name of the shared memory to create.
+    ///
+    /// \since 4.3.0
+    auto init(const std::string_view _shm_name = "irods_api_statistics") -> void;
+
+    /// Cleans up any resources created via init().
+    ///
+    /// This function must be called from the same process that called init().
+    ///
+    /// \since 4.3.0
+    auto deinit() noexcept -> void;
+
+    /// Records a single request.
+    ///
+    /// \param[in] _api_number The API number of the request.
+    /// \param[in] _ec         The value returned to the client. Negative values are counted as errors.
+    /// \param[in] _bytes_in   The number of bytes received.
+    /// \param[in] _bytes_out  The number of bytes sent.
+    /// \param[in] _elapsed    The time taken to handle the request.
+    ///
+    /// \return A boolean value.
+    /// \retval true  If the request was recorded.
+    /// \retval false If the statistics are not initialized or every slot is taken by other API numbers.
+    ///
+    /// \since 4.3.0
+    auto record(int _api_number,
+                int _ec,
+                std::uint64_t _bytes_in,
+                std::uint64_t _bytes_out,
+                std::chrono::nanoseconds _elapsed) noexcept -> bool;
+
+    /// Returns the counters of every API number which has been recorded, ordered by API number.
+    ///
+    /// The counters of one API are read individually, so they may be slightly out of step with
+    /// each other while requests are being recorded.
+    ///
+    /// \since 4.3.0
+    auto snapshot() -> std::vector<api_counters>;
+
+    /// Sets every counter to zero and forgets every API number.
+    ///
+    /// Must not be called while requests are being recorded.
+    ///
+    /// \since 4.3.0
+    auto reset() noexcept -> void;
+
+    /// Renders the counters of one or more servers in the Prometheus text exposition format.
+    ///
+    /// \param[in] _hosts The counters to render. Each host becomes the \p hostname label.
+    ///
+    /// \since 4.3.0
+    auto to_prometheus_text(const std::vector<host_counters>& _hosts) -> std::string;
+
+    /// \since 4.3.0
+    auto to_json(nlohmann::json& _json, const api_counters& _counters) -> void;
+
+    /// \since 4.3.0
+    auto from_json(const nlohmann::json& _json, api_counters& _counters) -> void;
+} // namespace irods::experimental::api_statistics
+
+#endif // IRODS_API_STATISTICS_HPP
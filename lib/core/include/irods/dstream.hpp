@@ -6,8 +6,8 @@
 
 #include <streambuf>
 #include <type_traits>
-#include <array>
 #include <string>
+#include <vector>
 #include <stdexcept>
 #include <algorithm>
 #include <utility>
@@ -40,7 +40,7 @@ namespace irods::experimental::io
         using base_type = std::basic_streambuf<CharT, Traits>;
 
         // clang-format off
-        inline static constexpr auto buffer_size          = 4096;
+        inline static constexpr auto default_buffer_size  = 4096;
 
         // Errors
         inline static constexpr auto external_write_error = -1;
@@ -50,7 +50,7 @@ namespace irods::experimental::io
     public:
         basic_data_object_buf()
             : base_type{}
-            , buf_{}
+            , buf_(default_buffer_size)
             , transport_{}
         {
         }
@@ -234,6 +234,40 @@ namespace irods::experimental::io
         }
 
     protected:
+        // Replaces the internal buffer. If "_buffer" is null, the internal buffer is resized to
+        // "_buffer_size" characters. Otherwise, the "_buffer_size" characters starting at "_buffer"
+        // are copied into the new internal buffer. Larger buffers mean fewer, larger requests to the
+        // transport. This should be called via pubsetbuf() before the stream is opened. Fails if
+        // the "Get" or "Put" area holds data which has not been consumed or flushed.
+        base_type* setbuf(char_type* _buffer, std::streamsize _buffer_size) override
+        {
+            if (_buffer_size <= 0) {
+                return nullptr;
+            }
+
+            if (this->gptr() < this->egptr() || this->pptr() > this->pbase()) {
+                return nullptr;
+            }
+
+            if (_buffer) {
+                buf_.assign(_buffer, _buffer + _buffer_size);
+            }
+            else {
+                buf_.resize(_buffer_size);
+            }
+
+            auto* pbase = buf_.data();
+
+            if (this->gptr()) {
+                this->setg(pbase, pbase, pbase);
+            }
+            else if (this->pptr()) {
+                this->setp(pbase, pbase + buf_.size());
+            }
+
+            return this;
+        }
+
         int_type underflow() override
         {
             prepare_for_input();
@@ -415,7 +449,7 @@ namespace irods::experimental::io
             return 0;
         }
 
-        std::array<char_type, buffer_size> buf_;
+        std::vector<char_type> buf_;
         transport<char_type>* transport_;
     }; // basic_data_object_buf
 
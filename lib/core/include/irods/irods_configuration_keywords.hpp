@@ -83,6 +83,7 @@ namespace irods
     extern const char* const KW_CFG_DEF_TEMP_PASSWORD_LIFETIME;
     extern const char* const KW_CFG_MAX_TEMP_PASSWORD_LIFETIME;
     extern const char* const KW_CFG_NUMBER_OF_CONCURRENT_DELAY_RULE_EXECUTORS;
+    extern const char* const KW_CFG_NUMBER_OF_CONCURRENT_UNLINK_THREADS;
     extern const char* const KW_CFG_MAX_SIZE_OF_DELAY_QUEUE_IN_BYTES;
     extern const char* const KW_CFG_STACKTRACE_FILE_PROCESSOR_SLEEP_TIME_IN_SECONDS;
     extern const char* const KW_CFG_AGENT_FACTORY_WATCHER_SLEEP_TIME_IN_SECONDS;
@@ -98,6 +99,16 @@ namespace irods
     extern const char* const KW_CFG_EVICTION_AGE_IN_SECONDS;
     extern const char* const KW_CFG_CACHE_CLEARER_SLEEP_TIME_IN_SECONDS;
 
+    extern const char* const KW_CFG_SERVER_TO_SERVER_CONNECTION_POOL;
+    extern const char* const KW_CFG_MAX_IDLE_CONNECTIONS;
+    extern const char* const KW_CFG_IDLE_TIMEOUT_IN_SECONDS;
+
+    extern const char* const KW_CFG_ACCESS_CHECK_CACHE;
+    extern const char* const KW_CFG_MAX_ENTRIES;
+
+    extern const char* const KW_CFG_TRACING;
+    extern const char* const KW_CFG_SINK;
+
     extern const char* const KW_CFG_IRODS_TCP_KEEPALIVE_PROBES;
     extern const char* const KW_CFG_IRODS_TCP_KEEPALIVE_TIME_IN_SECONDS;
     extern const char* const KW_CFG_IRODS_TCP_KEEPALIVE_INTVL_IN_SECONDS;
@@ -25,6 +25,7 @@
 #include "irods/rodsError.h"
 #include "irods/rcMisc.h"
 #include "irods/rcConnect.h"
+#include "irods/tracing.hpp"
 
 #include <boost/range/iterator_range_core.hpp>
 #include <fmt/format.h>
@@ -417,6 +418,8 @@ namespace irods::experimental::log
             inline constexpr const char* proxy_user      = "request_proxy_user";
             inline constexpr const char* api_number      = "request_api_number";
             inline constexpr const char* api_name        = "request_api_name";
+            inline constexpr const char* trace_id        = "trace_id";
+            inline constexpr const char* span_id         = "span_id";
             // clang-forexprmat on
         } // namespace request
 
@@ -697,6 +700,11 @@ namespace irods::experimental::log
                     object[tag::request::proxy_user] = username;
                 }
 
+                if (const auto& trace = tracing::current_context(); !trace.trace_id.empty()) {
+                    object[tag::request::trace_id] = trace.trace_id;
+                    object[tag::request::span_id] = trace.span_id;
+                }
+
                 object[tag::server::type] = get_server_type();
                 object[tag::server::host] = get_server_hostname();
                 object[tag::server::pid] = getpid();
@@ -1,7 +1,11 @@
 #ifndef IRODS_PLUGIN_BASE_HPP
 #define IRODS_PLUGIN_BASE_HPP
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <string>
+#include <vector>
 
 #include <boost/function.hpp>
 
@@ -39,6 +43,28 @@ namespace irods
         return SUCCESS();
     }
 
+    /// \brief Identifies an operation by its slot in the dispatch table of every plugin.
+    ///
+    /// An operation name maps to the same index in every plugin. Callers on hot paths can look
+    /// the index up once and call the operation on any plugin without hashing its name.
+    ///
+    /// \since 4.3.0
+    enum class operation_index : std::size_t {};
+
+    /// \brief Returns the index of an operation, registering the name if it has not been seen before.
+    ///
+    /// \param[in] _operation_name The name the operation is added to plugins under.
+    ///
+    /// \since 4.3.0
+    auto get_operation_index(const std::string& _operation_name) -> operation_index;
+
+    /// \brief Returns the name of the operation an index was assigned to.
+    ///
+    /// \throws std::out_of_range If the index was not returned by get_operation_index().
+    ///
+    /// \since 4.3.0
+    auto get_operation_name(operation_index _index) -> const std::string&;
+
     /**
      * \brief  Abstract Base Class for iRODS Plugins
      This class enforces the delay_load interface necessary for the
@@ -71,6 +97,7 @@ namespace irods
             , operations_( _rhs.operations_ )
             , start_operation_(_rhs.start_operation_)
             , stop_operation_(_rhs.stop_operation_)
+            , dispatch_table_(_rhs.dispatch_table_)
         {
         } // cctor
 
@@ -82,6 +109,7 @@ namespace irods
             operations_        = _rhs.operations_;
             start_operation_   = _rhs.start_operation_;
             stop_operation_    = _rhs.stop_operation_;
+            dispatch_table_    = _rhs.dispatch_table_;
             return *this;
         } // operator=
 
@@ -99,6 +127,22 @@ namespace irods
             return SUCCESS();
         }
 
+        /// =-=-=-=-=-=-=-
+        /// @brief interface to determine if work was deferred which should be
+        ///        performed while the client is connected but idle
+        virtual error need_idle_maintenance_operation( bool& _b ) {
+            _b = false;
+            return SUCCESS();
+        }
+
+        /// =-=-=-=-=-=-=-
+        /// @brief interface to perform deferred work while the client is idle.
+        ///        the client may send its next request at any time, so the
+        ///        operation must bound the time it takes.
+        virtual error idle_maintenance_operation( rsComm_t* ) {
+            return SUCCESS();
+        }
+
         /// =-=-=-=-=-=-=-
         /// @brief list all of the operations in the plugin
         error enumerate_operations( std::vector< std::string >& _ops ) {
@@ -130,6 +174,7 @@ namespace irods
                 return ERROR( SYS_INVALID_INPUT_PARAM, msg.str() );
             }
             operations_[_op] = _f;
+            bind_operation(_op, operations_[_op]);
             return SUCCESS();
 
         }
@@ -148,6 +193,7 @@ namespace irods
                 return ERROR( SYS_INVALID_INPUT_PARAM, msg.str() );
             }
             operations_[_op] = _f;
+            bind_operation(_op, operations_[_op]);
             return SUCCESS();
 
         }
@@ -158,18 +204,35 @@ namespace irods
             const std::string&            _operation_name,
             irods::first_class_object_ptr _fco,
             types_t...                    _t)
+        {
+            return call<types_t...>(_comm, get_operation_index(_operation_name), _fco, _t...);
+        } // call
+
+        /// \brief Invokes an operation and its policy enforcement points.
+        ///
+        /// The PEPs are skipped entirely when no rule engine plugin defines a pre, post, except or
+        /// finally PEP for the operation.
+        ///
+        /// \since 4.3.0
+        template<typename... types_t>
+        error call(
+            rsComm_t*                     _comm,
+            operation_index               _operation,
+            irods::first_class_object_ptr _fco,
+            types_t...                    _t)
         {
             using namespace std;
 
+            bound_operation* bound = find_bound_operation(_operation);
+            const std::string& _operation_name = bound ? bound->name : get_operation_name(_operation);
+
             try {
                 plugin_context ctx( _comm, properties_, _fco, "" );
 
-                using adapted_func_type = std::function<error(plugin_context&, std::string*, types_t...)>;
-                
-                adapted_func_type adapted_fcn = [this, &_operation_name](plugin_context& _ctx, std::string* _out_param, types_t... _t) {
+                const auto adapted_fcn =
+                    [this, bound, &_operation_name](plugin_context& _ctx, std::string* _out_param, types_t... _t) {
                     _ctx.rule_results( *_out_param );
-                    typedef std::function<error(plugin_context&,types_t...)> fcn_t;
-                    fcn_t& fcn = boost::any_cast< fcn_t& >( operations_[ _operation_name ] );
+                    auto& fcn = get_operation<types_t...>(bound, _operation_name);
                     error ret = fcn( _ctx, _t... );
                     *_out_param = _ctx.rule_results();
                     return ret;
@@ -177,6 +240,10 @@ namespace irods
 
                 std::string out_param;
 #ifdef ENABLE_RE
+                if (!policy_enforcement_points_exist(bound, _operation_name)) {
+                    return adapted_fcn(ctx, &out_param, forward<types_t>(_t)...);
+                }
+
                 error to_return_op_err = SUCCESS();
                 ruleExecInfo_t rei;
                 memset( &rei, 0, sizeof( rei ) );
@@ -306,8 +373,8 @@ namespace irods
                 std::string out_param;
                 ctx.rule_results(out_param);
 
-                using func_type =  std::function<error(plugin_context&, Args...)>;
-                func_type& f = boost::any_cast<func_type&>(operations_[_operation_name]);
+                auto& f = get_operation<Args...>(find_bound_operation(get_operation_index(_operation_name)),
+                                                 _operation_name);
                 auto err = f(ctx, _args...);
 
                 out_param = ctx.rule_results();
@@ -351,6 +418,22 @@ namespace irods
             return stop_operation_( properties_ );
         }
 
+        /// \brief Returns whether any rule engine plugin defines a PEP for the operation.
+        ///
+        /// Code which performs an operation without going through call() must not do so when this
+        /// returns true, since the PEPs would not be invoked.
+        ///
+        /// \since 4.3.0
+        bool policy_enforcement_points_exist(const std::string& _operation_name)
+        {
+#ifdef ENABLE_RE
+            return policy_enforcement_points_exist(find_bound_operation(get_operation_index(_operation_name)),
+                                                   _operation_name);
+#else
+            return false;
+#endif // ENABLE_RE
+        } // policy_enforcement_points_exist
+
     protected:
         std::string context_;           // context string for this plugin
         std::string instance_name_;     // name of this instance of the plugin
@@ -372,7 +455,114 @@ namespace irods
         maintenance_operation_t stop_operation_;
 
     private:
+        // An operation bound at load time, held at the position given by its operation_index.
+        struct bound_operation
+        {
+            bound_operation() = default;
+
+            bound_operation(const bound_operation& _other)
+                : name{_other.name}
+                , function{_other.function}
+                , no_peps_in_generation{_other.no_peps_in_generation.load()}
+            {
+            }
+
+            auto operator=(const bound_operation& _other) -> bound_operation&
+            {
+                name = _other.name;
+                function = _other.function;
+                no_peps_in_generation = _other.no_peps_in_generation.load();
+                return *this;
+            }
+
+            std::string name;
+
+            // Holds a std::function<error(plugin_context&, ...)>.
+            boost::any function;
+
+            // The rule engine generation in which the operation was found to have no PEPs, or zero.
+            std::atomic<std::uint64_t> no_peps_in_generation{0};
+        }; // struct bound_operation
+
+        void bind_operation(const std::string& _op, const boost::any& _f)
+        {
+            const auto index = static_cast<std::size_t>(get_operation_index(_op));
+
+            if (index >= dispatch_table_.size()) {
+                dispatch_table_.resize(index + 1);
+            }
+
+            auto& entry = dispatch_table_[index];
+            entry.name = _op;
+            entry.function = _f;
+            entry.no_peps_in_generation = 0;
+        } // bind_operation
+
+        bound_operation* find_bound_operation(operation_index _operation)
+        {
+            const auto index = static_cast<std::size_t>(_operation);
+
+            if (index < dispatch_table_.size() && !dispatch_table_[index].function.empty()) {
+                return &dispatch_table_[index];
+            }
+
+            return nullptr;
+        } // find_bound_operation
+
+        // Throws boost::bad_any_cast if the operation does not exist or takes different arguments.
+        template <typename... Args>
+        std::function<error(plugin_context&, Args...)>& get_operation(bound_operation* _bound,
+                                                                     const std::string& _operation_name)
+        {
+            using fcn_t = std::function<error(plugin_context&, Args...)>;
+
+            // Operations added without add_operation() are only known by name.
+            return boost::any_cast<fcn_t&>(_bound ? _bound->function : operations_[_operation_name]);
+        } // get_operation
+
+        // Operations bound by add_operation(), indexed by operation_index.
+        std::vector<bound_operation> dispatch_table_;
+
 #ifdef ENABLE_RE
+        // Returns whether any rule engine plugin defines a PEP for the operation. A negative answer
+        // is remembered until the rule engine plugins are restarted.
+        bool policy_enforcement_points_exist(bound_operation* _bound, const std::string& _operation_name)
+        {
+            if (!re_plugin_globals) {
+                return false;
+            }
+
+            const auto generation = get_rule_engine_generation();
+
+            if (_bound && _bound->no_peps_in_generation.load(std::memory_order_relaxed) == generation) {
+                return false;
+            }
+
+            rule_exists_manager<unit, ruleExecInfo_t*> re_mgr{re_plugin_globals->global_re_mgr};
+
+            for (const auto& ns : NamespacesHelper::Instance()->getNamespaces()) {
+                for (const auto* pep_class : {"pre", "post", "except", "finally"}) {
+                    const auto rule_name = ns + "pep_" + _operation_name + "_" + pep_class;
+
+                    if (!RuleExistsHelper::Instance()->checkOperation(rule_name)) {
+                        continue;
+                    }
+
+                    // Assume the PEP exists if a rule engine plugin cannot say.
+                    bool exists = false;
+                    if (!re_mgr.rule_exists(rule_name, exists).ok() || exists) {
+                        return true;
+                    }
+                }
+            }
+
+            if (_bound) {
+                _bound->no_peps_in_generation.store(generation, std::memory_order_relaxed);
+            }
+
+            return false;
+        } // policy_enforcement_points_exist
+
         template<typename... types_t>
         error invoke_policy_enforcement_point(
             rule_engine_context_manager_type _re_ctx_mgr,
@@ -8,6 +8,7 @@
 #include <fmt/format.h>
 
 #include <algorithm>
+#include <cstring>
 #include <limits>
 #include <string>
 #include <string_view>
@@ -190,8 +191,12 @@ namespace irods::experimental {
             /// \since 4.2.9
             static auto index_of(key_type k, kvp_type& kvp) -> size_type
             {
+                // Compare against the keyword without measuring it first, and only once the first
+                // characters match. The terminator check rejects keywords that only begin with k.
+                const char first = k.empty() ? '\0' : k.front();
                 for (size_type i = 0; i < kvp.len; i++) {
-                    if (k == kvp.keyWord[i]) {
+                    const char* kw = kvp.keyWord[i];
+                    if (kw && *kw == first && std::strncmp(kw, k.data(), k.size()) == 0 && kw[k.size()] == '\0') {
                         return i;
                     }
                 }
@@ -298,6 +303,16 @@ namespace irods::experimental {
             }
 
         private:
+            friend class key_value_proxy;
+
+            /// \brief Constructs iterator for array of kvps starting at the specified index
+            /// \since 4.3.0
+            iterator(kvp_type& _kvp, size_type _index)
+                : index_{_index}
+                , kvp_{&_kvp}
+            {
+            }
+
             /// \brief Index into the array of kvp_type
             /// \since 4.2.8
             size_type index_;
@@ -485,33 +500,25 @@ namespace irods::experimental {
             typename = std::enable_if_t<!std::is_const_v<P>>>
         auto find(key_type _k) -> iterator
         {
-            if (empty()) {
-                return end();
+            if (const auto i = handle::index_of(_k, *kvp_); i >= 0) {
+                return {*kvp_, i};
             }
-            return std::find_if(begin(), end(),
-                                [&_k](const auto& _hndl)
-                                {
-                                    return _k == _hndl.key();
-                                });
+            return end();
         }
 
         /// \see https://en.cppreference.com/w/cpp/container/map/find
         /// \since 4.2.8
         auto find(key_type _k) const -> iterator
         {
-            if (empty()) {
-                return cend();
+            if (const auto i = handle::index_of(_k, *kvp_); i >= 0) {
+                return {*kvp_, i};
             }
-            return std::find_if(cbegin(), cend(),
-                                [&_k](const auto& _hndl)
-                                {
-                                    return _k == _hndl.key();
-                                });
+            return cend();
         }
 
         /// \see https://en.cppreference.com/w/cpp/container/map/contains
         /// \since 4.2.8
-        auto contains(key_type _k) const -> bool { return find(_k) != cend(); }
+        auto contains(key_type _k) const -> bool { return handle::index_of(_k, *kvp_) >= 0; }
 
         /// \brief Returns pointer to stored struct
         ///
@@ -0,0 +1,89 @@
+#ifndef IRODS_LOAD_DIGEST_CACHE_HPP
+#define IRODS_LOAD_DIGEST_CACHE_HPP
+
+/// \file
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace irods::experimental::load_digest_cache
+{
+    /// The latest load reported for a resource by the server monitoring system.
+    ///
+    /// \since 4.3.0
+    struct load_digest
+    {
+        std::string resource_name;
+        int load_factor;
+        std::int64_t create_time; // Seconds since epoch.
+    }; // struct load_digest
+
+    /// Initializes the load digest cache.
+    ///
+    /// This function should only be called on startup of the server.
+    ///
+    /// \param[in] _shm_name The name of the shared memory to create.
+    /// \param[in] _shm_size The size of the shared memory to allocate in bytes.
+    ///
+    /// \since 4.3.0
+    auto init(const std::string_view _shm_name = "irods_load_digest_cache",
+              std::size_t _shm_size = 1'000'000) -> void;
+
+    /// Cleans up any resources created via init().
+    ///
+    /// This function must be called from the same process that called init().
+    ///
+    /// \since 4.3.0
+    auto deinit() noexcept -> void;
+
+    /// Replaces the contents of the cache with a snapshot of the catalog.
+    ///
+    /// Only the most recent digest for each resource is kept.
+    ///
+    /// \param[in] _digests       The digests read from the catalog.
+    /// \param[in] _expires_after The number of seconds from now before the snapshot must be
+    ///                           read from the catalog again.
+    ///
+    /// \since 4.3.0
+    auto assign(const std::vector<load_digest>& _digests, std::chrono::seconds _expires_after) -> void;
+
+    /// Records a digest that was just registered in the catalog.
+    ///
+    /// The digest replaces the cached digest for the same resource if it is at least as recent.
+    /// This does not extend the lifetime of the snapshot.
+    ///
+    /// \param[in] _digest The digest.
+    ///
+    /// \return A boolean value.
+    /// \retval true  If the cache was updated.
+    /// \retval false If the cache held a more recent digest or is not initialized.
+    ///
+    /// \since 4.3.0
+    auto insert_or_assign(const load_digest& _digest) -> bool;
+
+    /// Returns the latest digest for every resource if the snapshot has not expired.
+    ///
+    /// \return An optional list of digests.
+    /// \retval std::vector  If the snapshot is still valid.
+    /// \retval std::nullopt If the snapshot has expired, was never taken, or the cache is not
+    ///                      initialized.
+    ///
+    /// \since 4.3.0
+    auto lookup() -> std::optional<std::vector<load_digest>>;
+
+    /// Erases all digests and invalidates the snapshot.
+    ///
+    /// \since 4.3.0
+    auto clear() -> void;
+
+    /// Returns the number of digests in the cache.
+    ///
+    /// \since 4.3.0
+    auto size() -> std::size_t;
+} // namespace irods::experimental::load_digest_cache
+
+#endif // IRODS_LOAD_DIGEST_CACHE_HPP
@@ -243,6 +243,7 @@ typedef struct startupPack {
 #define SP_REL_VERSION          "spRelVersion"
 #define SP_API_VERSION          "spApiVersion"
 #define SP_OPTION               "spOption"
+#define SP_TRACE_PARENT         "spTraceParent"
 #define SP_LOG_SQL              "spLogSql"
 #define SP_LOG_LEVEL            "spLogLevel"
 #define SP_RE_CACHE_SALT        "reCacheSalt"
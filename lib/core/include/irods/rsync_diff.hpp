@@ -0,0 +1,115 @@
+#ifndef IRODS_RSYNC_DIFF_HPP
+#define IRODS_RSYNC_DIFF_HPP
+
+/// \file
+///
+/// \brief Compares the listings of two trees to decide what irsync must transfer.
+///
+/// A listing is taken for the whole source and the whole target before anything is transferred,
+/// so that unchanged files cost nothing beyond their share of a bulk query or a directory read.
+///
+/// \since 4.3.0
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace irods::experimental::rsync
+{
+    /// \brief The properties of a local file or data object used to compare it with its counterpart.
+    ///
+    /// \since 4.3.0
+    struct file_info
+    {
+        std::int64_t size = 0;
+
+        /// The modification time in seconds since the epoch.
+        std::int64_t mtime = 0;
+
+        int mode = 0;
+
+        /// The checksum as stored in the catalog. For local files, only computed when the data object
+        /// of the same size has a checksum, and then using the same scheme.
+        std::string checksum;
+    }; // struct file_info
+
+    /// \brief The listing of a directory or collection tree.
+    ///
+    /// Paths are relative to the root of the tree and use '/' as the separator.
+    ///
+    /// \since 4.3.0
+    struct tree
+    {
+        std::map<std::string, file_info> files;
+        std::set<std::string> directories;
+    }; // struct tree
+
+    /// \brief How files present on both sides are compared.
+    ///
+    /// \since 4.3.0
+    enum class compare_by
+    {
+        /// Files of the same size are compared by checksum.
+        checksum,
+
+        /// Files of the same size are considered equal.
+        size
+    }; // enum class compare_by
+
+    /// \brief What must be done for a file of the source tree.
+    ///
+    /// \since 4.3.0
+    enum class change_type
+    {
+        /// The file does not exist in the target tree.
+        create,
+
+        /// The file exists in the target tree but is known to differ.
+        update,
+
+        /// The file exists in the target tree with the same size, but only one side has a checksum.
+        /// The contents must be compared before deciding whether to transfer it.
+        verify
+    }; // enum class change_type
+
+    /// \since 4.3.0
+    struct file_change
+    {
+        std::string path;
+        change_type type;
+    }; // struct file_change
+
+    /// \brief The result of comparing two trees.
+    ///
+    /// Every list is sorted by path, so parents come before their children.
+    ///
+    /// \since 4.3.0
+    struct tree_diff
+    {
+        /// Directories of the source tree which do not exist in the target tree.
+        std::vector<std::string> directories_to_create;
+
+        /// Files of the source tree which must be transferred or verified.
+        std::vector<file_change> files;
+
+        /// Files of the target tree which do not exist in the source tree. They are left in place.
+        std::vector<std::string> only_in_target;
+
+        /// The number of files considered equal on both sides.
+        std::size_t unchanged = 0;
+    }; // struct tree_diff
+
+    /// Compares a source tree with a target tree.
+    ///
+    /// \param[in] _source  The tree being copied from.
+    /// \param[in] _target  The tree being copied to.
+    /// \param[in] _compare How files present on both sides are compared.
+    ///
+    /// \since 4.3.0
+    auto diff(const tree& _source, const tree& _target, compare_by _compare) -> tree_diff;
+} // namespace irods::experimental::rsync
+
+#endif // IRODS_RSYNC_DIFF_HPP
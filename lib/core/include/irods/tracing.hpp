@@ -0,0 +1,201 @@
+#ifndef IRODS_TRACING_HPP
+#define IRODS_TRACING_HPP
+
+/// \file
+///
+/// \brief Correlates the work done for a client across agents and server-to-server hops.
+///
+/// Every client process picks a trace id the first time it connects. The trace id, along with the
+/// id of the span that was active when the connection was made, travels to the agent in the
+/// option string of the startup pack. The agent adopts the trace id, so its log records and the
+/// connections it makes to other servers carry the same trace id.
+///
+/// Spans are only recorded when a sink is configured. Each span is written as a single line of
+/// OTLP/JSON (an ExportTraceServiceRequest holding one span), which can be collected by any
+/// OpenTelemetry collector that reads files or datagrams.
+///
+/// \since 4.3.0
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace irods::experimental::tracing
+{
+    /// The key which precedes the trace context in the option string of a startup pack.
+    ///
+    /// \since 4.3.0
+    inline constexpr std::string_view startup_option_key = "traceparent=";
+
+    /// \brief Identifies a span within a trace.
+    ///
+    /// Both ids are lowercase hexadecimal strings, as used by W3C Trace Context and OTLP/JSON.
+    ///
+    /// \since 4.3.0
+    struct trace_context
+    {
+        /// 32 hexadecimal characters.
+        std::string trace_id;
+
+        /// 16 hexadecimal characters.
+        std::string span_id;
+    }; // struct trace_context
+
+    /// \brief The role of a span, as defined by OpenTelemetry.
+    ///
+    /// \since 4.3.0
+    enum class span_kind
+    {
+        internal = 1,
+        server = 2,
+        client = 3
+    }; // enum class span_kind
+
+    /// Returns a new random trace id.
+    ///
+    /// \since 4.3.0
+    auto generate_trace_id() -> std::string;
+
+    /// Returns a new random span id.
+    ///
+    /// \since 4.3.0
+    auto generate_span_id() -> std::string;
+
+    /// Formats a trace context as a W3C traceparent header value.
+    ///
+    /// \since 4.3.0
+    auto to_traceparent(const trace_context& _context) -> std::string;
+
+    /// Parses a W3C traceparent header value.
+    ///
+    /// \return The trace context, or std::nullopt if \p _value is not a valid traceparent.
+    ///
+    /// \since 4.3.0
+    auto from_traceparent(std::string_view _value) -> std::optional<trace_context>;
+
+    /// Sets the trace context inherited by every thread of the process.
+    ///
+    /// This function is thread-safe. Threads which already hold a reference to the previous root
+    /// context keep it, and spans started after the call belong to the new trace. Passing an empty
+    /// context clears the root.
+    ///
+    /// \since 4.3.0
+    auto set_root_context(trace_context _context) -> void;
+
+    /// Returns the context of the innermost span of the calling thread, or the root context if the
+    /// thread has no active span.
+    ///
+    /// The returned context is empty if no trace has been started.
+    ///
+    /// \since 4.3.0
+    auto current_context() -> const trace_context&;
+
+    /// Returns the current context, starting a new trace with a new root context if there is none.
+    ///
+    /// This function is thread-safe. If several threads find no root context at the same time,
+    /// only one of them starts a trace and the others return it.
+    ///
+    /// \since 4.3.0
+    auto current_or_new_context() -> const trace_context&;
+
+    /// Appends the current trace context to the option string of a startup pack.
+    ///
+    /// Servers which predate tracing ignore everything following the client-server negotiation
+    /// request, so this must be called after the negotiation request has been appended.
+    ///
+    /// \param[in,out] _option      The null-terminated option string.
+    /// \param[in]     _option_size The size of the buffer holding the option string.
+    ///
+    /// \return A boolean value.
+    /// \retval true  If the trace context was appended.
+    /// \retval false If there was not enough room.
+    ///
+    /// \since 4.3.0
+    auto append_to_startup_option(char* _option, std::size_t _option_size) -> bool;
+
+    /// Removes the trace context from the option string of a startup pack.
+    ///
+    /// \param[in,out] _option The option string.
+    ///
+    /// \return The trace context sent by the client, or std::nullopt if none was sent.
+    ///
+    /// \since 4.3.0
+    auto extract_from_startup_option(std::string& _option) -> std::optional<trace_context>;
+
+    /// Sets where spans are written.
+    ///
+    /// Supported values:
+    /// - "file:///path/to/file": Appends each span to a file.
+    /// - "unix:///path/to/socket": Sends each span as a datagram to a Unix domain socket.
+    /// - "": Disables the recording of spans.
+    ///
+    /// \param[in] _uri      The sink.
+    /// \param[in] _hostname The value of the host.name resource attribute.
+    ///
+    /// \return A boolean value.
+    /// \retval true  If the sink was recognized.
+    /// \retval false If the sink is not supported. Spans are not recorded.
+    ///
+    /// \since 4.3.0
+    auto configure_sink(std::string_view _uri, std::string_view _hostname) -> bool;
+
+    /// Returns whether spans are being recorded.
+    ///
+    /// \since 4.3.0
+    auto is_recording() noexcept -> bool;
+
+    /// \brief Measures a unit of work and records it to the sink when it goes out of scope.
+    ///
+    /// While alive, the span is the current span of the thread that created it, so log records
+    /// and connections made by that thread refer to it. If no sink is configured, a span does
+    /// nothing.
+    ///
+    /// \since 4.3.0
+    class span
+    {
+      public:
+        /// Starts a span as a child of the current span of the calling thread.
+        ///
+        /// \param[in] _name The name of the span.
+        /// \param[in] _kind The role of the span.
+        ///
+        /// \since 4.3.0
+        explicit span(std::string_view _name, span_kind _kind = span_kind::internal);
+
+        span(const span&) = delete;
+        auto operator=(const span&) -> span& = delete;
+
+        ~span();
+
+        /// \since 4.3.0
+        auto set_attribute(std::string_view _key, std::string_view _value) -> void;
+
+        /// \since 4.3.0
+        auto set_attribute(std::string_view _key, std::int64_t _value) -> void;
+
+        /// Marks the span as failed if \p _ec is negative.
+        ///
+        /// \since 4.3.0
+        auto set_error_code(int _ec) -> void;
+
+      private:
+        bool recording_;
+        std::string name_;
+        span_kind kind_;
+        trace_context context_;
+        std::string parent_span_id_;
+        const trace_context* previous_;
+        std::chrono::system_clock::time_point start_;
+
+        std::vector<std::pair<std::string, std::variant<std::string, std::int64_t>>> attributes_;
+        int ec_;
+    }; // class span
+} // namespace irods::experimental::tracing
+
+#endif // IRODS_TRACING_HPP
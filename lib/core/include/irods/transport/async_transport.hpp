@@ -0,0 +1,472 @@
+#ifndef IRODS_IO_ASYNC_TRANSPORT_HPP
+#define IRODS_IO_ASYNC_TRANSPORT_HPP
+
+/// \file
+
+#include "irods/rodsErrorTable.h"
+#include "irods/transport/transport.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace irods::experimental::io
+{
+    /// \brief A transport which reads ahead and writes behind on a background thread.
+    ///
+    /// This transport wraps another transport (e.g. default_transport) and moves the transfer of
+    /// bytes off of the caller's thread. While the caller consumes one buffer, the next one is
+    /// being read from the server. While the server stores one buffer, the caller fills the next
+    /// one. Every read and write sent to the server is \p buffer_size bytes long, regardless of
+    /// the size of the buffer used by the stream on top of this transport.
+    ///
+    /// Seeking, opening and closing wait for outstanding requests to complete and discard any
+    /// bytes read ahead, so the position reported by seekpos() is the same as it would be for the
+    /// wrapped transport.
+    ///
+    /// Errors from writes performed in the background are reported by the next call to send(),
+    /// seekpos() or close().
+    ///
+    /// The wrapped transport, and the connection it uses, are accessed from a background thread.
+    /// The connection must be dedicated to this transport and must not be used by anything else
+    /// until the replica is closed.
+    ///
+    /// \since 4.3.0
+    template <typename CharT>
+    class basic_async_transport : public transport<CharT>
+    {
+    public:
+        // clang-format off
+        using char_type   = typename transport<CharT>::char_type;
+        using traits_type = typename transport<CharT>::traits_type;
+        using int_type    = typename traits_type::int_type;
+        using pos_type    = typename traits_type::pos_type;
+        using off_type    = typename traits_type::off_type;
+        // clang-format on
+
+        // clang-format off
+        inline static constexpr std::streamsize default_buffer_size  = 4 * 1024 * 1024;
+        inline static constexpr std::size_t     default_buffer_count = 2;
+        // clang-format on
+
+    private:
+        // clang-format off
+        inline static const auto seek_error = pos_type{off_type{-1}};
+        // clang-format on
+
+        struct chunk
+        {
+            std::vector<char_type> data;
+
+            // The number of bytes held by the chunk. Zero or less marks the end of the data
+            // object or the error returned by the wrapped transport.
+            std::streamsize size = 0;
+
+            std::streamsize consumed = 0;
+        }; // struct chunk
+
+    public:
+        /// Constructs an async transport which wraps \p _transport.
+        ///
+        /// \param[in] _transport    The transport used to communicate with the server.
+        /// \param[in] _buffer_size  The number of bytes sent or received by each request.
+        /// \param[in] _buffer_count The number of buffers read ahead or waiting to be written.
+        ///                          Two means one buffer is transferred while the caller uses the
+        ///                          other.
+        explicit basic_async_transport(transport<CharT>& _transport,
+                                       std::streamsize _buffer_size = default_buffer_size,
+                                       std::size_t _buffer_count = default_buffer_count)
+            : transport<CharT>{}
+            , transport_{&_transport}
+            , buffer_size_{std::max<std::streamsize>(_buffer_size, 1)}
+            , buffer_count_{std::max<std::size_t>(_buffer_count, 1)}
+            , worker_{}
+            , mutex_{}
+            , cv_{}
+            , stop_{}
+            , busy_{}
+            , read_ahead_{}
+            , ready_{}
+            , pending_writes_{}
+            , write_buffer_{}
+            , write_error_{}
+            , free_buffers_{}
+        {
+            worker_ = std::thread{[this] { run(); }};
+        }
+
+        basic_async_transport(const basic_async_transport&) = delete;
+        auto operator=(const basic_async_transport&) -> basic_async_transport& = delete;
+
+        ~basic_async_transport()
+        {
+            {
+                std::unique_lock lock{mutex_};
+                flush(lock);
+                stop_reading(lock);
+                stop_ = true;
+            }
+
+            cv_.notify_all();
+            worker_.join();
+        }
+
+        bool open(const irods::experimental::filesystem::path& _path,
+                  std::ios_base::openmode _mode) override
+        {
+            std::unique_lock lock{mutex_};
+            reset(lock);
+            return transport_->open(_path, _mode);
+        }
+
+        bool open(const irods::experimental::filesystem::path& _path,
+                  const struct replica_number& _replica_number,
+                  std::ios_base::openmode _mode) override
+        {
+            std::unique_lock lock{mutex_};
+            reset(lock);
+            return transport_->open(_path, _replica_number, _mode);
+        }
+
+        bool open(const irods::experimental::filesystem::path& _path,
+                  const struct root_resource_name& _root_resource_name,
+                  std::ios_base::openmode _mode) override
+        {
+            std::unique_lock lock{mutex_};
+            reset(lock);
+            return transport_->open(_path, _root_resource_name, _mode);
+        }
+
+        bool open(const irods::experimental::filesystem::path& _path,
+                  const struct leaf_resource_name& _leaf_resource_name,
+                  std::ios_base::openmode _mode) override
+        {
+            std::unique_lock lock{mutex_};
+            reset(lock);
+            return transport_->open(_path, _leaf_resource_name, _mode);
+        }
+
+        bool open(const struct replica_token& _replica_token,
+                  const irods::experimental::filesystem::path& _path,
+                  const struct replica_number& _replica_number,
+                  std::ios_base::openmode _mode) override
+        {
+            std::unique_lock lock{mutex_};
+            reset(lock);
+            return transport_->open(_replica_token, _path, _replica_number, _mode);
+        }
+
+        bool open(const struct replica_token& _replica_token,
+                  const irods::experimental::filesystem::path& _path,
+                  const struct leaf_resource_name& _leaf_resource_name,
+                  std::ios_base::openmode _mode) override
+        {
+            std::unique_lock lock{mutex_};
+            reset(lock);
+            return transport_->open(_replica_token, _path, _leaf_resource_name, _mode);
+        }
+
+        bool close(const on_close_success* _on_close_success = nullptr) override
+        {
+            std::unique_lock lock{mutex_};
+
+            const auto flushed = flush(lock) >= 0;
+            stop_reading(lock);
+            write_error_ = 0;
+
+            return transport_->close(_on_close_success) && flushed;
+        }
+
+        std::streamsize receive(char_type* _buffer, std::streamsize _buffer_size) override
+        {
+            std::unique_lock lock{mutex_};
+
+            if (const auto ec = flush(lock); ec < 0) {
+                return ec;
+            }
+
+            if (!read_ahead_) {
+                read_ahead_ = true;
+                cv_.notify_all();
+            }
+
+            std::streamsize bytes_copied = 0;
+
+            while (bytes_copied < _buffer_size) {
+                cv_.wait(lock, [this] { return !ready_.empty(); });
+
+                auto& c = ready_.front();
+
+                // Leave the end of the data object or the error in place if some bytes were
+                // copied. The next call will report it.
+                if (c.size <= 0) {
+                    if (bytes_copied > 0) {
+                        break;
+                    }
+
+                    const auto result = c.size;
+                    ready_.pop_front();
+                    read_ahead_ = false;
+
+                    return result;
+                }
+
+                const auto n = std::min(_buffer_size - bytes_copied, c.size - c.consumed);
+                std::memcpy(_buffer + bytes_copied, c.data.data() + c.consumed, n * sizeof(char_type));
+                bytes_copied += n;
+                c.consumed += n;
+
+                if (c.consumed == c.size) {
+                    free_buffers_.push_back(std::move(c.data));
+                    ready_.pop_front();
+                    cv_.notify_all();
+                }
+            }
+
+            return bytes_copied;
+        }
+
+        std::streamsize send(const char_type* _buffer, std::streamsize _buffer_size) override
+        {
+            std::unique_lock lock{mutex_};
+
+            // The wrapped transport is ahead of the caller by the number of bytes read ahead.
+            // Move it back to where the caller expects the bytes to be written.
+            if (const auto unread = stop_reading(lock); unread > 0) {
+                if (seek_error == transport_->seekpos(-unread, std::ios_base::cur)) {
+                    return SYS_INTERNAL_ERR;
+                }
+            }
+
+            if (write_error_ < 0) {
+                return write_error_;
+            }
+
+            std::streamsize bytes_copied = 0;
+
+            while (bytes_copied < _buffer_size) {
+                if (write_buffer_.data.empty()) {
+                    write_buffer_.data = take_buffer();
+                    write_buffer_.size = 0;
+                }
+
+                const auto n = std::min(_buffer_size - bytes_copied, buffer_size_ - write_buffer_.size);
+                auto* dst = write_buffer_.data.data() + write_buffer_.size;
+                std::memcpy(dst, _buffer + bytes_copied, n * sizeof(char_type));
+                bytes_copied += n;
+                write_buffer_.size += n;
+
+                if (write_buffer_.size == buffer_size_) {
+                    submit_write_buffer(lock);
+                }
+            }
+
+            return bytes_copied;
+        }
+
+        pos_type seekpos(off_type _offset, std::ios_base::seekdir _dir) override
+        {
+            std::unique_lock lock{mutex_};
+
+            if (flush(lock) < 0) {
+                return seek_error;
+            }
+
+            const auto unread = stop_reading(lock);
+
+            if (std::ios_base::cur == _dir) {
+                _offset -= unread;
+            }
+
+            return transport_->seekpos(_offset, _dir);
+        }
+
+        bool is_open() const noexcept override
+        {
+            return transport_->is_open();
+        }
+
+        int file_descriptor() const noexcept override
+        {
+            return transport_->file_descriptor();
+        }
+
+        const struct root_resource_name& root_resource_name() const override
+        {
+            return transport_->root_resource_name();
+        }
+
+        const struct leaf_resource_name& leaf_resource_name() const override
+        {
+            return transport_->leaf_resource_name();
+        }
+
+        const struct replica_number& replica_number() const override
+        {
+            return transport_->replica_number();
+        }
+
+        const struct replica_token& replica_token() const override
+        {
+            return transport_->replica_token();
+        }
+
+    private:
+        // Performs the requests queued by the caller on the background thread. The wrapped
+        // transport is only used while busy_ is set, and the caller only uses it while the
+        // worker is idle.
+        void run()
+        {
+            std::unique_lock lock{mutex_};
+
+            while (true) {
+                cv_.wait(lock, [this] { return stop_ || !pending_writes_.empty() || can_read_ahead(); });
+
+                if (stop_) {
+                    return;
+                }
+
+                if (!pending_writes_.empty()) {
+                    auto c = std::move(pending_writes_.front());
+                    pending_writes_.pop_front();
+
+                    // Later writes are dropped once a write has failed.
+                    if (write_error_ == 0) {
+                        busy_ = true;
+                        lock.unlock();
+                        const auto bytes_written = transport_->send(c.data.data(), c.size);
+                        lock.lock();
+                        busy_ = false;
+
+                        if (bytes_written < 0) {
+                            write_error_ = bytes_written;
+                        }
+                        else if (bytes_written != c.size) {
+                            write_error_ = SYS_COPY_LEN_ERR;
+                        }
+                    }
+
+                    free_buffers_.push_back(std::move(c.data));
+                    cv_.notify_all();
+
+                    continue;
+                }
+
+                chunk c{take_buffer()};
+
+                busy_ = true;
+                lock.unlock();
+                c.size = transport_->receive(c.data.data(), buffer_size_);
+                lock.lock();
+                busy_ = false;
+
+                ready_.push_back(std::move(c));
+                cv_.notify_all();
+            }
+        }
+
+        bool can_read_ahead() const noexcept
+        {
+            return read_ahead_ && ready_.size() < buffer_count_ && (ready_.empty() || ready_.back().size > 0);
+        }
+
+        std::vector<char_type> take_buffer()
+        {
+            if (free_buffers_.empty()) {
+                return std::vector<char_type>(buffer_size_);
+            }
+
+            auto buffer = std::move(free_buffers_.back());
+            free_buffers_.pop_back();
+
+            return buffer;
+        }
+
+        void wait_until_idle(std::unique_lock<std::mutex>& _lock)
+        {
+            cv_.wait(_lock, [this] { return !busy_ && pending_writes_.empty(); });
+        }
+
+        // Hands the partially filled write buffer to the worker, waiting for room in the queue.
+        void submit_write_buffer(std::unique_lock<std::mutex>& _lock)
+        {
+            if (write_buffer_.size == 0) {
+                return;
+            }
+
+            cv_.wait(_lock, [this] { return pending_writes_.size() < buffer_count_; });
+
+            pending_writes_.push_back(std::exchange(write_buffer_, chunk{}));
+            cv_.notify_all();
+        }
+
+        // Waits for every pending write to complete and returns the first error, if any.
+        std::streamsize flush(std::unique_lock<std::mutex>& _lock)
+        {
+            submit_write_buffer(_lock);
+            wait_until_idle(_lock);
+
+            return write_error_;
+        }
+
+        // Stops reading ahead, waits for the outstanding read and discards everything read
+        // ahead. Returns the number of bytes which were read but never consumed.
+        std::streamsize stop_reading(std::unique_lock<std::mutex>& _lock)
+        {
+            read_ahead_ = false;
+            wait_until_idle(_lock);
+
+            std::streamsize unread = 0;
+
+            for (auto&& c : ready_) {
+                if (c.size > 0) {
+                    unread += c.size - c.consumed;
+                }
+
+                free_buffers_.push_back(std::move(c.data));
+            }
+
+            ready_.clear();
+
+            return unread;
+        }
+
+        void reset(std::unique_lock<std::mutex>& _lock)
+        {
+            flush(_lock);
+            stop_reading(_lock);
+            write_error_ = 0;
+        }
+
+        transport<CharT>* transport_;
+        const std::streamsize buffer_size_;
+        const std::size_t buffer_count_;
+
+        std::thread worker_;
+        std::mutex mutex_;
+        std::condition_variable cv_;
+
+        bool stop_;
+        bool busy_;
+        bool read_ahead_;
+
+        std::deque<chunk> ready_;
+        std::deque<chunk> pending_writes_;
+        chunk write_buffer_;
+        std::streamsize write_error_;
+
+        std::vector<std::vector<char_type>> free_buffers_;
+    }; // basic_async_transport
+
+    // clang-format off
+    using async_transport = basic_async_transport<char>;
+    // clang-format on
+} // namespace irods::experimental::io
+
+#endif // IRODS_IO_ASYNC_TRANSPORT_HPP
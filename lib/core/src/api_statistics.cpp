@@ -0,0 +1,336 @@
+#include "irods/api_statistics.hpp"
+
+#include <boost/interprocess/managed_shared_memory.hpp>
+#include <boost/interprocess/shared_memory_object.hpp>
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <memory>
+
+#include <sys/types.h>
+#include <unistd.h>
+
+namespace
+{
+    namespace bi = boost::interprocess;
+    namespace stats = irods::experimental::api_statistics;
+
+    using counter_type = std::atomic<std::uint64_t>;
+
+    // The counters are shared between processes, so they must not fall back to a lock.
+    static_assert(counter_type::is_always_lock_free);
+    static_assert(std::atomic<int>::is_always_lock_free);
+
+    // The number of distinct API numbers that can be recorded. Enough for every built-in API and
+    // a generous number of API plugins.
+    constexpr std::size_t slot_count = 1024;
+
+    // A slot is owned by the first API number written into it and is never released.
+    struct slot
+    {
+        std::atomic<int> api_number; // Zero marks an unused slot.
+        counter_type requests;
+        counter_type errors;
+        counter_type bytes_in;
+        counter_type bytes_out;
+        counter_type latency_sum_in_microseconds;
+        std::array<counter_type, stats::latency_bucket_count> latency_buckets;
+    }; // struct slot
+
+    using slot_table = std::array<slot, slot_count>;
+
+    //
+    // Global Variables
+    //
+
+    // The following variables define the name of the shared memory object.
+    std::string g_segment_name;
+
+    // On initialization, holds the PID of the process that initialized the API statistics.
+    // This ensures that only the process that initialized the system can deinitialize it.
+    pid_t g_owner_pid;
+
+    // Allocating on the heap allows us to know when the API statistics are constructed/destructed.
+    std::unique_ptr<bi::managed_shared_memory> g_segment;
+    slot_table* g_slots;
+
+    auto current_timestamp_in_seconds() noexcept -> std::int64_t
+    {
+        using std::chrono::duration_cast;
+        using std::chrono::seconds;
+
+        return duration_cast<seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    } // current_timestamp_in_seconds
+
+    // Returns the slot owned by _api_number, claiming an unused one if necessary.
+    auto find_or_claim_slot(int _api_number) noexcept -> slot*
+    {
+        const auto start = static_cast<std::size_t>(_api_number) % slot_count;
+
+        for (std::size_t i = 0; i < slot_count; ++i) {
+            auto& s = (*g_slots)[(start + i) % slot_count];
+            auto owner = s.api_number.load(std::memory_order_acquire);
+
+            if (0 == owner && s.api_number.compare_exchange_strong(owner, _api_number, std::memory_order_acq_rel)) {
+                return &s;
+            }
+
+            // On failure, compare_exchange_strong stored the current owner in "owner".
+            if (owner == _api_number) {
+                return &s;
+            }
+        }
+
+        return nullptr;
+    } // find_or_claim_slot
+
+    auto to_latency_bucket(std::uint64_t _microseconds) noexcept -> std::size_t
+    {
+        return std::min<std::size_t>(std::bit_width(_microseconds), stats::latency_bucket_count - 1);
+    } // to_latency_bucket
+
+    auto escape_label_value(std::string_view _value) -> std::string
+    {
+        std::string escaped;
+        escaped.reserve(_value.size());
+
+        for (auto c : _value) {
+            switch (c) {
+                case '\\': escaped += R"(\\)"; break;
+                case '"':  escaped += R"(\")"; break;
+                case '\n': escaped += R"(\n)"; break;
+                default:   escaped += c; break;
+            }
+        }
+
+        return escaped;
+    } // escape_label_value
+
+    auto make_labels(const stats::host_counters& _host, const stats::api_counters& _api) -> std::string
+    {
+        return fmt::format(R"(hostname="{}",api_number="{}",api_name="{}")",
+                           escape_label_value(_host.hostname),
+                           _api.api_number,
+                           escape_label_value(_api.api_name));
+    } // make_labels
+
+    auto append_counter(std::string& _out,
+                        const std::vector<stats::host_counters>& _hosts,
+                        std::string_view _name,
+                        std::string_view _help,
+                        std::uint64_t stats::api_counters::*_member) -> void
+    {
+        _out += fmt::format("# HELP {} {}\n# TYPE {} counter\n", _name, _help, _name);
+
+        for (auto&& host : _hosts) {
+            for (auto&& api : host.apis) {
+                _out += fmt::format("{}{{{}}} {}\n", _name, make_labels(host, api), api.*_member);
+            }
+        }
+    } // append_counter
+} // anonymous namespace
+
+namespace irods::experimental::api_statistics
+{
+    auto init(const std::string_view _shm_name) -> void
+    {
+        if (getpid() == g_owner_pid) {
+            return;
+        }
+
+        g_segment_name = fmt::format("{}_{}_{}", _shm_name, getpid(), current_timestamp_in_seconds());
+
+        bi::shared_memory_object::remove(g_segment_name.data());
+
+        // Leave room for the bookkeeping done by the segment manager.
+        constexpr auto segment_size = sizeof(slot_table) + 65'536;
+
+        g_owner_pid = getpid();
+        g_segment = std::make_unique<bi::managed_shared_memory>(bi::create_only, g_segment_name.data(), segment_size);
+        g_slots = g_segment->construct<slot_table>(bi::anonymous_instance)();
+    } // init
+
+    auto deinit() noexcept -> void
+    {
+        if (getpid() != g_owner_pid) {
+            return;
+        }
+
+        try {
+            g_owner_pid = 0;
+
+            if (g_segment && g_slots) {
+                g_segment->destroy_ptr(g_slots);
+                g_slots = nullptr;
+            }
+
+            if (g_segment) {
+                g_segment.reset();
+            }
+
+            bi::shared_memory_object::remove(g_segment_name.data());
+        }
+        catch (...) {}
+    } // deinit
+
+    auto record(int _api_number,
+                int _ec,
+                std::uint64_t _bytes_in,
+                std::uint64_t _bytes_out,
+                std::chrono::nanoseconds _elapsed) noexcept -> bool
+    {
+        if (!g_slots || _api_number <= 0) {
+            return false;
+        }
+
+        auto* s = find_or_claim_slot(_api_number);
+
+        if (!s) {
+            return false;
+        }
+
+        using std::chrono::duration_cast;
+        using std::chrono::microseconds;
+
+        const auto elapsed_us = std::max<std::int64_t>(duration_cast<microseconds>(_elapsed).count(), 0);
+        const auto us = static_cast<std::uint64_t>(elapsed_us);
+
+        // The counters are independent of each other, so no ordering is required.
+        constexpr auto order = std::memory_order_relaxed;
+
+        s->requests.fetch_add(1, order);
+        s->bytes_in.fetch_add(_bytes_in, order);
+        s->bytes_out.fetch_add(_bytes_out, order);
+        s->latency_sum_in_microseconds.fetch_add(us, order);
+        s->latency_buckets[to_latency_bucket(us)].fetch_add(1, order);
+
+        if (_ec < 0) {
+            s->errors.fetch_add(1, order);
+        }
+
+        return true;
+    } // record
+
+    auto snapshot() -> std::vector<api_counters>
+    {
+        std::vector<api_counters> counters;
+
+        if (!g_slots) {
+            return counters;
+        }
+
+        constexpr auto order = std::memory_order_relaxed;
+
+        for (auto&& s : *g_slots) {
+            const auto api_number = s.api_number.load(std::memory_order_acquire);
+
+            if (0 == api_number) {
+                continue;
+            }
+
+            auto& c = counters.emplace_back();
+            c.api_number = api_number;
+            c.requests = s.requests.load(order);
+            c.errors = s.errors.load(order);
+            c.bytes_in = s.bytes_in.load(order);
+            c.bytes_out = s.bytes_out.load(order);
+            c.latency_sum_in_microseconds = s.latency_sum_in_microseconds.load(order);
+
+            for (std::size_t i = 0; i < latency_bucket_count; ++i) {
+                c.latency_buckets[i] = s.latency_buckets[i].load(order);
+            }
+        }
+
+        std::sort(std::begin(counters), std::end(counters), [](const auto& _lhs, const auto& _rhs) {
+            return _lhs.api_number < _rhs.api_number;
+        });
+
+        return counters;
+    } // snapshot
+
+    auto reset() noexcept -> void
+    {
+        if (!g_slots) {
+            return;
+        }
+
+        for (auto&& s : *g_slots) {
+            s.requests = 0;
+            s.errors = 0;
+            s.bytes_in = 0;
+            s.bytes_out = 0;
+            s.latency_sum_in_microseconds = 0;
+
+            for (auto&& b : s.latency_buckets) {
+                b = 0;
+            }
+
+            s.api_number = 0;
+        }
+    } // reset
+
+    auto to_prometheus_text(const std::vector<host_counters>& _hosts) -> std::string
+    {
+        std::string out;
+
+        append_counter(out, _hosts, "irods_api_requests_total", "Requests handled per API.", &api_counters::requests);
+        append_counter(
+            out, _hosts, "irods_api_errors_total", "Requests which returned an error.", &api_counters::errors);
+        append_counter(
+            out, _hosts, "irods_api_received_bytes_total", "Bytes received per API.", &api_counters::bytes_in);
+        append_counter(out, _hosts, "irods_api_sent_bytes_total", "Bytes sent per API.", &api_counters::bytes_out);
+
+        constexpr std::string_view histogram = "irods_api_request_duration_seconds";
+
+        out += fmt::format("# HELP {} Time taken to handle a request.\n# TYPE {} histogram\n", histogram, histogram);
+
+        for (auto&& host : _hosts) {
+            for (auto&& api : host.apis) {
+                const auto labels = make_labels(host, api);
+                std::uint64_t cumulative = 0;
+
+                // The last bucket has no upper bound and is reported as "+Inf" below.
+                for (std::size_t i = 0; i < latency_bucket_count - 1; ++i) {
+                    cumulative += api.latency_buckets[i];
+                    const auto le = static_cast<double>(std::uint64_t{1} << i) / 1'000'000;
+                    out += fmt::format("{}_bucket{{{},le=\"{}\"}} {}\n", histogram, labels, le, cumulative);
+                }
+
+                cumulative += api.latency_buckets.back();
+                out += fmt::format("{}_bucket{{{},le=\"+Inf\"}} {}\n", histogram, labels, cumulative);
+                const auto sum = static_cast<double>(api.latency_sum_in_microseconds) / 1'000'000;
+                out += fmt::format("{}_sum{{{}}} {}\n", histogram, labels, sum);
+                out += fmt::format("{}_count{{{}}} {}\n", histogram, labels, cumulative);
+            }
+        }
+
+        return out;
+    } // to_prometheus_text
+
+    auto to_json(nlohmann::json& _json, const api_counters& _counters) -> void
+    {
+        _json = nlohmann::json{{"api_number", _counters.api_number},
+                               {"api_name", _counters.api_name},
+                               {"requests", _counters.requests},
+                               {"errors", _counters.errors},
+                               {"bytes_in", _counters.bytes_in},
+                               {"bytes_out", _counters.bytes_out},
+                               {"latency_sum_in_microseconds", _counters.latency_sum_in_microseconds},
+                               {"latency_buckets", _counters.latency_buckets}};
+    } // to_json
+
+    auto from_json(const nlohmann::json& _json, api_counters& _counters) -> void
+    {
+        _json.at("api_number").get_to(_counters.api_number);
+        _json.at("api_name").get_to(_counters.api_name);
+        _json.at("requests").get_to(_counters.requests);
+        _json.at("errors").get_to(_counters.errors);
+        _json.at("bytes_in").get_to(_counters.bytes_in);
+        _json.at("bytes_out").get_to(_counters.bytes_out);
+        _json.at("latency_sum_in_microseconds").get_to(_counters.latency_sum_in_microseconds);
+        _json.at("latency_buckets").get_to(_counters.latency_buckets);
+    } // from_json
+} // namespace irods::experimental::api_statistics
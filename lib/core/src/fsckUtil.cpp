@@ -7,16 +7,584 @@
 #include "irods/scanUtil.h"
 #include "irods/checksum.h"
 #include "irods/rcGlobalExtern.h"
+#include "irods/thread_pool.hpp"
 
 #include <boost/filesystem/operations.hpp>
 #include <boost/filesystem/convenience.hpp>
 
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
 #include <cstring>
 #include <iostream>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace fs = boost::filesystem;
 
+namespace
+{
+    // The largest number of files checked by default at the same time.
+    constexpr int default_max_thread_count = 8;
+
+    // The number of files per thread which may wait to be checked before the walker
+    // stops reading directories. This bounds the memory used for large trees.
+    constexpr std::size_t in_flight_files_per_thread = 4 * MAX_SQL_ROWS;
+
+    // The catalog binds the values of an IN condition into a buffer of 32000 bytes, so
+    // batches are kept well below that.
+    constexpr std::size_t max_batch_bytes = 16000;
+
+    // The catalog information needed to check a local file.
+    struct replica_info
+    {
+        // The status of the lookup: 0, CAT_NO_ROWS_FOUND or an error.
+        int status = 0;
+        std::string data_name;
+        std::string coll_name;
+        std::string data_size;
+        std::string checksum;
+    }; // struct replica_info
+
+    // The client configuration needed to verify checksums, captured once so that it can be
+    // shared with the threads which do the checks.
+    struct checksum_policy
+    {
+        std::string default_hash_scheme;
+        std::string match_hash_policy;
+    }; // struct checksum_policy
+
+    // The messages produced by the check of a single file, held until they can be printed in
+    // the order in which the files were found.
+    struct check_report
+    {
+        std::string out;
+        std::string err;
+    }; // struct check_report
+
+    [[gnu::format(printf, 2, 3)]]
+    auto append_formatted(std::string& _s, const char* _format, ...) -> void
+    {
+        std::va_list args;
+        va_start(args, _format);
+        std::va_list args_copy;
+        va_copy(args_copy, args);
+
+        if (const int n = std::vsnprintf(nullptr, 0, _format, args); n > 0) {
+            const auto offset = _s.size();
+            _s.resize(offset + n + 1);
+            std::vsnprintf(_s.data() + offset, n + 1, _format, args_copy);
+            _s.resize(offset + n);
+        }
+
+        va_end(args_copy);
+        va_end(args);
+    } // append_formatted
+
+    auto print_report(const check_report& _report) -> void
+    {
+        std::fputs(_report.out.c_str(), stdout);
+        std::fflush(stdout);
+        std::cerr << _report.err;
+    } // print_report
+
+    auto row_value(genQueryOut_t& _out, int _column, int _row) -> const char*
+    {
+        const auto& result = _out.sqlResult[_column];
+        return &result.value[result.len * _row];
+    } // row_value
+
+    auto to_replica_info(genQueryOut_t& _out, int _row) -> replica_info
+    {
+        return {0,
+                row_value(_out, 0, _row),
+                row_value(_out, 1, _row),
+                row_value(_out, 2, _row),
+                row_value(_out, 3, _row)};
+    } // to_replica_info
+
+    // Looks up the replica stored at a single physical path.
+    auto lookup_replica(rcComm_t* _conn,
+                        SetGenQueryInpFromPhysicalPath _strategy,
+                        const char* _strategy_argument,
+                        const std::string& _path) -> replica_info
+    {
+        genQueryInp_t genQueryInp;
+        _strategy(&genQueryInp, _path.c_str(), _strategy_argument);
+
+        genQueryOut_t* genQueryOut = nullptr;
+        replica_info info;
+        info.status = rcGenQuery(_conn, &genQueryInp, &genQueryOut);
+
+        if (info.status == 0 && genQueryOut) {
+            info = to_replica_info(*genQueryOut, 0);
+        }
+        else if (info.status == 0) {
+            info.status = SYS_INTERNAL_ERR;
+        }
+
+        clearGenQueryInp(&genQueryInp);
+        freeGenQueryOut(&genQueryOut);
+
+        return info;
+    } // lookup_replica
+
+    // Looks up the replicas stored at several physical paths with a single query.
+    //
+    // The query built by the strategy for the first path is reused, with its condition on the
+    // physical path replaced by an IN condition holding every path. If the query cannot be
+    // batched, each path is looked up separately.
+    auto lookup_replicas(rcComm_t* _conn,
+                         SetGenQueryInpFromPhysicalPath _strategy,
+                         const char* _strategy_argument,
+                         const std::vector<std::string>& _paths) -> std::vector<replica_info>
+    {
+        const auto lookup_each = [&] {
+            std::vector<replica_info> infos;
+            infos.reserve(_paths.size());
+
+            for (const auto& path : _paths) {
+                infos.push_back(lookup_replica(_conn, _strategy, _strategy_argument, path));
+            }
+
+            return infos;
+        };
+
+        // Paths containing a quote cannot be expressed in an IN condition.
+        const auto has_quote = [](const std::string& _p) { return _p.find('\'') != std::string::npos; };
+
+        if (_paths.size() < 2 || std::any_of(std::begin(_paths), std::end(_paths), has_quote)) {
+            return lookup_each();
+        }
+
+        genQueryInp_t genQueryInp;
+        _strategy(&genQueryInp, _paths.front().c_str(), _strategy_argument);
+
+        auto& conditions = genQueryInp.sqlCondInp;
+        auto* const last = conditions.inx + conditions.len;
+        auto* const iter = std::find(conditions.inx, last, COL_D_DATA_PATH);
+
+        if (iter == last) {
+            clearGenQueryInp(&genQueryInp);
+            return lookup_each();
+        }
+
+        std::string in_condition = "in (";
+        for (const auto& path : _paths) {
+            in_condition += '\'';
+            in_condition += path;
+            in_condition += "', ";
+        }
+        in_condition.replace(in_condition.size() - 2, 2, ")");
+
+        char*& value = conditions.value[iter - conditions.inx];
+        std::free(value);
+        value = strdup(in_condition.c_str());
+
+        // The physical path is selected so that each row can be matched to a local file.
+        if (int ignored{}; getIvalByInx(&genQueryInp.selectInp, COL_D_DATA_PATH, &ignored) < 0) {
+            addInxIval(&genQueryInp.selectInp, COL_D_DATA_PATH, 1);
+        }
+
+        genQueryInp.maxRows = MAX_SQL_ROWS;
+
+        std::unordered_map<std::string, replica_info> infos_by_path;
+        genQueryOut_t* genQueryOut = nullptr;
+        int status = 0;
+
+        do {
+            status = rcGenQuery(_conn, &genQueryInp, &genQueryOut);
+            if (status < 0 || !genQueryOut) {
+                break;
+            }
+
+            const auto* data_path = getSqlResultByInx(genQueryOut, COL_D_DATA_PATH);
+            if (!data_path) {
+                status = SYS_INTERNAL_ERR;
+                break;
+            }
+
+            for (int row = 0; row < genQueryOut->rowCnt; ++row) {
+                // The first replica found at a path is used, as when looking up a single path.
+                infos_by_path.try_emplace(&data_path->value[data_path->len * row], to_replica_info(*genQueryOut, row));
+            }
+
+            genQueryInp.continueInx = genQueryOut->continueInx;
+            freeGenQueryOut(&genQueryOut);
+        } while (genQueryInp.continueInx > 0);
+
+        if (genQueryInp.continueInx > 0) {
+            // Close the statement on the server.
+            genQueryInp.maxRows = 0;
+            freeGenQueryOut(&genQueryOut);
+            rcGenQuery(_conn, &genQueryInp, &genQueryOut);
+        }
+
+        clearGenQueryInp(&genQueryInp);
+        freeGenQueryOut(&genQueryOut);
+
+        if (status < 0 && status != CAT_NO_ROWS_FOUND) {
+            return lookup_each();
+        }
+
+        std::vector<replica_info> infos;
+        infos.reserve(_paths.size());
+
+        for (const auto& path : _paths) {
+            if (auto it = infos_by_path.find(path); it != std::end(infos_by_path)) {
+                infos.push_back(std::move(it->second));
+            }
+            else {
+                infos.push_back({CAT_NO_ROWS_FOUND, "", "", "", ""});
+            }
+        }
+
+        return infos;
+    } // lookup_replicas
+
+    // Compares a local file against the catalog information of its replica and reports any
+    // inconsistency. Safe to call from several threads at once.
+    //
+    // Messages are appended to \p _report instead of being printed. Errors which are logged,
+    // i.e. failing to get the size of the local file, are written immediately.
+    //
+    // \param[out] _report The messages to print for the file.
+    // \param[out] _bytes  The size of the local file.
+    auto check_local_file(const std::string& _path,
+                          const replica_info& _info,
+                          bool _verify_checksum,
+                          const checksum_policy& _policy,
+                          check_report& _report,
+                          std::uintmax_t& _bytes) -> int
+    {
+        const char* inpPath = _path.c_str();
+        int status = _info.status;
+
+        if (status == 0) {
+            const char* objName = _info.data_name.c_str();
+            const char* objPath = _info.coll_name.c_str();
+
+            intmax_t objSize = 0;
+
+            try {
+                objSize = std::stoll(_info.data_size);
+            }
+            catch (const std::invalid_argument& e) {
+                append_formatted(_report.err, "ERROR: could not parse object size into integer [exception => %s, path => %s].\n", e.what(), inpPath);
+                return SYS_INTERNAL_ERR;
+            }
+            catch (const std::out_of_range& e) {
+                append_formatted(_report.err, "ERROR: could not parse object size into integer [exception => %s, path => %s].\n", e.what(), inpPath);
+                return SYS_INTERNAL_ERR;
+            }
+
+            const char* objChksum = _info.checksum.c_str();
+
+            intmax_t srcSize = 0;
+
+            try {
+                srcSize = fs::file_size(_path);
+            }
+            catch (const fs::filesystem_error& e) {
+                rodsLog(LOG_ERROR, "Could not get the size of \"%s\": %s", inpPath, e.code().message().c_str());
+                return e.code().value();
+            }
+
+            _bytes = srcSize;
+
+            if (srcSize == objSize) {
+                if (_verify_checksum) {
+                    if (std::strcmp(objChksum, "") != 0) {
+                        status = verifyChksumLocFileWithPolicy(inpPath,
+                                                               objChksum,
+                                                               _policy.default_hash_scheme.c_str(),
+                                                               _policy.match_hash_policy.c_str());
+
+                        if (status == USER_CHKSUM_MISMATCH) {
+                            append_formatted(_report.out, "CORRUPTION: local file [%s] checksum not consistent with iRODS object [%s/%s] checksum.\n", inpPath, objPath, objName);
+                        }
+                        else if (status != 0) {
+                            append_formatted(_report.out, "ERROR chkObjConsistency: verifyChksumLocFile failed: status [%d] file [%s] objPath [%s] objName [%s] objChksum [%s]\n", status, inpPath, objPath, objName, objChksum);
+                        }
+                    }
+                    else {
+                        append_formatted(_report.out, "WARNING: checksum not available for iRODS object [%s/%s], no checksum comparison possible with local file [%s] .\n", objPath, objName, inpPath);
+                    }
+                }
+            }
+            else {
+                append_formatted(_report.out, "CORRUPTION: local file [%s] size [%ji] not consistent with iRODS object [%s/%s] size [%ji].\n", inpPath, srcSize, objPath, objName, objSize);
+                status = SYS_INTERNAL_ERR;
+            }
+        }
+        else if (status == CAT_NO_ROWS_FOUND) {
+            append_formatted(_report.out, "WARNING: local file [%s] is not registered in iRODS.\n", inpPath);
+        }
+        else {
+            append_formatted(_report.out, "ERROR chkObjConsistency: rcGenQuery failed: status [%d] file [%s]\n", status, inpPath);
+        }
+
+        return status;
+    } // check_local_file
+
+    auto capture_checksum_policy(checksum_policy& _policy) -> int
+    {
+        rodsEnv env;
+        if (const int ec = getRodsEnv(&env); ec < 0) {
+            return ec;
+        }
+
+        _policy.default_hash_scheme = env.rodsDefaultHashScheme;
+        _policy.match_hash_policy = env.rodsMatchHashPolicy;
+
+        return 0;
+    } // capture_checksum_policy
+
+    // Checks a tree of local files as a pipeline.
+    //
+    // The calling thread walks the tree and looks up the replicas of each directory in
+    // batches, since the connection cannot be shared. The size and checksum of each file are
+    // checked by a thread pool while the walk continues.
+    //
+    // The entries of each directory are visited in lexicographical order of their paths. The
+    // messages of each file are printed in that order, regardless of which thread checked it,
+    // so the output does not depend on the number of threads.
+    class fsck_engine
+    {
+      public:
+        fsck_engine(rcComm_t* _conn,
+                    rodsArguments_t* _args,
+                    SetGenQueryInpFromPhysicalPath _strategy,
+                    const char* _strategy_argument,
+                    checksum_policy _policy)
+            : conn_{_conn}
+            , verify_checksum_{_args->verifyChecksum == True}
+            , verbose_{_args->verbose == True}
+            , recursive_{_args->recursive == True}
+            , strategy_{_strategy}
+            , strategy_argument_{_strategy_argument}
+            , policy_{std::move(_policy)}
+            , thread_count_{thread_count(*_args)}
+            , pool_{thread_count_}
+            , max_in_flight_{in_flight_files_per_thread * thread_count_}
+            , mutex_{}
+            , cv_{}
+            , in_flight_{}
+            , next_sequence_{}
+            , next_to_print_{}
+            , reports_{}
+            , error_sequence_{std::numeric_limits<std::uint64_t>::max()}
+            , status_{}
+            , files_{}
+            , bytes_{}
+            , start_{std::chrono::steady_clock::now()}
+        {
+        }
+
+        fsck_engine(const fsck_engine&) = delete;
+        auto operator=(const fsck_engine&) -> fsck_engine& = delete;
+
+        ~fsck_engine()
+        {
+            pool_.join();
+        }
+
+        // Checks every file in a directory, and in its subdirectories if recursion was requested.
+        auto check_directory(const fs::path& _dir) -> void
+        {
+            std::vector<std::string> batch;
+            std::size_t batch_bytes = 0;
+
+            try {
+                std::vector<fs::path> entries{fs::directory_iterator{_dir}, fs::directory_iterator{}};
+                std::sort(std::begin(entries), std::end(entries));
+
+                for (const auto& e : entries) {
+                    // Don't do anything if it is symlink.
+                    if (fs::is_symlink(e)) {
+                        continue;
+                    }
+
+                    if (fs::is_directory(e)) {
+                        if (recursive_) {
+                            check_directory(e);
+                        }
+
+                        continue;
+                    }
+
+                    if (batch.size() == MAX_SQL_ROWS || batch_bytes + e.size() + 4 > max_batch_bytes) {
+                        submit(batch);
+                        batch_bytes = 0;
+                    }
+
+                    batch_bytes += e.size() + 4;
+                    batch.push_back(e.string());
+                }
+            }
+            catch (const fs::filesystem_error& e) {
+                // Logged immediately, and so possibly ahead of messages for files found earlier.
+                if (e.code() == std::errc::permission_denied) {
+                    rodsLog(LOG_ERROR, "Permission denied: \"%s\"", e.path1().c_str());
+                }
+
+                submit(batch);
+
+                const auto seq = reserve_sequence();
+                complete(seq, e.code().value(), {}, 0);
+
+                return;
+            }
+
+            submit(batch);
+        } // check_directory
+
+        // Waits for every file to be checked and returns the status of the first failure, in
+        // the order in which the files were found.
+        auto finish() -> int
+        {
+            pool_.join();
+
+            if (verbose_) {
+                using seconds = std::chrono::duration<double>;
+                const auto elapsed = std::chrono::duration_cast<seconds>(std::chrono::steady_clock::now() - start_);
+                const auto rate = [&elapsed](double _n) { return elapsed.count() > 0 ? _n / elapsed.count() : 0.0; };
+
+                std::printf("Checked %ju files (%ju bytes) in %.3f seconds using %d threads "
+                            "[%.1f files/s, %.3f MB/s].\n",
+                            files_,
+                            bytes_,
+                            elapsed.count(),
+                            thread_count_,
+                            rate(files_),
+                            rate(bytes_) / (1024 * 1024));
+            }
+
+            return status_;
+        } // finish
+
+      private:
+        static auto thread_count(const rodsArguments_t& _args) -> int
+        {
+            if (_args.number == True) {
+                return std::max(_args.numberValue, 1);
+            }
+
+            const int hardware_threads = static_cast<int>(std::thread::hardware_concurrency());
+            return std::clamp(hardware_threads, 1, default_max_thread_count);
+        } // thread_count
+
+        // Looks up a batch of files and hands them to the thread pool. The batch is cleared.
+        auto submit(std::vector<std::string>& _batch) -> void
+        {
+            if (_batch.empty()) {
+                return;
+            }
+
+            auto infos = lookup_replicas(conn_, strategy_, strategy_argument_, _batch);
+
+            {
+                std::lock_guard lock{mutex_};
+                files_ += _batch.size();
+            }
+
+            for (std::size_t i = 0; i < _batch.size(); ++i) {
+                irods::thread_pool::post(
+                    pool_, [this, seq = reserve_sequence(), path = std::move(_batch[i]), info = std::move(infos[i])] {
+                        check_report report;
+                        std::uintmax_t bytes = 0;
+                        const int status = check_local_file(path, info, verify_checksum_, policy_, report, bytes);
+
+                        complete(seq, status, std::move(report), bytes);
+                    });
+            }
+
+            _batch.clear();
+        } // submit
+
+        // Returns the sequence number of the next entry found by the walk. Blocks while too many
+        // entries are waiting to be printed.
+        auto reserve_sequence() -> std::uint64_t
+        {
+            std::unique_lock lock{mutex_};
+            cv_.wait(lock, [this] { return in_flight_ < max_in_flight_; });
+            ++in_flight_;
+
+            return next_sequence_++;
+        } // reserve_sequence
+
+        // Records the result of an entry and prints the messages of every entry which is no
+        // longer waiting for an earlier one.
+        auto complete(std::uint64_t _sequence, int _status, check_report _report, std::uintmax_t _bytes) -> void
+        {
+            std::size_t printed = 0;
+
+            {
+                std::lock_guard lock{mutex_};
+
+                if (_status != 0 && _sequence < error_sequence_) {
+                    error_sequence_ = _sequence;
+                    status_ = _status;
+                }
+
+                bytes_ += _bytes;
+                reports_.emplace(_sequence, std::move(_report));
+
+                for (auto it = std::begin(reports_); it != std::end(reports_) && it->first == next_to_print_;) {
+                    print_report(it->second);
+                    it = reports_.erase(it);
+                    ++next_to_print_;
+                    ++printed;
+                }
+
+                in_flight_ -= printed;
+            }
+
+            if (printed > 0) {
+                cv_.notify_all();
+            }
+        } // complete
+
+        rcComm_t* conn_;
+        const bool verify_checksum_;
+        const bool verbose_;
+        const bool recursive_;
+        SetGenQueryInpFromPhysicalPath strategy_;
+        const char* strategy_argument_;
+        const checksum_policy policy_;
+
+        const int thread_count_;
+        irods::thread_pool pool_;
+        const std::size_t max_in_flight_;
+
+        std::mutex mutex_;
+        std::condition_variable cv_;
+        std::size_t in_flight_;
+
+        // Protected by mutex_.
+        std::uint64_t next_sequence_;
+        std::uint64_t next_to_print_;
+        std::map<std::uint64_t, check_report> reports_;
+        std::uint64_t error_sequence_;
+        int status_;
+        std::uintmax_t files_;
+        std::uintmax_t bytes_;
+
+        const std::chrono::steady_clock::time_point start_;
+    }; // class fsck_engine
+} // anonymous namespace
+
 int fsckObj(rcComm_t* conn,
             rodsArguments_t* myRodsArgs,
             rodsPathInp_t* rodsPathInp,
@@ -83,43 +651,18 @@ int fsckObjDir(rcComm_t* conn,
         return chkObjConsistency(conn, myRodsArgs, inpPath, strategy, argument_for_SetGenQueryInpFromPhysicalPath);
     }
 
-    char fullPath[MAX_PATH_ALLOWED] = "\0";
-    int status = 0;
-
-    try {
-        for (const auto& e : fs::directory_iterator{srcDirPath}) {
-            std::snprintf(fullPath, MAX_PATH_ALLOWED, "%s", e.path().c_str());
+    checksum_policy policy;
 
-            // Don't do anything if it is symlink.
-            if (fs::is_symlink(e.path())) {
-                continue;
-            }
-
-            if (fs::is_directory(e.path())) {
-                if (myRodsArgs->recursive == True) {
-                    const int tmp_status = fsckObjDir(conn, myRodsArgs, fullPath, strategy, argument_for_SetGenQueryInpFromPhysicalPath);
-                    if (status == 0) {
-                        status = tmp_status;
-                    }
-                }
-            }
-            else {
-                const int tmp_status = chkObjConsistency(conn, myRodsArgs, fullPath, strategy, argument_for_SetGenQueryInpFromPhysicalPath);
-                if (status == 0) {
-                    status = tmp_status;
-                }
-            }
+    if (myRodsArgs->verifyChecksum == True) {
+        if (const int ec = capture_checksum_policy(policy); ec < 0) {
+            return ec;
         }
     }
-    catch (const fs::filesystem_error& e) {
-        if (e.code() == std::errc::permission_denied) {
-            rodsLog(LOG_ERROR, "Permission denied: \"%s\"", e.path1().c_str());
-        }
 
-        return e.code().value();
-    }
+    fsck_engine engine{conn, myRodsArgs, strategy, argument_for_SetGenQueryInpFromPhysicalPath, std::move(policy)};
+    engine.check_directory(srcDirPath);
 
-    return status;
+    return engine.finish();
 }
 
 int chkObjConsistency(rcComm_t* conn,
@@ -133,64 +676,21 @@ int chkObjConsistency(rcComm_t* conn,
         return 0;
     }
 
-    genQueryInp_t genQueryInp;
-    strategy(&genQueryInp, inpPath, argument_for_SetGenQueryInpFromPhysicalPath);
-
-    genQueryOut_t* genQueryOut = nullptr;
-    int status = rcGenQuery(conn, &genQueryInp, &genQueryOut);
-
-    if (status == 0 && genQueryOut) {
-        const char* objName = genQueryOut->sqlResult[0].value;
-        const char* objPath = genQueryOut->sqlResult[1].value;
-
-        intmax_t objSize = 0;
-
-        try {
-            objSize = std::stoll(genQueryOut->sqlResult[2].value);
-        }
-        catch (const std::invalid_argument& e) {
-            std::cerr << "ERROR: could not parse object size into integer [exception => " << e.what() << ", path => " << inpPath << "].\n";
-            return SYS_INTERNAL_ERR;
-        }
-        catch (const std::out_of_range& e) {
-            std::cerr << "ERROR: could not parse object size into integer [exception => " << e.what() << ", path => " << inpPath << "].\n";
-            return SYS_INTERNAL_ERR;
-        }
-
-        const char* objChksum = genQueryOut->sqlResult[3].value;
-        const intmax_t srcSize = fs::file_size(p);
+    checksum_policy policy;
+    const bool verify_checksum = myRodsArgs->verifyChecksum == True;
 
-        if (srcSize == objSize) {
-            if (myRodsArgs->verifyChecksum == True) {
-                if (std::strcmp(objChksum, "") != 0) {
-                    status = verifyChksumLocFile(inpPath, objChksum, nullptr);
-                    if (status == USER_CHKSUM_MISMATCH) {
-                        std::printf("CORRUPTION: local file [%s] checksum not consistent with iRODS object [%s/%s] checksum.\n", inpPath, objPath, objName);
-                    }
-                    else if (status != 0) {
-                        std::printf("ERROR chkObjConsistency: verifyChksumLocFile failed: status [%d] file [%s] objPath [%s] objName [%s] objChksum [%s]\n", status, inpPath, objPath, objName, objChksum);
-                    }
-                }
-                else {
-                    std::printf("WARNING: checksum not available for iRODS object [%s/%s], no checksum comparison possible with local file [%s] .\n", objPath, objName, inpPath);
-                }
-            }
+    if (verify_checksum) {
+        if (const int ec = capture_checksum_policy(policy); ec < 0) {
+            return ec;
         }
-        else {
-            std::printf("CORRUPTION: local file [%s] size [%ji] not consistent with iRODS object [%s/%s] size [%ji].\n", inpPath, srcSize, objPath, objName, objSize);
-            status = SYS_INTERNAL_ERR;
-        }
-    }
-    else if (status == CAT_NO_ROWS_FOUND) {
-        std::printf("WARNING: local file [%s] is not registered in iRODS.\n", inpPath);
-    }
-    else {
-        std::printf("ERROR chkObjConsistency: rcGenQuery failed: status [%d] genQueryOut [%p] file [%s]\n", status, genQueryOut, inpPath);
     }
 
-    clearGenQueryInp(&genQueryInp);
-    freeGenQueryOut(&genQueryOut);
+    const auto info = lookup_replica(conn, strategy, argument_for_SetGenQueryInpFromPhysicalPath, inpPath);
+
+    check_report report;
+    std::uintmax_t bytes = 0;
+    const int status = check_local_file(inpPath, info, verify_checksum, policy, report, bytes);
+    print_report(report);
 
     return status;
 }
-
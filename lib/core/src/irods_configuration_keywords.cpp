@@ -78,6 +78,7 @@ namespace irods
     const char* const KW_CFG_DEF_TEMP_PASSWORD_LIFETIME{"default_temporary_password_lifetime_in_seconds"};
     const char* const KW_CFG_MAX_TEMP_PASSWORD_LIFETIME{"maximum_temporary_password_lifetime_in_seconds"};
     const char* const KW_CFG_NUMBER_OF_CONCURRENT_DELAY_RULE_EXECUTORS{"number_of_concurrent_delay_rule_executors"};
+    const char* const KW_CFG_NUMBER_OF_CONCURRENT_UNLINK_THREADS{"number_of_concurrent_unlink_threads"};
     const char* const KW_CFG_MAX_SIZE_OF_DELAY_QUEUE_IN_BYTES{"maximum_size_of_delay_queue_in_bytes"};
     const char* const KW_CFG_STACKTRACE_FILE_PROCESSOR_SLEEP_TIME_IN_SECONDS{"stacktrace_file_processor_sleep_time_in_seconds"};
     const char* const KW_CFG_AGENT_FACTORY_WATCHER_SLEEP_TIME_IN_SECONDS{"agent_factory_watcher_sleep_time_in_seconds"};
@@ -93,6 +94,16 @@ namespace irods
     const char* const KW_CFG_EVICTION_AGE_IN_SECONDS{"eviction_age_in_seconds"};
     const char* const KW_CFG_CACHE_CLEARER_SLEEP_TIME_IN_SECONDS{"cache_clearer_sleep_time_in_seconds"};
 
+    const char* const KW_CFG_SERVER_TO_SERVER_CONNECTION_POOL{"server_to_server_connection_pool"};
+    const char* const KW_CFG_MAX_IDLE_CONNECTIONS{"max_idle_connections"};
+    const char* const KW_CFG_IDLE_TIMEOUT_IN_SECONDS{"idle_timeout_in_seconds"};
+
+    const char* const KW_CFG_ACCESS_CHECK_CACHE{"access_check_cache"};
+    const char* const KW_CFG_MAX_ENTRIES{"max_entries"};
+
+    const char* const KW_CFG_TRACING{"tracing"};
+    const char* const KW_CFG_SINK{"sink"};
+
     // service_account_environment.json keywords
     const char* const KW_CFG_IRODS_USER_NAME{"irods_user_name"};
     const char* const KW_CFG_IRODS_HOST{"irods_host"};
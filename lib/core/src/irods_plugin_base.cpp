@@ -0,0 +1,60 @@
+#include "irods/irods_plugin_base.hpp"
+
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace
+{
+    // Maps operation names to their slot in every plugin's dispatch table. Slots are never
+    // reused, so an index remains valid for the lifetime of the process.
+    struct operation_registry
+    {
+        std::shared_mutex mutex;
+        std::unordered_map<std::string, std::size_t> indices;
+
+        // A deque keeps references to existing names valid as new names are added.
+        std::deque<std::string> names;
+    }; // struct operation_registry
+
+    auto get_operation_registry() -> operation_registry&
+    {
+        static operation_registry registry;
+        return registry;
+    } // get_operation_registry
+} // anonymous namespace
+
+namespace irods
+{
+    auto get_operation_index(const std::string& _operation_name) -> operation_index
+    {
+        auto& registry = get_operation_registry();
+
+        {
+            std::shared_lock lock{registry.mutex};
+
+            if (const auto iter = registry.indices.find(_operation_name); iter != std::end(registry.indices)) {
+                return static_cast<operation_index>(iter->second);
+            }
+        }
+
+        std::unique_lock lock{registry.mutex};
+
+        const auto [iter, inserted] = registry.indices.try_emplace(_operation_name, registry.names.size());
+
+        if (inserted) {
+            registry.names.push_back(_operation_name);
+        }
+
+        return static_cast<operation_index>(iter->second);
+    } // get_operation_index
+
+    auto get_operation_name(operation_index _index) -> const std::string&
+    {
+        auto& registry = get_operation_registry();
+
+        std::shared_lock lock{registry.mutex};
+        return registry.names.at(static_cast<std::size_t>(_index));
+    } // get_operation_name
+} // namespace irods
@@ -0,0 +1,218 @@
+#include "irods/load_digest_cache.hpp"
+
+#include <boost/interprocess/managed_shared_memory.hpp>
+#include <boost/interprocess/shared_memory_object.hpp>
+#include <boost/interprocess/containers/map.hpp>
+#include <boost/interprocess/containers/string.hpp>
+#include <boost/interprocess/allocators/allocator.hpp>
+#include <boost/interprocess/sync/named_sharable_mutex.hpp>
+#include <boost/interprocess/sync/scoped_lock.hpp>
+#include <boost/interprocess/sync/sharable_lock.hpp>
+
+#include <fmt/format.h>
+
+#include <utility>
+
+#include <sys/types.h>
+#include <unistd.h>
+
+namespace
+{
+    namespace bi = boost::interprocess;
+
+    using std::chrono::duration_cast;
+    using std::chrono::seconds;
+
+    struct digest;
+
+    // clang-format off
+    using segment_manager_type = bi::managed_shared_memory::segment_manager;
+    using void_allocator_type  = bi::allocator<void, segment_manager_type>;
+    using char_allocator_type  = bi::allocator<char, segment_manager_type>;
+    using key_type             = bi::basic_string<char, std::char_traits<char>, char_allocator_type>;
+    using mapped_type          = digest;
+    using value_type           = std::pair<const key_type, mapped_type>;
+    using value_allocator_type = bi::allocator<value_type, segment_manager_type>;
+    using map_type             = bi::map<key_type, mapped_type, std::less<key_type>, value_allocator_type>;
+    using clock_type           = std::chrono::system_clock;
+    // clang-format on
+
+    // The value type mapped to a specific resource name.
+    struct digest
+    {
+        int load_factor;
+        std::int64_t create_time;
+    }; // struct digest
+
+    //
+    // Global Variables
+    //
+
+    // The following variables define the names of shared memory objects and other properties.
+    std::string g_segment_name;
+    std::size_t g_segment_size;
+    std::string g_mutex_name;
+
+    // On initialization, holds the PID of the process that initialized the load digest cache.
+    // This ensures that only the process that initialized the system can deinitialize it.
+    pid_t g_owner_pid;
+
+    // The following are pointers to the shared memory objects and allocator.
+    // Allocating on the heap allows us to know when the load digest cache is constructed/destructed.
+    std::unique_ptr<bi::managed_shared_memory> g_segment;
+    std::unique_ptr<void_allocator_type> g_allocator;
+    std::unique_ptr<bi::named_sharable_mutex> g_mutex;
+    map_type* g_map;
+
+    // The seconds since epoch representing when the snapshot held by g_map expires.
+    std::int64_t* g_expiration;
+
+    auto current_timestamp_in_seconds() noexcept -> std::int64_t
+    {
+        return duration_cast<seconds>(clock_type::now().time_since_epoch()).count();
+    }
+
+    // Assumes the caller holds an exclusive lock on g_mutex.
+    auto insert_if_newer(const irods::experimental::load_digest_cache::load_digest& _digest) -> bool
+    {
+        key_type key{_digest.resource_name.data(), *g_allocator};
+
+        if (auto iter = g_map->find(key); iter != g_map->end()) {
+            if (iter->second.create_time > _digest.create_time) {
+                return false;
+            }
+
+            iter->second = mapped_type{_digest.load_factor, _digest.create_time};
+            return true;
+        }
+
+        g_map->emplace(std::move(key), mapped_type{_digest.load_factor, _digest.create_time});
+
+        return true;
+    } // insert_if_newer
+} // anonymous namespace
+
+namespace irods::experimental::load_digest_cache
+{
+    auto init(const std::string_view _shm_name, std::size_t _shm_size) -> void
+    {
+        if (getpid() == g_owner_pid) {
+            return;
+        }
+
+        g_segment_name = fmt::format("{}_{}_{}", _shm_name, getpid(), current_timestamp_in_seconds());
+        g_segment_size = _shm_size;
+        g_mutex_name = g_segment_name + "_mutex";
+
+        bi::named_sharable_mutex::remove(g_mutex_name.data());
+        bi::shared_memory_object::remove(g_segment_name.data());
+
+        g_owner_pid = getpid();
+        g_segment = std::make_unique<bi::managed_shared_memory>(bi::create_only, g_segment_name.data(), g_segment_size);
+        g_allocator = std::make_unique<void_allocator_type>(g_segment->get_segment_manager());
+        g_mutex = std::make_unique<bi::named_sharable_mutex>(bi::create_only, g_mutex_name.data());
+        g_map = g_segment->construct<map_type>(bi::anonymous_instance)(std::less<key_type>{}, *g_allocator);
+        g_expiration = g_segment->construct<std::int64_t>(bi::anonymous_instance)(0);
+    } // init
+
+    auto deinit() noexcept -> void
+    {
+        if (getpid() != g_owner_pid) {
+            return;
+        }
+
+        try {
+            g_owner_pid = 0;
+
+            if (g_segment && g_map) {
+                g_segment->destroy_ptr(g_map);
+                g_map = nullptr;
+            }
+
+            if (g_segment && g_expiration) {
+                g_segment->destroy_ptr(g_expiration);
+                g_expiration = nullptr;
+            }
+
+            // clang-format off
+            if (g_mutex)     { g_mutex.reset(); }
+            if (g_allocator) { g_allocator.reset(); }
+            if (g_segment)   { g_segment.reset(); }
+            // clang-format on
+
+            bi::named_sharable_mutex::remove(g_mutex_name.data());
+            bi::shared_memory_object::remove(g_segment_name.data());
+        }
+        catch (...) {}
+    } // deinit
+
+    auto assign(const std::vector<load_digest>& _digests, std::chrono::seconds _expires_after) -> void
+    {
+        if (!g_map) {
+            return;
+        }
+
+        bi::scoped_lock lk{*g_mutex};
+
+        g_map->clear();
+
+        for (const auto& d : _digests) {
+            insert_if_newer(d);
+        }
+
+        *g_expiration = current_timestamp_in_seconds() + _expires_after.count();
+    } // assign
+
+    auto insert_or_assign(const load_digest& _digest) -> bool
+    {
+        if (!g_map) {
+            return false;
+        }
+
+        bi::scoped_lock lk{*g_mutex};
+        return insert_if_newer(_digest);
+    } // insert_or_assign
+
+    auto lookup() -> std::optional<std::vector<load_digest>>
+    {
+        if (!g_map) {
+            return std::nullopt;
+        }
+
+        bi::sharable_lock lk{*g_mutex};
+
+        if (current_timestamp_in_seconds() >= *g_expiration) {
+            return std::nullopt;
+        }
+
+        std::vector<load_digest> digests;
+        digests.reserve(g_map->size());
+
+        for (const auto& [name, d] : *g_map) {
+            digests.push_back({std::string{name.data(), name.size()}, d.load_factor, d.create_time});
+        }
+
+        return digests;
+    } // lookup
+
+    auto clear() -> void
+    {
+        if (!g_map) {
+            return;
+        }
+
+        bi::scoped_lock lk{*g_mutex};
+        g_map->clear();
+        *g_expiration = 0;
+    } // clear
+
+    auto size() -> std::size_t
+    {
+        if (!g_map) {
+            return 0;
+        }
+
+        bi::sharable_lock lk{*g_mutex};
+        return g_map->size();
+    } // size
+} // namespace irods::experimental::load_digest_cache
@@ -13,8 +13,10 @@
 #include "irods/sockCommNetworkInterface.hpp"
 #include "irods/sslSockComm.h"
 #include "irods/irods_client_server_negotiation.hpp"
+#include "irods/tracing.hpp"
 
 #include <iostream>
+#include <optional>
 
 #include <boost/shared_ptr.hpp>
 
@@ -58,8 +60,27 @@ int procApiRequest(rcComm_t *conn,
         return apiInx;
     }
 
+    // Measures the request as seen by the caller, e.g. an agent talking to another server.
+    namespace tracing = irods::experimental::tracing;
+
+    std::optional<tracing::span> client_span;
+
+    if (tracing::is_recording()) {
+        auto& api_table = irods::get_client_api_table();
+        const auto iter = api_table.find(apiInx);
+        const auto found = iter != std::end(api_table) && iter->second;
+        client_span.emplace(found ? iter->second->operation_name : "unknown", tracing::span_kind::client);
+        client_span->set_attribute("irods.api.number", apiNumber);
+        client_span->set_attribute("server.address", conn->host);
+    }
+
     if (const auto ec = sendApiRequest(conn, apiInx, inputStruct, inputBsBBuf); ec < 0) {
         rodsLogError(LOG_DEBUG, ec, "procApiRequest: sendApiRequest failed. status = %d", ec);
+
+        if (client_span) {
+            client_span->set_error_code(ec);
+        }
+
         return ec;
     }
 
@@ -70,6 +91,10 @@ int procApiRequest(rcComm_t *conn,
         rodsLogError(LOG_DEBUG, ec, "procApiRequest: readAndProcApiReply failed. status = %d", ec);
     }
 
+    if (client_span) {
+        client_span->set_error_code(ec);
+    }
+
     return ec;
 }
 
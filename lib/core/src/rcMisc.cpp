@@ -83,6 +83,25 @@ namespace
             std::free(_q); // NOLINT(cppcoreguidelines-owning-memory, cppcoreguidelines-no-malloc)
         }
     }
+
+    // Returns the index of the first entry in _kvp whose keyword is _key_word, or -1.
+    //
+    // condInput is consulted many times per request, so the first characters are compared
+    // before calling strcmp. Most keywords differ in their first character.
+    auto index_of_keyword(const keyValPair_t& _kvp, const char* _key_word) -> int
+    {
+        const char first = *_key_word;
+
+        for (int i = 0; i < _kvp.len; ++i) {
+            const char* k = _kvp.keyWord[i];
+
+            if (k && *k == first && std::strcmp(k, _key_word) == 0) {
+                return i;
+            }
+        }
+
+        return -1;
+    } // index_of_keyword
 } // namespace
 
 int
@@ -613,19 +632,13 @@ getDataObjInfoCnt( dataObjInfo_t *dataObjInfoHead ) {
 
 char *
 getValByKey( const keyValPair_t *condInput, const char *keyWord ) {
-    int i;
-
-    if ( condInput == NULL ) {
+    if ( condInput == NULL || keyWord == NULL ) {
         return NULL;
     }
 
-    for ( i = 0; i < condInput->len; i++ ) {
-        if ( strcmp( condInput->keyWord[i], keyWord ) == 0 ) {
-            return condInput->value[i];
-        }
-    }
+    const int i = index_of_keyword( *condInput, keyWord );
 
-    return NULL;
+    return i < 0 ? NULL : condInput->value[i];
 }
 
 int
@@ -648,30 +661,29 @@ getIvalByInx( inxIvalPair_t *inxIvalPair, int inx, int *outValue ) {
 
 int
 rmKeyVal( keyValPair_t *condInput, const char *keyWord ) {
-    int i, j;
+    if ( condInput == NULL || keyWord == NULL ) {
+        return 0;
+    }
 
-    if ( condInput == NULL ) {
+    const int i = index_of_keyword( *condInput, keyWord );
+    if ( i < 0 ) {
         return 0;
     }
 
-    for ( i = 0; i < condInput->len; i++ ) {
-        if ( condInput->keyWord[i] != NULL &&
-                strcmp( condInput->keyWord[i], keyWord ) == 0 ) {
-            free( condInput->keyWord[i] );
-            free( condInput->value[i] );
-            condInput->len--;
-            for ( j = i; j < condInput->len; j++ ) {
-                condInput->keyWord[j] = condInput->keyWord[j + 1];
-                condInput->value[j] = condInput->value[j + 1];
-            }
-            if ( condInput->len <= 0 ) {
-                free( condInput->keyWord );
-                free( condInput->value );
-                condInput->value = condInput->keyWord = NULL;
-            }
-            break;
-        }
+    free( condInput->keyWord[i] );
+    free( condInput->value[i] );
+    condInput->len--;
+
+    const std::size_t tail = condInput->len - i;
+    memmove( condInput->keyWord + i, condInput->keyWord + i + 1, tail * sizeof( *condInput->keyWord ) );
+    memmove( condInput->value + i, condInput->value + i + 1, tail * sizeof( *condInput->value ) );
+
+    if ( condInput->len <= 0 ) {
+        free( condInput->keyWord );
+        free( condInput->value );
+        condInput->value = condInput->keyWord = NULL;
     }
+
     return 0;
 }
 
@@ -763,14 +775,14 @@ addKeyVal( keyValPair_t *condInput, const char *keyWord, const char *value ) {
 
     /* check if the keyword exists */
     for ( int i = 0; i < condInput->len; i++ ) {
-        if ( condInput->keyWord[i] == NULL || strlen( condInput->keyWord[i] ) == 0 ) {
+        if ( condInput->keyWord[i] == NULL || condInput->keyWord[i][0] == '\0' ) {
             free( condInput->keyWord[i] );
             free( condInput->value[i] );
             condInput->keyWord[i] = strdup( keyWord );
             condInput->value[i] = value ? strdup( value ) : NULL;
             return i;
         }
-        else if ( strcmp( keyWord, condInput->keyWord[i] ) == 0 ) {
+        else if ( condInput->keyWord[i][0] == keyWord[0] && strcmp( keyWord, condInput->keyWord[i] ) == 0 ) {
             free( condInput->value[i] );
             condInput->value[i] = value ? strdup( value ) : NULL;
             return i;
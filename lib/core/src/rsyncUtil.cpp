@@ -10,21 +10,64 @@
 #include "irods/irods_hasher_factory.hpp"
 #include "irods/irods_path_recursion.hpp"
 #include "irods/irods_exception.hpp"
+#include "irods/irods_query.hpp"
+#include "irods/connection_pool.hpp"
+#include "irods/rsync_diff.hpp"
+#include "irods/thread_pool.hpp"
 
 #include <boost/filesystem/operations.hpp>
 #include <boost/filesystem/convenience.hpp>
 
+#include <fmt/format.h>
+
+#include <sys/stat.h>
 #include <sys/time.h>
 
+#include <algorithm>
+#include <condition_variable>
 #include <cstdlib>
 #include <cstring>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
 #include <sstream>
+#include <string>
+#include <thread>
 
 static int CurrentTime = 0;
 
 int
 ageExceeded( int ageLimit, int myTime, char *objPath, rodsLong_t fileSize );
 
+// Same as rcChksumLocFile, except that the hashing configuration is taken from env rather than
+// read from the client environment.
+static int
+chksumLocFileWithEnv( char *fileName, const char *chksumFlag, keyValPair_t *condInput,
+                      const char *hashScheme, const rodsEnv &env ) {
+    char chksumStr[NAME_LEN];
+    int status = chksumLocFileWithPolicy( fileName, chksumStr, hashScheme,
+                                          env.rodsDefaultHashScheme, env.rodsMatchHashPolicy );
+    if ( status < 0 ) {
+        return status;
+    }
+
+    addKeyVal( condInput, chksumFlag, chksumStr );
+
+    return 0;
+}
+
+// Synchronizes a directory or collection tree in bulk mode (-b). Both trees are listed before
+// anything is transferred, and the files which differ are transferred concurrently.
+//
+// parseCmdLineOpt() sets rodsArgs->bulk for -b, but irsync only passes the options in its own
+// option string to it. Bulk mode is reachable from irsync once the icommands add "b" to that
+// string and to the usage of irsync. Until then it is only reachable through rsyncUtil().
+static int
+rsyncTreeUtil( rcComm_t *conn, rodsPath_t *srcPath, rodsPath_t *targPath,
+               rodsArguments_t *myRodsArgs, dataObjInp_t *dataObjOprInp,
+               dataObjCopyInp_t *dataObjCopyInp );
+
 int
 rsyncUtil( rcComm_t *conn, rodsEnv *myRodsEnv, rodsArguments_t *myRodsArgs,
            rodsPathInp_t *rodsPathInp ) {
@@ -123,6 +166,12 @@ rsyncUtil( rcComm_t *conn, rodsEnv *myRodsEnv, rodsArguments_t *myRodsArgs,
             status = rsyncDataToDataUtil( conn, srcPath, targPath,
                                           myRodsArgs, &dataObjCopyInp );
         }
+        else if ( srcType == COLL_OBJ_T && targType == LOCAL_DIR_T &&
+                  myRodsArgs->bulk == True && dataObjOprInp.specColl == NULL ) {
+            addKeyVal( &dataObjOprInp.condInput, TRANSLATED_PATH_KW, "" );
+            status = rsyncTreeUtil( conn, srcPath, targPath, myRodsArgs,
+                                    &dataObjOprInp, NULL );
+        }
         else if ( srcType == COLL_OBJ_T && targType == LOCAL_DIR_T ) {
             addKeyVal( &dataObjOprInp.condInput, TRANSLATED_PATH_KW, "" );
             status = rsyncCollToDirUtil( conn, srcPath, targPath,
@@ -134,11 +183,25 @@ rsyncUtil( rcComm_t *conn, rodsEnv *myRodsEnv, rodsArguments_t *myRodsArgs,
                                              myRodsEnv, myRodsArgs, &dataObjOprInp );
             }
         }
+        else if ( srcType == LOCAL_DIR_T && targType == COLL_OBJ_T &&
+                  myRodsArgs->bulk == True ) {
+            status = rsyncTreeUtil( conn, srcPath, targPath, myRodsArgs,
+                                    &dataObjOprInp, NULL );
+        }
         else if ( srcType == LOCAL_DIR_T && targType == COLL_OBJ_T )
         {
             status = rsyncDirToCollUtil( conn, srcPath, targPath,
                                  myRodsEnv, myRodsArgs, &dataObjOprInp );
         }
+        else if ( srcType == COLL_OBJ_T && targType == COLL_OBJ_T &&
+                  myRodsArgs->bulk == True && dataObjCopyInp.srcDataObjInp.specColl == NULL ) {
+            addKeyVal( &dataObjCopyInp.srcDataObjInp.condInput,
+                       TRANSLATED_PATH_KW, "" );
+            addKeyVal( &dataObjCopyInp.destDataObjInp.condInput,
+                       REG_CHKSUM_KW, "" );
+            status = rsyncTreeUtil( conn, srcPath, targPath, myRodsArgs,
+                                    NULL, &dataObjCopyInp );
+        }
         else if ( srcType == COLL_OBJ_T && targType == COLL_OBJ_T ) {
             addKeyVal( &dataObjCopyInp.srcDataObjInp.condInput,
                        TRANSLATED_PATH_KW, "" );
@@ -173,10 +236,12 @@ rsyncUtil( rcComm_t *conn, rodsEnv *myRodsEnv, rodsArguments_t *myRodsArgs,
     return savedStatus;
 }
 
-int
-rsyncDataToFileUtil( rcComm_t *conn, rodsPath_t *srcPath,
-                     rodsPath_t *targPath, rodsArguments_t *myRodsArgs,
-                     dataObjInp_t *dataObjOprInp ) {
+// The work of rsyncDataToFileUtil, given the client environment. Because the environment
+// is not read, this may be called by several threads at once.
+static int
+rsyncDataToFile( rcComm_t *conn, rodsPath_t *srcPath,
+                 rodsPath_t *targPath, rodsArguments_t *myRodsArgs,
+                 dataObjInp_t *dataObjOprInp, const rodsEnv &env ) {
     int status;
     struct timeval startTime, endTime;
     int getFlag = 0;
@@ -204,16 +269,6 @@ rsyncDataToFileUtil( rcComm_t *conn, rodsPath_t *srcPath,
         std::memset(&conn->transStat, 0, sizeof(transStat_t));
     }
 
-    rodsEnv env;
-    int ret = getRodsEnv( &env );
-    if ( ret < 0 ) {
-        rodsLogError(
-            LOG_ERROR,
-            ret,
-            "rsyncDataToFileUtil: getRodsEnv failed" );
-        return ret;
-    }
-
     if ( targPath->objState == NOT_EXIST_ST ) {
         getFlag = 1;
     }
@@ -235,10 +290,10 @@ rsyncDataToFileUtil( rcComm_t *conn, rodsPath_t *srcPath,
         }
 
         /* src has a checksum value */
-        status = rcChksumLocFile( targPath->outPath,
-                                  RSYNC_CHKSUM_KW,
-                                  &dataObjOprInp->condInput,
-                                  scheme.c_str() );
+        status = chksumLocFileWithEnv( targPath->outPath,
+                                       RSYNC_CHKSUM_KW,
+                                       &dataObjOprInp->condInput,
+                                       scheme.c_str(), env );
         if ( status < 0 ) {
             rodsLogError( LOG_ERROR, status,
                           "rsyncDataToFileUtil: rcChksumLocFile error for %s, status = %d",
@@ -254,9 +309,9 @@ rsyncDataToFileUtil( rcComm_t *conn, rodsPath_t *srcPath,
     }
     else {
         /* exist but no chksum */
-        status = rcChksumLocFile( targPath->outPath, RSYNC_CHKSUM_KW,
-                                  &dataObjOprInp->condInput,
-                                  env.rodsDefaultHashScheme );
+        status = chksumLocFileWithEnv( targPath->outPath, RSYNC_CHKSUM_KW,
+                                       &dataObjOprInp->condInput,
+                                       env.rodsDefaultHashScheme, env );
         if ( status < 0 ) {
             rodsLogError( LOG_ERROR, status,
                           "rsyncDataToFileUtil: rcChksumLocFile error for %s, status = %d",
@@ -319,9 +374,28 @@ rsyncDataToFileUtil( rcComm_t *conn, rodsPath_t *srcPath,
 }
 
 int
-rsyncFileToDataUtil( rcComm_t *conn, rodsPath_t *srcPath,
+rsyncDataToFileUtil( rcComm_t *conn, rodsPath_t *srcPath,
                      rodsPath_t *targPath, rodsArguments_t *myRodsArgs,
                      dataObjInp_t *dataObjOprInp ) {
+    rodsEnv env;
+    int ret = getRodsEnv( &env );
+    if ( ret < 0 ) {
+        rodsLogError(
+            LOG_ERROR,
+            ret,
+            "rsyncDataToFileUtil: getRodsEnv failed" );
+        return ret;
+    }
+
+    return rsyncDataToFile( conn, srcPath, targPath, myRodsArgs, dataObjOprInp, env );
+}
+
+// The work of rsyncFileToDataUtil, given the client environment. Because the environment
+// is not read, this may be called by several threads at once.
+static int
+rsyncFileToData( rcComm_t *conn, rodsPath_t *srcPath,
+                 rodsPath_t *targPath, rodsArguments_t *myRodsArgs,
+                 dataObjInp_t *dataObjOprInp, const rodsEnv &env ) {
     int status;
     struct timeval startTime, endTime;
     int putFlag = 0;
@@ -354,16 +428,6 @@ rsyncFileToDataUtil( rcComm_t *conn, rodsPath_t *srcPath,
         }
     }
 
-    rodsEnv env;
-    int ret = getRodsEnv( &env );
-    if ( ret < 0 ) {
-        rodsLogError(
-            LOG_ERROR,
-            ret,
-            "rsyncFileToDataUtil: getRodsEnv failed" );
-        return ret;
-    }
-
     if ( myRodsArgs->verbose == True ) {
         ( void ) gettimeofday( &startTime, ( struct timezone * )0 );
         std::memset(&conn->transStat, 0, sizeof(transStat_t));
@@ -372,11 +436,12 @@ rsyncFileToDataUtil( rcComm_t *conn, rodsPath_t *srcPath,
     if ( targPath->objState == NOT_EXIST_ST ) {
         putFlag = 1;
         if( True == myRodsArgs->verifyChecksum ) {
-            status = rcChksumLocFile(
+            status = chksumLocFileWithEnv(
                          srcPath->outPath,
                          RSYNC_CHKSUM_KW,
                          &dataObjOprInp->condInput,
-                         env.rodsDefaultHashScheme );
+                         env.rodsDefaultHashScheme,
+                         env );
             if ( status < 0 ) {
                 rodsLogError(
                     LOG_ERROR,
@@ -417,9 +482,9 @@ rsyncFileToDataUtil( rcComm_t *conn, rodsPath_t *srcPath,
         }
 
         /* src has a checksum value */
-        status = rcChksumLocFile( srcPath->outPath, RSYNC_CHKSUM_KW,
-                                  &dataObjOprInp->condInput,
-                                  scheme.c_str() );
+        status = chksumLocFileWithEnv( srcPath->outPath, RSYNC_CHKSUM_KW,
+                                       &dataObjOprInp->condInput,
+                                       scheme.c_str(), env );
         if ( status < 0 ) {
             rodsLogError( LOG_ERROR, status,
                           "rsyncFileToDataUtil: rcChksumLocFile error for %s, status = %d",
@@ -441,9 +506,9 @@ rsyncFileToDataUtil( rcComm_t *conn, rodsPath_t *srcPath,
     }
     else {
         /* exist but no chksum */
-        status = rcChksumLocFile( srcPath->outPath, RSYNC_CHKSUM_KW,
-                                  &dataObjOprInp->condInput,
-                                  env.rodsDefaultHashScheme );
+        status = chksumLocFileWithEnv( srcPath->outPath, RSYNC_CHKSUM_KW,
+                                       &dataObjOprInp->condInput,
+                                       env.rodsDefaultHashScheme, env );
         if ( status < 0 ) {
             rodsLogError( LOG_ERROR, status,
                           "rsyncFileToDataUtil: rcChksumLocFile error for %s, status = %d",
@@ -509,6 +574,23 @@ rsyncFileToDataUtil( rcComm_t *conn, rodsPath_t *srcPath,
     return status;
 }
 
+int
+rsyncFileToDataUtil( rcComm_t *conn, rodsPath_t *srcPath,
+                     rodsPath_t *targPath, rodsArguments_t *myRodsArgs,
+                     dataObjInp_t *dataObjOprInp ) {
+    rodsEnv env;
+    int ret = getRodsEnv( &env );
+    if ( ret < 0 ) {
+        rodsLogError(
+            LOG_ERROR,
+            ret,
+            "rsyncFileToDataUtil: getRodsEnv failed" );
+        return ret;
+    }
+
+    return rsyncFileToData( conn, srcPath, targPath, myRodsArgs, dataObjOprInp, env );
+}
+
 int
 rsyncDataToDataUtil( rcComm_t *conn, rodsPath_t *srcPath,
                      rodsPath_t *targPath, rodsArguments_t *myRodsArgs,
@@ -1072,6 +1154,595 @@ rsyncCollToCollUtil( rcComm_t *conn, rodsPath_t *srcPath,
     }
 }
 
+namespace
+{
+    namespace rsync = irods::experimental::rsync;
+
+    // The number of files transferred at the same time in bulk mode.
+    constexpr int bulk_transfer_connection_count = 4;
+
+    // The largest number of threads reading local directories at the same time.
+    constexpr int max_local_walk_thread_count = 8;
+
+    enum class rsync_direction
+    {
+        put,
+        get,
+        copy
+    }; // enum class rsync_direction
+
+    auto join_path(const std::string& _parent, const std::string& _relative) -> std::string
+    {
+        if (_parent.empty()) {
+            return _relative;
+        }
+
+        return _relative.empty() ? _parent : _parent + '/' + _relative;
+    } // join_path
+
+    // Lists the data objects and subcollections of a collection with paged queries.
+    //
+    // When a data object has several replicas, the first good replica found is used.
+    auto list_collection(rcComm_t* _conn, const std::string& _coll, rsync::tree& _tree) -> int
+    {
+        // GenQuery has no way to escape quotes.
+        if (_coll.find('\'') != std::string::npos) {
+            return SYS_NOT_SUPPORTED;
+        }
+
+        const auto prefix = _coll.back() == '/' ? _coll : _coll + '/';
+
+        // The LIKE conditions treat '_' as a wildcard, so every row is checked against the prefix.
+        const auto relative_path = [&](const std::string& _coll_name) -> std::optional<std::string> {
+            if (_coll_name == _coll) {
+                return std::string{};
+            }
+
+            if (_coll_name.compare(0, prefix.size(), prefix) == 0) {
+                return _coll_name.substr(prefix.size());
+            }
+
+            return std::nullopt;
+        };
+
+        try {
+            const auto gql = fmt::format("select COLL_NAME, DATA_NAME, DATA_SIZE, DATA_MODIFY_TIME, DATA_CHECKSUM, "
+                                         "DATA_MODE, DATA_REPL_STATUS where COLL_NAME = '{}' || like '{}%'",
+                                         _coll,
+                                         prefix);
+
+            std::set<std::string> good_replicas;
+
+            for (auto&& row : irods::query<rcComm_t>{_conn, gql}) {
+                const auto parent = relative_path(row[0]);
+                if (!parent) {
+                    continue;
+                }
+
+                auto path = join_path(*parent, row[1]);
+
+                rsync::file_info info;
+                info.size = std::stoll(row[2]);
+                info.mtime = std::stoll(row[3]);
+                info.mode = std::atoi(row[5].c_str());
+                info.checksum = row[4];
+
+                const bool good = row[6] == "1";
+                auto [iter, inserted] = _tree.files.try_emplace(path, info);
+
+                if (!inserted && good && good_replicas.count(path) == 0) {
+                    iter->second = std::move(info);
+                }
+
+                if (good) {
+                    good_replicas.insert(std::move(path));
+                }
+            }
+
+            const auto colls = fmt::format("select COLL_NAME where COLL_NAME like '{}%'", prefix);
+
+            for (auto&& row : irods::query<rcComm_t>{_conn, colls}) {
+                if (const auto path = relative_path(row[0]); path && !path->empty()) {
+                    _tree.directories.insert(*path);
+                }
+            }
+        }
+        catch (const irods::exception& e) {
+            rodsLog(LOG_ERROR,
+                    "rsyncTreeUtil: could not list collection %s: %s",
+                    _coll.c_str(),
+                    e.client_display_what());
+            return e.code();
+        }
+        catch (const std::exception& e) {
+            rodsLog(LOG_ERROR, "rsyncTreeUtil: could not list collection %s: %s", _coll.c_str(), e.what());
+            return SYS_INTERNAL_ERR;
+        }
+
+        return 0;
+    } // list_collection
+
+    // Lists a local directory tree, reading several directories at the same time.
+    //
+    // Symbolic links are followed unless --link was given, as in rsyncDirToCollUtil.
+    //
+    // Checksums are not computed while listing, since which files need one depends on the
+    // listing of the collection. Call compute_checksums once both listings are complete.
+    class local_tree_walker
+    {
+      public:
+        explicit local_tree_walker(const rodsArguments_t& _args)
+            : args_{_args}
+            , pool_{std::clamp(static_cast<int>(std::thread::hardware_concurrency()), 1, max_local_walk_thread_count)}
+            , root_{}
+            , mutex_{}
+            , cv_{}
+            , pending_{}
+            , status_{}
+            , tree_{}
+        {
+        }
+
+        local_tree_walker(const local_tree_walker&) = delete;
+        auto operator=(const local_tree_walker&) -> local_tree_walker& = delete;
+
+        ~local_tree_walker()
+        {
+            pool_.join();
+        }
+
+        // Starts listing the tree rooted at _root. Returns immediately.
+        auto start(const std::string& _root) -> void
+        {
+            root_ = _root;
+            post(std::string{});
+        } // start
+
+        // Waits for the listing to finish and returns the first error encountered, if any.
+        auto wait() -> int
+        {
+            std::unique_lock lock{mutex_};
+            cv_.wait(lock, [this] { return pending_ == 0; });
+            return status_;
+        } // wait
+
+        auto tree() -> rsync::tree&
+        {
+            return tree_;
+        } // tree
+
+        // Computes the checksum of every local file which has the same size as its data object
+        // in _collection, when the data object has a checksum. The scheme of the data object's
+        // checksum is used, so that the two can be compared by rsync::diff.
+        //
+        // A file whose checksum cannot be computed is left without one. It is then compared by
+        // the per-file logic, which reports the error.
+        auto compute_checksums(const rsync::tree& _collection, const rodsEnv& _env) -> void
+        {
+            for (auto& [path, info] : tree_.files) {
+                const auto iter = _collection.files.find(path);
+
+                if (iter == std::end(_collection.files) || iter->second.size != info.size ||
+                    iter->second.checksum.empty()) {
+                    continue;
+                }
+
+                run([this, &_env, &info = info, &path = path, &checksum = iter->second.checksum] {
+                    std::string scheme;
+                    if (!irods::get_hash_scheme_from_checksum(checksum, scheme).ok()) {
+                        return;
+                    }
+
+                    const auto full_path = join_path(root_, path);
+                    char checksum_str[NAME_LEN]{};
+
+                    if (chksumLocFileWithPolicy(full_path.c_str(),
+                                                checksum_str,
+                                                scheme.c_str(),
+                                                _env.rodsDefaultHashScheme,
+                                                _env.rodsMatchHashPolicy) >= 0) {
+                        info.checksum = checksum_str;
+                    }
+                });
+            }
+
+            wait();
+        } // compute_checksums
+
+      private:
+        // Runs _task on the pool. wait() returns once every task has finished.
+        template <typename Task>
+        auto run(Task _task) -> void
+        {
+            {
+                std::lock_guard lock{mutex_};
+                ++pending_;
+            }
+
+            irods::thread_pool::post(pool_, [this, task = std::move(_task)] {
+                task();
+
+                std::lock_guard lock{mutex_};
+                if (--pending_ == 0) {
+                    cv_.notify_all();
+                }
+            });
+        } // run
+
+        auto post(std::string _relative) -> void
+        {
+            run([this, relative = std::move(_relative)] { list_directory(relative); });
+        } // post
+
+        auto list_directory(const std::string& _relative) -> void
+        {
+            namespace fs = boost::filesystem;
+
+            const auto dir = join_path(root_, _relative);
+
+            try {
+                for (const auto& e : fs::directory_iterator{dir}) {
+                    const auto& p = e.path();
+                    const auto name = p.filename().string();
+                    const auto relative = join_path(_relative, name);
+
+                    try {
+                        if (!irods::is_path_valid_for_recursion(&args_, p.c_str())) {
+                            continue;
+                        }
+                    }
+                    catch (const irods::exception& _e) {
+                        rodsLog(LOG_ERROR, _e.client_display_what());
+                        record_status(USER_INPUT_PATH_ERR);
+                        continue;
+                    }
+
+                    struct stat st{};
+                    if (stat(p.c_str(), &st) != 0) {
+                        rodsLog(LOG_ERROR, "rsyncTreeUtil: stat error for %s, errno = %d", p.c_str(), errno);
+                        record_status(USER_INPUT_PATH_ERR);
+                        continue;
+                    }
+
+                    if (S_ISDIR(st.st_mode)) {
+                        {
+                            std::lock_guard lock{mutex_};
+                            tree_.directories.insert(relative);
+                        }
+
+                        post(relative);
+                    }
+                    else if (S_ISREG(st.st_mode)) {
+                        rsync::file_info info;
+                        info.size = st.st_size;
+                        info.mtime = st.st_mtime;
+                        info.mode = static_cast<int>(st.st_mode);
+
+                        std::lock_guard lock{mutex_};
+                        tree_.files.emplace(relative, std::move(info));
+                    }
+                    else {
+                        rodsLog(LOG_ERROR, "rsyncTreeUtil: unknown local path %s", p.c_str());
+                        record_status(USER_INPUT_PATH_ERR);
+                    }
+                }
+            }
+            catch (const fs::filesystem_error& e) {
+                rodsLog(LOG_ERROR, "rsyncTreeUtil: could not read directory %s: %s", dir.c_str(), e.what());
+                record_status(USER_INPUT_PATH_ERR);
+            }
+        } // list_directory
+
+        auto record_status(int _status) -> void
+        {
+            std::lock_guard lock{mutex_};
+            if (status_ == 0) {
+                status_ = _status;
+            }
+        } // record_status
+
+        const rodsArguments_t& args_;
+        irods::thread_pool pool_;
+        std::string root_;
+        std::mutex mutex_;
+        std::condition_variable cv_;
+        std::size_t pending_;
+        int status_;
+        rsync::tree tree_;
+    }; // class local_tree_walker
+
+    // Removes the files of a source tree which are older than the --age limit.
+    auto remove_aged_files(rsync::tree& _tree, const std::string& _root, int _age_limit) -> void
+    {
+        for (auto iter = std::begin(_tree.files); iter != std::end(_tree.files);) {
+            auto path = join_path(_root, iter->first);
+
+            if (ageExceeded(_age_limit, static_cast<int>(iter->second.mtime), path.data(), iter->second.size)) {
+                iter = _tree.files.erase(iter);
+            }
+            else {
+                ++iter;
+            }
+        }
+    } // remove_aged_files
+
+    auto print_tree_diff(const rsync::tree_diff& _diff,
+                         const rsync::tree& _source,
+                         const std::string& _source_root,
+                         const std::string& _target_root) -> void
+    {
+        std::size_t counts[3]{};
+
+        for (const auto& dir : _diff.directories_to_create) {
+            std::printf("C %s\n", join_path(_target_root, dir).c_str());
+        }
+
+        for (const auto& [path, type] : _diff.files) {
+            constexpr const char* markers[] = {"+", "M", "?"};
+            const auto i = static_cast<int>(type);
+            ++counts[i];
+
+            std::printf("%s %s   %lld\n",
+                        markers[i],
+                        join_path(_source_root, path).c_str(),
+                        static_cast<long long>(_source.files.at(path).size));
+        }
+
+        for (const auto& path : _diff.only_in_target) {
+            std::printf("- %s\n", join_path(_target_root, path).c_str());
+        }
+
+        std::printf("%zu to create, %zu to update, %zu to verify, %zu unchanged, %zu only in target, "
+                    "%zu directories to create\n",
+                    counts[static_cast<int>(rsync::change_type::create)],
+                    counts[static_cast<int>(rsync::change_type::update)],
+                    counts[static_cast<int>(rsync::change_type::verify)],
+                    _diff.unchanged,
+                    _diff.only_in_target.size(),
+                    _diff.directories_to_create.size());
+    } // print_tree_diff
+
+    // Fills in a rodsPath_t for one side of a transfer from its listing.
+    auto to_rods_path(objType_t _obj_type,
+                      const std::string& _path,
+                      const rsync::tree& _tree,
+                      const std::string& _relative) -> std::unique_ptr<rodsPath_t>
+    {
+        auto p = std::make_unique<rodsPath_t>();
+        std::memset(p.get(), 0, sizeof(rodsPath_t));
+
+        p->objType = _obj_type;
+        p->objState = NOT_EXIST_ST;
+        rstrcpy(p->outPath, _path.c_str(), MAX_NAME_LEN);
+
+        if (const auto iter = _tree.files.find(_relative); iter != std::end(_tree.files)) {
+            p->objState = EXIST_ST;
+            p->size = iter->second.size;
+            p->objMode = iter->second.mode;
+            rstrcpy(p->chksum, iter->second.checksum.c_str(), NAME_LEN);
+        }
+
+        return p;
+    } // to_rods_path
+} // anonymous namespace
+
+static int
+rsyncTreeUtil( rcComm_t *conn, rodsPath_t *srcPath, rodsPath_t *targPath,
+               rodsArguments_t *myRodsArgs, dataObjInp_t *dataObjOprInp,
+               dataObjCopyInp_t *dataObjCopyInp ) {
+    if ( srcPath == NULL || targPath == NULL ) {
+        rodsLog( LOG_ERROR,
+                 "rsyncTreeUtil: NULL srcPath or targPath input" );
+        return USER__NULL_INPUT_ERR;
+    }
+
+    if ( myRodsArgs->recursive != True ) {
+        rodsLog( LOG_ERROR,
+                 "rsyncTreeUtil: -r option must be used for %s",
+                 srcPath->outPath );
+        return USER_INPUT_OPTION_ERR;
+    }
+
+    rodsEnv env;
+    int status = getRodsEnv( &env );
+    if ( status < 0 ) {
+        rodsLogError( LOG_ERROR, status, "rsyncTreeUtil: getRodsEnv failed" );
+        return status;
+    }
+
+    const std::string srcRoot = srcPath->outPath;
+    const std::string targRoot = targPath->outPath;
+
+    rsync_direction direction = rsync_direction::copy;
+    if ( srcPath->objType == LOCAL_DIR_T ) {
+        direction = rsync_direction::put;
+    }
+    else if ( targPath->objType == LOCAL_DIR_T ) {
+        direction = rsync_direction::get;
+    }
+
+    // Take both listings. The local tree is read by other threads while the catalog is queried.
+    local_tree_walker walker{ *myRodsArgs };
+    rsync::tree remoteSource;
+    rsync::tree remoteTarget;
+
+    if ( direction == rsync_direction::put ) {
+        walker.start( srcRoot );
+        status = list_collection( conn, targRoot, remoteTarget );
+    }
+    else if ( direction == rsync_direction::get ) {
+        walker.start( targRoot );
+        status = list_collection( conn, srcRoot, remoteSource );
+    }
+    else {
+        status = list_collection( conn, srcRoot, remoteSource );
+        if ( status >= 0 ) {
+            status = list_collection( conn, targRoot, remoteTarget );
+        }
+    }
+
+    if ( direction != rsync_direction::copy ) {
+        const int walkStatus = walker.wait();
+        if ( status >= 0 ) {
+            status = walkStatus;
+        }
+    }
+
+    if ( status < 0 ) {
+        return status;
+    }
+
+    rsync::tree& source = ( direction == rsync_direction::put ) ? walker.tree() : remoteSource;
+    rsync::tree& target = ( direction == rsync_direction::get ) ? walker.tree() : remoteTarget;
+
+    if ( myRodsArgs->age == True ) {
+        remove_aged_files( source, srcRoot, myRodsArgs->agevalue );
+    }
+
+    const auto compare = ( myRodsArgs->sizeFlag == True ) ? rsync::compare_by::size : rsync::compare_by::checksum;
+
+    if ( compare == rsync::compare_by::checksum ) {
+        if ( direction == rsync_direction::put ) {
+            walker.compute_checksums( target, env );
+        }
+        else if ( direction == rsync_direction::get ) {
+            walker.compute_checksums( source, env );
+        }
+    }
+
+    const auto diff = rsync::diff( source, target, compare );
+
+    if ( myRodsArgs->dryrun == True ) {
+        print_tree_diff( diff, source, srcRoot, targRoot );
+        return 0;
+    }
+
+    // With -l, nothing is created. The per-file functions print the files which would be
+    // transferred, in the same format as without -b.
+    const bool listOnly = ( myRodsArgs->longOption == True );
+
+    for ( const auto& dir : diff.directories_to_create ) {
+        if ( listOnly ) {
+            break;
+        }
+
+        auto fullPath = join_path( targRoot, dir );
+        if ( direction == rsync_direction::get ) {
+            status = mkdirR( targPath->outPath, fullPath.data(), 0750 );
+        }
+        else {
+            status = mkCollR( conn, targPath->outPath, fullPath.data() );
+        }
+
+        if ( status < 0 ) {
+            rodsLogError( LOG_ERROR, status, "rsyncTreeUtil: could not create %s", fullPath.c_str() );
+            return status;
+        }
+    }
+
+    if ( diff.files.empty() ) {
+        return 0;
+    }
+
+    // The age was checked above. Files are only compared by the transfer functions.
+    rodsArguments_t args = *myRodsArgs;
+    args.age = False;
+
+    // The files are listed serially so that they are printed in order.
+    std::shared_ptr<irods::connection_pool> connPool;
+    try {
+        if ( !listOnly ) {
+            connPool = irods::make_connection_pool( bulk_transfer_connection_count );
+        }
+    }
+    catch ( const irods::exception& e ) {
+        rodsLog( LOG_NOTICE, "rsyncTreeUtil: could not create a connection pool, transferring serially: %s",
+                 e.client_display_what() );
+    }
+
+    std::mutex statusMutex;
+    int savedStatus = 0;
+
+    const auto transfer = [&]( const rsync::file_change& _change ) {
+        const auto srcFull = join_path( srcRoot, _change.path );
+        const auto targFull = join_path( targRoot, _change.path );
+
+        std::optional<irods::connection_pool::connection_proxy> proxy;
+        rcComm_t* myConn = conn;
+        if ( connPool ) {
+            proxy = connPool->get_connection();
+            myConn = static_cast<rcComm_t*>( *proxy );
+        }
+
+        int myStatus = 0;
+
+        if ( direction == rsync_direction::put ) {
+            auto mySrcPath = to_rods_path( LOCAL_FILE_T, srcFull, source, _change.path );
+            auto myTargPath = to_rods_path( DATA_OBJ_T, targFull, target, _change.path );
+
+            dataObjInp_t myDataObjInp = *dataObjOprInp;
+            std::memset( &myDataObjInp.condInput, 0, sizeof( keyValPair_t ) );
+            replKeyVal( &dataObjOprInp->condInput, &myDataObjInp.condInput );
+            myDataObjInp.createMode = mySrcPath->objMode;
+
+            myStatus = rsyncFileToData( myConn, mySrcPath.get(), myTargPath.get(), &args, &myDataObjInp, env );
+            clearKeyVal( &myDataObjInp.condInput );
+        }
+        else if ( direction == rsync_direction::get ) {
+            auto mySrcPath = to_rods_path( DATA_OBJ_T, srcFull, source, _change.path );
+            auto myTargPath = to_rods_path( LOCAL_FILE_T, targFull, target, _change.path );
+
+            dataObjInp_t myDataObjInp = *dataObjOprInp;
+            std::memset( &myDataObjInp.condInput, 0, sizeof( keyValPair_t ) );
+            replKeyVal( &dataObjOprInp->condInput, &myDataObjInp.condInput );
+
+            myStatus = rsyncDataToFile( myConn, mySrcPath.get(), myTargPath.get(), &args, &myDataObjInp, env );
+            clearKeyVal( &myDataObjInp.condInput );
+        }
+        else {
+            auto mySrcPath = to_rods_path( DATA_OBJ_T, srcFull, source, _change.path );
+            auto myTargPath = to_rods_path( DATA_OBJ_T, targFull, target, _change.path );
+
+            dataObjCopyInp_t myDataObjCopyInp = *dataObjCopyInp;
+            std::memset( &myDataObjCopyInp.srcDataObjInp.condInput, 0, sizeof( keyValPair_t ) );
+            std::memset( &myDataObjCopyInp.destDataObjInp.condInput, 0, sizeof( keyValPair_t ) );
+            replKeyVal( &dataObjCopyInp->srcDataObjInp.condInput, &myDataObjCopyInp.srcDataObjInp.condInput );
+            replKeyVal( &dataObjCopyInp->destDataObjInp.condInput, &myDataObjCopyInp.destDataObjInp.condInput );
+
+            myStatus = rsyncDataToDataUtil( myConn, mySrcPath.get(), myTargPath.get(), &args, &myDataObjCopyInp );
+            clearKeyVal( &myDataObjCopyInp.srcDataObjInp.condInput );
+            clearKeyVal( &myDataObjCopyInp.destDataObjInp.condInput );
+        }
+
+        if ( myStatus < 0 ) {
+            rodsLogError( LOG_ERROR, myStatus,
+                          "rsyncTreeUtil: rsync of %s to %s failed. status = %d",
+                          srcFull.c_str(), targFull.c_str(), myStatus );
+
+            std::lock_guard lock{ statusMutex };
+            if ( savedStatus == 0 ) {
+                savedStatus = myStatus;
+            }
+        }
+    };
+
+    if ( !connPool ) {
+        for ( const auto& change : diff.files ) {
+            transfer( change );
+        }
+
+        return savedStatus;
+    }
+
+    irods::thread_pool transferPool{ bulk_transfer_connection_count };
+    for ( const auto& change : diff.files ) {
+        irods::thread_pool::post( transferPool, [&transfer, &change] { transfer( change ); } );
+    }
+    transferPool.join();
+
+    return savedStatus;
+}
+
 int
 initCondForRsync( rodsEnv *myRodsEnv, rodsArguments_t *rodsArgs,
                   dataObjInp_t *dataObjInp ) {
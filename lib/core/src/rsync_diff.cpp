@@ -0,0 +1,54 @@
+#include "irods/rsync_diff.hpp"
+
+#include <iterator>
+
+namespace irods::experimental::rsync
+{
+    auto diff(const tree& _source, const tree& _target, compare_by _compare) -> tree_diff
+    {
+        tree_diff result;
+
+        for (const auto& dir : _source.directories) {
+            if (_target.directories.count(dir) == 0) {
+                result.directories_to_create.push_back(dir);
+            }
+        }
+
+        for (const auto& [path, src] : _source.files) {
+            const auto iter = _target.files.find(path);
+
+            if (iter == std::end(_target.files)) {
+                result.files.push_back({path, change_type::create});
+                continue;
+            }
+
+            const auto& dst = iter->second;
+
+            if (src.size != dst.size) {
+                result.files.push_back({path, change_type::update});
+            }
+            else if (compare_by::size == _compare) {
+                ++result.unchanged;
+            }
+            else if (!src.checksum.empty() && !dst.checksum.empty()) {
+                if (src.checksum == dst.checksum) {
+                    ++result.unchanged;
+                }
+                else {
+                    result.files.push_back({path, change_type::update});
+                }
+            }
+            else {
+                result.files.push_back({path, change_type::verify});
+            }
+        }
+
+        for (const auto& [path, dst] : _target.files) {
+            if (_source.files.count(path) == 0) {
+                result.only_in_target.push_back(path);
+            }
+        }
+
+        return result;
+    } // diff
+} // namespace irods::experimental::rsync
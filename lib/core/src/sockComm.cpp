@@ -36,6 +36,7 @@
 #include "irods/irods_server_properties.hpp"
 #include "irods/irods_stacktrace.hpp"
 #include "irods/sockCommNetworkInterface.hpp"
+#include "irods/tracing.hpp"
 #include "irods/with_durability.hpp"
 
 #include <nlohmann/json.hpp>
@@ -1211,6 +1212,12 @@ sendStartupPack( rcComm_t *conn, int connectCnt, int reconnFlag ) {
         }
     }
 
+    // The trace context goes last because servers which do not support tracing drop
+    // everything following the negotiation request.
+    if (!irods::experimental::tracing::append_to_startup_option(startupPack.option, sizeof(startupPack.option))) {
+        rodsLog(LOG_DEBUG, "sendStartupPack :: insufficient room in option string for the trace context");
+    }
+
     /* always use XML_PROT for the startupPack */
     status = pack_struct( ( void * ) &startupPack, &startupPackBBuf,
                          "StartupPack_PI", RodsPackTable, 0, XML_PROT, nullptr);
@@ -0,0 +1,400 @@
+#include "irods/tracing.hpp"
+
+#include "irods/irods_random.hpp"
+
+#include <fmt/format.h>
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <list>
+#include <mutex>
+
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace
+{
+    namespace tracing = irods::experimental::tracing;
+
+    using json = nlohmann::json;
+
+    // A traceparent is "00-<trace id>-<span id>-<flags>".
+    constexpr std::size_t trace_id_length = 32;
+    constexpr std::size_t span_id_length = 16;
+    constexpr std::size_t traceparent_length = 2 + 1 + trace_id_length + 1 + span_id_length + 1 + 2;
+
+    enum class sink_type
+    {
+        none,
+        file,
+        unix_socket
+    }; // enum class sink_type
+
+    struct sink
+    {
+        sink_type type = sink_type::none;
+        std::string path;
+        std::string hostname;
+        int fd = -1;
+    }; // struct sink
+
+    //
+    // Global Variables
+    //
+
+    sink g_sink;
+
+    // Every root context ever set. Roots are never removed so that references returned by
+    // current_context and current_or_new_context stay valid after the root is replaced. The
+    // list only grows when the root is replaced, which happens at most once per request.
+    std::list<tracing::trace_context> g_roots;
+    std::mutex g_root_mutex;
+
+    // The current root context, or null if no trace has been started. Writers hold g_root_mutex.
+    std::atomic<const tracing::trace_context*> g_root{nullptr};
+
+    const tracing::trace_context g_no_context;
+
+    // The innermost active span of each thread.
+    thread_local const tracing::trace_context* g_current = nullptr;
+
+    auto generate_hex_id(std::size_t _bytes) -> std::string
+    {
+        std::array<unsigned char, trace_id_length / 2> buf{};
+
+        // An id made of zeros is invalid.
+        do {
+            irods::getRandomBytes(buf.data(), static_cast<int>(_bytes));
+        } while (std::all_of(buf.data(), buf.data() + _bytes, [](auto _b) { return _b == 0; }));
+
+        std::string id;
+        id.reserve(_bytes * 2);
+
+        for (std::size_t i = 0; i < _bytes; ++i) {
+            fmt::format_to(std::back_inserter(id), "{:02x}", buf[i]);
+        }
+
+        return id;
+    } // generate_hex_id
+
+    auto is_hex_id(std::string_view _id, std::size_t _length) -> bool
+    {
+        return _id.size() == _length &&
+               std::all_of(std::begin(_id), std::end(_id), [](char _c) {
+                   return (_c >= '0' && _c <= '9') || (_c >= 'a' && _c <= 'f');
+               }) &&
+               _id.find_first_not_of('0') != std::string_view::npos;
+    } // is_hex_id
+
+    auto open_sink() -> bool
+    {
+        if (g_sink.fd >= 0) {
+            return true;
+        }
+
+        if (sink_type::file == g_sink.type) {
+            g_sink.fd = open(g_sink.path.c_str(), O_WRONLY | O_APPEND | O_CREAT | O_CLOEXEC, 0600);
+        }
+        else if (sink_type::unix_socket == g_sink.type) {
+            g_sink.fd = socket(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+        }
+
+        return g_sink.fd >= 0;
+    } // open_sink
+
+    auto write_to_sink(const std::string& _line) -> void
+    {
+        if (!open_sink()) {
+            return;
+        }
+
+        // Each span is written with a single call so that lines written by different agents are
+        // not interleaved. Spans are dropped rather than slowing down the request.
+        if (sink_type::file == g_sink.type) {
+            [[maybe_unused]] const auto n = write(g_sink.fd, _line.data(), _line.size());
+        }
+        else {
+            sockaddr_un addr{};
+            addr.sun_family = AF_UNIX;
+            std::strncpy(addr.sun_path, g_sink.path.c_str(), sizeof(addr.sun_path) - 1);
+
+            sendto(g_sink.fd,
+                   _line.data(),
+                   _line.size(),
+                   MSG_DONTWAIT | MSG_NOSIGNAL,
+                   reinterpret_cast<const sockaddr*>(&addr),
+                   sizeof(addr));
+        }
+    } // write_to_sink
+
+    auto to_any_value(const std::variant<std::string, std::int64_t>& _value) -> json
+    {
+        if (const auto* s = std::get_if<std::string>(&_value); s) {
+            return {{"stringValue", *s}};
+        }
+
+        // OTLP/JSON encodes 64-bit integers as strings.
+        return {{"intValue", std::to_string(std::get<std::int64_t>(_value))}};
+    } // to_any_value
+
+    auto to_unix_nanoseconds(std::chrono::system_clock::time_point _tp) -> std::string
+    {
+        using std::chrono::duration_cast;
+        using std::chrono::nanoseconds;
+
+        return std::to_string(duration_cast<nanoseconds>(_tp.time_since_epoch()).count());
+    } // to_unix_nanoseconds
+} // anonymous namespace
+
+namespace irods::experimental::tracing
+{
+    auto generate_trace_id() -> std::string
+    {
+        return generate_hex_id(trace_id_length / 2);
+    } // generate_trace_id
+
+    auto generate_span_id() -> std::string
+    {
+        return generate_hex_id(span_id_length / 2);
+    } // generate_span_id
+
+    auto to_traceparent(const trace_context& _context) -> std::string
+    {
+        return fmt::format("00-{}-{}-01", _context.trace_id, _context.span_id);
+    } // to_traceparent
+
+    auto from_traceparent(std::string_view _value) -> std::optional<trace_context>
+    {
+        if (_value.size() != traceparent_length || !_value.starts_with("00-")) {
+            return std::nullopt;
+        }
+
+        const auto trace_id = _value.substr(3, trace_id_length);
+        const auto span_id = _value.substr(3 + trace_id_length + 1, span_id_length);
+
+        if (_value[3 + trace_id_length] != '-' || _value[traceparent_length - 3] != '-' ||
+            !is_hex_id(trace_id, trace_id_length) || !is_hex_id(span_id, span_id_length))
+        {
+            return std::nullopt;
+        }
+
+        return trace_context{std::string{trace_id}, std::string{span_id}};
+    } // from_traceparent
+
+    auto set_root_context(trace_context _context) -> void
+    {
+        std::lock_guard lock{g_root_mutex};
+
+        if (_context.trace_id.empty()) {
+            g_root.store(nullptr, std::memory_order_release);
+            return;
+        }
+
+        g_root.store(&g_roots.emplace_back(std::move(_context)), std::memory_order_release);
+    } // set_root_context
+
+    auto current_context() -> const trace_context&
+    {
+        if (g_current) {
+            return *g_current;
+        }
+
+        const auto* root = g_root.load(std::memory_order_acquire);
+
+        return root ? *root : g_no_context;
+    } // current_context
+
+    auto current_or_new_context() -> const trace_context&
+    {
+        if (g_current) {
+            return *g_current;
+        }
+
+        if (const auto* root = g_root.load(std::memory_order_acquire); root) {
+            return *root;
+        }
+
+        std::lock_guard lock{g_root_mutex};
+
+        // Another thread may have started a trace while this one waited for the lock.
+        if (const auto* root = g_root.load(std::memory_order_relaxed); root) {
+            return *root;
+        }
+
+        const auto& root = g_roots.emplace_back(trace_context{generate_trace_id(), generate_span_id()});
+        g_root.store(&root, std::memory_order_release);
+
+        return root;
+    } // current_or_new_context
+
+    auto append_to_startup_option(char* _option, std::size_t _option_size) -> bool
+    {
+        const auto value = fmt::format("{}{}", startup_option_key, to_traceparent(current_or_new_context()));
+        const auto length = std::strlen(_option);
+
+        if (_option_size - length <= value.size()) {
+            return false;
+        }
+
+        std::strncat(_option, value.c_str(), _option_size - length - 1);
+
+        return true;
+    } // append_to_startup_option
+
+    auto extract_from_startup_option(std::string& _option) -> std::optional<trace_context>
+    {
+        const auto pos = _option.find(startup_option_key);
+
+        if (std::string::npos == pos) {
+            return std::nullopt;
+        }
+
+        const auto value = std::string_view{_option}.substr(pos + startup_option_key.size(), traceparent_length);
+        auto context = from_traceparent(value);
+
+        _option.erase(pos, startup_option_key.size() + value.size());
+
+        return context;
+    } // extract_from_startup_option
+
+    auto configure_sink(std::string_view _uri, std::string_view _hostname) -> bool
+    {
+        if (g_sink.fd >= 0) {
+            close(g_sink.fd);
+        }
+
+        g_sink = {};
+        g_sink.hostname = _hostname;
+
+        if (_uri.empty()) {
+            return true;
+        }
+
+        constexpr std::string_view file_scheme = "file://";
+        constexpr std::string_view unix_scheme = "unix://";
+
+        if (_uri.starts_with(file_scheme)) {
+            g_sink.type = sink_type::file;
+            g_sink.path = _uri.substr(file_scheme.size());
+        }
+        else if (_uri.starts_with(unix_scheme)) {
+            g_sink.type = sink_type::unix_socket;
+            g_sink.path = _uri.substr(unix_scheme.size());
+        }
+
+        if (g_sink.path.empty() || (sink_type::unix_socket == g_sink.type &&
+                                    g_sink.path.size() >= sizeof(sockaddr_un::sun_path))) {
+            g_sink.type = sink_type::none;
+            return false;
+        }
+
+        return true;
+    } // configure_sink
+
+    auto is_recording() noexcept -> bool
+    {
+        return sink_type::none != g_sink.type;
+    } // is_recording
+
+    span::span(std::string_view _name, span_kind _kind)
+        : recording_{is_recording()}
+        , name_{}
+        , kind_{_kind}
+        , context_{}
+        , parent_span_id_{}
+        , previous_{}
+        , start_{}
+        , attributes_{}
+        , ec_{}
+    {
+        if (!recording_) {
+            return;
+        }
+
+        const auto& parent = current_or_new_context();
+
+        name_ = _name;
+        context_ = {parent.trace_id, generate_span_id()};
+        parent_span_id_ = parent.span_id;
+        previous_ = g_current;
+        start_ = std::chrono::system_clock::now();
+
+        g_current = &context_;
+    } // span
+
+    span::~span()
+    {
+        if (!recording_) {
+            return;
+        }
+
+        g_current = previous_;
+
+        try {
+            const auto end = std::chrono::system_clock::now();
+
+            auto attributes = json::array();
+
+            for (auto&& [k, v] : attributes_) {
+                attributes.push_back({{"key", k}, {"value", to_any_value(v)}});
+            }
+
+            json span{{"traceId", context_.trace_id},
+                      {"spanId", context_.span_id},
+                      {"parentSpanId", parent_span_id_},
+                      {"name", name_},
+                      {"kind", static_cast<int>(kind_)},
+                      {"startTimeUnixNano", to_unix_nanoseconds(start_)},
+                      {"endTimeUnixNano", to_unix_nanoseconds(end)},
+                      {"attributes", std::move(attributes)}};
+
+            if (ec_ < 0) {
+                span["status"] = {{"code", 2}, {"message", std::to_string(ec_)}};
+            }
+
+            const json resource{
+                {"attributes",
+                 json::array({{{"key", "service.name"}, {"value", to_any_value(std::string{"irods"})}},
+                              {{"key", "host.name"}, {"value", to_any_value(g_sink.hostname)}},
+                              {{"key", "process.pid"}, {"value", to_any_value(std::int64_t{getpid()})}}})}};
+
+            const json request{
+                {"resourceSpans",
+                 json::array({{{"resource", resource},
+                               {"scopeSpans",
+                                json::array({{{"scope", {{"name", "irods"}}}, {"spans", json::array({span})}}})}}})}};
+
+            write_to_sink(request.dump() + '\n');
+        }
+        catch (...) {}
+    } // ~span
+
+    auto span::set_attribute(std::string_view _key, std::string_view _value) -> void
+    {
+        if (recording_) {
+            attributes_.emplace_back(_key, std::string{_value});
+        }
+    } // set_attribute
+
+    auto span::set_attribute(std::string_view _key, std::int64_t _value) -> void
+    {
+        if (recording_) {
+            attributes_.emplace_back(_key, _value);
+        }
+    } // set_attribute
+
+    auto span::set_error_code(int _ec) -> void
+    {
+        ec_ = _ec;
+
+        if (recording_) {
+            attributes_.emplace_back("irods.error_code", std::int64_t{_ec});
+        }
+    } // set_error_code
+} // namespace irods::experimental::tracing
@@ -14,8 +14,29 @@ extern "C" {
 
 int verifyChksumLocFile(char *fileName, const char *myChksum, char *chksumStr);
 
+/// Same as verifyChksumLocFile, except that the default hash scheme and the hash match policy
+/// are passed in instead of being read from the client environment. Unlike
+/// verifyChksumLocFile, this function may be called from several threads at once.
+///
+/// \since 4.3.0
+int verifyChksumLocFileWithPolicy(const char *fileName,
+                                  const char *myChksum,
+                                  const char *defaultHashScheme,
+                                  const char *matchHashPolicy);
+
 int chksumLocFile(const char *fileName, char *chksumStr, const char* hashScheme);
 
+/// Same as chksumLocFile, except that the default hash scheme and the hash match policy are
+/// passed in instead of being read from the client environment. This function may be called
+/// from several threads at once.
+///
+/// \since 4.3.0
+int chksumLocFileWithPolicy(const char *fileName,
+                            char *chksumStr,
+                            const char *hashScheme,
+                            const char *defaultHashScheme,
+                            const char *matchHashPolicy);
+
 int hashToStr(unsigned char *digest, char *digestStr);
 
 int rcChksumLocFile(char *fileName,
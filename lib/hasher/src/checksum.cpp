@@ -16,43 +16,28 @@
 
 #define HASH_BUF_SZ (1024*1024)
 
-int chksumLocFile(
-    const char*       _file_name,
+// Does the work of chksumLocFile once the client side configuration is known.
+static int checksum_local_file(
+    const char* _file_name,
     char*       _checksum,
-    const char* _hash_scheme ) {
-    if ( !_file_name ||
-            !_checksum  ||
-            !_hash_scheme ) {
-        rodsLog(
-            LOG_ERROR,
-            "chksumLocFile :: null input param - %p %p %p",
-            _file_name,
-            _checksum,
-            _hash_scheme );
-        return SYS_INVALID_INPUT_PARAM;
-    }
-
-    // =-=-=-=-=-=-=-
-    // capture client side configuration
-    rodsEnv env;
-    int status = getRodsEnv( &env );
-    if ( status < 0 ) {
-        return status;
-    }
+    const char* _hash_scheme,
+    const char* _default_hash_scheme,
+    const char* _match_hash_policy ) {
+    int status = 0;
 
     // =-=-=-=-=-=-=-
     // capture the configured scheme if it is valid
     std::string env_scheme( irods::SHA256_NAME );
-    if ( strlen( env.rodsDefaultHashScheme ) > 0 ) {
-        env_scheme = env.rodsDefaultHashScheme;
+    if ( strlen( _default_hash_scheme ) > 0 ) {
+        env_scheme = _default_hash_scheme;
 
     }
 
     // =-=-=-=-=-=-=-
     // capture the configured hash match policy if it is valid
     std::string env_policy;
-    if ( strlen( env.rodsMatchHashPolicy ) > 0 ) {
-        env_policy = env.rodsMatchHashPolicy;
+    if ( strlen( _match_hash_policy ) > 0 ) {
+        env_policy = _match_hash_policy;
         // =-=-=-=-=-=-=-
         // hash scheme keywords are all lowercase
         std::transform(
@@ -174,8 +159,54 @@ int chksumLocFile(
 
     return 0;
 
+} // checksum_local_file
+
+int chksumLocFile(
+    const char*       _file_name,
+    char*       _checksum,
+    const char* _hash_scheme ) {
+    if ( !_file_name ||
+            !_checksum  ||
+            !_hash_scheme ) {
+        rodsLog(
+            LOG_ERROR,
+            "chksumLocFile :: null input param - %p %p %p",
+            _file_name,
+            _checksum,
+            _hash_scheme );
+        return SYS_INVALID_INPUT_PARAM;
+    }
+
+    // =-=-=-=-=-=-=-
+    // capture client side configuration
+    rodsEnv env;
+    int status = getRodsEnv( &env );
+    if ( status < 0 ) {
+        return status;
+    }
+
+    return checksum_local_file(
+               _file_name,
+               _checksum,
+               _hash_scheme,
+               env.rodsDefaultHashScheme,
+               env.rodsMatchHashPolicy );
+
 } // chksumLocFile
 
+int chksumLocFileWithPolicy(
+    const char* fileName,
+    char*       chksumStr,
+    const char* hashScheme,
+    const char* defaultHashScheme,
+    const char* matchHashPolicy ) {
+    if ( !fileName || !chksumStr || !hashScheme || !defaultHashScheme || !matchHashPolicy ) {
+        return SYS_INVALID_INPUT_PARAM;
+    }
+
+    return checksum_local_file( fileName, chksumStr, hashScheme, defaultHashScheme, matchHashPolicy );
+}
+
 int verifyChksumLocFile(
     char *fileName,
     const char *myChksum,
@@ -203,6 +234,29 @@ int verifyChksumLocFile(
     return 0;
 }
 
+int verifyChksumLocFileWithPolicy(
+    const char* fileName,
+    const char* myChksum,
+    const char* defaultHashScheme,
+    const char* matchHashPolicy ) {
+    if ( !fileName || !myChksum || !defaultHashScheme || !matchHashPolicy ) {
+        return SYS_INVALID_INPUT_PARAM;
+    }
+
+    std::string scheme;
+    irods::get_hash_scheme_from_checksum( myChksum, scheme );
+
+    char chksumStr[CHKSUM_LEN];
+    int status = checksum_local_file( fileName, chksumStr, scheme.c_str(), defaultHashScheme, matchHashPolicy );
+    if ( status < 0 ) {
+        return status;
+    }
+    if ( strcmp( myChksum, chksumStr ) != 0 ) {
+        return USER_CHKSUM_MISMATCH;
+    }
+    return 0;
+}
+
 int
 hashToStr( unsigned char *digest, char *digestStr ) {
     int i;
@@ -14,6 +14,10 @@ API_PLUGIN_NUMBER(SET_GRID_CONFIGURATION_VALUE_APN,             20010)
 API_PLUGIN_NUMBER(SET_DELAY_SERVER_MIGRATION_INFO_APN,          20011)
 API_PLUGIN_NUMBER(SWITCH_USER_APN,                              20012)
 API_PLUGIN_NUMBER(GET_DELAY_RULE_INFO_APN,                      20013)
+API_PLUGIN_NUMBER(GET_DATA_OBJECT_OPEN_PLAN_APN,                20014)
+API_PLUGIN_NUMBER(BULK_APPLY_METADATA_OPERATIONS_APN,           20015)
+API_PLUGIN_NUMBER(BATCH_EXECUTE_APN,                            20016)
+API_PLUGIN_NUMBER(SET_TRACE_CONTEXT_APN,                        20017)
 API_PLUGIN_NUMBER(AUTHENTICATION_APN,                           110000)
 API_PLUGIN_NUMBER(ADAPTER_APN,                                  120000)
 // clang-format on
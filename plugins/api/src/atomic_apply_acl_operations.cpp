@@ -20,6 +20,7 @@
 
 #include "irods/atomic_apply_acl_operations.h"
 
+#include "irods/access_check_cache.hpp"
 #include "irods/catalog.hpp"
 #include "irods/catalog_utilities.hpp"
 #include "irods/irods_get_full_path_for_config_file.hpp"
@@ -490,7 +491,7 @@ namespace
 
         try {
             log::api::trace("Connecting to database ...");
-            std::tie(db_instance_name, db_conn) = ic::new_database_connection();
+            std::tie(db_instance_name, db_conn) = ic::get_database_connection();
         }
         catch (const irods::exception& e) {
             *_output = irods::to_bytes_buffer(make_error_object(json{}, 0, e.what()).dump());
@@ -551,6 +552,9 @@ namespace
 
                 _trans.commit();
 
+                // Permissions checked earlier by this agent may no longer hold.
+                irods::access_check_cache::clear();
+
                 *_output = irods::to_bytes_buffer("{}");
 
                 return 0;
@@ -505,7 +505,7 @@ namespace
         nanodbc::connection db_conn;
 
         try {
-            std::tie(db_instance_name, db_conn) = ic::new_database_connection();
+            std::tie(db_instance_name, db_conn) = ic::get_database_connection();
         }
         catch (const std::exception& e) {
             *_output = irods::to_bytes_buffer(make_error_object(json{}, 0, e.what()).dump());
@@ -0,0 +1,470 @@
+#include "irods/plugins/api/api_plugin_number.h"
+#include "irods/irods_configuration_keywords.hpp"
+#include "irods/rodsDef.h"
+#include "irods/rcConnect.h"
+#include "irods/rodsErrorTable.h"
+#include "irods/rodsPackInstruct.h"
+#include "irods/client_api_allowlist.hpp"
+
+#include "irods/apiHandler.hpp"
+
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+
+#ifdef RODS_SERVER
+
+//
+// Server-side Implementation
+//
+
+#include "irods/batch_execute.h"
+
+#include "irods/apiNumber.h"
+#include "irods/api_statistics.hpp"
+#include "irods/base64.hpp"
+#include "irods/dataObjInpOut.h"
+#include "irods/irods_api_number_validator.hpp"
+#include "irods/irods_at_scope_exit.hpp"
+#include "irods/irods_logger.hpp"
+#include "irods/irods_server_api_table.hpp"
+#include "irods/key_value_proxy.hpp"
+#include "irods/packStruct.h"
+#include "irods/rcGlobalExtern.h"
+#include "irods/rcMisc.h"
+#include "irods/rodsKeyWdDef.h"
+#include "irods/rsApiHandler.hpp"
+#include "irods/server_utilities.hpp"
+
+#include <nlohmann/json.hpp>
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace
+{
+    // clang-format off
+    namespace ix  = irods::experimental;
+    namespace log = irods::experimental::log;
+
+    using json      = nlohmann::json;
+    using operation = std::function<int(rsComm_t*, bytesBuf_t*, bytesBuf_t**)>;
+    // clang-format on
+
+    // APIs which cannot be executed as part of a batch, in addition to every API carrying a byte stream.
+    // The data transfer APIs talk to the client over a separate portal or reply to the client on their own.
+    // Collection replication and rule execution exchange messages with the client before returning, which
+    // the client of a batch does not expect. A batch inside a batch would only make the request harder to
+    // reason about.
+    constexpr auto disallowed_api_numbers = std::to_array<int>({
+        DATA_OBJ_PUT_AN,
+        DATA_PUT_AN,
+        DATA_OBJ_GET_AN,
+        DATA_GET_AN,
+        COLL_REPL_AN,
+        EXEC_MY_RULE_AN,
+        BATCH_EXECUTE_APN
+    });
+
+    struct request_result
+    {
+        int api_number;
+        int status;
+        std::string output;
+    }; // struct request_result
+
+    //
+    // Function Prototypes
+    //
+
+    auto call_batch_execute(irods::api_entry*, rsComm_t*, bytesBuf_t*, bytesBuf_t**) -> int;
+
+    auto is_input_valid(const bytesBuf_t*) -> std::tuple<bool, std::string>;
+
+    auto make_output(const std::vector<request_result>& _results, const std::string& _error_msg = "")
+        -> bytesBuf_t*;
+
+    auto is_api_number_allowed(int _api_number, const irods::api_entry& _api_entry) -> bool;
+
+    auto is_input_allowed(int _api_number, const void* _input) -> bool;
+
+    auto decode(const std::string& _encoded, std::string& _decoded) -> int;
+
+    auto encode(const bytesBuf_t& _decoded) -> std::string;
+
+    auto execute_request(rsComm_t& _comm, int _api_number, const std::string& _input) -> request_result;
+
+    auto rs_batch_execute(rsComm_t*, bytesBuf_t*, bytesBuf_t**) -> int;
+
+    //
+    // Function Implementations
+    //
+
+    auto call_batch_execute(irods::api_entry* _api, rsComm_t* _comm, bytesBuf_t* _input, bytesBuf_t** _output)
+        -> int
+    {
+        return _api->call_handler<bytesBuf_t*, bytesBuf_t**>(_comm, _input, _output);
+    }
+
+    auto is_input_valid(const bytesBuf_t* _input) -> std::tuple<bool, std::string>
+    {
+        if (!_input) {
+            return {false, "Missing JSON input"};
+        }
+
+        if (_input->len <= 0) {
+            return {false, "Length of buffer must be greater than zero"};
+        }
+
+        if (!_input->buf) {
+            return {false, "Missing input buffer"};
+        }
+
+        return {true, ""};
+    }
+
+    auto make_output(const std::vector<request_result>& _results, const std::string& _error_msg) -> bytesBuf_t*
+    {
+        auto results = json::array();
+
+        for (auto&& r : _results) {
+            results.push_back({{"api_number", r.api_number}, {"status", r.status}, {"output", r.output}});
+        }
+
+        auto output = json{{"results", results}};
+
+        if (!_error_msg.empty()) {
+            output["error_message"] = _error_msg;
+        }
+
+        return irods::to_bytes_buffer(output.dump());
+    }
+
+    auto is_api_number_allowed(int _api_number, const irods::api_entry& _api_entry) -> bool
+    {
+        if (_api_entry.inBsFlag != 0 || _api_entry.outBsFlag != 0) {
+            return false;
+        }
+
+        return std::find(std::begin(disallowed_api_numbers), std::end(disallowed_api_numbers), _api_number) ==
+               std::end(disallowed_api_numbers);
+    }
+
+    auto is_input_allowed(int _api_number, const void* _input) -> bool
+    {
+        // A recursive removal reports its progress to the client while it runs (see svrSendCollOprStat).
+        if (RM_COLL_AN == _api_number) {
+            const auto* input = static_cast<const collInp_t*>(_input);
+            return !input || !getValByKey(&input->condInput, RECURSIVE_OPR__KW);
+        }
+
+        return true;
+    }
+
+    auto decode(const std::string& _encoded, std::string& _decoded) -> int
+    {
+        // The decoded buffer is null-terminated so that packed XML can be unpacked safely.
+        unsigned long size = _encoded.size() / 4 * 3 + 1;
+        _decoded.assign(size, '\0');
+
+        const auto* in = reinterpret_cast<const unsigned char*>(_encoded.data());
+        auto* out = reinterpret_cast<unsigned char*>(_decoded.data());
+
+        if (const auto ec = irods::base64_decode(in, _encoded.size(), out, &size); ec != 0) {
+            return SYS_API_INPUT_ERR;
+        }
+
+        _decoded.resize(size + 1);
+
+        return 0;
+    }
+
+    auto encode(const bytesBuf_t& _decoded) -> std::string
+    {
+        const auto* in = static_cast<const unsigned char*>(_decoded.buf);
+        const unsigned long in_size = _decoded.len;
+
+        unsigned long size = 4 * ((in_size + 2) / 3) + 1;
+        std::string encoded(size, '\0');
+
+        if (irods::base64_encode(in, in_size, reinterpret_cast<unsigned char*>(encoded.data()), &size) != 0) {
+            return {};
+        }
+
+        encoded.resize(size);
+
+        return encoded;
+    }
+
+    auto execute_request(rsComm_t& _comm, int _api_number, const std::string& _input) -> request_result
+    {
+        request_result result{_api_number, 0, ""};
+
+        const auto start_time = std::chrono::steady_clock::now();
+        std::uint64_t bytes_out = 0;
+
+        irods::at_scope_exit record_api_statistics{[&] {
+            namespace stats = irods::experimental::api_statistics;
+            const auto elapsed = std::chrono::steady_clock::now() - start_time;
+            stats::record(_api_number, result.status, _input.size(), bytes_out, elapsed);
+        }};
+
+        if (const auto [supported, ec] = irods::is_api_number_supported(_api_number); !supported) {
+            result.status = ec;
+            return result;
+        }
+
+        auto& api_table = irods::get_server_api_table();
+        const auto iter = api_table.find(_api_number);
+
+        if (iter == std::end(api_table) || !iter->second) {
+            result.status = SYS_UNMATCHED_API_NUM;
+            return result;
+        }
+
+        auto& api_entry = *iter->second;
+
+        if (!is_api_number_allowed(_api_number, api_entry)) {
+            log::api::error("API [{}] cannot be executed as part of a batch", _api_number);
+            result.status = SYS_NOT_SUPPORTED;
+            return result;
+        }
+
+        // The same checks rsApiHandler applies to every request.
+        if (const auto ec = chkApiVersion(_api_number); ec < 0) {
+            result.status = ec;
+            return result;
+        }
+
+        if (const auto ec = chkApiPermission(&_comm, _api_number); ec < 0) {
+            log::api::info("User has no permission for API [{}]", _api_number);
+            result.status = ec;
+            return result;
+        }
+
+        if (_input.empty() != (api_entry.inPackInstruct == nullptr)) {
+            result.status = SYS_API_INPUT_ERR;
+            return result;
+        }
+
+        void* in_struct = nullptr;
+        void* out_struct = nullptr;
+
+        irods::at_scope_exit free_structs{[&api_entry, &in_struct, &out_struct] {
+            if (in_struct) {
+                if (api_entry.clearInStruct) {
+                    api_entry.clearInStruct(in_struct);
+                }
+
+                std::free(in_struct);
+            }
+
+            if (out_struct) {
+                if (api_entry.clearOutStruct) {
+                    api_entry.clearOutStruct(out_struct);
+                }
+
+                std::free(out_struct);
+            }
+        }};
+
+        if (!_input.empty()) {
+            std::string packed_input;
+
+            if (const auto ec = decode(_input, packed_input); ec < 0) {
+                result.status = ec;
+                return result;
+            }
+
+            const auto ec = unpack_struct(packed_input.data(), &in_struct, api_entry.inPackInstruct, RodsPackTable,
+                                          _comm.irodsProt, _comm.cliVersion.relVersion);
+
+            if (ec < 0) {
+                log::api::error("Failed to unpack input for API [{}] [error_code={}]", _api_number, ec);
+                result.status = ec;
+                return result;
+            }
+        }
+
+        if (!is_input_allowed(_api_number, in_struct)) {
+            log::api::error("API [{}] cannot be executed as part of a batch with the given input", _api_number);
+            result.status = SYS_NOT_SUPPORTED;
+            return result;
+        }
+
+        // Clear the session properties, as rsApiHandler does between requests on the same connection.
+        ix::key_value_proxy{_comm.session_props}.clear();
+
+        // The API being executed is identified by the connection, as rsApiHandler does.
+        const auto batch_api_inx = _comm.apiInx;
+        _comm.apiInx = _api_number;
+        irods::at_scope_exit restore_api_inx{[&_comm, batch_api_inx] { _comm.apiInx = batch_api_inx; }};
+
+        if (api_entry.inPackInstruct && api_entry.outPackInstruct) {
+            result.status = api_entry.call_wrapper(&api_entry, &_comm, in_struct, &out_struct);
+        }
+        else if (api_entry.inPackInstruct) {
+            result.status = api_entry.call_wrapper(&api_entry, &_comm, in_struct);
+        }
+        else if (api_entry.outPackInstruct) {
+            result.status = api_entry.call_wrapper(&api_entry, &_comm, &out_struct);
+        }
+        else {
+            result.status = api_entry.call_wrapper(&api_entry, &_comm);
+        }
+
+        if (SYS_HANDLER_DONE_NO_ERROR == result.status) {
+            result.status = 0;
+        }
+
+        if (api_entry.outPackInstruct && out_struct) {
+            bytesBuf_t* packed_output = nullptr;
+
+            const auto ec = pack_struct(out_struct, &packed_output, api_entry.outPackInstruct, RodsPackTable, 0,
+                                        _comm.irodsProt, _comm.cliVersion.relVersion);
+
+            if (ec < 0) {
+                log::api::error("Failed to pack output for API [{}] [error_code={}]", _api_number, ec);
+                result.status = ec;
+                return result;
+            }
+
+            bytes_out = static_cast<std::uint64_t>(packed_output->len);
+            result.output = encode(*packed_output);
+            freeBBuf(packed_output);
+        }
+
+        return result;
+    }
+
+    auto rs_batch_execute(rsComm_t* _comm, bytesBuf_t* _input, bytesBuf_t** _output) -> int
+    {
+        if (const auto [valid, msg] = is_input_valid(_input); !valid) {
+            log::api::error(msg);
+            *_output = make_output({}, "Invalid input");
+            return INPUT_ARG_NOT_WELL_FORMED_ERR;
+        }
+
+        json input;
+
+        try {
+            input = json::parse(std::string(static_cast<const char*>(_input->buf), _input->len));
+        }
+        catch (const json::parse_error& e) {
+            log::api::error({{"log_message", "Failed to parse input into JSON"}, {"error_message", e.what()}});
+            *_output = make_output({}, e.what());
+            return INPUT_ARG_NOT_WELL_FORMED_ERR;
+        }
+
+        bool stop_on_error = false;
+        std::vector<std::tuple<int, std::string>> requests;
+
+        try {
+            if (const auto iter = input.find("stop_on_error"); iter != std::end(input)) {
+                stop_on_error = iter->get<bool>();
+            }
+
+            const auto& request_list = input.at("requests");
+
+            if (!request_list.is_array()) {
+                *_output = make_output({}, "Requests must be an array");
+                return JSON_VALIDATION_ERROR;
+            }
+
+            requests.reserve(request_list.size());
+
+            for (auto&& r : request_list) {
+                requests.emplace_back(r.at("api_number").get<int>(), r.value("input", ""));
+            }
+        }
+        catch (const json::exception& e) {
+            log::api::error({{"log_message", "Failed to validate batch"}, {"error_message", e.what()}});
+            *_output = make_output({}, e.what());
+            return JSON_VALIDATION_ERROR;
+        }
+
+        std::vector<request_result> results;
+        results.reserve(requests.size());
+
+        int first_error = 0;
+
+        for (auto&& [api_number, packed_input] : requests) {
+            auto& result = results.emplace_back(execute_request(*_comm, api_number, packed_input));
+
+            if (result.status < 0) {
+                if (0 == first_error) {
+                    first_error = result.status;
+                }
+
+                if (stop_on_error) {
+                    break;
+                }
+            }
+        }
+
+        *_output = make_output(results);
+
+        return first_error;
+    }
+
+    const operation op = rs_batch_execute;
+    #define CALL_BATCH_EXECUTE call_batch_execute
+} // anonymous namespace
+
+#else // RODS_SERVER
+
+//
+// Client-side Implementation
+//
+
+namespace
+{
+    using operation = std::function<int(rsComm_t*, bytesBuf_t*, bytesBuf_t**)>;
+    const operation op{};
+    #define CALL_BATCH_EXECUTE nullptr
+} // anonymous namespace
+
+#endif // RODS_SERVER
+
+// The plugin factory function must always be defined.
+extern "C"
+auto plugin_factory(const std::string& _instance_name,
+                    const std::string& _context) -> irods::api_entry*
+{
+#ifdef RODS_SERVER
+    irods::client_api_allowlist::add(BATCH_EXECUTE_APN);
+#endif // RODS_SERVER
+
+    // clang-format off
+    irods::apidef_t def{
+        BATCH_EXECUTE_APN,                          // API number
+        RODS_API_VERSION,                           // API version
+        NO_USER_AUTH,                               // Client auth
+        NO_USER_AUTH,                               // Proxy auth
+        "BinBytesBuf_PI", 0,                        // In PI / bs flag
+        "BinBytesBuf_PI", 0,                        // Out PI / bs flag
+        op,                                         // Operation
+        "api_batch_execute",                        // Operation name
+        clearBytesBuffer,                           // clear input function
+        clearBytesBuffer,                           // clear output function
+        (funcPtr) CALL_BATCH_EXECUTE
+    };
+    // clang-format on
+
+    auto* api = new irods::api_entry{def};
+
+    api->in_pack_key = "BinBytesBuf_PI";
+    api->in_pack_value = BytesBuf_PI;
+
+    api->out_pack_key = "BinBytesBuf_PI";
+    api->out_pack_value = BytesBuf_PI;
+
+    return api;
+} // plugin_factory
@@ -0,0 +1,1042 @@
+#include "irods/plugins/api/api_plugin_number.h"
+#include "irods/irods_configuration_keywords.hpp"
+#include "irods/rodsDef.h"
+#include "irods/rcConnect.h"
+#include "irods/rodsErrorTable.h"
+#include "irods/rodsPackInstruct.h"
+#include "irods/client_api_allowlist.hpp"
+
+#include "irods/apiHandler.hpp"
+
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+
+#ifdef RODS_SERVER
+
+//
+// Server-side Implementation
+//
+
+#include "irods/bulk_apply_metadata_operations.h"
+
+#include "irods/catalog.hpp"
+#include "irods/catalog_utilities.hpp"
+#include "irods/irods_logger.hpp"
+#include "irods/irods_rs_comm_query.hpp"
+#include "irods/rodsConnect.h"
+#include "irods/server_utilities.hpp"
+
+#define IRODS_FILESYSTEM_ENABLE_SERVER_SIDE_API
+#include "irods/filesystem.hpp"
+
+#include <nlohmann/json.hpp>
+#include <fmt/format.h>
+#include <nanodbc/nanodbc.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <set>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    // clang-format off
+    namespace fs  = irods::experimental::filesystem;
+    namespace ic  = irods::experimental::catalog;
+    namespace log = irods::experimental::log;
+
+    using json      = nlohmann::json;
+    using operation = std::function<int(rsComm_t*, bytesBuf_t*, bytesBuf_t**)>;
+    using id_type   = std::int64_t;
+
+    // An AVU as (attribute, value, units).
+    using avu_type  = std::tuple<std::string, std::string, std::string>;
+
+    // A link between an object and an AVU as (object_id, meta_id).
+    using link_type = std::pair<id_type, id_type>;
+    // clang-format on
+
+    // Upper bounds on the number of values placed in a single statement. They keep every statement
+    // well below the bind parameter and statement length limits of the supported databases while
+    // still replacing thousands of round trips with a handful.
+    constexpr std::size_t max_names_per_statement = 500;
+    constexpr std::size_t max_avus_per_statement = 100;
+    constexpr std::size_t max_rows_per_statement = 500;
+
+    struct entity_request
+    {
+        std::string name;
+        ic::entity_type type;
+        id_type object_id = -1;
+
+        // The operations in the order given by the client. True means "add".
+        std::vector<std::pair<bool, avu_type>> operations;
+    }; // struct entity_request
+
+    struct item_error
+    {
+        int entity_index;
+        int operation_index;
+        std::string entity_name;
+        int error_code;
+        std::string error_message;
+    }; // struct item_error
+
+    //
+    // Function Prototypes
+    //
+
+    auto call_bulk_apply_metadata_operations(irods::api_entry*, rsComm_t*, bytesBuf_t*, bytesBuf_t**) -> int;
+
+    auto is_input_valid(const bytesBuf_t*) -> std::tuple<bool, std::string>;
+
+    auto make_error_object(int _entity_index,
+                           int _op_index,
+                           const std::string& _entity_name,
+                           int _error_code,
+                           const std::string& _error_msg) -> json;
+
+    auto make_output(const std::vector<item_error>& _errors) -> bytesBuf_t*;
+
+    auto parse_entity(const json& _entity, int _entity_index, std::vector<item_error>& _errors)
+        -> std::optional<entity_request>;
+
+    auto make_placeholders(std::size_t _count) -> std::string;
+
+    auto make_id_list(const std::vector<id_type>& _ids, std::size_t _first, std::size_t _last) -> std::string;
+
+    auto make_timestamp() -> std::string;
+
+    auto resolve_ids_by_name(nanodbc::connection& _db_conn,
+                             std::string_view _sql_prefix,
+                             const std::vector<std::string>& _names) -> std::map<std::string, id_type>;
+
+    auto resolve_data_object_ids(nanodbc::connection& _db_conn, const std::vector<std::string>& _paths)
+        -> std::map<std::string, id_type>;
+
+    auto resolve_object_ids(nanodbc::connection& _db_conn, std::vector<entity_request>& _entities) -> void;
+
+    auto get_object_access_levels(RsComm& _comm, nanodbc::connection& _db_conn, const std::vector<id_type>& _ids)
+        -> std::map<id_type, ic::access_type>;
+
+    auto get_meta_ids(nanodbc::connection& _db_conn,
+                      std::string_view _db_instance_name,
+                      const std::vector<avu_type>& _avus) -> std::map<avu_type, id_type>;
+
+    auto insert_metadata(nanodbc::connection& _db_conn,
+                         std::string_view _db_instance_name,
+                         const std::vector<avu_type>& _avus,
+                         const std::string& _timestamp) -> void;
+
+    auto make_link_conditions(const std::vector<link_type>& _links, std::size_t _first, std::size_t _last)
+        -> std::string;
+
+    auto get_existing_links(nanodbc::connection& _db_conn, const std::vector<link_type>& _links)
+        -> std::set<link_type>;
+
+    auto attach_metadata_to_objects(nanodbc::connection& _db_conn,
+                                    std::string_view _db_instance_name,
+                                    const std::vector<link_type>& _links,
+                                    const std::string& _timestamp) -> void;
+
+    auto detach_metadata_from_objects(nanodbc::connection& _db_conn, const std::vector<link_type>& _links) -> void;
+
+    auto apply_metadata_operations(nanodbc::connection& _db_conn,
+                                   std::string_view _db_instance_name,
+                                   const std::vector<entity_request>& _entities) -> void;
+
+    auto rs_bulk_apply_metadata_operations(rsComm_t*, bytesBuf_t*, bytesBuf_t**) -> int;
+
+    //
+    // Function Implementations
+    //
+
+    auto call_bulk_apply_metadata_operations(irods::api_entry* _api,
+                                             rsComm_t* _comm,
+                                             bytesBuf_t* _input,
+                                             bytesBuf_t** _output) -> int
+    {
+        return _api->call_handler<bytesBuf_t*, bytesBuf_t**>(_comm, _input, _output);
+    }
+
+    auto is_input_valid(const bytesBuf_t* _input) -> std::tuple<bool, std::string>
+    {
+        if (!_input) {
+            return {false, "Missing JSON input"};
+        }
+
+        if (_input->len <= 0) {
+            return {false, "Length of buffer must be greater than zero"};
+        }
+
+        if (!_input->buf) {
+            return {false, "Missing input buffer"};
+        }
+
+        return {true, ""};
+    }
+
+    auto make_error_object(int _entity_index,
+                           int _op_index,
+                           const std::string& _entity_name,
+                           int _error_code,
+                           const std::string& _error_msg) -> json
+    {
+        return json{
+            {"entity_index", _entity_index},
+            {"operation_index", _op_index},
+            {"entity_name", _entity_name},
+            {"error_code", _error_code},
+            {"error_message", _error_msg}
+        };
+    }
+
+    auto make_output(const std::vector<item_error>& _errors) -> bytesBuf_t*
+    {
+        auto errors = json::array();
+
+        for (auto&& e : _errors) {
+            errors.push_back(make_error_object(
+                e.entity_index, e.operation_index, e.entity_name, e.error_code, e.error_message));
+        }
+
+        return irods::to_bytes_buffer(json{{"errors", errors}}.dump());
+    }
+
+    auto parse_entity(const json& _entity, int _entity_index, std::vector<item_error>& _errors)
+        -> std::optional<entity_request>
+    {
+        entity_request request;
+
+        try {
+            request.name = _entity.at("entity_name").get<std::string>();
+
+            const auto type = _entity.at("entity_type").get<std::string>();
+
+            if (const auto iter = ic::entity_type_map.find(type); iter != std::end(ic::entity_type_map)) {
+                request.type = iter->second;
+            }
+            else {
+                const auto msg = fmt::format("Invalid entity type specified [entity_type={}]", type);
+                _errors.push_back({_entity_index, -1, request.name, SYS_INVALID_INPUT_PARAM, msg});
+                return std::nullopt;
+            }
+        }
+        catch (const json::exception& e) {
+            _errors.push_back({_entity_index, -1, request.name, JSON_VALIDATION_ERROR, e.what()});
+            return std::nullopt;
+        }
+
+        // An entity is applied all-or-nothing, just like a call to rc_atomic_apply_metadata_operations.
+        // Any invalid operation causes every operation of the entity to be skipped.
+        bool valid = true;
+
+        try {
+            const auto& operations = _entity.at("operations");
+
+            if (!operations.is_array()) {
+                const auto* msg = "Operations must be an array";
+                _errors.push_back({_entity_index, -1, request.name, JSON_VALIDATION_ERROR, msg});
+                return std::nullopt;
+            }
+
+            request.operations.reserve(operations.size());
+
+            for (json::size_type i = 0; i < operations.size(); ++i) {
+                const auto& op = operations[i];
+                const auto op_index = static_cast<int>(i);
+
+                try {
+                    avu_type avu{op.at("attribute").get<std::string>(), op.at("value").get<std::string>(), ""};
+                    auto& [attribute, value, units] = avu;
+
+                    if (attribute.empty() || value.empty()) {
+                        const auto msg = fmt::format(
+                            "Empty metadata attribute name or value [attribute={}, value={}]", attribute, value);
+                        _errors.push_back({_entity_index, op_index, request.name, SYS_INVALID_INPUT_PARAM, msg});
+                        valid = false;
+                        continue;
+                    }
+
+                    // "units" are optional.
+                    if (op.count("units")) {
+                        units = op.at("units").get<std::string>();
+                    }
+
+                    if (const auto op_code = op.at("operation").get<std::string>(); op_code == "add") {
+                        request.operations.emplace_back(true, std::move(avu));
+                    }
+                    else if (op_code == "remove") {
+                        request.operations.emplace_back(false, std::move(avu));
+                    }
+                    else {
+                        _errors.push_back(
+                            {_entity_index, op_index, request.name, INVALID_OPERATION, "Invalid metadata operation."});
+                        valid = false;
+                    }
+                }
+                catch (const json::exception& e) {
+                    _errors.push_back({_entity_index, op_index, request.name, JSON_VALIDATION_ERROR, e.what()});
+                    valid = false;
+                }
+            }
+        }
+        catch (const json::exception& e) {
+            _errors.push_back({_entity_index, -1, request.name, JSON_VALIDATION_ERROR, e.what()});
+            return std::nullopt;
+        }
+
+        if (!valid) {
+            return std::nullopt;
+        }
+
+        return request;
+    }
+
+    auto make_placeholders(std::size_t _count) -> std::string
+    {
+        std::string placeholders;
+        placeholders.reserve(_count * 3);
+
+        for (std::size_t i = 0; i < _count; ++i) {
+            placeholders += (i == 0) ? "?" : ", ?";
+        }
+
+        return placeholders;
+    }
+
+    // Object ids come from the catalog, so they are embedded in the SQL directly. This avoids
+    // the per-database differences in how 64-bit integers are bound (see the oracle branches in
+    // atomic_apply_metadata_operations.cpp).
+    auto make_id_list(const std::vector<id_type>& _ids, std::size_t _first, std::size_t _last) -> std::string
+    {
+        std::string list;
+
+        for (auto i = _first; i < _last; ++i) {
+            if (i > _first) {
+                list += ", ";
+            }
+
+            list += std::to_string(_ids[i]);
+        }
+
+        return list;
+    }
+
+    auto make_timestamp() -> std::string
+    {
+        using std::chrono::system_clock;
+        using std::chrono::duration_cast;
+        using std::chrono::seconds;
+
+        return fmt::format("{:011}", duration_cast<seconds>(system_clock::now().time_since_epoch()).count());
+    }
+
+    auto resolve_ids_by_name(nanodbc::connection& _db_conn,
+                             std::string_view _sql_prefix,
+                             const std::vector<std::string>& _names) -> std::map<std::string, id_type>
+    {
+        std::map<std::string, id_type> ids;
+
+        for (std::size_t first = 0; first < _names.size(); first += max_names_per_statement) {
+            const auto last = std::min(first + max_names_per_statement, _names.size());
+
+            nanodbc::statement stmt{_db_conn};
+            prepare(stmt, fmt::format("{} in ({})", _sql_prefix, make_placeholders(last - first)));
+
+            for (auto i = first; i < last; ++i) {
+                stmt.bind(static_cast<short>(i - first), _names[i].c_str());
+            }
+
+            for (auto row = execute(stmt); row.next();) {
+                ids.insert_or_assign(row.get<std::string>(1), row.get<id_type>(0));
+            }
+        }
+
+        return ids;
+    }
+
+    auto resolve_data_object_ids(nanodbc::connection& _db_conn, const std::vector<std::string>& _paths)
+        -> std::map<std::string, id_type>
+    {
+        std::map<std::string, id_type> ids;
+
+        for (std::size_t first = 0; first < _paths.size(); first += max_names_per_statement) {
+            const auto last = std::min(first + max_names_per_statement, _paths.size());
+
+            // The set of parents and the set of names are matched independently, so the result may
+            // include data objects that were not requested. Those are discarded below.
+            std::vector<std::string> parents;
+            std::vector<std::string> names;
+            std::map<std::pair<std::string, std::string>, std::string> requested;
+
+            for (auto i = first; i < last; ++i) {
+                const fs::path p = _paths[i];
+                auto parent = p.parent_path().string();
+                auto name = p.object_name().string();
+
+                parents.push_back(parent);
+                names.push_back(name);
+                requested.insert_or_assign({std::move(parent), std::move(name)}, _paths[i]);
+            }
+
+            std::sort(std::begin(parents), std::end(parents));
+            parents.erase(std::unique(std::begin(parents), std::end(parents)), std::end(parents));
+
+            std::sort(std::begin(names), std::end(names));
+            names.erase(std::unique(std::begin(names), std::end(names)), std::end(names));
+
+            nanodbc::statement stmt{_db_conn};
+            prepare(stmt, fmt::format("select distinct d.data_id, c.coll_name, d.data_name "
+                                      "from R_DATA_MAIN d inner join R_COLL_MAIN c on d.coll_id = c.coll_id "
+                                      "where c.coll_name in ({}) and d.data_name in ({})",
+                                      make_placeholders(parents.size()),
+                                      make_placeholders(names.size())));
+
+            short index = 0;
+
+            for (auto&& parent : parents) {
+                stmt.bind(index++, parent.c_str());
+            }
+
+            for (auto&& name : names) {
+                stmt.bind(index++, name.c_str());
+            }
+
+            for (auto row = execute(stmt); row.next();) {
+                const auto iter = requested.find({row.get<std::string>(1), row.get<std::string>(2)});
+
+                if (iter != std::end(requested)) {
+                    ids.insert_or_assign(iter->second, row.get<id_type>(0));
+                }
+            }
+        }
+
+        return ids;
+    }
+
+    auto resolve_object_ids(nanodbc::connection& _db_conn, std::vector<entity_request>& _entities) -> void
+    {
+        std::map<ic::entity_type, std::vector<std::string>> names_by_type;
+
+        for (auto&& e : _entities) {
+            names_by_type[e.type].push_back(e.name);
+        }
+
+        std::map<ic::entity_type, std::map<std::string, id_type>> ids_by_type;
+
+        for (auto&& [type, names] : names_by_type) {
+            std::sort(std::begin(names), std::end(names));
+            names.erase(std::unique(std::begin(names), std::end(names)), std::end(names));
+
+            switch (type) {
+                case ic::entity_type::data_object:
+                    ids_by_type[type] = resolve_data_object_ids(_db_conn, names);
+                    break;
+
+                case ic::entity_type::collection:
+                    ids_by_type[type] = resolve_ids_by_name(
+                        _db_conn, "select coll_id, coll_name from R_COLL_MAIN where coll_name", names);
+                    break;
+
+                case ic::entity_type::user:
+                    ids_by_type[type] = resolve_ids_by_name(
+                        _db_conn, "select user_id, user_name from R_USER_MAIN where user_name", names);
+                    break;
+
+                case ic::entity_type::resource:
+                    ids_by_type[type] = resolve_ids_by_name(
+                        _db_conn, "select resc_id, resc_name from R_RESC_MAIN where resc_name", names);
+                    break;
+
+                default:
+                    // Entities of unsupported types are left unresolved and reported by the caller.
+                    break;
+            }
+        }
+
+        for (auto&& e : _entities) {
+            const auto& ids = ids_by_type[e.type];
+
+            if (const auto iter = ids.find(e.name); iter != std::end(ids)) {
+                e.object_id = iter->second;
+            }
+        }
+    }
+
+    auto get_object_access_levels(RsComm& _comm, nanodbc::connection& _db_conn, const std::vector<id_type>& _ids)
+        -> std::map<id_type, ic::access_type>
+    {
+        using int_type = std::underlying_type_t<ic::access_type>;
+
+        std::map<id_type, ic::access_type> levels;
+
+        for (std::size_t first = 0; first < _ids.size(); first += max_names_per_statement) {
+            const auto last = std::min(first + max_names_per_statement, _ids.size());
+
+            // Mirrors ic::user_has_permission_to_modify_entity(), for a set of objects at once. Objects
+            // the user cannot read are left out, as GenQuery leaves them out.
+            nanodbc::statement stmt{_db_conn};
+            prepare(stmt, fmt::format("select a.object_id, max(a.access_type_id) from R_USER_GROUP ug "
+                                      "inner join R_USER_MAIN u on ug.user_id = u.user_id "
+                                      "inner join R_OBJT_ACCESS a on ug.group_user_id = a.user_id "
+                                      "where u.user_name = ? and "
+                                            "a.access_type_id >= {} and "
+                                            "a.object_id in ({}) "
+                                      "group by a.object_id",
+                                      static_cast<int_type>(ic::access_type::read_object),
+                                      make_id_list(_ids, first, last)));
+
+            stmt.bind(0, _comm.clientUser.userName);
+
+            for (auto row = execute(stmt); row.next();) {
+                levels.insert_or_assign(row.get<id_type>(0), static_cast<ic::access_type>(row.get<int_type>(1)));
+            }
+        }
+
+        return levels;
+    }
+
+    auto get_meta_ids(nanodbc::connection& _db_conn,
+                      std::string_view _db_instance_name,
+                      const std::vector<avu_type>& _avus) -> std::map<avu_type, id_type>
+    {
+        std::map<avu_type, id_type> ids;
+
+        for (std::size_t first = 0; first < _avus.size(); first += max_avus_per_statement) {
+            const auto last = std::min(first + max_avus_per_statement, _avus.size());
+
+            std::string conditions;
+
+            for (auto i = first; i < last; ++i) {
+                if (i > first) {
+                    conditions += " or ";
+                }
+
+                // Oracle stores empty strings as null.
+                if ("oracle" == _db_instance_name && std::get<2>(_avus[i]).empty()) {
+                    conditions += "(meta_attr_name = ? and meta_attr_value = ? and meta_attr_unit is null)";
+                }
+                else {
+                    conditions += "(meta_attr_name = ? and meta_attr_value = ? and meta_attr_unit = ?)";
+                }
+            }
+
+            nanodbc::statement stmt{_db_conn};
+            prepare(stmt, "select meta_id, meta_attr_name, meta_attr_value, meta_attr_unit from R_META_MAIN where " +
+                          conditions + " order by meta_id");
+
+            short index = 0;
+
+            for (auto i = first; i < last; ++i) {
+                const auto& [attribute, value, units] = _avus[i];
+
+                stmt.bind(index++, attribute.c_str());
+                stmt.bind(index++, value.c_str());
+
+                if ("oracle" != _db_instance_name || !units.empty()) {
+                    stmt.bind(index++, units.c_str());
+                }
+            }
+
+            for (auto row = execute(stmt); row.next();) {
+                avu_type avu{row.get<std::string>(1), row.get<std::string>(2), row.get<std::string>(3, "")};
+
+                // Duplicate AVUs may exist in the catalog. Prefer the oldest one, like get_meta_id().
+                ids.try_emplace(std::move(avu), row.get<id_type>(0));
+            }
+        }
+
+        return ids;
+    }
+
+    auto insert_metadata(nanodbc::connection& _db_conn,
+                         std::string_view _db_instance_name,
+                         const std::vector<avu_type>& _avus,
+                         const std::string& _timestamp) -> void
+    {
+        constexpr const char* columns = "insert into R_META_MAIN (meta_id, meta_attr_name, meta_attr_value, "
+                                        "meta_attr_unit, create_ts, modify_ts) ";
+
+        if ("oracle" == _db_instance_name) {
+            // Oracle does not support multi-row VALUES and evaluates nextval once per statement
+            // for INSERT ALL. Insert one row at a time, reusing the prepared statement.
+            nanodbc::statement stmt{_db_conn};
+            prepare(stmt, fmt::format("{} values (R_OBJECTID.nextval, ?, ?, ?, ?, ?)", columns));
+
+            for (auto&& [attribute, value, units] : _avus) {
+                stmt.bind(0, attribute.c_str());
+                stmt.bind(1, value.c_str());
+                stmt.bind(2, units.c_str());
+                stmt.bind(3, _timestamp.c_str());
+                stmt.bind(4, _timestamp.c_str());
+
+                execute(stmt);
+            }
+
+            return;
+        }
+
+        std::string_view next_id;
+
+        if ("mysql" == _db_instance_name) {
+            next_id = "R_OBJECTID_nextval()";
+        }
+        else if ("postgres" == _db_instance_name) {
+            next_id = "nextval('R_OBJECTID')";
+        }
+        else {
+            throw std::runtime_error{"Invalid database plugin configuration"};
+        }
+
+        const auto row_values = fmt::format("({}, ?, ?, ?, ?, ?)", next_id);
+
+        for (std::size_t first = 0; first < _avus.size(); first += max_rows_per_statement) {
+            const auto last = std::min(first + max_rows_per_statement, _avus.size());
+
+            std::string sql = columns;
+            sql += "values ";
+
+            for (auto i = first; i < last; ++i) {
+                if (i > first) {
+                    sql += ", ";
+                }
+
+                sql += row_values;
+            }
+
+            nanodbc::statement stmt{_db_conn};
+            prepare(stmt, sql);
+
+            short index = 0;
+
+            for (auto i = first; i < last; ++i) {
+                const auto& [attribute, value, units] = _avus[i];
+
+                stmt.bind(index++, attribute.c_str());
+                stmt.bind(index++, value.c_str());
+                stmt.bind(index++, units.c_str());
+                stmt.bind(index++, _timestamp.c_str());
+                stmt.bind(index++, _timestamp.c_str());
+            }
+
+            execute(stmt);
+        }
+    }
+
+    auto make_link_conditions(const std::vector<link_type>& _links, std::size_t _first, std::size_t _last)
+        -> std::string
+    {
+        std::string conditions;
+
+        for (auto i = _first; i < _last; ++i) {
+            if (i > _first) {
+                conditions += " or ";
+            }
+
+            conditions += fmt::format("(object_id = {} and meta_id = {})", _links[i].first, _links[i].second);
+        }
+
+        return conditions;
+    }
+
+    auto get_existing_links(nanodbc::connection& _db_conn, const std::vector<link_type>& _links)
+        -> std::set<link_type>
+    {
+        std::set<link_type> existing;
+
+        for (std::size_t first = 0; first < _links.size(); first += max_rows_per_statement) {
+            const auto last = std::min(first + max_rows_per_statement, _links.size());
+
+            nanodbc::statement stmt{_db_conn};
+            prepare(stmt, "select object_id, meta_id from R_OBJT_METAMAP where " +
+                          make_link_conditions(_links, first, last));
+
+            for (auto row = execute(stmt); row.next();) {
+                existing.emplace(row.get<id_type>(0), row.get<id_type>(1));
+            }
+        }
+
+        return existing;
+    }
+
+    auto attach_metadata_to_objects(nanodbc::connection& _db_conn,
+                                    std::string_view _db_instance_name,
+                                    const std::vector<link_type>& _links,
+                                    const std::string& _timestamp) -> void
+    {
+        const bool is_oracle = ("oracle" == _db_instance_name);
+
+        for (std::size_t first = 0; first < _links.size(); first += max_rows_per_statement) {
+            const auto last = std::min(first + max_rows_per_statement, _links.size());
+
+            // Oracle does not support multi-row VALUES, but a UNION ALL of rows selected from dual
+            // is equivalent and does not involve a sequence.
+            std::string sql = "insert into R_OBJT_METAMAP (object_id, meta_id, create_ts, modify_ts) ";
+            sql += is_oracle ? "" : "values ";
+
+            for (auto i = first; i < last; ++i) {
+                const auto& [object_id, meta_id] = _links[i];
+
+                if (is_oracle) {
+                    sql += fmt::format("{}select {}, {}, '{}', '{}' from dual",
+                                       (i > first) ? " union all " : "", object_id, meta_id, _timestamp, _timestamp);
+                }
+                else {
+                    sql += fmt::format("{}({}, {}, '{}', '{}')",
+                                       (i > first) ? ", " : "", object_id, meta_id, _timestamp, _timestamp);
+                }
+            }
+
+            nanodbc::statement stmt{_db_conn};
+            prepare(stmt, sql);
+            execute(stmt);
+        }
+    }
+
+    auto detach_metadata_from_objects(nanodbc::connection& _db_conn, const std::vector<link_type>& _links) -> void
+    {
+        for (std::size_t first = 0; first < _links.size(); first += max_rows_per_statement) {
+            const auto last = std::min(first + max_rows_per_statement, _links.size());
+
+            nanodbc::statement stmt{_db_conn};
+            prepare(stmt, "delete from R_OBJT_METAMAP where " + make_link_conditions(_links, first, last));
+            execute(stmt);
+        }
+    }
+
+    auto apply_metadata_operations(nanodbc::connection& _db_conn,
+                                   std::string_view _db_instance_name,
+                                   const std::vector<entity_request>& _entities) -> void
+    {
+        // Replaying the operations in request order and keeping only the last operation for each
+        // (object, AVU) pair yields the same result as executing them one after the other.
+        std::map<std::pair<id_type, avu_type>, bool> final_state;
+
+        for (auto&& e : _entities) {
+            for (auto&& [add, avu] : e.operations) {
+                final_state.insert_or_assign({e.object_id, avu}, add);
+            }
+        }
+
+        std::set<avu_type> avu_set;
+
+        for (auto&& [key, add] : final_state) {
+            avu_set.insert(key.second);
+        }
+
+        const std::vector<avu_type> avus(std::begin(avu_set), std::end(avu_set));
+        auto meta_ids = get_meta_ids(_db_conn, _db_instance_name, avus);
+
+        std::set<avu_type> missing_set;
+
+        for (auto&& [key, add] : final_state) {
+            if (add && meta_ids.count(key.second) == 0) {
+                missing_set.insert(key.second);
+            }
+        }
+
+        const std::vector<avu_type> missing(std::begin(missing_set), std::end(missing_set));
+
+        const auto timestamp = make_timestamp();
+
+        if (!missing.empty()) {
+            insert_metadata(_db_conn, _db_instance_name, missing, timestamp);
+
+            for (auto&& [avu, id] : get_meta_ids(_db_conn, _db_instance_name, missing)) {
+                meta_ids.try_emplace(avu, id);
+            }
+        }
+
+        std::vector<link_type> to_attach;
+        std::vector<link_type> to_detach;
+
+        for (auto&& [key, add] : final_state) {
+            const auto iter = meta_ids.find(key.second);
+
+            if (iter == std::end(meta_ids)) {
+                if (add) {
+                    const auto& [attribute, value, units] = key.second;
+                    throw std::runtime_error{fmt::format(
+                        "Failed to insert metadata [attribute={}, value={}, units={}]", attribute, value, units)};
+                }
+
+                // Removing an AVU which does not exist is not an error.
+                continue;
+            }
+
+            (add ? to_attach : to_detach).emplace_back(key.first, iter->second);
+        }
+
+        if (!to_attach.empty()) {
+            const auto existing = get_existing_links(_db_conn, to_attach);
+
+            if (!existing.empty()) {
+                const auto is_existing = [&existing](const link_type& _l) { return existing.count(_l) > 0; };
+                to_attach.erase(std::remove_if(std::begin(to_attach), std::end(to_attach), is_existing),
+                                std::end(to_attach));
+            }
+
+            attach_metadata_to_objects(_db_conn, _db_instance_name, to_attach, timestamp);
+        }
+
+        detach_metadata_from_objects(_db_conn, to_detach);
+    }
+
+    auto rs_bulk_apply_metadata_operations(rsComm_t* _comm, bytesBuf_t* _input, bytesBuf_t** _output) -> int
+    {
+        try {
+            if (!ic::connected_to_catalog_provider(*_comm)) {
+                log::api::trace("Redirecting request to catalog service provider ...");
+
+                auto* host_info = ic::redirect_to_catalog_provider(*_comm);
+
+                const std::string json_input(static_cast<const char*>(_input->buf), _input->len);
+                char* json_output = nullptr;
+
+                const auto ec = rc_bulk_apply_metadata_operations(host_info->conn, json_input.data(), &json_output);
+                *_output = irods::to_bytes_buffer(json_output);
+
+                return ec;
+            }
+
+            ic::throw_if_catalog_provider_service_role_is_invalid();
+        }
+        catch (const irods::exception& e) {
+            log::api::error(e.what());
+            *_output = make_output({{-1, -1, "", static_cast<int>(e.code()), e.what()}});
+            return e.code();
+        }
+
+        if (const auto [valid, msg] = is_input_valid(_input); !valid) {
+            log::api::error(msg);
+            *_output = make_output({{-1, -1, "", INPUT_ARG_NOT_WELL_FORMED_ERR, "Invalid input"}});
+            return INPUT_ARG_NOT_WELL_FORMED_ERR;
+        }
+
+        json input;
+
+        try {
+            input = json::parse(std::string(static_cast<const char*>(_input->buf), _input->len));
+        }
+        catch (const json::parse_error& e) {
+            log::api::error({{"log_message", "Failed to parse input into JSON"}, {"error_message", e.what()}});
+            *_output = make_output({{-1, -1, "", INPUT_ARG_NOT_WELL_FORMED_ERR, e.what()}});
+            return INPUT_ARG_NOT_WELL_FORMED_ERR;
+        }
+
+        std::vector<item_error> errors;
+        std::vector<entity_request> entities;
+        std::vector<int> entity_indices;
+
+        try {
+            const auto& input_entities = input.at("entities");
+
+            if (!input_entities.is_array()) {
+                *_output = make_output({{-1, -1, "", JSON_VALIDATION_ERROR, "Entities must be an array"}});
+                return JSON_VALIDATION_ERROR;
+            }
+
+            for (json::size_type i = 0; i < input_entities.size(); ++i) {
+                if (auto e = parse_entity(input_entities[i], static_cast<int>(i), errors); e) {
+                    entities.push_back(std::move(*e));
+                    entity_indices.push_back(static_cast<int>(i));
+                }
+            }
+        }
+        catch (const json::exception& e) {
+            *_output = make_output({{-1, -1, "", JSON_VALIDATION_ERROR, e.what()}});
+            return JSON_VALIDATION_ERROR;
+        }
+
+        bool admin_mode = false;
+
+        try {
+            if (const auto iter = input.find("admin_mode"); iter != std::end(input) && iter->get<bool>()) {
+                if (!irods::is_privileged_client(*_comm)) {
+                    log::api::error("User is not an administrator.");
+                    const auto* msg = "User is not an administrator";
+                    *_output = make_output({{-1, -1, "", CAT_INSUFFICIENT_PRIVILEGE_LEVEL, msg}});
+                    return CAT_INSUFFICIENT_PRIVILEGE_LEVEL;
+                }
+
+                admin_mode = true;
+            }
+        }
+        catch (const json::exception& e) {
+            *_output = make_output({{-1, -1, "", JSON_VALIDATION_ERROR, e.what()}});
+            return JSON_VALIDATION_ERROR;
+        }
+
+        std::string db_instance_name;
+        nanodbc::connection db_conn;
+
+        try {
+            std::tie(db_instance_name, db_conn) = ic::get_database_connection();
+        }
+        catch (const std::exception& e) {
+            *_output = make_output({{-1, -1, "", SYS_CONFIG_FILE_ERR, e.what()}});
+            return SYS_CONFIG_FILE_ERR;
+        }
+
+        return ic::execute_transaction(db_conn, [&](auto& _trans) -> int
+        {
+            try {
+                auto& conn = _trans.connection();
+
+                resolve_object_ids(conn, entities);
+
+                std::map<id_type, ic::access_type> access_levels;
+
+                if (!admin_mode) {
+                    std::vector<id_type> ids;
+
+                    for (auto&& e : entities) {
+                        const bool is_fs_object = (ic::entity_type::data_object == e.type ||
+                                                   ic::entity_type::collection == e.type);
+
+                        if (e.object_id > -1 && is_fs_object) {
+                            ids.push_back(e.object_id);
+                        }
+                    }
+
+                    std::sort(std::begin(ids), std::end(ids));
+                    ids.erase(std::unique(std::begin(ids), std::end(ids)), std::end(ids));
+
+                    access_levels = get_object_access_levels(*_comm, conn, ids);
+                }
+
+                const bool is_privileged = admin_mode || irods::is_privileged_client(*_comm);
+
+                // Drop the entities which cannot be modified and report why.
+                std::vector<entity_request> allowed;
+                allowed.reserve(entities.size());
+
+                for (std::size_t i = 0; i < entities.size(); ++i) {
+                    auto& e = entities[i];
+                    const auto index = entity_indices[i];
+
+                    if (e.object_id < 0) {
+                        const auto msg = fmt::format("Entity does not exist [entity_name={}]", e.name);
+                        errors.push_back({index, -1, e.name, SYS_INVALID_INPUT_PARAM, msg});
+                        continue;
+                    }
+
+                    bool permitted = admin_mode;
+
+                    if (!permitted) {
+                        if (ic::entity_type::data_object == e.type || ic::entity_type::collection == e.type) {
+                            const auto iter = access_levels.find(e.object_id);
+
+                            // Do not reveal the existence of objects the user cannot see.
+                            if (iter == std::end(access_levels)) {
+                                const auto msg = fmt::format("Entity does not exist [entity_name={}]", e.name);
+                                errors.push_back({index, -1, e.name, CAT_NO_ROWS_FOUND, msg});
+                                continue;
+                            }
+
+                            permitted = (iter->second >= ic::access_type::modify_object);
+                        }
+                        else {
+                            permitted = is_privileged;
+                        }
+                    }
+
+                    if (!permitted) {
+                        log::api::error("User not allowed to modify metadata [entity_name={}, object_id={}]",
+                                        e.name, e.object_id);
+                        errors.push_back(
+                            {index, -1, e.name, CAT_NO_ACCESS_PERMISSION, "User not allowed to modify metadata"});
+                        continue;
+                    }
+
+                    allowed.push_back(std::move(e));
+                }
+
+                apply_metadata_operations(conn, db_instance_name, allowed);
+
+                _trans.commit();
+            }
+            catch (const nanodbc::database_error& e) {
+                log::api::error({{"log_message", "Failed to apply metadata operations"}, {"error_message", e.what()}});
+                *_output = make_output({{-1, -1, "", SYS_LIBRARY_ERROR, e.what()}});
+                return SYS_LIBRARY_ERROR;
+            }
+            catch (const std::exception& e) {
+                log::api::error({{"log_message", "Failed to apply metadata operations"}, {"error_message", e.what()}});
+                *_output = make_output({{-1, -1, "", SYS_INTERNAL_ERR, e.what()}});
+                return SYS_INTERNAL_ERR;
+            }
+
+            std::stable_sort(std::begin(errors), std::end(errors), [](const item_error& _l, const item_error& _r) {
+                return _l.entity_index < _r.entity_index;
+            });
+
+            *_output = make_output(errors);
+
+            return errors.empty() ? 0 : errors.front().error_code;
+        });
+    }
+
+    const operation op = rs_bulk_apply_metadata_operations;
+    #define CALL_BULK_APPLY_METADATA_OPERATIONS call_bulk_apply_metadata_operations
+} // anonymous namespace
+
+#else // RODS_SERVER
+
+//
+// Client-side Implementation
+//
+
+namespace
+{
+    using operation = std::function<int(rsComm_t*, bytesBuf_t*, bytesBuf_t**)>;
+    const operation op{};
+    #define CALL_BULK_APPLY_METADATA_OPERATIONS nullptr
+} // anonymous namespace
+
+#endif // RODS_SERVER
+
+// The plugin factory function must always be defined.
+extern "C"
+auto plugin_factory(const std::string& _instance_name,
+                    const std::string& _context) -> irods::api_entry*
+{
+#ifdef RODS_SERVER
+    irods::client_api_allowlist::add(BULK_APPLY_METADATA_OPERATIONS_APN);
+#endif // RODS_SERVER
+
+    // clang-format off
+    irods::apidef_t def{
+        BULK_APPLY_METADATA_OPERATIONS_APN,         // API number
+        RODS_API_VERSION,                           // API version
+        NO_USER_AUTH,                               // Client auth
+        NO_USER_AUTH,                               // Proxy auth
+        "BinBytesBuf_PI", 0,                        // In PI / bs flag
+        "BinBytesBuf_PI", 0,                        // Out PI / bs flag
+        op,                                         // Operation
+        "api_bulk_apply_metadata_operations",       // Operation name
+        clearBytesBuffer,                           // clear input function
+        clearBytesBuffer,                           // clear output function
+        (funcPtr) CALL_BULK_APPLY_METADATA_OPERATIONS
+    };
+    // clang-format on
+
+    auto* api = new irods::api_entry{def};
+
+    api->in_pack_key = "BinBytesBuf_PI";
+    api->in_pack_value = BytesBuf_PI;
+
+    api->out_pack_key = "BinBytesBuf_PI";
+    api->out_pack_value = BytesBuf_PI;
+
+    return api;
+} // plugin_factory
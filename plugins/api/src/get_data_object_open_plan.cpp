@@ -0,0 +1,179 @@
+#include "irods/apiHandler.hpp"
+#include "irods/client_api_allowlist.hpp"
+#include "irods/plugins/api/api_plugin_number.h"
+#include "irods/rcConnect.h"
+#include "irods/rodsErrorTable.h"
+#include "irods/rodsPackInstruct.h"
+
+#include <functional>
+
+#ifdef RODS_SERVER
+
+//
+// Server-side Implementation
+//
+
+// clang-format off
+#include "irods/get_data_object_open_plan.h"
+
+#include "irods/catalog.hpp"
+#include "irods/catalog_utilities.hpp"
+#include "irods/icatHighLevelRoutines.hpp"
+#include "irods/irods_logger.hpp"
+#include "irods/irods_re_serialization.hpp"
+#include "irods/irods_server_api_call.hpp"
+#include "irods/server_utilities.hpp"
+
+#include <nlohmann/json.hpp>
+#include <fmt/format.h>
+
+#include <string>
+// clang-format on
+
+namespace
+{
+    using log_api = irods::experimental::log::api;
+    using json = nlohmann::json;
+
+    //
+    // Function Prototypes
+    //
+
+    auto call_get_data_object_open_plan(irods::api_entry*, RsComm*, const char*, BytesBuf**) -> int;
+
+    auto rs_get_data_object_open_plan_impl(RsComm*, const char*, BytesBuf**) -> int;
+
+    //
+    // Function Implementations
+    //
+
+    auto call_get_data_object_open_plan(irods::api_entry* _api,
+                                        RsComm* _comm,
+                                        const char* _json_input,
+                                        BytesBuf** _output) -> int
+    {
+        return _api->call_handler<const char*, BytesBuf**>(_comm, _json_input, _output);
+    } // call_get_data_object_open_plan
+
+    auto rs_get_data_object_open_plan_impl(RsComm* _comm, const char* _json_input, BytesBuf** _output) -> int
+    {
+        if (!_json_input || !_output) {
+            log_api::error("Invalid input: _json_input or _output is null");
+            return SYS_INVALID_INPUT_PARAM;
+        }
+
+        std::string logical_path;
+        std::string access_level;
+
+        try {
+            const auto input = json::parse(_json_input);
+            logical_path = input.at("logical_path").get<std::string>();
+            access_level = input.at("access_level").get<std::string>();
+        }
+        catch (const json::exception& e) {
+            log_api::error("Could not parse JSON input: {}", e.what());
+            return INPUT_ARG_NOT_WELL_FORMED_ERR;
+        }
+
+        log_api::debug("{}: logical_path = [{}], access_level = [{}]", __func__, logical_path, access_level);
+
+        try {
+            namespace ic = irods::experimental::catalog;
+
+            if (!ic::connected_to_catalog_provider(*_comm)) {
+                log_api::trace("Redirecting request to catalog service provider ...");
+                auto* host_info = ic::redirect_to_catalog_provider(*_comm);
+                return rc_get_data_object_open_plan(host_info->conn, _json_input, _output);
+            }
+
+            ic::throw_if_catalog_provider_service_role_is_invalid();
+        }
+        catch (const irods::exception& e) {
+            log_api::error(e.what());
+            return e.code();
+        }
+
+        std::string plan;
+
+        if (const auto ec = chl_get_data_object_open_plan(*_comm, logical_path.c_str(), access_level.c_str(), &plan);
+            ec != 0)
+        {
+            // The caller falls back to the individual lookups, so this is not worth more than a debug message.
+            log_api::debug("Could not get open plan [error_code=[{}], logical_path=[{}]]", ec, logical_path);
+            return ec;
+        }
+
+        try {
+            // The replicas are only returned to clients that are allowed to see them.
+            const auto output = json::parse(plan);
+
+            if (!output.at("permission_granted").get<bool>() && !output.at("replicas").empty()) {
+                log_api::debug("Client lacks [{}] permission on [{}]", access_level, logical_path);
+                return CAT_NO_ACCESS_PERMISSION;
+            }
+
+            *_output = irods::to_bytes_buffer(plan);
+        }
+        catch (const std::exception& e) {
+            log_api::error("An error occurred while serializing the JSON object: {}", e.what());
+            return SYS_LIBRARY_ERROR;
+        }
+
+        return 0;
+    } // rs_get_data_object_open_plan_impl
+
+    using operation = std::function<int(RsComm*, const char*, BytesBuf**)>;
+    const operation op = rs_get_data_object_open_plan_impl;
+    auto fn_ptr = reinterpret_cast<funcPtr>(call_get_data_object_open_plan);
+} // anonymous namespace
+
+#else // RODS_SERVER
+
+//
+// Client-side Implementation
+//
+
+namespace
+{
+    using operation = std::function<int(RsComm*, const char*, BytesBuf**)>;
+    const operation op{};
+    funcPtr fn_ptr = nullptr;
+} // anonymous namespace
+
+#endif // RODS_SERVER
+
+// The plugin factory function must always be defined.
+extern "C" auto plugin_factory(
+    [[maybe_unused]] const std::string& _instance_name, // NOLINT(bugprone-easily-swappable-parameters)
+    [[maybe_unused]] const std::string& _context) -> irods::api_entry*
+{
+#ifdef RODS_SERVER
+    irods::client_api_allowlist::add(GET_DATA_OBJECT_OPEN_PLAN_APN);
+#endif // RODS_SERVER
+
+    // clang-format off
+    irods::apidef_t def{
+        GET_DATA_OBJECT_OPEN_PLAN_APN,   // API number
+        RODS_API_VERSION,                // API version
+        REMOTE_USER_AUTH,                // Client auth
+        REMOTE_USER_AUTH,                // Proxy auth
+        "STR_PI", 0,                     // In PI / bs flag
+        "BinBytesBuf_PI", 0,             // Out PI / bs flag
+        op,                              // Operation
+        "api_get_data_object_open_plan", // Operation name
+        irods::clearInStruct_noop,       // Clear input function
+        clearBytesBuffer,                // Clear output function
+        fn_ptr
+    };
+    // clang-format on
+
+    auto* api = new irods::api_entry{def}; // NOLINT(cppcoreguidelines-owning-memory)
+
+    api->in_pack_key = "STR_PI";
+    api->in_pack_value = STR_PI;
+
+    api->out_pack_key = "BinBytesBuf_PI";
+    api->out_pack_value = BytesBuf_PI;
+
+    return api;
+} // plugin_factory
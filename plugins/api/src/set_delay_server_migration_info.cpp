@@ -138,7 +138,7 @@ namespace
         //
 
         try {
-            auto [db_instance_name, db_conn] = ic::new_database_connection();
+            auto [db_instance_name, db_conn] = ic::get_database_connection();
 
             return ic::execute_transaction(db_conn, [&_input, ignore_leader, ignore_successor](auto& _trans) -> int {
                 try {
@@ -0,0 +1,120 @@
+#include "irods/irods_pack_table.hpp"
+#include "irods/plugins/api/api_plugin_number.h"
+#include "irods/rodsDef.h"
+#include "irods/rcConnect.h"
+#include "irods/rodsPackInstruct.h"
+#include "irods/apiHandler.hpp"
+#include "irods/client_api_allowlist.hpp"
+
+#include <functional>
+
+#ifdef RODS_SERVER
+
+//
+// Server-side Implementation
+//
+
+#include "irods/set_trace_context.h"
+
+#include "irods/irods_logger.hpp"
+#include "irods/irods_server_api_call.hpp"
+#include "irods/rodsErrorTable.h"
+#include "irods/tracing.hpp"
+
+#include <cstring>
+#include <string_view>
+
+namespace
+{
+    using log_api = irods::experimental::log::api;
+
+    //
+    // Function Prototypes
+    //
+
+    auto call_set_trace_context(irods::api_entry*, RsComm*, bytesBuf_t*) -> int;
+
+    auto rs_set_trace_context(RsComm*, bytesBuf_t*) -> int;
+
+    //
+    // Function Implementations
+    //
+
+    auto call_set_trace_context(irods::api_entry* _api, RsComm* _comm, bytesBuf_t* _input) -> int
+    {
+        return _api->call_handler<bytesBuf_t*>(_comm, _input);
+    } // call_set_trace_context
+
+    auto rs_set_trace_context(RsComm* _comm, bytesBuf_t* _input) -> int
+    {
+        namespace tracing = irods::experimental::tracing;
+
+        if (!_input || !_input->buf || _input->len <= 0) {
+            return SYS_INVALID_INPUT_PARAM;
+        }
+
+        const auto* buf = static_cast<const char*>(_input->buf);
+        const auto context = tracing::from_traceparent({buf, strnlen(buf, _input->len)});
+
+        if (!context) {
+            log_api::error("Invalid traceparent received from [{}].", _comm->clientAddr);
+            return SYS_INVALID_INPUT_PARAM;
+        }
+
+        tracing::set_root_context(*context);
+
+        return 0;
+    } // rs_set_trace_context
+
+    using operation = std::function<int(RsComm*, bytesBuf_t*)>;
+    const operation op = rs_set_trace_context;
+    #define CALL_SET_TRACE_CONTEXT call_set_trace_context
+} // anonymous namespace
+
+#else // RODS_SERVER
+
+//
+// Client-side Implementation
+//
+
+namespace
+{
+    using operation = std::function<int(RsComm*, bytesBuf_t*)>;
+    const operation op{};
+    #define CALL_SET_TRACE_CONTEXT nullptr
+} // anonymous namespace
+
+#endif // RODS_SERVER
+
+// The plugin factory function must always be defined.
+extern "C"
+auto plugin_factory(const std::string& _instance_name,
+                    const std::string& _context) -> irods::api_entry*
+{
+#ifdef RODS_SERVER
+    irods::client_api_allowlist::add(SET_TRACE_CONTEXT_APN);
+#endif // RODS_SERVER
+
+    // clang-format off
+    irods::apidef_t def{
+        SET_TRACE_CONTEXT_APN,      // API number
+        RODS_API_VERSION,           // API version
+        REMOTE_USER_AUTH,           // Client auth
+        REMOTE_USER_AUTH,           // Proxy auth
+        "BinBytesBuf_PI", 0,        // In PI / bs flag
+        nullptr, 0,                 // Out PI / bs flag
+        op,                         // Operation
+        "api_set_trace_context",    // Operation name
+        clearBytesBuffer,           // Clear input function
+        irods::clearOutStruct_noop, // Clear output function
+        (funcPtr) CALL_SET_TRACE_CONTEXT
+    };
+    // clang-format on
+
+    auto* api = new irods::api_entry{def};
+
+    api->in_pack_key = "BinBytesBuf_PI";
+    api->in_pack_value = BytesBuf_PI;
+
+    return api;
+} // plugin_factory
@@ -20,6 +20,7 @@
 // clang-format off
 #include "irods/switch_user.h"
 
+#include "irods/connection_broker.hpp"
 #include "irods/fileOpr.hpp" // For FD_INUSE.
 #include "irods/initServer.hpp" // For close_all_l1_descriptors.
 #include "irods/irods_logger.hpp"
@@ -171,7 +172,11 @@ namespace
                     ec);
                 rcDisconnect(_host.conn);
                 _host.conn = nullptr;
+                return;
             }
+
+            // The connection no longer acts for the client user it was established for.
+            irods::connection_broker::exclude(_host.conn);
         };
 
         for (auto* zone_ptr = ZoneInfoHead; zone_ptr; zone_ptr = zone_ptr->next) {
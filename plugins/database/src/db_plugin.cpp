@@ -37,6 +37,8 @@
 #include "irods/irods_logger.hpp"
 #include "irods/catalog.hpp"
 #include "irods/catalog_utilities.hpp"
+#include "irods/access_check_cache.hpp"
+#include "irods/irods_at_scope_exit.hpp"
 #include "irods/plugins/auth/pam_password.hpp"
 
 #include <fmt/chrono.h>
@@ -49,6 +51,7 @@
 #include <boost/regex.hpp>
 
 #include <algorithm>
+#include <array>
 #include <charconv>
 #include <chrono>
 #include <cstring>
@@ -111,6 +114,7 @@ char irods_pam_password_default_time[ NAME_LEN ] = { "1209600" };
 size_t log_sql_flg = 0;
 icatSessionStruct icss; // JMC :: only for testing!!!
 extern int logSQL;
+extern int accessControlControlFlag;
 
 int  creatingUserByGroupAdmin; // JMC - backport 4772
 char mySessionTicket[NAME_LEN];
@@ -951,6 +955,9 @@ static int _delColl( rsComm_t *rsComm, collInfo_t *collInfo ) {
         _rollback( "_delColl" );
     }
 
+    irods::access_check_cache::erase(collInfo->collName);
+    irods::access_check_cache::erase(collIdNum);
+
     /* Remove associated AVUs, if any */
     if (const auto ec = removeMetaMapAndAVU(collIdNum); ec < 0) {
         irods::log(LOG_WARNING, fmt::format(
@@ -1714,6 +1721,132 @@ int setOverQuota( rsComm_t *rsComm ) {
     return status;
 }
 
+/*
+  Incremental quota accounting.  Rather than leaving R_QUOTA_USAGE stale
+  until the next chlCalcUsageAndQuota, the replica operations apply the
+  change in usage for each (owner, resource) pair they touch, within the
+  same transaction.  The quota_over values are shifted by the same amount
+  for every quota the usage counts against: those of the owner and of
+  each group the owner belongs to, on that resource or on total usage.
+  This is only done once quotas are defined; chlCalcUsageAndQuota remains
+  the reconciliation pass that corrects any drift.
+
+  Whether quotas are defined is checked within the transaction of each
+  replica operation rather than cached, since another agent, on this or
+  any other server, may define or remove the first quota at any time.
+*/
+static bool quotaUsageTrackingEnabled() {
+    rodsLong_t iVal = 0;
+    std::vector<std::string> bindVars;
+    if ( logSQL != 0 ) {
+        log_sql::debug("quotaUsageTrackingEnabled SQL 1");
+    }
+    int status = cmlGetIntegerValueFromSql(
+                     "select count(*) from R_QUOTA_MAIN", &iVal, bindVars, &icss );
+    return status == 0 && iVal > 0;
+}
+
+static int applyQuotaUsageDelta( const char *userId, const char *rescId, rodsLong_t delta ) {
+    char deltaStr[MAX_NAME_LEN];
+    char myTime[50];
+    int status;
+
+    if ( delta == 0 ) {
+        return 0;
+    }
+    snprintf( deltaStr, sizeof( deltaStr ), "%lld", delta );
+    getNowStr( myTime );
+
+    cllBindVars[cllBindVarCount++] = deltaStr;
+    cllBindVars[cllBindVarCount++] = myTime;
+    cllBindVars[cllBindVarCount++] = userId;
+    cllBindVars[cllBindVarCount++] = rescId;
+    if ( logSQL != 0 ) {
+        log_sql::debug("applyQuotaUsageDelta SQL 1");
+    }
+    status = cmlExecuteNoAnswerSql(
+                 "update R_QUOTA_USAGE set quota_usage = quota_usage + ?, modify_ts = ? where user_id = ? and resc_id = ?",
+                 &icss );
+    if ( status == CAT_SUCCESS_BUT_WITH_NO_INFO ) {
+        if ( delta < 0 ) {
+            /* usage that was never counted; reconciliation will settle it */
+            return 0;
+        }
+        cllBindVars[cllBindVarCount++] = deltaStr;
+        cllBindVars[cllBindVarCount++] = rescId;
+        cllBindVars[cllBindVarCount++] = userId;
+        cllBindVars[cllBindVarCount++] = myTime;
+        if ( logSQL != 0 ) {
+            log_sql::debug("applyQuotaUsageDelta SQL 2");
+        }
+        status = cmlExecuteNoAnswerSql(
+                     "insert into R_QUOTA_USAGE (quota_usage, resc_id, user_id, modify_ts) values (?, ?, ?, ?)",
+                     &icss );
+    }
+    if ( status != 0 ) {
+        return status;
+    }
+
+    cllBindVars[cllBindVarCount++] = deltaStr;
+    cllBindVars[cllBindVarCount++] = myTime;
+    cllBindVars[cllBindVarCount++] = rescId;
+    cllBindVars[cllBindVarCount++] = userId;
+    if ( logSQL != 0 ) {
+        log_sql::debug("applyQuotaUsageDelta SQL 3");
+    }
+    status = cmlExecuteNoAnswerSql(
+                 "update R_QUOTA_MAIN set quota_over = quota_over + ?, modify_ts = ? where (resc_id = ? or resc_id = '0') and user_id in (select group_user_id from R_USER_GROUP where user_id = ?)",
+                 &icss );
+    if ( status == CAT_SUCCESS_BUT_WITH_NO_INFO ) {
+        status = 0;
+    }
+    return status;
+}
+
+/*
+  Add (sign > 0) or remove (sign < 0) the usage of the replicas selected
+  by whereClause, a condition on R_DATA_MAIN, to or from the quota usage
+  of their owners.  Must be called before any bind variables are set up
+  for the caller's own statement.
+*/
+static int applyQuotaUsageForReplicas( const char *whereClause,
+                                       std::vector<std::string> &bindVars,
+                                       int sign ) {
+    char tSQL[MAX_SQL_SIZE];
+    int statementNum = UNINITIALIZED_STATEMENT_NUMBER;
+    std::vector<std::array<std::string, 3>> usage;
+    int status;
+
+    if ( !quotaUsageTrackingEnabled() ) {
+        return 0;
+    }
+
+    snprintf( tSQL, sizeof( tSQL ),
+              "select R_USER_MAIN.user_id, R_DATA_MAIN.resc_id, sum(R_DATA_MAIN.data_size) from R_DATA_MAIN, R_USER_MAIN where R_USER_MAIN.user_name = R_DATA_MAIN.data_owner_name and R_USER_MAIN.zone_name = R_DATA_MAIN.data_owner_zone and %s group by R_USER_MAIN.user_id, R_DATA_MAIN.resc_id",
+              whereClause );
+    if ( logSQL != 0 ) {
+        log_sql::debug("applyQuotaUsageForReplicas SQL 1");
+    }
+    status = cmlGetFirstRowFromSqlBV( tSQL, bindVars, &statementNum, &icss );
+    while ( status == 0 ) {
+        char **values = icss.stmtPtr[statementNum]->resultValue;
+        usage.push_back( { values[0], values[1], values[2] } );
+        status = cmlGetNextRowFromStatement( statementNum, &icss );
+    }
+    if ( status != CAT_NO_ROWS_FOUND ) {
+        return status;
+    }
+
+    for ( const auto& u : usage ) {
+        status = applyQuotaUsageDelta( u[0].c_str(), u[1].c_str(),
+                                       sign * strtoll( u[2].c_str(), 0, 0 ) );
+        if ( status != 0 ) {
+            return status;
+        }
+    }
+    return 0;
+}
+
 int
 icatGetTicketUserId( irods::plugin_property_map& _prop_map, const char *userName, char *userIdStr ) {
 
@@ -1834,6 +1967,33 @@ convertHostToIp( const char *inputName ) {
     return ipAddr;
 }
 
+// Sizes the per-agent cache of permission checks from advanced_settings.access_check_cache.
+void configureAccessCheckCache() {
+    // clang-format off
+    std::size_t max_entries = 10'000;
+    int         ttl         = 5;
+    // clang-format on
+
+    try {
+        const auto config = irods::get_advanced_setting<nlohmann::json>(irods::KW_CFG_ACCESS_CHECK_CACHE);
+
+        if (const auto iter = config.find(irods::KW_CFG_MAX_ENTRIES); iter != std::end(config)) {
+            max_entries = std::max(iter->get<int>(), 0);
+        }
+
+        if (const auto iter = config.find(irods::KW_CFG_EVICTION_AGE_IN_SECONDS); iter != std::end(config)) {
+            ttl = std::max(iter->get<int>(), 0);
+        }
+    }
+    catch (...) {
+        log_db::debug("Could not read server configuration property [{}.{}]. Using defaults.",
+                      irods::KW_CFG_ADVANCED_SETTINGS,
+                      irods::KW_CFG_ACCESS_CHECK_CACHE);
+    }
+
+    irods::access_check_cache::configure(max_entries, std::chrono::seconds{ttl});
+}
+
 // XXXX HELPER FUNCTIONS ABOVE
 
 // =-=-=-=-=-=-=-
@@ -1975,6 +2135,8 @@ irods::error db_open_op(
     // set success flag
     icss.status = 1;
 
+    configureAccessCheckCache();
+
     // =-=-=-=-=-=-=-
     // Capture ICAT properties
 #if MY_ICAT
@@ -2065,6 +2227,11 @@ irods::error db_close_op(
     // set success flag
     icss.status = 0;
 
+    const auto stats = irods::access_check_cache::get_statistics();
+    log_db::debug("Access check cache statistics: hits [{}], misses [{}], catalog queries avoided [{}], "
+                  "invalidations [{}].",
+                  stats.hits, stats.misses, stats.queries_avoided, stats.invalidations);
+
     return CODE( status );
 
 } // db_close_op
@@ -2522,6 +2689,21 @@ irods::error db_mod_data_obj_meta_op(
         return PASS( ret );
     }
 
+    /* If the size, location or owner of replicas changes, move their
+     * usage out of the quota accounting now and back in once updated. */
+    const bool quotaUsageAffected =
+        doingDataSize || update_resc_id || getValByKey( _reg_param, DATA_OWNER_KW );
+    if ( quotaUsageAffected ) {
+        std::vector<std::string> bindVars;
+        bindVars.push_back( idVal );
+        status = applyQuotaUsageForReplicas( "R_DATA_MAIN.data_id = ?", bindVars, -1 );
+        if ( status != 0 ) {
+            _rollback( "chlModDataObjMeta" );
+            log_db::info("chlModDataObjMeta quota usage update failure {}", status);
+            return ERROR( status, "quota usage update failure" );
+        }
+    }
+
     if (!getValByKey(_reg_param, ALL_REPL_STATUS_KW)) {
         if ( logSQL != 0 ) {
             log_sql::debug("chlModDataObjMeta SQL 4");
@@ -2634,6 +2816,17 @@ irods::error db_mod_data_obj_meta_op(
                    "cmlModifySingleTable failure" );
     }
 
+    if ( quotaUsageAffected ) {
+        std::vector<std::string> bindVars;
+        bindVars.push_back( idVal );
+        status = applyQuotaUsageForReplicas( "R_DATA_MAIN.data_id = ?", bindVars, 1 );
+        if ( status != 0 ) {
+            _rollback( "chlModDataObjMeta" );
+            log_db::info("chlModDataObjMeta quota usage update failure {}", status);
+            return ERROR( status, "quota usage update failure" );
+        }
+    }
+
     if ( !( _data_obj_info->flags & NO_COMMIT_FLAG ) ) {
         status =  cmlExecuteNoAnswerSql( "commit", &icss );
         if ( status != 0 ) {
@@ -2823,6 +3016,21 @@ irods::error db_reg_data_obj_op(
         _rollback( "chlRegDataObj" );
         return ERROR( status, "chlRegDataObj cmlExecuteNoAnswerSql failure" );
     }
+
+    if ( _data_obj_info->dataSize > 0 ) {
+        std::vector<std::string> bindVars;
+        bindVars.push_back( dataIdNum );
+        bindVars.push_back( dataReplNum );
+        status = applyQuotaUsageForReplicas(
+                     "R_DATA_MAIN.data_id = ? and R_DATA_MAIN.data_repl_num = ?",
+                     bindVars, 1 );
+        if ( status != 0 ) {
+            log_db::info("chlRegDataObj quota usage update failure {}", status);
+            _rollback( "chlRegDataObj" );
+            return ERROR( status, "chlRegDataObj quota usage update failure" );
+        }
+    }
+
     std::string zone;
     ret = getLocalZone(
               _ctx.prop_map(),
@@ -3149,6 +3357,20 @@ irods::error db_reg_replica_op(
         return ERROR( status, "cmlFreeStatement failure" );
     }
 
+    {
+        std::vector<std::string> bindVars;
+        bindVars.push_back( objIdString );
+        bindVars.push_back( nextRepl );
+        status = applyQuotaUsageForReplicas(
+                     "R_DATA_MAIN.data_id = ? and R_DATA_MAIN.data_repl_num = ?",
+                     bindVars, 1 );
+    }
+    if ( status != 0 ) {
+        log_db::info("chlRegReplica quota usage update failure {}", status);
+        _rollback( "chlRegReplica" );
+        return ERROR( status, "chlRegReplica quota usage update failure" );
+    }
+
     status =  cmlExecuteNoAnswerSql( "commit", &icss );
     if ( status != 0 ) {
         log_db::info("chlRegReplica cmlExecuteNoAnswerSql commit failure {}", status);
@@ -3290,6 +3512,25 @@ irods::error db_unreg_replica_op(
         }
     }
 
+    {
+        std::vector<std::string> bindVars;
+        bindVars.push_back( logicalDirName );
+        bindVars.push_back( logicalFileName );
+        if ( _data_obj_info->replNum >= 0 ) {
+            bindVars.push_back( std::to_string( _data_obj_info->replNum ) );
+        }
+        status = applyQuotaUsageForReplicas(
+                     _data_obj_info->replNum >= 0 ?
+                     "R_DATA_MAIN.coll_id=(select coll_id from R_COLL_MAIN where coll_name=?) and R_DATA_MAIN.data_name=? and R_DATA_MAIN.data_repl_num=?" :
+                     "R_DATA_MAIN.coll_id=(select coll_id from R_COLL_MAIN where coll_name=?) and R_DATA_MAIN.data_name=?",
+                     bindVars, -1 );
+        if ( status != 0 ) {
+            log_db::info("chlUnregDataObj quota usage update failure {}", status);
+            _rollback( "chlUnregDataObj" );
+            return ERROR( status, "chlUnregDataObj quota usage update failure" );
+        }
+    }
+
     cllBindVars[0] = logicalDirName;
     cllBindVars[1] = logicalFileName;
     if ( _data_obj_info->replNum >= 0 ) {
@@ -3355,13 +3596,19 @@ irods::error db_unreg_replica_op(
                            "[{}:{}] - failed to remove associated AVUs [ec=[{}]]",
                            __func__, __LINE__, ec));
             }
+
+            // That was the last replica, so the data object no longer exists.
+            irods::access_check_cache::erase(_data_obj_info->objPath);
+            irods::access_check_cache::erase(dataObjNumber);
         }
     }
 
-    status =  cmlExecuteNoAnswerSql( "commit", &icss );
-    if ( status != 0 ) {
-        log_db::info("chlUnregDataObj cmlExecuteNoAnswerSql commit failure {}", status);
-        return ERROR( status, "cmlExecuteNoAnswerSql commit failure" );
+    if ( !( _data_obj_info->flags & NO_COMMIT_FLAG ) ) {
+        status =  cmlExecuteNoAnswerSql( "commit", &icss );
+        if ( status != 0 ) {
+            log_db::info("chlUnregDataObj cmlExecuteNoAnswerSql commit failure {}", status);
+            return ERROR( status, "cmlExecuteNoAnswerSql commit failure" );
+        }
     }
 
     return SUCCESS();
@@ -4235,6 +4482,9 @@ irods::error db_rollback_op(
         return PASS( ret );
     }
 
+    // Cached permission checks may no longer hold once this operation has run.
+    irods::at_scope_exit clear_access_checks{[] { irods::access_check_cache::clear(); }};
+
     // =-=-=-=-=-=-=-
     // get a postgres object from the context
     /*irods::postgres_object_ptr pg;
@@ -4311,6 +4561,9 @@ irods::error db_del_user_re_op(
         return PASS( ret );
     }
 
+    // Cached permission checks may no longer hold once this operation has run.
+    irods::at_scope_exit clear_access_checks{[] { irods::access_check_cache::clear(); }};
+
     // =-=-=-=-=-=-=-
     // check the params
     if (
@@ -5355,6 +5608,9 @@ irods::error db_rename_coll_op(
         return PASS( ret );
     }
 
+    // Cached permission checks may no longer hold once this operation has run.
+    irods::at_scope_exit clear_access_checks{[] { irods::access_check_cache::clear(); }};
+
     // =-=-=-=-=-=-=-
     // check the params
     if (
@@ -5421,6 +5677,9 @@ irods::error db_mod_zone_coll_acl_op(
         return PASS( ret );
     }
 
+    // Cached permission checks may no longer hold once this operation has run.
+    irods::at_scope_exit clear_access_checks{[] { irods::access_check_cache::clear(); }};
+
     // =-=-=-=-=-=-=-
     // check the params
     if (
@@ -5479,6 +5738,9 @@ irods::error db_rename_local_zone_op(
         return PASS( ret );
     }
 
+    // Cached permission checks may no longer hold once this operation has run.
+    irods::at_scope_exit clear_access_checks{[] { irods::access_check_cache::clear(); }};
+
     // =-=-=-=-=-=-=-
     // check the params
     if (
@@ -5659,6 +5921,9 @@ irods::error db_del_zone_op(
         return PASS( ret );
     }
 
+    // Cached permission checks may no longer hold once this operation has run.
+    irods::at_scope_exit clear_access_checks{[] { irods::access_check_cache::clear(); }};
+
     // =-=-=-=-=-=-=-
     // check the params
     if (
@@ -6191,6 +6456,9 @@ irods::error db_del_coll_by_admin_op(
         return ERROR( CAT_UNKNOWN_COLLECTION, "unknown collection" );
     }
 
+    irods::access_check_cache::erase(_coll_info->collName);
+    irods::access_check_cache::erase(collIdNum);
+
     return SUCCESS();
 
 } // db_del_coll_by_admin_op
@@ -7305,6 +7573,9 @@ irods::error db_mod_user_op(
         return PASS( ret );
     }
 
+    // Cached permission checks may no longer hold once this operation has run.
+    irods::at_scope_exit clear_access_checks{[] { irods::access_check_cache::clear(); }};
+
     // =-=-=-=-=-=-=-
     // check the params
     if (
@@ -7638,6 +7909,9 @@ irods::error db_mod_group_op(
         return PASS( ret );
     }
 
+    // Cached permission checks may no longer hold once this operation has run.
+    irods::at_scope_exit clear_access_checks{[] { irods::access_check_cache::clear(); }};
+
     // =-=-=-=-=-=-=-
     // check the params
     if (
@@ -10038,6 +10312,9 @@ irods::error db_mod_access_control_op(
         return PASS( ret );
     }
 
+    // Cached permission checks may no longer hold once this operation has run.
+    irods::at_scope_exit clear_access_checks{[] { irods::access_check_cache::clear(); }};
+
     if ( logSQL != 0 ) {
         log_sql::debug("chlModAccessControl");
     }
@@ -10594,6 +10871,9 @@ irods::error db_rename_object_op(
         return PASS( ret );
     }
 
+    // Cached permission checks may no longer hold once this operation has run.
+    irods::at_scope_exit clear_access_checks{[] { irods::access_check_cache::clear(); }};
+
     // =-=-=-=-=-=-=-
     // get a postgres object from the context
     /*irods::postgres_object_ptr pg;
@@ -10925,6 +11205,9 @@ irods::error db_move_object_op(
         return PASS( ret );
     }
 
+    // Cached permission checks may no longer hold once this operation has run.
+    irods::at_scope_exit clear_access_checks{[] { irods::access_check_cache::clear(); }};
+
     // =-=-=-=-=-=-=-
     // get a postgres object from the context
     /*irods::postgres_object_ptr pg;
@@ -11935,34 +12218,76 @@ irods::error db_calc_usage_and_quota_op(
 
     log_db::info("chlCalcUsageAndQuota called");
 
-    getNowStr( myTime );
-
-    /* Delete the old rows from R_QUOTA_USAGE */
-    if ( logSQL != 0 ) {
-        log_sql::debug("chlCalcUsageAndQuota SQL 1");
+    /* Recompute the usage one resource at a time, each in its own
+     * transaction, so that the replica operations maintaining
+     * R_QUOTA_USAGE incrementally are only held up for the duration of
+     * a single resource's aggregation rather than the whole catalog's. */
+    std::vector<std::string> rescIds;
+    {
+        int statementNum = UNINITIALIZED_STATEMENT_NUMBER;
+        std::vector<std::string> bindVars;
+        if ( logSQL != 0 ) {
+            log_sql::debug("chlCalcUsageAndQuota SQL 1");
+        }
+        status = cmlGetFirstRowFromSqlBV( "select resc_id from R_RESC_MAIN",
+                                          bindVars, &statementNum, &icss );
+        while ( status == 0 ) {
+            rescIds.push_back( icss.stmtPtr[statementNum]->resultValue[0] );
+            status = cmlGetNextRowFromStatement( statementNum, &icss );
+        }
+        if ( status != CAT_NO_ROWS_FOUND ) {
+            _rollback( "chlCalcUsageAndQuota" );
+            return ERROR( status, "select resources failed" );
+        }
     }
-    cllBindVars[cllBindVarCount++] = myTime;
-    status =  cmlExecuteNoAnswerSql(
-                  "delete from R_QUOTA_USAGE where modify_ts < ?", &icss );
-    if ( status != 0 && status != CAT_SUCCESS_BUT_WITH_NO_INFO ) {
-        _rollback( "chlCalcUsageAndQuota" );
-        return ERROR( status, "delete failed" );
+
+    for ( const auto& rescId : rescIds ) {
+        getNowStr( myTime );
+
+        /* Delete the old rows from R_QUOTA_USAGE for this resource */
+        if ( logSQL != 0 ) {
+            log_sql::debug("chlCalcUsageAndQuota SQL 2");
+        }
+        cllBindVars[cllBindVarCount++] = rescId.c_str();
+        status =  cmlExecuteNoAnswerSql(
+                      "delete from R_QUOTA_USAGE where resc_id = ?", &icss );
+        if ( status != 0 && status != CAT_SUCCESS_BUT_WITH_NO_INFO ) {
+            _rollback( "chlCalcUsageAndQuota" );
+            return ERROR( status, "delete failed" );
+        }
+
+        /* Add a row to R_QUOTA_USAGE for each user's usage on this resource */
+        if ( logSQL != 0 ) {
+            log_sql::debug("chlCalcUsageAndQuota SQL 3");
+        }
+        cllBindVars[cllBindVarCount++] = myTime;
+        cllBindVars[cllBindVarCount++] = rescId.c_str();
+        status =  cmlExecuteNoAnswerSql(
+                      "insert into R_QUOTA_USAGE (quota_usage, resc_id, user_id, modify_ts) (select sum(R_DATA_MAIN.data_size), R_DATA_MAIN.resc_id, R_USER_MAIN.user_id, ? from R_DATA_MAIN, R_USER_MAIN where R_USER_MAIN.user_name = R_DATA_MAIN.data_owner_name and R_USER_MAIN.zone_name = R_DATA_MAIN.data_owner_zone and R_DATA_MAIN.resc_id = ? group by R_DATA_MAIN.resc_id, R_USER_MAIN.user_id)",
+                      &icss );
+        if ( status == CAT_SUCCESS_BUT_WITH_NO_INFO ) {
+            status = 0;    /* no files, OK */
+        }
+        if ( status != 0 ) {
+            _rollback( "chlCalcUsageAndQuota" );
+            return ERROR( status, "insert failed" );
+        }
+
+        status =  cmlExecuteNoAnswerSql( "commit", &icss );
+        if ( status < 0 ) {
+            return ERROR( status, "commit failed" );
+        }
     }
 
-    /* Add a row to R_QUOTA_USAGE for each user's usage on each resource */
+    /* Delete the rows left behind by resources that no longer exist */
     if ( logSQL != 0 ) {
-        log_sql::debug("chlCalcUsageAndQuota SQL 2");
+        log_sql::debug("chlCalcUsageAndQuota SQL 4");
     }
-    cllBindVars[cllBindVarCount++] = myTime;
     status =  cmlExecuteNoAnswerSql(
-                  "insert into R_QUOTA_USAGE (quota_usage, resc_id, user_id, modify_ts) (select sum(R_DATA_MAIN.data_size), R_RESC_MAIN.resc_id, R_USER_MAIN.user_id, ? from R_DATA_MAIN, R_USER_MAIN, R_RESC_MAIN where R_USER_MAIN.user_name = R_DATA_MAIN.data_owner_name and R_USER_MAIN.zone_name = R_DATA_MAIN.data_owner_zone and R_RESC_MAIN.resc_id = R_DATA_MAIN.resc_id group by R_RESC_MAIN.resc_id, user_id)",
-                  &icss );
-    if ( status == CAT_SUCCESS_BUT_WITH_NO_INFO ) {
-        status = 0;    /* no files, OK */
-    }
-    if ( status != 0 ) {
+                  "delete from R_QUOTA_USAGE where resc_id not in (select resc_id from R_RESC_MAIN)", &icss );
+    if ( status != 0 && status != CAT_SUCCESS_BUT_WITH_NO_INFO ) {
         _rollback( "chlCalcUsageAndQuota" );
-        return ERROR( status, "insert failed" );
+        return ERROR( status, "delete failed" );
     }
 
     /* Set the over_quota flags where appropriate */
@@ -15271,6 +15596,9 @@ irods::error db_general_update_op(
         return PASS( ret );
     }
 
+    // Cached permission checks may no longer hold once this operation has run.
+    irods::at_scope_exit clear_access_checks{[] { irods::access_check_cache::clear(); }};
+
     // =-=-=-=-=-=-=-
     // check the params
     if ( !_update_inp ) {
@@ -15408,7 +15736,7 @@ auto db_get_delay_rule_info_op(irods::plugin_context& _ctx, const char* _rule_id
     log_db::debug("{}: _rule_id => [{}]", __func__, _rule_id);
 
     try {
-        auto [db_instance, db_conn] = irods::experimental::catalog::new_database_connection();
+        auto [db_instance, db_conn] = irods::experimental::catalog::get_database_connection();
 
         nanodbc::statement stmt{db_conn};
         nanodbc::prepare(stmt,
@@ -15440,6 +15768,148 @@ auto db_get_delay_rule_info_op(irods::plugin_context& _ctx, const char* _rule_id
     }
 } // db_get_delay_rule_info_op
 
+auto db_get_data_object_open_plan_op(irods::plugin_context& _ctx,
+                                     const char* _logical_path,
+                                     const char* _access_level,
+                                     std::string* _plan) -> irods::error
+{
+    using json = nlohmann::json;
+
+    if (const auto ret = _ctx.valid(); !ret.ok()) {
+        return PASS(ret);
+    }
+
+    if (!_logical_path || !_access_level || !_plan) {
+        return ERROR(SYS_INVALID_INPUT_PARAM, "Invalid input: logical path, access level or plan is null");
+    }
+
+    const auto* comm = _ctx.comm();
+
+    // Tickets and strict access control change which replicas a user may see. Those cases are
+    // left to the general query path, which already knows how to handle them.
+    if (!std::string_view{mySessionTicket}.empty() || accessControlControlFlag > 1 ||
+        std::string_view{comm->clientUser.userName} == ANONYMOUS_USER)
+    {
+        return ERROR(SYS_NOT_SUPPORTED, "Open plan does not apply to ticket or strict access control sessions");
+    }
+
+    const std::string_view logical_path = _logical_path;
+    const auto slash = logical_path.rfind('/');
+
+    if (slash == std::string_view::npos || slash == 0 || slash + 1 == logical_path.size()) {
+        return ERROR(USER_INPUT_PATH_ERR, fmt::format("Invalid logical path [{}]", logical_path));
+    }
+
+    const std::string coll_name{logical_path.substr(0, slash)};
+    const std::string data_name{logical_path.substr(slash + 1)};
+
+    log_db::debug("{}: _logical_path => [{}], _access_level => [{}]", __func__, _logical_path, _access_level);
+
+    // The columns that follow the collection information, in the order they are selected.
+    constexpr std::array<const char*, 17> replica_columns = {"data_repl_num",
+                                                             "data_version",
+                                                             "data_type_name",
+                                                             "data_size",
+                                                             "data_path",
+                                                             "data_owner_name",
+                                                             "data_owner_zone",
+                                                             "data_is_dirty",
+                                                             "data_status",
+                                                             "data_checksum",
+                                                             "data_expiry_ts",
+                                                             "data_map_id",
+                                                             "data_mode",
+                                                             "r_comment",
+                                                             "create_ts",
+                                                             "modify_ts",
+                                                             "resc_id"};
+
+    try {
+        auto [db_instance, db_conn] = irods::experimental::catalog::get_database_connection();
+
+        // A single statement returns the parent collection, whether the logical path names a
+        // collection, every replica of the data object and whether the client has the requested
+        // access. The access check mirrors cmlCheckDataObjId.
+        nanodbc::statement stmt{db_conn};
+        nanodbc::prepare(stmt,
+                         "select c.coll_id, c.coll_type,"
+                         " (select count(*) from R_COLL_MAIN where coll_name = ?),"
+                         " d.data_id,"
+                         " d.data_repl_num, d.data_version, d.data_type_name, d.data_size, d.data_path,"
+                         " d.data_owner_name, d.data_owner_zone, d.data_is_dirty, d.data_status, d.data_checksum,"
+                         " d.data_expiry_ts, d.data_map_id, d.data_mode, d.r_comment, d.create_ts, d.modify_ts,"
+                         " d.resc_id,"
+                         " case when exists (select OA.object_id"
+                         "  from R_OBJT_ACCESS OA, R_USER_GROUP UG, R_USER_MAIN UM, R_TOKN_MAIN TM"
+                         "  where OA.object_id = d.data_id and UM.user_name = ? and UM.zone_name = ?"
+                         "  and UM.user_type_name != 'rodsgroup' and UM.user_id = UG.user_id"
+                         "  and UG.group_user_id = OA.user_id and OA.access_type_id >= TM.token_id"
+                         "  and TM.token_namespace = 'access_type' and TM.token_name = ?) then 1 else 0 end "
+                         "from R_COLL_MAIN c left join R_DATA_MAIN d on d.coll_id = c.coll_id and d.data_name = ? "
+                         "where c.coll_name = ? "
+                         "order by d.data_repl_num");
+
+        const std::string logical_path_string{logical_path};
+
+        stmt.bind(0, logical_path_string.c_str());
+        stmt.bind(1, comm->clientUser.userName);
+        stmt.bind(2, comm->clientUser.rodsZone);
+        stmt.bind(3, _access_level);
+        stmt.bind(4, data_name.c_str());
+        stmt.bind(5, coll_name.c_str());
+
+        auto row = nanodbc::execute(stmt);
+
+        json plan{{"collection", nullptr}, {"is_collection", false}, {"permission_granted", false}};
+        auto& replicas = plan["replicas"] = json::array();
+
+        constexpr auto data_id_column = 3;
+        constexpr auto first_replica_column = data_id_column + 1;
+        constexpr auto permission_column = first_replica_column + static_cast<short>(replica_columns.size());
+
+        while (row.next()) {
+            if (plan.at("collection").is_null()) {
+                plan["collection"] = {{"coll_id", row.get<std::string>(0)}, {"coll_type", row.get<std::string>(1, "")}};
+                plan["is_collection"] = row.get<std::string>(2, "0") != "0";
+            }
+
+            // The parent collection exists but does not contain the data object.
+            if (row.is_null(data_id_column)) {
+                break;
+            }
+
+            json replica{{"data_id", row.get<std::string>(data_id_column)}, {"coll_id", row.get<std::string>(0)}};
+
+            for (short i = 0; i < static_cast<short>(replica_columns.size()); ++i) {
+                replica[replica_columns[i]] = row.get<std::string>(first_replica_column + i, "");
+            }
+
+            plan["permission_granted"] = row.get<std::string>(permission_column, "0") == "1";
+            replicas.push_back(std::move(replica));
+        }
+
+        // Later checks of the same data object, e.g. after hierarchy resolution, can now be answered
+        // from the cache.
+        if (!replicas.empty() && plan.at("permission_granted").get<bool>()) {
+            const auto& data_id = replicas.front().at("data_id").get_ref<const std::string&>();
+            irods::access_check_cache::insert(
+                {irods::access_check_cache::check_type::data_object_id,
+                 data_id,
+                 comm->clientUser.userName,
+                 comm->clientUser.rodsZone,
+                 _access_level},
+                {std::stoll(data_id), -1});
+        }
+
+        *_plan = plan.dump();
+
+        return SUCCESS();
+    }
+    catch (const std::exception& e) {
+        return ERROR(SYS_LIBRARY_ERROR, e.what());
+    }
+} // db_get_data_object_open_plan_op
+
 auto db_data_object_finalize_op(irods::plugin_context& _ctx, const char* _json_input) -> irods::error
 {
     using json = nlohmann::json;
@@ -15466,6 +15936,9 @@ auto db_data_object_finalize_op(irods::plugin_context& _ctx, const char* _json_i
                                                           "modify_ts",
                                                           "resc_id"};
 
+    constexpr std::array<const char*, 4> quota_usage_columns = {
+        "data_size", "data_owner_name", "data_owner_zone", "resc_id"};
+
     try {
         auto input = json::parse(_json_input);
 
@@ -15499,6 +15972,24 @@ auto db_data_object_finalize_op(irods::plugin_context& _ctx, const char* _json_i
                 }
             }
 
+            // If the size, location or owner of the replica changes, move its usage out of the quota
+            // accounting; it is added back below once the row reflects the change.
+            const auto quota_usage_affected = std::any_of(
+                std::begin(quota_usage_columns), std::end(quota_usage_columns), [&](const char* _c) {
+                    return before.at(_c) != after.at(_c);
+                });
+
+            if (quota_usage_affected) {
+                std::vector<std::string> bindVars{get_json_string_value(before, "data_id"),
+                                                  get_json_string_value(before, "resc_id")};
+                if (const auto ec = applyQuotaUsageForReplicas(
+                        "R_DATA_MAIN.data_id = ? and R_DATA_MAIN.resc_id = ?", bindVars, -1);
+                    0 != ec) {
+                    _rollback("data_object_finalize");
+                    return ERROR(ec, "quota usage update failure");
+                }
+            }
+
             std::string sql = "update R_DATA_MAIN set";
 
             for (const auto& c : column_names) {
@@ -15564,6 +16055,17 @@ auto db_data_object_finalize_op(irods::plugin_context& _ctx, const char* _json_i
 
                 return ERROR(ec, std::move(msg));
             }
+
+            if (quota_usage_affected) {
+                std::vector<std::string> bindVars{get_json_string_value(before, "data_id"),
+                                                  get_json_string_value(after, "resc_id")};
+                if (const auto ec = applyQuotaUsageForReplicas(
+                        "R_DATA_MAIN.data_id = ? and R_DATA_MAIN.resc_id = ?", bindVars, 1);
+                    0 != ec) {
+                    _rollback("data_object_finalize");
+                    return ERROR(ec, "quota usage update failure");
+                }
+            }
         }
 
         // If everything executed successfully above, we commit all of the changes here, which fulfills the atomicity of
@@ -15627,7 +16129,7 @@ auto db_check_auth_credentials_op(irods::plugin_context& _ctx,
     icatScramble(decoded_password.data());
 
     try {
-        auto [db_instance, db_conn] = irods::experimental::catalog::new_database_connection();
+        auto [db_instance, db_conn] = irods::experimental::catalog::get_database_connection();
 
         nanodbc::statement stmt{db_conn};
         nanodbc::prepare(stmt,
@@ -16072,6 +16574,9 @@ irods::database* plugin_factory(
     pg->add_operation<const char*, const char*, const char*, int*>(
         DATABASE_OP_CHECK_AUTH_CREDENTIALS,
         function<error(plugin_context&, const char*, const char*, const char*, int*)>(db_check_auth_credentials_op));
+    pg->add_operation<const char*, const char*, std::string*>(
+        DATABASE_OP_GET_DATA_OBJECT_OPEN_PLAN,
+        function<error(plugin_context&, const char*, const char*, std::string*)>(db_get_data_object_open_plan_op));
 
     return pg;
 
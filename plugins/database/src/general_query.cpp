@@ -33,6 +33,7 @@
 
 #include <string>
 #include <algorithm>
+#include <vector>
 
 extern int logSQLGenQuery;
 
@@ -764,149 +765,137 @@ int setTable( int column, int sel, int selectOption, int castOption ) {
 }
 
 /*
- When there are multiple AVU conditions, need to adjust the SQL.
+ The part of whereSQL, and of the bind variables, that was generated
+ for one AVU name or value condition.
  */
-void
-handleMultiDataAVUConditions( int nConditions ) {
-    int i;
-    char *firstItem, *nextItem;
-    char nextStr[20];
-
-    /* In the whereSQL, change r_data_meta_main.meta_attr_name to
-       r_data_meta_mnNN.meta_attr_name, where NN is index.  First one
-       is OK, subsequent ones need a new name for each. */
-    firstItem = strstr( whereSQL, "r_data_meta_main.meta_attr_name" );
-    if ( firstItem != NULL ) {
-        *firstItem = 'x'; /* temporarily change 1st string */
-    }
-    for ( i = 2; i <= nConditions; i++ ) {
-        nextItem = strstr( whereSQL, "r_data_meta_main.meta_attr_name" );
-        if ( nextItem != NULL ) {
-            snprintf( nextStr, sizeof nextStr, "n%2.2d", i );
-            *( nextItem + 13 ) = nextStr[0]; /* replace "ain" in main */
-            *( nextItem + 14 ) = nextStr[1]; /* with nNN */
-            *( nextItem + 15 ) = nextStr[2];
-        }
-    }
-    if ( firstItem != NULL ) {
-        *firstItem = 'r'; /* put it back */
-    }
-
-    /* Do similar for r_data_meta_main.meta_attr_value.  */
-    firstItem = strstr( whereSQL, "r_data_meta_main.meta_attr_value" );
-    if ( firstItem != NULL ) {
-        *firstItem = 'x'; /* temporarily change 1st string */
-    }
-    for ( i = 2; i <= nConditions; i++ ) {
-        nextItem = strstr( whereSQL, "r_data_meta_main.meta_attr_value" );
-        if ( nextItem != NULL ) {
-            snprintf( nextStr, sizeof nextStr, "n%2.2d", i );
-            *( nextItem + 13 ) = nextStr[0]; /* replace "ain" in main */
-            *( nextItem + 14 ) = nextStr[1]; /* with nNN */
-            *( nextItem + 15 ) = nextStr[2];
-        }
-    }
-    if ( firstItem != NULL ) {
-        *firstItem = 'r'; /* put it back */
-    }
-
-
-    /* In the fromSQL, add items for r_data_metamapNN and
-       r_data_meta_mnNN */
-    for ( i = 2; i <= nConditions; i++ ) {
-        char newStr[100];
-        snprintf( newStr, sizeof newStr,
-                  ", R_OBJT_METAMAP r_data_metamap%d, R_META_MAIN r_data_meta_mn%2.2d ",
-                  i, i );
-        if ( !rstrcat( fromSQL, newStr, MAX_SQL_SIZE_GQ ) ) { return; }
-    }
-
-    /* In the whereSQL, add items for
-       r_data_metamapNN.meta_id = r_data_meta_maNN.meta_id  and
-       R_DATA_MAIN.data_id = r_data_metamap2.object_id
-    */
-    for ( i = 2; i <= nConditions; i++ ) {
-        char newStr[100];
-        snprintf( newStr, sizeof newStr,
-                  " AND r_data_metamap%d.meta_id = r_data_meta_mn%2.2d.meta_id", i, i );
-        if ( !rstrcat( whereSQL, newStr, MAX_SQL_SIZE_GQ ) ) { return; }
-        snprintf( newStr, sizeof newStr,
-                  " AND R_DATA_MAIN.data_id = r_data_metamap%d.object_id ", i );
-        if ( !rstrcat( whereSQL, newStr, MAX_SQL_SIZE_GQ ) ) { return; }
-    }
-}
+struct avuConditionSpan {
+    int column;
+    size_t start;      /* offset of the condition in whereSQL */
+    size_t end;
+    int firstBindVar;  /* range of the condition in cllBindVars */
+    int endBindVar;
+};
 
 /*
- When there are multiple AVU conditions on Collections, need to adjust the SQL.
+ When there are multiple AVU conditions, need to adjust the SQL.
+
+ The Nth name condition and the Nth value condition refer to the same
+ AVU.  The first AVU is matched through the tables already joined by
+ tScan.  Every further AVU used to get its own self-join of
+ R_OBJT_METAMAP and R_META_MAIN, which multiplies the intermediate rows
+ and forces the join order.  Instead, each further AVU is moved into a
+ semi-join of the form
+
+   AND R_DATA_MAIN.data_id in (select r_data_metamap2.object_id
+       from R_OBJT_METAMAP r_data_metamap2, R_META_MAIN r_data_meta_mn02
+       where r_data_metamap2.meta_id = r_data_meta_mn02.meta_id
+       AND r_data_meta_mn02.meta_attr_name = ? ...)
+
+ so the database can evaluate the most selective condition first and
+ probe the others with the meta_attr_name, meta_attr_value and
+ (meta_id, object_id) indexes.  The conditions are moved to the end of
+ whereSQL, so their bind variables are moved to the end as well.
  */
-void
-handleMultiCollAVUConditions( int nConditions ) {
-    int i;
-    char *firstItem, *nextItem;
-    char nextStr[20];
-
-    /* In the whereSQL, change r_coll_meta_main.meta_attr_name to
-       r_coll_meta_mnNN.meta_attr_name, where NN is index.  First one
-       is OK, subsequent ones need a new name for each. */
-    firstItem = strstr( whereSQL, "r_coll_meta_main.meta_attr_name" );
-    if ( firstItem != NULL ) {
-        *firstItem = 'x'; /* temporarily change 1st string */
-    }
-    for ( i = 2; i <= nConditions; i++ ) {
-        nextItem = strstr( whereSQL, "r_coll_meta_main.meta_attr_name" );
-        if ( nextItem != NULL ) {
-            snprintf( nextStr, sizeof nextStr, "n%2.2d", i );
-            *( nextItem + 13 ) = nextStr[0]; /* replace "ain" in main */
-            *( nextItem + 14 ) = nextStr[1]; /* with nNN */
-            *( nextItem + 15 ) = nextStr[2];
-        }
-    }
-    if ( firstItem != NULL ) {
-        *firstItem = 'r'; /* put it back */
-    }
-
-    /* Do similar for r_coll_meta_main.meta_attr_value.  */
-    firstItem = strstr( whereSQL, "r_coll_meta_main.meta_attr_value" );
-    if ( firstItem != NULL ) {
-        *firstItem = 'x'; /* temporarily change 1st string */
-    }
-    for ( i = 2; i <= nConditions; i++ ) {
-        nextItem = strstr( whereSQL, "r_coll_meta_main.meta_attr_value" );
-        if ( nextItem != NULL ) {
-            snprintf( nextStr, sizeof nextStr, "n%2.2d", i );
-            *( nextItem + 13 ) = nextStr[0]; /* replace "ain" in main */
-            *( nextItem + 14 ) = nextStr[1]; /* with nNN */
-            *( nextItem + 15 ) = nextStr[2];
-        }
-    }
-    if ( firstItem != NULL ) {
-        *firstItem = 'r'; /* put it back */
-    }
-
-
-    /* In the fromSQL, add items for r_coll_metamapNN and
-       r_coll_meta_mnNN */
-    for ( i = 2; i <= nConditions; i++ ) {
-        char newStr[100];
-        snprintf( newStr, sizeof newStr,
-                  ", R_OBJT_METAMAP r_coll_metamap%d, R_META_MAIN r_coll_meta_mn%2.2d ",
-                  i, i );
-        if ( !rstrcat( fromSQL, newStr, MAX_SQL_SIZE_GQ ) ) { return; }
-    }
-
-    /* In the whereSQL, add items for
-       r_coll_metamapNN.meta_id = r_coll_meta_maNN.meta_id  and
-       R_COLL_MAIN.coll_id = r_coll_metamap2.object_id
-    */
-    for ( i = 2; i <= nConditions; i++ ) {
-        char newStr[100];
-        snprintf( newStr, sizeof newStr,
-                  " AND r_coll_metamap%d.meta_id = r_coll_meta_mn%2.2d.meta_id", i, i );
-        if ( !rstrcat( whereSQL, newStr, MAX_SQL_SIZE_GQ ) ) { return; }
-        snprintf( newStr, sizeof newStr,
-                  " AND R_COLL_MAIN.coll_id = r_coll_metamap%d.object_id ", i );
-        if ( !rstrcat( whereSQL, newStr, MAX_SQL_SIZE_GQ ) ) { return; }
+int
+handleMultiAVUConditions( const std::vector<avuConditionSpan>& spans,
+                          int nameColumn, int valueColumn,
+                          const char *metaMainAlias,  /* e.g. r_data_meta_main */
+                          const char *metaMnPrefix,   /* e.g. r_data_meta_mn */
+                          const char *metamapPrefix,  /* e.g. r_data_metamap */
+                          const char *objectIdColumn ) {
+    /* Assign each span to an AVU; 1 is the first one. */
+    std::vector<int> avuOfSpan( spans.size(), 0 );
+    int nNames = 0;
+    int nValues = 0;
+    int nAvus = 0;
+    for ( size_t i = 0; i < spans.size(); i++ ) {
+        if ( spans[i].column == nameColumn ) {
+            avuOfSpan[i] = ++nNames;
+        }
+        else if ( spans[i].column == valueColumn ) {
+            avuOfSpan[i] = ++nValues;
+        }
+        nAvus = std::max( nAvus, avuOfSpan[i] );
+    }
+
+    if ( nAvus < 2 ) {
+        return 0;
+    }
+
+    /* Remove the conditions of AVUs 2..N from whereSQL, keeping the
+       bind variables of everything else in order. */
+    std::string keptWhere;
+    std::vector<const char*> keptBindVars;
+    size_t whereIx = 0;
+    int bindIx = 0;
+    for ( size_t i = 0; i < spans.size(); i++ ) {
+        if ( avuOfSpan[i] < 2 ) {
+            continue;
+        }
+        keptWhere.append( whereSQL + whereIx, spans[i].start - whereIx );
+        whereIx = spans[i].end;
+        while ( bindIx < spans[i].firstBindVar ) {
+            keptBindVars.push_back( cllBindVars[bindIx++] );
+        }
+        bindIx = spans[i].endBindVar;
+    }
+    keptWhere.append( whereSQL + whereIx );
+    while ( bindIx < cllBindVarCount ) {
+        keptBindVars.push_back( cllBindVars[bindIx++] );
+    }
+
+    /* Append a semi-join for each of AVUs 2..N. */
+    std::vector<const char*> movedBindVars;
+    const std::string mainColumnPrefix = std::string( metaMainAlias ) + ".";
+    for ( int avu = 2; avu <= nAvus; avu++ ) {
+        char metaMn[NAME_LEN];
+        char metamap[NAME_LEN];
+        snprintf( metaMn, sizeof metaMn, "%s%2.2d", metaMnPrefix, avu );
+        snprintf( metamap, sizeof metamap, "%s%d", metamapPrefix, avu );
+
+        keptWhere += " AND ";
+        keptWhere += objectIdColumn;
+        keptWhere += " in (select ";
+        keptWhere += std::string( metamap ) + ".object_id from R_OBJT_METAMAP " + metamap;
+        keptWhere += std::string( ", R_META_MAIN " ) + metaMn;
+        keptWhere += std::string( " where " ) + metamap + ".meta_id = " + metaMn + ".meta_id";
+
+        for ( size_t i = 0; i < spans.size(); i++ ) {
+            if ( avuOfSpan[i] != avu ) {
+                continue;
+            }
+
+            std::string condition( whereSQL + spans[i].start, spans[i].end - spans[i].start );
+            boost::algorithm::trim_left( condition );
+            if ( boost::algorithm::starts_with( condition, "AND " ) ) {
+                condition.erase( 0, 4 );
+            }
+            boost::algorithm::replace_all( condition, mainColumnPrefix, std::string( metaMn ) + "." );
+
+            keptWhere += " AND ";
+            keptWhere += condition;
+
+            for ( int b = spans[i].firstBindVar; b < spans[i].endBindVar; b++ ) {
+                movedBindVars.push_back( cllBindVars[b] );
+            }
+        }
+
+        keptWhere += ")";
+    }
+
+    if ( !rstrcpy( whereSQL, keptWhere.c_str(), MAX_SQL_SIZE_GQ ) ) {
+        return USER_STRLEN_TOOLONG;
+    }
+
+    cllBindVarCount = 0;
+    for ( const char* bindVar : keptBindVars ) {
+        cllBindVars[cllBindVarCount++] = bindVar;
+    }
+    for ( const char* bindVar : movedBindVars ) {
+        cllBindVars[cllBindVarCount++] = bindVar;
     }
+
+    return 0;
 }
 
 /*
@@ -1846,6 +1835,8 @@ generateSQL( genQueryInp_t genQueryInp, char *resultingSQL,
     int N_col_meta_user_attr_name = 0;
     int N_col_meta_resc_attr_name = 0;
     int N_col_meta_resc_group_attr_name = 0;
+    std::vector<avuConditionSpan> dataAvuSpans;
+    std::vector<avuConditionSpan> collAvuSpans;
 
     char combinedSQL[MAX_SQL_SIZE_GQ];
 #if ORA_ICAT
@@ -1918,6 +1909,7 @@ generateSQL( genQueryInp_t genQueryInp, char *resultingSQL,
         char *cptr;
 
         prevWhereLen = strlen( whereSQL );
+        const int prevBindVarCount = cllBindVarCount;
         if ( genQueryInp.sqlCondInp.inx[i] == COL_META_DATA_ATTR_NAME ) {
             N_col_meta_data_attr_name++;
         }
@@ -1974,6 +1966,20 @@ generateSQL( genQueryInp_t genQueryInp, char *resultingSQL,
             }
         }
 
+        switch ( genQueryInp.sqlCondInp.inx[i] ) {
+        case COL_META_DATA_ATTR_NAME:
+        case COL_META_DATA_ATTR_VALUE:
+            dataAvuSpans.push_back( { genQueryInp.sqlCondInp.inx[i], ( size_t ) prevWhereLen, strlen( whereSQL ),
+                                      prevBindVarCount, cllBindVarCount } );
+            break;
+        case COL_META_COLL_ATTR_NAME:
+        case COL_META_COLL_ATTR_VALUE:
+            collAvuSpans.push_back( { genQueryInp.sqlCondInp.inx[i], ( size_t ) prevWhereLen, strlen( whereSQL ),
+                                      prevBindVarCount, cllBindVarCount } );
+            break;
+        default:
+            break;
+        }
     }
 
     keepVal = tScan( startingTable, -1 );
@@ -1989,12 +1995,22 @@ generateSQL( genQueryInp_t genQueryInp, char *resultingSQL,
 
     if ( N_col_meta_data_attr_name > 1 ) {
         /* Make some special changes & additions for multi AVU query - data */
-        handleMultiDataAVUConditions( N_col_meta_data_attr_name );
+        status = handleMultiAVUConditions( dataAvuSpans, COL_META_DATA_ATTR_NAME, COL_META_DATA_ATTR_VALUE,
+                                           "r_data_meta_main", "r_data_meta_mn", "r_data_metamap",
+                                           "R_DATA_MAIN.data_id" );
+        if ( status ) {
+            return status;
+        }
     }
 
     if ( N_col_meta_coll_attr_name > 1 ) {
         /* Make some special changes & additions for multi AVU query - collections */
-        handleMultiCollAVUConditions( N_col_meta_coll_attr_name );
+        status = handleMultiAVUConditions( collAvuSpans, COL_META_COLL_ATTR_NAME, COL_META_COLL_ATTR_VALUE,
+                                           "r_coll_meta_main", "r_coll_meta_mn", "r_coll_metamap",
+                                           "R_COLL_MAIN.coll_id" );
+        if ( status ) {
+            return status;
+        }
     }
 
     if ( N_col_meta_user_attr_name > 1 ) {
@@ -13,14 +13,17 @@
 
 #include "irods/private/mid_level.hpp"
 #include "irods/private/low_level.hpp"
+#include "irods/access_check_cache.hpp"
 #include "irods/irods_stacktrace.hpp"
 #include "irods/irods_log.hpp"
 #include "irods/irods_virtual_path.hpp"
 #include "irods/rodsErrorTable.h"
 #include "irods/rcMisc.h"
 
-#include <vector>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <vector>
 
 #include <boost/filesystem.hpp>
 
@@ -29,6 +32,22 @@
 
 extern int logSQL_CML;
 
+namespace acc = irods::access_check_cache;
+
+namespace
+{
+    auto make_logical_path(std::string_view _coll_name, std::string_view _data_name) -> std::string
+    {
+        std::string path{_coll_name};
+
+        if (path.empty() || path.back() != '/') {
+            path += '/';
+        }
+
+        return path.append(_data_name);
+    } // make_logical_path
+} // anonymous namespace
+
 int checkObjIdByTicket( const char *dataId, const char *accessLevel,
                         const char *ticketStr, const char *ticketHost,
                         const char *userName, const char *userZone,
@@ -861,6 +880,12 @@ cmlCheckDir(const char *dirName,
         return (status < 0) ? CAT_UNKNOWN_COLLECTION : iVal;
     }
 
+    acc::key key{acc::check_type::collection, dirName, userName, userZone, accessLevel};
+
+    if (const auto cached = acc::lookup(key); cached) {
+        return cached->object_id;
+    }
+
     bindVars.push_back( dirName );
     bindVars.push_back( userName );
     bindVars.push_back( userZone );
@@ -901,6 +926,9 @@ cmlCheckDir(const char *dirName,
         return CAT_NO_ACCESS_PERMISSION;
     }
 
+    // The inheritance flag was not read, so it is recorded as unknown.
+    acc::insert(std::move(key), {iVal, -1});
+
     return iVal;
 }
 
@@ -930,7 +958,21 @@ cmlCheckDirAndGetInheritFlag( const char *dirName, const char *userName, const c
 
     *inheritFlag = 0;
 
-    if ( ticketStr != NULL && *ticketStr != '\0' ) {
+    const bool use_ticket = ticketStr != NULL && *ticketStr != '\0';
+
+    // Ticket checks are never cached. They update the ticket's use count.
+    std::optional<acc::key> key;
+
+    if ( !use_ticket ) {
+        key.emplace(acc::key{acc::check_type::collection, dirName, userName, userZone, accessLevel});
+
+        if (const auto cached = acc::lookup(*key); cached && cached->inherit_flag >= 0) {
+            *inheritFlag = cached->inherit_flag;
+            return cached->object_id;
+        }
+    }
+
+    if ( use_ticket ) {
         if ( logSQL_CML != 0 ) {
             rodsLog( LOG_SQL, "cmlCheckDirAndGetInheritFlag SQL 1 " );
         }
@@ -985,7 +1027,7 @@ cmlCheckDirAndGetInheritFlag( const char *dirName, const char *userName, const c
     /*
      Also check the other aspects ticket at this point.
      */
-    if ( ticketStr != NULL && *ticketStr != '\0' ) {
+    if ( use_ticket ) {
         status = checkObjIdByTicket( cValStr1, accessLevel, ticketStr,
                                      ticketHost, userName, userZone,
                                      icss );
@@ -993,6 +1035,9 @@ cmlCheckDirAndGetInheritFlag( const char *dirName, const char *userName, const c
             return status;
         }
     }
+    else {
+        acc::insert(std::move(*key), {iVal, *inheritFlag});
+    }
 
     return iVal;
 
@@ -1009,6 +1054,12 @@ cmlCheckDirId( const char *dirId, const char *userName, const char *userZone,
     int status;
     rodsLong_t iVal;
 
+    acc::key key{acc::check_type::collection_id, dirId, userName, userZone, accessLevel};
+
+    if (acc::lookup(key)) {
+        return 0;
+    }
+
     if ( logSQL_CML != 0 ) {
         rodsLog( LOG_SQL, "cmlCheckDirId S-Q-L 1 " );
     }
@@ -1040,6 +1091,8 @@ cmlCheckDirId( const char *dirId, const char *userName, const char *userZone,
         return CAT_NO_ACCESS_PERMISSION;
     }
 
+    acc::insert(std::move(key), {iVal, -1});
+
     return 0;
 }
 
@@ -1105,6 +1158,12 @@ cmlCheckDataObjOnly(const char *dirName, const char *dataName,
         return (status < 0) ? CAT_UNKNOWN_FILE : iVal;
     }
 
+    acc::key key{acc::check_type::data_object, make_logical_path(dirName, dataName), userName, userZone, accessLevel};
+
+    if (const auto cached = acc::lookup(key); cached) {
+        return cached->object_id;
+    }
+
     bindVars.push_back( dataName );
     bindVars.push_back( dirName );
     bindVars.push_back( userName );
@@ -1149,6 +1208,8 @@ cmlCheckDataObjOnly(const char *dirName, const char *dataName,
         return CAT_NO_ACCESS_PERMISSION;
     }
 
+    acc::insert(std::move(key), {iVal, -1});
+
     return iVal;
 }
 
@@ -1201,6 +1262,13 @@ int cmlCheckUserInGroup( const char *userName, const char *userZone,
     char sVal[MAX_NAME_LEN];
     rodsLong_t iVal;
 
+    acc::key key{acc::check_type::group_membership, groupName, userName, userZone, ""};
+
+    // A cached membership saves both of the queries below.
+    if (acc::lookup(key, 2)) {
+        return 0;
+    }
+
     if ( logSQL_CML != 0 ) {
         rodsLog( LOG_SQL, "cmlCheckUserInGroup SQL 1 " );
     }
@@ -1231,6 +1299,9 @@ int cmlCheckUserInGroup( const char *userName, const char *userZone,
     if ( status ) {
         return status;
     }
+
+    acc::insert(std::move(key), {iVal, -1});
+
     return 0;
 }
 
@@ -1701,6 +1772,12 @@ int cmlCheckDataObjId( const char *dataId, const char *userName,  const char *zo
         }
     }
     else {
+        acc::key key{acc::check_type::data_object_id, dataId, userName, zoneName, accessLevel};
+
+        if (acc::lookup(key)) {
+            return 0;
+        }
+
         if ( logSQL_CML != 0 ) {
             rodsLog( LOG_SQL, "cmlCheckDataObjId SQL 1 " );
         }
@@ -1717,6 +1794,9 @@ int cmlCheckDataObjId( const char *dataId, const char *userName,  const char *zo
         if ( iVal == 0 ) {
             return CAT_NO_ACCESS_PERMISSION;
         }
+        if ( status == 0 ) {
+            acc::insert(std::move(key), {iVal, -1});
+        }
     }
     if ( status != 0 ) {
         return CAT_NO_ACCESS_PERMISSION;
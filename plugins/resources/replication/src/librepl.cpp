@@ -684,7 +684,7 @@ irods::error repl_file_read(
             result = PASSMSG( msg.str(), ret );
         }
         else {
-            ret = child->call<void*, const int>( _ctx.comm(), irods::RESOURCE_OP_READ, _ctx.fco(), _buf, _len );
+            ret = child->call<void*, const int>( _ctx.comm(), irods::RESOURCE_OP_READ_INDEX, _ctx.fco(), _buf, _len );
             if ( !ret.ok() ) {
                 std::stringstream msg;
                 msg << __FUNCTION__;
@@ -729,7 +729,8 @@ irods::error repl_file_write(
             result = PASSMSG( msg.str(), ret );
         }
         else {
-            ret = child->call<const void*, const int>( _ctx.comm(), irods::RESOURCE_OP_WRITE, _ctx.fco(), _buf, _len );
+            ret = child->call<const void*, const int>( _ctx.comm(), irods::RESOURCE_OP_WRITE_INDEX,
+                                                       _ctx.fco(), _buf, _len );
             if ( !ret.ok() ) {
                 std::stringstream msg;
                 msg << __FUNCTION__;
@@ -1,9 +1,15 @@
+// irods_query.hpp is pulled in by several of the headers below, so the
+// server-side API must be enabled before any of them.
+#define IRODS_QUERY_ENABLE_SERVER_SIDE_API
+#include "irods/irods_query.hpp"
+
 #include "irods/dataObjOpr.hpp"
 #include "irods/dataObjRepl.h"
 #include "irods/finalize_utilities.hpp"
 #include "irods/generalAdmin.h"
 #include "irods/irods_at_scope_exit.hpp"
 #include "irods/irods_collection_object.hpp"
+#include "irods/irods_configuration_keywords.hpp"
 #include "irods/irods_file_object.hpp"
 #include "irods/irods_hierarchy_parser.hpp"
 #include "irods/irods_kvp_string_parser.hpp"
@@ -18,12 +24,16 @@
 #include "irods/miscServerFunct.hpp"
 #include "irods/msParam.h"
 #include "irods/physPath.hpp"
+#include "irods/modAVUMetadata.h"
 #include "irods/reIn2p3SysRule.hpp"
 #include "irods/replica_proxy.hpp"
 #include "irods/rsDataObjClose.hpp"
 #include "irods/rsDataObjOpen.hpp"
+#include "irods/rsDataObjTrim.hpp"
 #include "irods/rsFileStageToCache.hpp"
 #include "irods/rsFileSyncToArch.hpp"
+#include "irods/rsGlobalExtern.hpp"
+#include "irods/rsModAVUMetadata.hpp"
 #include "irods/scoped_client_identity.hpp"
 #include "irods/scoped_privileged_client.hpp"
 #include "irods/voting.hpp"
@@ -31,14 +41,23 @@
 #include <boost/lexical_cast.hpp>
 #include <boost/function.hpp>
 #include <boost/any.hpp>
+#include <boost/uuid/uuid.hpp>
+#include <boost/uuid/uuid_generators.hpp>
+#include <boost/uuid/uuid_io.hpp>
 
 #include <fmt/format.h>
 
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
 #include <iostream>
+#include <map>
+#include <set>
 #include <sstream>
 #include <string>
 #include <string_view>
 #include <tuple>
+#include <unordered_set>
 #include <vector>
 
 /// =-=-=-=-=-=-=-
@@ -60,6 +79,104 @@ const std::string AUTO_REPL_POLICY( "auto_repl" );
 /// @brief constant indicating the replication policy is enabled
 const std::string AUTO_REPL_POLICY_ENABLED( "on" );
 
+/// @brief constant indicating the replication policy is enabled, but replicas are
+///        queued for sync to the archive instead of being synced before the close
+///        returns to the client
+const std::string AUTO_REPL_POLICY_ASYNC( "async" );
+
+/// @brief constant naming the number of seconds after which a queued sync is
+///        considered abandoned by the agent that queued it and may be performed
+///        by any other agent
+const std::string ASYNC_SYNC_ORPHAN_AGE( "async_sync_orphan_age_in_seconds" );
+const int DEFAULT_ASYNC_SYNC_ORPHAN_AGE = 600;
+
+/// @brief constant naming the minimum number of seconds between two searches for
+///        abandoned syncs.  only one agent at a time searches, see SYNC_QUEUE_LOCK_ATTR.
+const std::string ASYNC_SYNC_RETRY_INTERVAL( "async_sync_retry_interval_in_seconds" );
+const int DEFAULT_ASYNC_SYNC_RETRY_INTERVAL = 60;
+
+/// @brief constant limiting the number of abandoned syncs an agent takes over
+const std::size_t MAX_ORPHANED_SYNCS_PER_AGENT = 100;
+
+/// @brief constant naming the metadata attribute on the compound resource which
+///        queues a data object for sync to the archive.  the value holds the data id
+///        and the units hold the time it was queued followed by a unique token.
+///        the entries are written in admin mode, so owners of the data objects can
+///        neither see nor remove them.
+const std::string SYNC_PENDING_ATTR( "irods::compound::sync_pending" );
+
+/// @brief constant naming the metadata attribute on the compound resource which
+///        elects the single agent allowed to take over abandoned syncs, in the same
+///        way as CACHE_EVICTION_LOCK_ATTR.
+const std::string SYNC_QUEUE_LOCK_ATTR( "irods::compound::sync_queue_lock" );
+
+/// @brief constant bounding, in seconds, how long an agent holds the sync queue lock
+const int SYNC_QUEUE_LOCK_DURATION = 600;
+
+/// @brief constant bounding, in milliseconds, how long an agent spends on queued syncs
+///        while its client is idle.  the client may send its next request at any time.
+const int IDLE_SYNC_BUDGET_IN_MILLISECONDS = 250;
+
+/// @brief constants naming the cache usage, in bytes, above which replicas are evicted from
+///        the cache and the usage at which eviction stops.  eviction is disabled unless both
+///        are set.
+const std::string CACHE_EVICTION_HIGH_WATERMARK( "cache_eviction_high_watermark_in_bytes" );
+const std::string CACHE_EVICTION_LOW_WATERMARK( "cache_eviction_low_watermark_in_bytes" );
+
+/// @brief constant naming the order in which replicas are evicted from the cache
+const std::string CACHE_EVICTION_POLICY( "cache_eviction_policy" );
+
+/// @brief constants indicating the cache eviction policies - least recently used and
+///        least frequently used.
+const std::string CACHE_EVICTION_POLICY_LRU( "lru" );
+const std::string CACHE_EVICTION_POLICY_LFU( "lfu" );
+
+/// @brief constant naming the number of replicas trimmed before the cache usage is checked again
+const std::string CACHE_EVICTION_BATCH_SIZE( "cache_eviction_batch_size" );
+const int DEFAULT_CACHE_EVICTION_BATCH_SIZE = 100;
+
+/// @brief constant naming the minimum number of seconds between two checks of the cache usage.
+///        only one agent at a time checks the usage and evicts, see CACHE_EVICTION_LOCK_ATTR.
+const std::string CACHE_EVICTION_CHECK_INTERVAL( "cache_eviction_check_interval_in_seconds" );
+const int DEFAULT_CACHE_EVICTION_CHECK_INTERVAL = 60;
+
+/// @brief constant naming the metadata attribute on the compound resource which elects the single
+///        agent allowed to check the cache usage and evict.  each contender adds a claim holding a
+///        unique token as the value and the time the claim expires as the units, and the live
+///        claim added first wins.  the winner leaves its claim behind, expiring once the check
+///        interval has elapsed, so that the other agents skip the check until then.
+const std::string CACHE_EVICTION_LOCK_ATTR( "irods::compound::cache_eviction_lock" );
+
+/// @brief constant bounding, in seconds, how long an agent holds the eviction lock.  an agent
+///        which exits while holding the lock blocks eviction for at most this long.  an agent
+///        stops evicting halfway through, and leaves the rest to the next check.
+const int CACHE_EVICTION_LOCK_DURATION = 600;
+
+/// @brief constant bounding the number of eviction candidates held in memory at once.  the cache
+///        is listed again once they have all been evicted.
+const std::size_t MAX_EVICTION_CANDIDATES_PER_PASS = 10000;
+
+/// @brief constant naming the resolution with which the access of cache replicas is recorded.
+///        an access is written to the catalog at most once per period per data object.
+const std::string CACHE_ACCESS_TIME_GRANULARITY( "cache_access_time_granularity_in_seconds" );
+const int DEFAULT_CACHE_ACCESS_TIME_GRANULARITY = 3600;
+
+/// @brief constant naming the metadata attribute on the cache resource recording the accesses of
+///        its replicas.  there is one entry per data object and period of the access time
+///        granularity in which it was accessed.  the value holds the data id and the units the
+///        number of the period.  entries are only ever added and removed, so agents recording
+///        accesses at the same time cannot lose each other's updates, and they are kept off the
+///        data objects so that they do not show up in the metadata of their owners.
+const std::string CACHE_ACCESS_ATTR( "irods::compound::cache_access" );
+
+/// @brief constant bounding the number of periods in which the access of a data object is
+///        recorded.  older periods are forgotten, so lfu counts accesses within this window.
+const std::size_t MAX_RECORDED_ACCESS_PERIODS = 32;
+
+/// @brief constant prefixing the metadata attributes on the compound resource holding the
+///        running totals of cache hits, misses and evictions.
+const std::string CACHE_METRICS_ATTR_PREFIX( "irods::compound::cache_" );
+
 auto repl_object(irods::plugin_context& _ctx,
                  const irods::hierarchy_parser& _hier_from_root_to_compound,
                  const std::string_view _stage_sync_kw) -> irods::error;
@@ -208,6 +325,141 @@ namespace
             cache_replica_number, cache_replica_status, archive_replica_number, archive_replica_status);
     } // get_replica_number_and_status_for_cache_and_archive
 
+    auto modify_avu(RsComm& _comm,
+                    const std::string_view _operation,
+                    const std::string_view _item_type,
+                    const std::string& _item_name,
+                    const std::string& _attr,
+                    const std::string& _value,
+                    const std::string& _units) -> int
+    {
+        std::string operation{_operation};
+        std::string item_type{_item_type};
+        std::string item_name{_item_name};
+        std::string attr{_attr};
+        std::string value{_value};
+        std::string units{_units};
+
+        modAVUMetadataInp_t inp{};
+        const irods::at_scope_exit free_cond_input{[&inp] { clearKeyVal(&inp.condInput); }};
+        inp.arg0 = operation.data();
+        inp.arg1 = item_type.data();
+        inp.arg2 = item_name.data();
+        inp.arg3 = attr.data();
+        inp.arg4 = value.data();
+        inp.arg5 = units.data();
+
+        // Maintenance runs as the service account on metadata belonging to other users.
+        addKeyVal(&inp.condInput, ADMIN_KW, "");
+
+        return rsModAVUMetadata(&_comm, &inp);
+    } // modify_avu
+
+    // The most recent access of a data object's cache replica by this agent.
+    struct cache_access
+    {
+        std::string logical_path;
+        std::int64_t time;
+    }; // struct cache_access
+
+    // Cache activity observed by this agent for a single compound resource. Apart from the queued syncs, which are
+    // performed while the client is idle, nothing is written to the catalog while the client is connected. The
+    // post-disconnect maintenance operation flushes the activity once the client is gone.
+    struct cache_activity
+    {
+        RsComm* comm{};
+        std::map<rodsLong_t, cache_access> accesses;
+        std::set<rodsLong_t> removals;
+        std::uint64_t hits{};
+        std::uint64_t misses{};
+        bool cache_grew{};
+
+        // Maps the data id of each data object this agent queued for sync to the archive to the units of its queue
+        // entry, see SYNC_PENDING_ATTR.
+        std::map<rodsLong_t, std::string> pending_syncs;
+
+        // The number of syncs performed while the client was idle, which are added to the cache metrics on disconnect.
+        std::uint64_t idle_syncs{};
+
+        auto empty() const noexcept -> bool
+        {
+            return accesses.empty() && removals.empty() && pending_syncs.empty() && 0 == hits && 0 == misses &&
+                   0 == idle_syncs && !cache_grew;
+        }
+    }; // struct cache_activity
+
+    auto get_cache_activity(const std::string& _compound_resc_name) -> cache_activity&
+    {
+        static std::map<std::string, cache_activity> activity;
+        return activity[_compound_resc_name];
+    } // get_cache_activity
+
+    auto current_timestamp_in_seconds() -> std::int64_t
+    {
+        using std::chrono::system_clock;
+        return std::chrono::duration_cast<std::chrono::seconds>(system_clock::now().time_since_epoch()).count();
+    } // current_timestamp_in_seconds
+
+    // Records that the client is about to use the cache replica of the data object in the plugin context. _hit
+    // indicates whether the replica was already good in the cache or had to be staged from the archive.
+    auto record_cache_access(irods::plugin_context& _ctx, const bool _hit) -> void
+    {
+        std::string name;
+        if (const auto err = _ctx.prop_map().get<std::string>(irods::RESOURCE_NAME, name); !err.ok()) {
+            irods::log(PASS(err));
+            return;
+        }
+
+        auto& activity = get_cache_activity(name);
+        activity.comm = _ctx.comm();
+
+        if (_hit) {
+            ++activity.hits;
+        }
+        else {
+            ++activity.misses;
+            activity.cache_grew = true;
+        }
+
+        irods::file_object_ptr obj = boost::dynamic_pointer_cast<irods::file_object>(_ctx.fco());
+        if (obj && obj->data_id() > 0) {
+            activity.accesses.insert_or_assign(obj->data_id(),
+                                               cache_access{obj->logical_path(), current_timestamp_in_seconds()});
+        }
+    } // record_cache_access
+
+    // Records that new data is being written into the cache through the compound resource named in the plugin context.
+    auto record_cache_growth(irods::plugin_context& _ctx) -> void
+    {
+        std::string name;
+        if (const auto err = _ctx.prop_map().get<std::string>(irods::RESOURCE_NAME, name); !err.ok()) {
+            irods::log(PASS(err));
+            return;
+        }
+
+        auto& activity = get_cache_activity(name);
+        activity.comm = _ctx.comm();
+        activity.cache_grew = true;
+    } // record_cache_growth
+
+    // Records that the cache replica of the data object in the plugin context is being removed, so that its recorded
+    // accesses can be forgotten.
+    auto record_cache_removal(irods::plugin_context& _ctx) -> void
+    {
+        std::string name;
+        if (const auto err = _ctx.prop_map().get<std::string>(irods::RESOURCE_NAME, name); !err.ok()) {
+            irods::log(PASS(err));
+            return;
+        }
+
+        irods::file_object_ptr obj = boost::dynamic_pointer_cast<irods::file_object>(_ctx.fco());
+        if (obj && obj->data_id() > 0) {
+            auto& activity = get_cache_activity(name);
+            activity.comm = _ctx.comm();
+            activity.removals.insert(obj->data_id());
+        }
+    } // record_cache_removal
+
     auto disconnect_server_to_server_connections() -> void
     {
         // Loop over all of the servers and disconnect any existing connections that this agent has with them. This
@@ -229,6 +481,112 @@ namespace
         }
     } // disconnect_server_to_server_connections
 
+    // Hides this agent's server-to-server connections while it acts as the service account so that any server it
+    // talks to in the meantime sees the new identity. Connections made in the meantime are disconnected and the
+    // original ones are restored on destruction, which keeps them valid for the other maintenance operations.
+    class stashed_server_to_server_connections
+    {
+    public:
+        stashed_server_to_server_connections()
+        {
+            for (auto* zone_ptr = ZoneInfoHead; zone_ptr; zone_ptr = zone_ptr->next) {
+                for (auto* host_list : {zone_ptr->primaryServerHost, zone_ptr->secondaryServerHost}) {
+                    for (auto* host_ptr = host_list; host_ptr; host_ptr = host_ptr->next) {
+                        if (host_ptr->conn) {
+                            stash_.emplace_back(host_ptr, host_ptr->conn);
+                            host_ptr->conn = nullptr;
+                        }
+                    }
+                }
+            }
+        }
+
+        stashed_server_to_server_connections(const stashed_server_to_server_connections&) = delete;
+        auto operator=(const stashed_server_to_server_connections&) -> stashed_server_to_server_connections& = delete;
+
+        ~stashed_server_to_server_connections()
+        {
+            disconnect_server_to_server_connections();
+
+            for (auto& [host_ptr, conn] : stash_) {
+                host_ptr->conn = conn;
+            }
+        }
+
+    private:
+        std::vector<std::pair<rodsServerHost_t*, rcComm_t*>> stash_;
+    }; // class stashed_server_to_server_connections
+
+    // Acts as the service account on the connection of the client for as long as it is alive, so that the metadata
+    // maintained by the compound resource can be written in admin mode.
+    class scoped_service_account
+    {
+    public:
+        explicit scoped_service_account(RsComm& _comm)
+            : identity_{_comm,
+                        static_cast<char*>(_comm.myEnv.rodsUserName),
+                        static_cast<char*>(_comm.myEnv.rodsZone)}
+            , privilege_{_comm}
+        {
+        }
+
+        scoped_service_account(const scoped_service_account&) = delete;
+        auto operator=(const scoped_service_account&) -> scoped_service_account& = delete;
+
+    private:
+        irods::experimental::scoped_client_identity identity_;
+        irods::experimental::scoped_privileged_client privilege_;
+        stashed_server_to_server_connections connections_;
+    }; // class scoped_service_account
+
+    auto sync_is_asynchronous(irods::plugin_property_map& _props) -> bool
+    {
+        std::string auto_repl;
+        return _props.get<std::string>(AUTO_REPL_POLICY, auto_repl).ok() && AUTO_REPL_POLICY_ASYNC == auto_repl;
+    } // sync_is_asynchronous
+
+    // Queues the data object in the plugin context for sync to the archive. The queue entry is kept in the catalog so
+    // that the sync is not lost if this agent exits before performing it. Queueing the same data object again replaces
+    // the entry this agent added for it before.
+    auto queue_sync_to_archive(irods::plugin_context& _ctx) -> irods::error
+    {
+        std::string name;
+        if (const auto err = _ctx.prop_map().get<std::string>(irods::RESOURCE_NAME, name); !err.ok()) {
+            return PASS(err);
+        }
+
+        irods::file_object_ptr obj = boost::dynamic_pointer_cast<irods::file_object>(_ctx.fco());
+        if (!obj || obj->data_id() <= 0) {
+            return ERROR(SYS_INVALID_INPUT_PARAM, "cannot queue a data object without a data id for sync");
+        }
+
+        const auto data_id = std::to_string(obj->data_id());
+        const auto token = fmt::format(
+            "{}:{}", current_timestamp_in_seconds(), boost::uuids::to_string(boost::uuids::random_generator{}()));
+
+        auto& activity = get_cache_activity(name);
+
+        {
+            // The entry is kept on the compound resource in admin mode, so that the owner of the data object can
+            // neither see nor remove it.
+            const scoped_service_account service_account{*_ctx.comm()};
+
+            const auto ec = modify_avu(*_ctx.comm(), "add", "-R", name, SYNC_PENDING_ATTR, data_id, token);
+            if (ec < 0) {
+                return ERROR(ec, fmt::format("failed to queue [{}] for sync to the archive", obj->logical_path()));
+            }
+
+            if (const auto iter = activity.pending_syncs.find(obj->data_id()); iter != activity.pending_syncs.end()) {
+                modify_avu(*_ctx.comm(), "rm", "-R", name, SYNC_PENDING_ATTR, data_id, iter->second);
+            }
+        }
+
+        activity.comm = _ctx.comm();
+        activity.pending_syncs.insert_or_assign(obj->data_id(), token);
+
+        return SUCCESS();
+    } // queue_sync_to_archive
+
     auto stage_to_cache(irods::plugin_context& _ctx, const irods::hierarchy_parser& _hier_from_root_to_compound)
         -> irods::error
     {
@@ -275,6 +633,8 @@ namespace
             return PASS(err);
         }
 
+        record_cache_access(_ctx, false);
+
         return SUCCESS();
     } // stage_to_cache
 } // anonymous namespace
@@ -1044,6 +1404,8 @@ irods::error compound_file_create(
         return PASS( ret );
     }
 
+    record_cache_growth( _ctx );
+
     // =-=-=-=-=-=-=-
     // forward the call
     return resc->call( _ctx.comm(), irods::RESOURCE_OP_CREATE, _ctx.fco() );
@@ -1094,7 +1456,7 @@ irods::error compound_file_read(irods::plugin_context& _ctx, void* _buf, int _le
 
     // =-=-=-=-=-=-=-
     // forward the call
-    return resc->call< void*, int >( _ctx.comm(), irods::RESOURCE_OP_READ, _ctx.fco(), _buf, _len );
+    return resc->call< void*, int >( _ctx.comm(), irods::RESOURCE_OP_READ_INDEX, _ctx.fco(), _buf, _len );
 } // compound_file_read
 
 /// =-=-=-=-=-=-=-
@@ -1120,7 +1482,7 @@ irods::error compound_file_write(
 
     // =-=-=-=-=-=-=-
     // forward the call
-    return resc->call< const void*, const int >( _ctx.comm(), irods::RESOURCE_OP_WRITE, _ctx.fco(), _buf, _len );
+    return resc->call< const void*, const int >( _ctx.comm(), irods::RESOURCE_OP_WRITE_INDEX, _ctx.fco(), _buf, _len );
 
 } // compound_file_write
 
@@ -1174,6 +1536,13 @@ irods::error compound_file_unlink(
         return PASS( ret );
     }
 
+    std::string cache_name;
+    std::string child_name;
+    if ( _ctx.prop_map().get< std::string >( CACHE_CONTEXT_TYPE, cache_name ).ok() &&
+         resc->get_property< std::string >( irods::RESOURCE_NAME, child_name ).ok() && child_name == cache_name ) {
+        record_cache_removal( _ctx );
+    }
+
     // =-=-=-=-=-=-=-
     // forward the call
     return resc->call( _ctx.comm(), irods::RESOURCE_OP_UNLINK, _ctx.fco() );
@@ -1539,13 +1908,19 @@ static bool auto_replication_is_enabled(
                            AUTO_REPL_POLICY,
                            auto_repl );
     if( ret.ok() ) {
-        if( AUTO_REPL_POLICY_ENABLED != auto_repl ) {
+        if( AUTO_REPL_POLICY_ENABLED != auto_repl &&
+            AUTO_REPL_POLICY_ASYNC   != auto_repl ) {
             return false;
         }
     }
     return true;
 } // auto_replication_is_enabled
 
+static bool auto_replication_is_asynchronous(
+    irods::plugin_context& _ctx ) {
+    return sync_is_asynchronous( _ctx.prop_map() );
+} // auto_replication_is_asynchronous
+
 /// =-=-=-=-=-=-=-
 /// @brief interface to notify of a file modification - this happens
 ///        after the close operation and the icat should be up to date
@@ -1575,6 +1950,18 @@ irods::error compound_file_modified(
     irods::hierarchy_parser sub_parser;
     sub_parser.set_string( file_obj->in_pdmo() );
     if ( !sub_parser.resc_in_hier( name ) ) {
+        // =-=-=-=-=-=-=-
+        // in asynchronous mode the archive replica stays stale until the
+        // queued sync is performed, once the client is idle or gone
+        if ( auto_replication_is_asynchronous( _ctx ) ) {
+            ret = queue_sync_to_archive( _ctx );
+            if ( ret.ok() ) {
+                return SUCCESS();
+            }
+
+            irods::log( PASSMSG( "Failed to queue the sync to the archive; syncing now.", ret ) );
+        }
+
         irods::hierarchy_parser parser{file_obj->resc_hier()};
         result = repl_object( _ctx, parser, SYNC_OBJ_KW );
     }
@@ -1819,10 +2206,24 @@ irods::error open_for_prefer_archive_policy(
         irods::log(LOG_DEBUG, fmt::format("[{}:{}] - [{}]", __FUNCTION__, __LINE__, e.what()));
     }
 
-    if (!ret.ok() || irv::vote::zero == arch_check_vote) {
+    // The archive replica is stale while a sync to the archive is queued (see the
+    // asynchronous auto_repl policy).  Staging it would overwrite the newer data in
+    // the cache, so the cache replica is used instead.
+    bool archive_is_behind_cache = false;
+    try {
+        const auto [cache_replica_number, cache_replica_status, archive_replica_number, archive_replica_status] =
+            get_replica_number_and_status_for_cache_and_archive(_ctx);
+        archive_is_behind_cache = GOOD_REPLICA == cache_replica_status && GOOD_REPLICA != archive_replica_status &&
+                                  REPLICA_DOES_NOT_EXIST != archive_replica_number;
+    }
+    catch (const irods::exception& e) {
+        irods::log(LOG_DEBUG, fmt::format("[{}:{}] - [{}]", __FUNCTION__, __LINE__, e.what()));
+    }
+
+    if (!ret.ok() || irv::vote::zero == arch_check_vote || archive_is_behind_cache) {
         rodsLog(
             LOG_DEBUG,
-            "replica not found in archive for [%s]",
+            "replica not found in archive or stale for [%s]",
             f_ptr->logical_path().c_str() );
         // =-=-=-=-=-=-=-
         // the archive query redirect failed, something terrible happened
@@ -1848,6 +2249,8 @@ irods::error open_for_prefer_archive_policy(
         _out_parser = cache_check_parser;
         _out_vote = cache_check_vote;
 
+        record_cache_access(_ctx, true);
+
         return SUCCESS();
     }
 
@@ -2119,6 +2522,10 @@ irods::error open_for_prefer_cache_policy(
         // else it is in the cache so assign the parser
         ( *_out_vote )   = cache_check_vote;
         ( *_out_parser ) = cache_check_parser;
+
+        if (cache_is_good && irods::UNLINK_OPERATION != *_opr && irv::vote::zero != cache_check_vote) {
+            record_cache_access(_ctx, true);
+        }
     }
 
     return SUCCESS();
@@ -2325,6 +2732,925 @@ irods::error compound_file_rebalance(
 
 } // compound_file_rebalance
 
+namespace
+{
+    using log_resource = irods::experimental::log::resource;
+
+    struct eviction_candidate
+    {
+        rodsLong_t data_id;
+        std::string logical_path;
+        std::string replica_number;
+        rodsLong_t size;
+        std::int64_t last_access;
+        std::int64_t access_count;
+    }; // struct eviction_candidate
+
+    struct eviction_summary
+    {
+        std::uint64_t replicas{};
+        rodsLong_t bytes{};
+    }; // struct eviction_summary
+
+    // Returns the integer held by the context string key, if it is set.
+    auto get_context_integer(irods::plugin_property_map& _props, const std::string& _key) -> std::optional<std::int64_t>
+    {
+        std::string value;
+        if (!_props.get<std::string>(_key, value).ok()) {
+            return std::nullopt;
+        }
+
+        try {
+            return boost::lexical_cast<std::int64_t>(value);
+        }
+        catch (const boost::bad_lexical_cast&) {
+            log_resource::error("Invalid value [{}] for context string key [{}]; ignoring it.", value, _key);
+            return std::nullopt;
+        }
+    } // get_context_integer
+
+    // Returns a comma separated list of the quoted data ids in [_first, _last), for use in a GenQuery "in" condition.
+    template <typename Iterator>
+    auto make_data_id_list(Iterator _first, Iterator _last) -> std::string
+    {
+        std::string id_list;
+        for (; _first != _last; ++_first) {
+            id_list += fmt::format("{}'{}'", id_list.empty() ? "" : ", ", *_first);
+        }
+
+        return id_list;
+    } // make_data_id_list
+
+    // Maps each of the data ids to the periods in which an access of its cache replica is recorded.
+    auto get_recorded_accesses(RsComm& _comm, const std::string& _cache_resc_name, const std::string& _id_list)
+        -> std::map<rodsLong_t, std::set<std::int64_t>>
+    {
+        std::map<rodsLong_t, std::set<std::int64_t>> recorded;
+
+        const auto gql = fmt::format("select META_RESC_ATTR_VALUE, META_RESC_ATTR_UNITS "
+                                     "where RESC_NAME = '{}' and META_RESC_ATTR_NAME = '{}' "
+                                     "and META_RESC_ATTR_VALUE in ({})",
+                                     _cache_resc_name,
+                                     CACHE_ACCESS_ATTR,
+                                     _id_list);
+
+        for (auto&& row : irods::query{&_comm, gql}) {
+            try {
+                recorded[std::stoll(row[0])].insert(std::stoll(row[1]));
+            }
+            catch (const std::exception&) {
+                // Malformed entries are ignored.
+            }
+        }
+
+        return recorded;
+    } // get_recorded_accesses
+
+    // Writes the accesses recorded by this agent to the access metadata of the cache resource. An access is only
+    // written if none is recorded for the same period of the granularity, so the access count of a data object is the
+    // number of periods in which it was accessed.
+    auto flush_cache_accesses(RsComm& _comm,
+                              const std::string& _cache_resc_name,
+                              const std::map<rodsLong_t, cache_access>& _accesses,
+                              const std::int64_t _granularity) -> void
+    {
+        constexpr std::size_t ids_per_query = 100;
+
+        std::vector<rodsLong_t> ids;
+        ids.reserve(_accesses.size());
+        for (const auto& [id, access] : _accesses) {
+            ids.push_back(id);
+        }
+
+        for (std::size_t first = 0; first < ids.size(); first += ids_per_query) {
+            const auto last = std::min(ids.size(), first + ids_per_query);
+            const auto id_list = make_data_id_list(ids.begin() + first, ids.begin() + last);
+            auto recorded = get_recorded_accesses(_comm, _cache_resc_name, id_list);
+
+            for (auto i = first; i < last; ++i) {
+                const auto& access = _accesses.at(ids[i]);
+                const auto period = access.time / _granularity;
+                const auto id = std::to_string(ids[i]);
+                auto& periods = recorded[ids[i]];
+
+                if (periods.count(period) > 0) {
+                    continue;
+                }
+
+                // Another agent may have recorded the same access in the meantime.
+                const auto ec =
+                    modify_avu(_comm, "add", "-R", _cache_resc_name, CACHE_ACCESS_ATTR, id, std::to_string(period));
+                if (ec < 0 && CATALOG_ALREADY_HAS_ITEM_BY_THAT_NAME != ec) {
+                    log_resource::warn("Failed to record cache access of [{}] [error_code={}].",
+                                       access.logical_path,
+                                       ec);
+                    continue;
+                }
+
+                // Forget the oldest periods, so that the entries of a data object stay bounded.
+                periods.insert(period);
+                while (periods.size() > MAX_RECORDED_ACCESS_PERIODS) {
+                    const auto oldest = std::to_string(*periods.begin());
+                    modify_avu(_comm, "rm", "-R", _cache_resc_name, CACHE_ACCESS_ATTR, id, oldest);
+                    periods.erase(periods.begin());
+                }
+            }
+        }
+    } // flush_cache_accesses
+
+    // Removes the recorded accesses of the data object. Its cache replica was removed or evicted.
+    auto forget_cache_accesses(RsComm& _comm, const std::string& _cache_resc_name, const rodsLong_t _data_id) -> void
+    {
+        const auto ec =
+            modify_avu(_comm, "rmw", "-R", _cache_resc_name, CACHE_ACCESS_ATTR, std::to_string(_data_id), "%");
+
+        if (ec < 0 && CAT_SUCCESS_BUT_WITH_NO_INFO != ec) {
+            log_resource::debug("Failed to remove the recorded cache accesses of data object [{}] [error_code={}].",
+                                _data_id,
+                                ec);
+        }
+    } // forget_cache_accesses
+
+    // Adds the activity of this agent to the running totals held in the metadata of the compound resource.
+    auto add_to_cache_metrics(RsComm& _comm,
+                              const std::string& _compound_resc_name,
+                              const std::map<std::string, std::uint64_t>& _deltas) -> void
+    {
+        std::map<std::string, std::uint64_t> totals;
+
+        const auto gql = fmt::format("select META_RESC_ATTR_NAME, META_RESC_ATTR_VALUE "
+                                     "where RESC_NAME = '{}' and META_RESC_ATTR_NAME like '{}%'",
+                                     _compound_resc_name,
+                                     CACHE_METRICS_ATTR_PREFIX);
+
+        for (auto&& row : irods::query{&_comm, gql}) {
+            try {
+                totals[row[0].substr(CACHE_METRICS_ATTR_PREFIX.size())] = std::stoull(row[1]);
+            }
+            catch (const std::exception&) {
+                // Malformed metadata is overwritten below.
+            }
+        }
+
+        for (const auto& [name, delta] : _deltas) {
+            if (0 == delta) {
+                continue;
+            }
+
+            const auto total = (totals[name] += delta);
+            const auto ec = modify_avu(
+                _comm, "set", "-R", _compound_resc_name, CACHE_METRICS_ATTR_PREFIX + name, std::to_string(total), "");
+
+            if (ec < 0) {
+                log_resource::warn("Failed to update cache metric [{}] of resource [{}] [error_code={}].",
+                                   name,
+                                   _compound_resc_name,
+                                   ec);
+            }
+        }
+
+        if (const auto lookups = totals["hits"] + totals["misses"]; lookups > 0) {
+            log_resource::debug("[{}]: cache hit ratio is [{:.3f}] over [{}] lookups.",
+                                _compound_resc_name,
+                                static_cast<double>(totals["hits"]) / static_cast<double>(lookups),
+                                lookups);
+        }
+    } // add_to_cache_metrics
+
+    auto get_cache_usage(RsComm& _comm, const rodsLong_t _cache_resc_id) -> rodsLong_t
+    {
+        const auto gql = fmt::format("select sum(DATA_SIZE) where DATA_RESC_ID = '{}'", _cache_resc_id);
+
+        for (auto&& row : irods::query{&_comm, gql}) {
+            return row[0].empty() ? 0 : std::stoll(row[0]);
+        }
+
+        return 0;
+    } // get_cache_usage
+
+    struct lock_claim
+    {
+        rodsLong_t id;
+        std::string token;
+        std::int64_t expires_at;
+    }; // struct lock_claim
+
+    auto get_lock_claims(RsComm& _comm, const std::string& _compound_resc_name, const std::string& _lock_attr)
+        -> std::vector<lock_claim>
+    {
+        std::vector<lock_claim> claims;
+
+        const auto gql = fmt::format("select META_RESC_ATTR_ID, META_RESC_ATTR_VALUE, META_RESC_ATTR_UNITS "
+                                     "where RESC_NAME = '{}' and META_RESC_ATTR_NAME = '{}'",
+                                     _compound_resc_name,
+                                     _lock_attr);
+
+        for (auto&& row : irods::query{&_comm, gql}) {
+            try {
+                claims.push_back({std::stoll(row[0]), row[1], std::stoll(row[2])});
+            }
+            catch (const std::exception&) {
+                // A malformed claim has expired.
+                claims.push_back({std::stoll(row[0]), row[1], 0});
+            }
+        }
+
+        return claims;
+    } // get_lock_claims
+
+    // Elects this agent as the only one performing the maintenance guarded by _lock_attr on the compound resource, see
+    // CACHE_EVICTION_LOCK_ATTR. Returns the token of its claim if it was elected.
+    auto acquire_maintenance_lock(RsComm& _comm,
+                                  const std::string& _compound_resc_name,
+                                  const std::string& _lock_attr,
+                                  const std::int64_t _duration) -> std::optional<std::string>
+    {
+        const auto now = current_timestamp_in_seconds();
+        const auto is_live = [now](const lock_claim& _claim) { return _claim.expires_at > now; };
+
+        // Another agent holds the lock, or released it recently. This is the common case, and costs one query.
+        auto claims = get_lock_claims(_comm, _compound_resc_name, _lock_attr);
+        if (std::any_of(claims.begin(), claims.end(), is_live)) {
+            return std::nullopt;
+        }
+
+        const auto token = boost::uuids::to_string(boost::uuids::random_generator{}());
+        const auto expires_at = std::to_string(now + _duration);
+
+        if (const auto ec = modify_avu(_comm, "add", "-R", _compound_resc_name, _lock_attr, token, expires_at); ec < 0)
+        {
+            log_resource::debug("[{}]: failed to claim [{}] [error_code={}].", _compound_resc_name, _lock_attr, ec);
+            return std::nullopt;
+        }
+
+        // Every contender reading the claims after adding its own agrees on the winner: the live claim added first.
+        claims = get_lock_claims(_comm, _compound_resc_name, _lock_attr);
+
+        const lock_claim* winner = nullptr;
+        for (const auto& claim : claims) {
+            if (is_live(claim) && (!winner || claim.id < winner->id)) {
+                winner = &claim;
+            }
+        }
+
+        if (winner && winner->token == token) {
+            return token;
+        }
+
+        modify_avu(_comm, "rm", "-R", _compound_resc_name, _lock_attr, token, expires_at);
+
+        return std::nullopt;
+    } // acquire_maintenance_lock
+
+    // Leaves a claim on the lock which expires once _interval has elapsed, so that no agent performs the maintenance
+    // again before then. Setting the claim also removes the claims of the contenders which lost the election, and of
+    // agents which exited while holding the lock.
+    auto release_maintenance_lock(RsComm& _comm,
+                                  const std::string& _compound_resc_name,
+                                  const std::string& _lock_attr,
+                                  const std::string& _token,
+                                  const std::int64_t _interval) -> void
+    {
+        const auto expires_at = std::to_string(current_timestamp_in_seconds() + _interval);
+
+        if (const auto ec = modify_avu(_comm, "set", "-R", _compound_resc_name, _lock_attr, _token, expires_at); ec < 0)
+        {
+            log_resource::warn("[{}]: failed to release [{}] [error_code={}].", _compound_resc_name, _lock_attr, ec);
+        }
+    } // release_maintenance_lock
+
+    // Returns up to MAX_EVICTION_CANDIDATES_PER_PASS good replicas in the cache whose archive replica is also good, in
+    // the order they should be evicted. The archive replicas and the recorded accesses are looked up for each page of
+    // the cache listing, so memory use does not grow with the size of the cache.
+    auto get_eviction_candidates(RsComm& _comm,
+                                 const rodsLong_t _cache_resc_id,
+                                 const std::string& _cache_resc_name,
+                                 const rodsLong_t _archive_resc_id,
+                                 const std::string& _policy,
+                                 const std::int64_t _granularity) -> std::vector<eviction_candidate>
+    {
+        constexpr std::size_t ids_per_query = 100;
+
+        const auto evict_first = [&_policy](const eviction_candidate& _lhs, const eviction_candidate& _rhs) {
+            if (CACHE_EVICTION_POLICY_LFU == _policy) {
+                return std::tie(_lhs.access_count, _lhs.last_access) < std::tie(_rhs.access_count, _rhs.last_access);
+            }
+
+            return _lhs.last_access < _rhs.last_access;
+        };
+
+        // A heap whose top is the candidate to be evicted last, which is dropped first once the heap is full.
+        std::vector<eviction_candidate> candidates;
+        std::vector<eviction_candidate> page;
+
+        const auto add_page = [&] {
+            std::vector<rodsLong_t> ids;
+            ids.reserve(page.size());
+            for (const auto& candidate : page) {
+                ids.push_back(candidate.data_id);
+            }
+
+            const auto id_list = make_data_id_list(ids.begin(), ids.end());
+
+            std::unordered_set<rodsLong_t> archived;
+
+            const auto gql = fmt::format("select DATA_ID where DATA_RESC_ID = '{}' and DATA_REPL_STATUS = '{}' "
+                                         "and DATA_ID in ({})",
+                                         _archive_resc_id,
+                                         GOOD_REPLICA,
+                                         id_list);
+
+            for (auto&& row : irods::query{&_comm, gql}) {
+                archived.insert(std::stoll(row[0]));
+            }
+
+            const auto recorded = get_recorded_accesses(_comm, _cache_resc_name, id_list);
+
+            for (auto& candidate : page) {
+                if (0 == archived.count(candidate.data_id)) {
+                    continue;
+                }
+
+                // Replicas which have never been read from the cache are ranked by the time they were written to it.
+                if (const auto iter = recorded.find(candidate.data_id); iter != recorded.end()) {
+                    candidate.last_access = std::max(candidate.last_access, *iter->second.rbegin() * _granularity);
+                    candidate.access_count = static_cast<std::int64_t>(iter->second.size());
+                }
+
+                candidates.push_back(std::move(candidate));
+                std::push_heap(candidates.begin(), candidates.end(), evict_first);
+
+                if (candidates.size() > MAX_EVICTION_CANDIDATES_PER_PASS) {
+                    std::pop_heap(candidates.begin(), candidates.end(), evict_first);
+                    candidates.pop_back();
+                }
+            }
+
+            page.clear();
+        };
+
+        const auto gql = fmt::format("select DATA_ID, COLL_NAME, DATA_NAME, DATA_REPL_NUM, DATA_SIZE, DATA_MODIFY_TIME "
+                                     "where DATA_RESC_ID = '{}' and DATA_REPL_STATUS = '{}'",
+                                     _cache_resc_id,
+                                     GOOD_REPLICA);
+
+        for (auto&& row : irods::query{&_comm, gql}) {
+            page.push_back({std::stoll(row[0]),
+                            fmt::format("{}/{}", row[1], row[2]),
+                            row[3],
+                            std::stoll(row[4]),
+                            std::stoll(row[5]),
+                            0});
+
+            if (page.size() == ids_per_query) {
+                add_page();
+            }
+        }
+
+        if (!page.empty()) {
+            add_page();
+        }
+
+        std::sort_heap(candidates.begin(), candidates.end(), evict_first);
+
+        return candidates;
+    } // get_eviction_candidates
+
+    auto trim_cache_replica(RsComm& _comm, const eviction_candidate& _candidate) -> int
+    {
+        dataObjInp_t inp{};
+        const irods::at_scope_exit free_cond_input{[&inp] { clearKeyVal(&inp.condInput); }};
+
+        std::snprintf(inp.objPath, sizeof(inp.objPath), "%s", _candidate.logical_path.c_str());
+        addKeyVal(&inp.condInput, REPL_NUM_KW, _candidate.replica_number.c_str());
+        addKeyVal(&inp.condInput, COPIES_KW, "1");
+        addKeyVal(&inp.condInput, ADMIN_KW, "");
+
+        return rsDataObjTrim(&_comm, &inp);
+    } // trim_cache_replica
+
+    // Trims replicas from the cache while its usage is above the low watermark, provided it exceeded the high watermark.
+    // Only the agent holding the eviction lock checks the usage, at most once per check interval.
+    auto evict_from_cache(RsComm& _comm,
+                          irods::plugin_property_map& _props,
+                          const std::string& _compound_resc_name,
+                          const std::int64_t _granularity,
+                          eviction_summary& _summary) -> irods::error
+    {
+        const auto high_watermark = get_context_integer(_props, CACHE_EVICTION_HIGH_WATERMARK);
+        const auto low_watermark = get_context_integer(_props, CACHE_EVICTION_LOW_WATERMARK);
+        if (!high_watermark || !low_watermark) {
+            return SUCCESS();
+        }
+
+        if (*low_watermark > *high_watermark) {
+            return ERROR(SYS_INVALID_INPUT_PARAM,
+                         fmt::format("[{}] must not exceed [{}] for resource [{}]",
+                                     CACHE_EVICTION_LOW_WATERMARK,
+                                     CACHE_EVICTION_HIGH_WATERMARK,
+                                     _compound_resc_name));
+        }
+
+        std::string policy = CACHE_EVICTION_POLICY_LRU;
+        _props.get<std::string>(CACHE_EVICTION_POLICY, policy);
+        if (CACHE_EVICTION_POLICY_LRU != policy && CACHE_EVICTION_POLICY_LFU != policy) {
+            return ERROR(SYS_INVALID_INPUT_PARAM,
+                         fmt::format("invalid [{}] [{}] for resource [{}]",
+                                     CACHE_EVICTION_POLICY,
+                                     policy,
+                                     _compound_resc_name));
+        }
+
+        auto batch_size = get_context_integer(_props, CACHE_EVICTION_BATCH_SIZE).value_or(DEFAULT_CACHE_EVICTION_BATCH_SIZE);
+        if (batch_size <= 0) {
+            batch_size = DEFAULT_CACHE_EVICTION_BATCH_SIZE;
+        }
+
+        auto check_interval =
+            get_context_integer(_props, CACHE_EVICTION_CHECK_INTERVAL).value_or(DEFAULT_CACHE_EVICTION_CHECK_INTERVAL);
+        if (check_interval < 0) {
+            check_interval = DEFAULT_CACHE_EVICTION_CHECK_INTERVAL;
+        }
+
+        const auto cache_resc = get_child_resource(_compound_resc_name, CACHE_CONTEXT_TYPE);
+        const auto archive_resc = get_child_resource(_compound_resc_name, ARCHIVE_CONTEXT_TYPE);
+        if (!cache_resc || !archive_resc) {
+            return ERROR(SYS_INVALID_INPUT_PARAM,
+                         fmt::format("failed to get the cache and archive of resource [{}]", _compound_resc_name));
+        }
+
+        rodsLong_t cache_resc_id = 0;
+        rodsLong_t archive_resc_id = 0;
+        std::string cache_resc_name;
+        if (auto err = cache_resc->get_property<rodsLong_t>(irods::RESOURCE_ID, cache_resc_id); !err.ok()) {
+            return PASS(err);
+        }
+        if (auto err = archive_resc->get_property<rodsLong_t>(irods::RESOURCE_ID, archive_resc_id); !err.ok()) {
+            return PASS(err);
+        }
+        cache_resc->get_property<std::string>(irods::RESOURCE_NAME, cache_resc_name);
+
+        const auto token = acquire_maintenance_lock(
+            _comm, _compound_resc_name, CACHE_EVICTION_LOCK_ATTR, CACHE_EVICTION_LOCK_DURATION);
+        if (!token) {
+            return SUCCESS();
+        }
+
+        const irods::at_scope_exit release_lock{[&] {
+            release_maintenance_lock(_comm, _compound_resc_name, CACHE_EVICTION_LOCK_ATTR, *token, check_interval);
+        }};
+
+        const auto usage_before = get_cache_usage(_comm, cache_resc_id);
+        if (usage_before <= *high_watermark) {
+            return SUCCESS();
+        }
+
+        // Stop well before the lock expires, so that no other agent starts evicting at the same time.
+        const auto deadline = current_timestamp_in_seconds() + CACHE_EVICTION_LOCK_DURATION / 2;
+        const auto has_time = [deadline] { return current_timestamp_in_seconds() < deadline; };
+
+        auto usage = usage_before;
+
+        for (bool more = true; more && usage > *low_watermark && has_time();) {
+            const auto candidates =
+                get_eviction_candidates(_comm, cache_resc_id, cache_resc_name, archive_resc_id, policy, _granularity);
+
+            // A full list may have left out candidates, which are found by listing the cache again.
+            more = candidates.size() == MAX_EVICTION_CANDIDATES_PER_PASS;
+            const auto evicted_before = _summary.replicas;
+
+            // Re-read the usage after every batch because other agents may be staging to the same cache.
+            for (std::size_t next = 0; usage > *low_watermark && next < candidates.size() && has_time();) {
+                const auto batch_end = std::min(candidates.size(), next + static_cast<std::size_t>(batch_size));
+
+                for (auto projected_usage = usage; next < batch_end && projected_usage > *low_watermark; ++next) {
+                    const auto& candidate = candidates[next];
+
+                    if (const auto ec = trim_cache_replica(_comm, candidate); ec < 0) {
+                        log_resource::debug("[{}]: failed to evict replica [{}] of [{}] [error_code={}].",
+                                            _compound_resc_name,
+                                            candidate.replica_number,
+                                            candidate.logical_path,
+                                            ec);
+                        continue;
+                    }
+
+                    forget_cache_accesses(_comm, cache_resc_name, candidate.data_id);
+
+                    projected_usage -= candidate.size;
+                    ++_summary.replicas;
+                    _summary.bytes += candidate.size;
+                }
+
+                usage = get_cache_usage(_comm, cache_resc_id);
+            }
+
+            if (_summary.replicas == evicted_before) {
+                break;
+            }
+        }
+
+        log_resource::info("[{}]: evicted [{}] replicas totaling [{}] bytes from cache resource [{}] using policy [{}]. "
+                           "Usage went from [{}] to [{}] bytes [high_watermark={}, low_watermark={}].",
+                           _compound_resc_name,
+                           _summary.replicas,
+                           _summary.bytes,
+                           cache_resc_name,
+                           policy,
+                           usage_before,
+                           usage,
+                           *high_watermark,
+                           *low_watermark);
+
+        return SUCCESS();
+    } // evict_from_cache
+
+    // An entry of the sync queue, see SYNC_PENDING_ATTR. The logical path is looked up before the sync, and is empty if
+    // the data object no longer exists.
+    struct sync_queue_entry
+    {
+        std::string data_id;
+        std::string token;
+        std::string logical_path;
+    }; // struct sync_queue_entry
+
+    // Returns up to MAX_ORPHANED_SYNCS_PER_AGENT entries of the sync queue which were queued longer than _orphan_age
+    // seconds ago, i.e. by agents which exited before performing the sync.
+    auto get_orphaned_syncs(RsComm& _comm, const std::string& _compound_resc_name, const std::int64_t _orphan_age)
+        -> std::vector<sync_queue_entry>
+    {
+        std::vector<sync_queue_entry> orphans;
+
+        const auto gql = fmt::format("select META_RESC_ATTR_VALUE, META_RESC_ATTR_UNITS "
+                                     "where RESC_NAME = '{}' and META_RESC_ATTR_NAME = '{}'",
+                                     _compound_resc_name,
+                                     SYNC_PENDING_ATTR);
+        const auto cutoff = current_timestamp_in_seconds() - _orphan_age;
+
+        for (auto&& row : irods::query{&_comm, gql}) {
+            try {
+                if (std::stoll(row[1].substr(0, row[1].find(':'))) > cutoff) {
+                    continue;
+                }
+            }
+            catch (const std::exception&) {
+                // An entry with a malformed time is treated as abandoned.
+            }
+
+            orphans.push_back({row[0], row[1], ""});
+
+            if (orphans.size() >= MAX_ORPHANED_SYNCS_PER_AGENT) {
+                break;
+            }
+        }
+
+        return orphans;
+    } // get_orphaned_syncs
+
+    // Looks up the current logical path of the data object of each entry. Entries are queued by data id, so that a
+    // data object renamed before the sync is still synced.
+    auto resolve_sync_queue_entries(RsComm& _comm, std::vector<sync_queue_entry>& _entries) -> void
+    {
+        constexpr std::size_t ids_per_query = 100;
+
+        std::vector<rodsLong_t> ids;
+        for (const auto& entry : _entries) {
+            try {
+                ids.push_back(std::stoll(entry.data_id));
+            }
+            catch (const std::exception&) {
+                // A malformed entry names no data object, and is only removed.
+            }
+        }
+
+        std::map<std::string, std::string> logical_paths;
+
+        for (std::size_t first = 0; first < ids.size(); first += ids_per_query) {
+            const auto last = std::min(ids.size(), first + ids_per_query);
+            const auto gql = fmt::format("select DATA_ID, COLL_NAME, DATA_NAME where DATA_ID in ({})",
+                                         make_data_id_list(ids.begin() + first, ids.begin() + last));
+
+            for (auto&& row : irods::query{&_comm, gql}) {
+                logical_paths.try_emplace(row[0], fmt::format("{}/{}", row[1], row[2]));
+            }
+        }
+
+        for (auto& entry : _entries) {
+            if (const auto iter = logical_paths.find(entry.data_id); iter != logical_paths.end()) {
+                entry.logical_path = iter->second;
+            }
+        }
+    } // resolve_sync_queue_entries
+
+    // Syncs the cache replica of a queued data object to the archive, unless the archive replica is already good, and
+    // removes the queue entry. _synced is set if a sync was performed.
+    auto sync_queued_data_object(RsComm& _comm,
+                                 irods::plugin_property_map& _props,
+                                 const std::string& _compound_resc_name,
+                                 const sync_queue_entry& _entry,
+                                 bool& _synced) -> irods::error
+    {
+        _synced = false;
+
+        // Only the entry read before the sync is removed. If the data object is written and queued again in the
+        // meantime, the new entry has a different token and survives.
+        const auto dequeue = [&] {
+            const auto ec =
+                modify_avu(_comm, "rm", "-R", _compound_resc_name, SYNC_PENDING_ATTR, _entry.data_id, _entry.token);
+
+            if (ec < 0 && CAT_SUCCESS_BUT_WITH_NO_INFO != ec) {
+                log_resource::warn("[{}]: failed to remove the sync queue entry of data id [{}] [error_code={}].",
+                                   _compound_resc_name,
+                                   _entry.data_id,
+                                   ec);
+            }
+        };
+
+        if (_entry.logical_path.empty()) {
+            log_resource::debug(
+                "[{}]: data id [{}] no longer exists; nothing to sync.", _compound_resc_name, _entry.data_id);
+            dequeue();
+            return SUCCESS();
+        }
+
+        std::string cache_name;
+        std::string archive_name;
+        if (auto err = _props.get<std::string>(CACHE_CONTEXT_TYPE, cache_name); !err.ok()) {
+            return PASS(err);
+        }
+        if (auto err = _props.get<std::string>(ARCHIVE_CONTEXT_TYPE, archive_name); !err.ok()) {
+            return PASS(err);
+        }
+
+        dataObjInp_t inp{};
+        const irods::at_scope_exit free_cond_input{[&inp] { clearKeyVal(&inp.condInput); }};
+        std::snprintf(inp.objPath, sizeof(inp.objPath), "%s", _entry.logical_path.c_str());
+
+        irods::file_object_ptr obj(new irods::file_object());
+        if (const auto err = irods::file_object_factory(&_comm, &inp, obj); !err.ok()) {
+            // The data object was removed or renamed after its path was looked up. Leave the entry for a later attempt.
+            return PASS(err);
+        }
+
+        std::optional<irods::physical_object> cache_replica;
+        std::optional<irods::physical_object> archive_replica;
+        for (const auto& replica : obj->replicas()) {
+            const auto leaf = irods::hierarchy_parser{replica.resc_hier()}.last_resc();
+            if (leaf == cache_name) {
+                cache_replica = replica;
+            }
+            else if (leaf == archive_name) {
+                archive_replica = replica;
+            }
+        }
+
+        // Several writes queued before the sync are all covered by it.
+        if (archive_replica && GOOD_REPLICA == archive_replica->replica_status()) {
+            dequeue();
+            return SUCCESS();
+        }
+
+        if (!cache_replica) {
+            dequeue();
+            return ERROR(
+                SYS_REPLICA_DOES_NOT_EXIST,
+                fmt::format("no replica of [{}] in cache resource [{}] to sync", _entry.logical_path, cache_name));
+        }
+
+        // The cache replica is being written or was left stale. Leave the entry for a later attempt.
+        if (GOOD_REPLICA != cache_replica->replica_status()) {
+            return SUCCESS();
+        }
+
+        obj->resc_hier(cache_replica->resc_hier());
+        addKeyVal((keyValPair_t*)&obj->cond_input(), ADMIN_KW, "");
+
+        irods::plugin_context ctx{&_comm, _props, obj, ""};
+        if (auto err = repl_object(ctx, irods::hierarchy_parser{cache_replica->resc_hier()}, SYNC_OBJ_KW); !err.ok()) {
+            return PASS(err);
+        }
+
+        _synced = true;
+        dequeue();
+
+        return SUCCESS();
+    } // sync_queued_data_object
+
+    // Performs the syncs to the archive of the queue entries, until the deadline if one is given.
+    auto drain_sync_queue(RsComm& _comm,
+                          irods::plugin_property_map& _props,
+                          const std::string& _compound_resc_name,
+                          std::vector<sync_queue_entry> _entries,
+                          std::uint64_t& _synced,
+                          const std::optional<std::int64_t> _deadline = std::nullopt) -> irods::error
+    {
+        resolve_sync_queue_entries(_comm, _entries);
+
+        // The work is ordered by logical path, which keeps data objects in the same collection - and so in the same
+        // region of the archive's vault - together.
+        std::sort(_entries.begin(), _entries.end(), [](const auto& _lhs, const auto& _rhs) {
+            return _lhs.logical_path < _rhs.logical_path;
+        });
+
+        irods::error result = SUCCESS();
+        std::uint64_t synced = 0;
+
+        for (const auto& entry : _entries) {
+            if (_deadline && current_timestamp_in_seconds() >= *_deadline) {
+                break;
+            }
+
+            bool entry_synced = false;
+            if (auto err = sync_queued_data_object(_comm, _props, _compound_resc_name, entry, entry_synced);
+                !err.ok()) {
+                irods::log(PASSMSG(
+                    fmt::format("[{}]: failed to sync [{}] to the archive.", _compound_resc_name, entry.logical_path),
+                    err));
+                result = err;
+                continue;
+            }
+
+            if (entry_synced) {
+                ++synced;
+            }
+        }
+
+        log_resource::debug("[{}]: synced [{}] of [{}] queued data objects to the archive.",
+                            _compound_resc_name,
+                            synced,
+                            _entries.size());
+
+        _synced += synced;
+
+        return result;
+    } // drain_sync_queue
+
+    // Takes over the syncs abandoned by agents which exited before performing them. Only one agent at a time searches
+    // for abandoned syncs, and at most once per retry interval, so the queue is drained even if no agent queues
+    // anything for the compound resource again.
+    auto drain_abandoned_syncs(RsComm& _comm,
+                               irods::plugin_property_map& _props,
+                               const std::string& _compound_resc_name,
+                               std::uint64_t& _synced) -> irods::error
+    {
+        auto orphan_age = get_context_integer(_props, ASYNC_SYNC_ORPHAN_AGE).value_or(DEFAULT_ASYNC_SYNC_ORPHAN_AGE);
+        if (orphan_age < 0) {
+            orphan_age = DEFAULT_ASYNC_SYNC_ORPHAN_AGE;
+        }
+
+        auto retry_interval =
+            get_context_integer(_props, ASYNC_SYNC_RETRY_INTERVAL).value_or(DEFAULT_ASYNC_SYNC_RETRY_INTERVAL);
+        if (retry_interval < 0) {
+            retry_interval = DEFAULT_ASYNC_SYNC_RETRY_INTERVAL;
+        }
+
+        const auto token =
+            acquire_maintenance_lock(_comm, _compound_resc_name, SYNC_QUEUE_LOCK_ATTR, SYNC_QUEUE_LOCK_DURATION);
+        if (!token) {
+            return SUCCESS();
+        }
+
+        const irods::at_scope_exit release_lock{[&] {
+            release_maintenance_lock(_comm, _compound_resc_name, SYNC_QUEUE_LOCK_ATTR, *token, retry_interval);
+        }};
+
+        auto orphans = get_orphaned_syncs(_comm, _compound_resc_name, orphan_age);
+        if (orphans.empty()) {
+            return SUCCESS();
+        }
+
+        // Stop well before the lock expires, so that no other agent takes over the same syncs at the same time.
+        const auto deadline = current_timestamp_in_seconds() + SYNC_QUEUE_LOCK_DURATION / 2;
+
+        return drain_sync_queue(_comm, _props, _compound_resc_name, std::move(orphans), _synced, deadline);
+    } // drain_abandoned_syncs
+
+    // The idle maintenance operation of the compound resource. Performs the syncs this agent queued, one at a time,
+    // until IDLE_SYNC_BUDGET_IN_MILLISECONDS have passed. Every attempted entry is forgotten by the agent, whether or
+    // not the sync succeeded. An entry left in the catalog is taken over as an abandoned sync later.
+    auto drain_pending_syncs(RsComm& _comm, irods::plugin_property_map& _props, const std::string& _compound_resc_name)
+        -> irods::error
+    {
+        using clock_type = std::chrono::steady_clock;
+
+        const auto deadline = clock_type::now() + std::chrono::milliseconds{IDLE_SYNC_BUDGET_IN_MILLISECONDS};
+        auto& activity = get_cache_activity(_compound_resc_name);
+
+        const scoped_service_account service_account{_comm};
+
+        irods::error result = SUCCESS();
+
+        try {
+            while (!activity.pending_syncs.empty() && clock_type::now() < deadline) {
+                const auto iter = activity.pending_syncs.begin();
+                std::vector<sync_queue_entry> entry{{std::to_string(iter->first), iter->second, ""}};
+                activity.pending_syncs.erase(iter);
+
+                auto err = drain_sync_queue(_comm, _props, _compound_resc_name, std::move(entry), activity.idle_syncs);
+                if (!err.ok()) {
+                    result = err;
+                }
+            }
+        }
+        catch (const irods::exception& e) {
+            return irods::error(e);
+        }
+        catch (const std::exception& e) {
+            return ERROR(SYS_INTERNAL_ERR, e.what());
+        }
+
+        return result;
+    } // drain_pending_syncs
+
+    // The post-disconnect maintenance operation of the compound resource. Records the cache accesses of the client
+    // session, performs the queued syncs to the archive, evicts replicas from the cache if it grew past its high
+    // watermark, and updates the cache metrics.
+    auto maintain_cache(const std::string& _compound_resc_name, irods::plugin_property_map& _props) -> irods::error
+    {
+        // Take the activity so that anything recorded during maintenance (i.e. by the trims) is not processed again.
+        const auto activity = std::exchange(get_cache_activity(_compound_resc_name), cache_activity{});
+        const auto asynchronous = sync_is_asynchronous(_props);
+
+        // An agent which did not use the compound resource still takes over abandoned syncs, on the connection of its
+        // own client.
+        auto* comm_ptr = activity.comm ? activity.comm : ThisComm;
+        if ((activity.empty() && !asynchronous) || !comm_ptr) {
+            return SUCCESS();
+        }
+
+        auto& comm = *comm_ptr;
+
+        // The client is gone, so act as the service account. It must be able to read and update the metadata of, and
+        // trim, data objects which the client may not have had access to.
+        const scoped_service_account service_account{comm};
+
+        eviction_summary evicted;
+        std::uint64_t synced = activity.idle_syncs;
+        irods::error result = SUCCESS();
+
+        try {
+            auto granularity = get_context_integer(_props, CACHE_ACCESS_TIME_GRANULARITY)
+                                   .value_or(DEFAULT_CACHE_ACCESS_TIME_GRANULARITY);
+            if (granularity <= 0) {
+                granularity = 1;
+            }
+
+            if (!activity.accesses.empty() || !activity.removals.empty()) {
+                std::string cache_resc_name;
+                if (auto err = _props.get<std::string>(CACHE_CONTEXT_TYPE, cache_resc_name); !err.ok()) {
+                    return PASS(err);
+                }
+
+                flush_cache_accesses(comm, cache_resc_name, activity.accesses, granularity);
+
+                for (const auto data_id : activity.removals) {
+                    forget_cache_accesses(comm, cache_resc_name, data_id);
+                }
+            }
+
+            // Sync before evicting. Only replicas with a good archive replica may be evicted.
+            if (!activity.pending_syncs.empty()) {
+                std::vector<sync_queue_entry> queued;
+                for (const auto& [data_id, token] : activity.pending_syncs) {
+                    queued.push_back({std::to_string(data_id), token, ""});
+                }
+
+                result = drain_sync_queue(comm, _props, _compound_resc_name, std::move(queued), synced);
+            }
+
+            if (asynchronous) {
+                if (auto err = drain_abandoned_syncs(comm, _props, _compound_resc_name, synced); !err.ok()) {
+                    result = err;
+                }
+            }
+
+            if (activity.cache_grew) {
+                if (auto err = evict_from_cache(comm, _props, _compound_resc_name, granularity, evicted); !err.ok()) {
+                    result = err;
+                }
+            }
+
+            if (!activity.empty() || synced > 0) {
+                add_to_cache_metrics(comm,
+                                     _compound_resc_name,
+                                     {{"hits", activity.hits},
+                                      {"misses", activity.misses},
+                                      {"evictions", evicted.replicas},
+                                      {"archive_syncs", synced},
+                                      {"evicted_bytes", static_cast<std::uint64_t>(evicted.bytes)}});
+            }
+        }
+        catch (const irods::exception& e) {
+            return irods::error(e);
+        }
+        catch (const std::exception& e) {
+            return ERROR(SYS_INTERNAL_ERR, e.what());
+        }
+
+        return result;
+    } // maintain_cache
+} // anonymous namespace
+
 
 // =-=-=-=-=-=-=-
 // 3. create derived class to handle universal mss resources
@@ -2355,16 +3681,52 @@ class compound_resource : public irods::resource {
         }
 
         // =-=-=-=-=-=-
-        // override from plugin_base
+        // override from plugin_base - maintenance is needed once this agent
+        // has used the cache on behalf of the client.  with asynchronous
+        // syncs, agents on the catalog provider also look for syncs abandoned
+        // by other agents, which costs them a single query while another
+        // agent has looked recently.  the provider needs no connection to
+        // reach the catalog, and the queue is drained even if no agent uses
+        // the compound resource again.
         irods::error need_post_disconnect_maintenance_operation( bool& _flg ) {
-            _flg = false;
+            _flg = !get_cache_activity( instance_name_ ).empty();
+
+            if ( !_flg && sync_is_asynchronous( properties_ ) ) {
+                std::string role;
+                _flg = get_catalog_service_role( role ).ok() &&
+                       irods::KW_CFG_SERVICE_ROLE_PROVIDER == role;
+            }
+
             return SUCCESS();
         }
 
         // =-=-=-=-=-=-
-        // override from plugin_base
-        irods::error post_disconnect_maintenance_operation( irods::pdmo_type& ) {
-            return ERROR( -1, "nop" );
+        // override from plugin_base - the syncs queued by this agent are
+        // performed between the requests of the client, so that the archive
+        // replicas do not stay stale for as long as the client is connected
+        irods::error need_idle_maintenance_operation( bool& _flg ) {
+            _flg = !get_cache_activity( instance_name_ ).pending_syncs.empty();
+            return SUCCESS();
+        }
+
+        // =-=-=-=-=-=-
+        // override from plugin_base - perform queued syncs to the archive
+        // for a bounded time while the client is idle
+        irods::error idle_maintenance_operation( rsComm_t* _comm ) {
+            if ( !_comm ) {
+                return ERROR( SYS_INTERNAL_NULL_INPUT_ERR, "null comm" );
+            }
+            return drain_pending_syncs( *_comm, properties_, instance_name_ );
+        }
+
+        // =-=-=-=-=-=-
+        // override from plugin_base - record cache accesses and evict from
+        // the cache once the client disconnects
+        irods::error post_disconnect_maintenance_operation( irods::pdmo_type& _op ) {
+            _op = [this]( rcComm_t* ) -> irods::error {
+                return maintain_cache( instance_name_, properties_ );
+            };
+            return SUCCESS();
         }
 }; // class compound_resource
 
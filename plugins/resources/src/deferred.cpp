@@ -219,7 +219,7 @@ irods::error deferred_file_read(irods::plugin_context& _ctx,
     }
 
     // call read on the child
-    const auto ret = resc->call<void*, const int>(_ctx.comm(), irods::RESOURCE_OP_READ, _ctx.fco(), _buf, _len);
+    const auto ret = resc->call<void*, const int>(_ctx.comm(), irods::RESOURCE_OP_READ_INDEX, _ctx.fco(), _buf, _len);
     if (!ret.ok()) {
         return PASSMSG("Failed calling read on the child.", ret);
     }
@@ -239,7 +239,8 @@ irods::error deferred_file_write(irods::plugin_context& _ctx,
     }
 
     // call write on the child
-    const auto ret = resc->call<const void*, const int>(_ctx.comm(), irods::RESOURCE_OP_WRITE, _ctx.fco(), _buf, _len);
+    const auto ret = resc->call<const void*, const int>(_ctx.comm(), irods::RESOURCE_OP_WRITE_INDEX,
+                                                        _ctx.fco(), _buf, _len);
     if (!ret.ok()) {
         return PASSMSG("Failed calling write on the child.", ret);
     }
@@ -16,9 +16,11 @@
 #include "irods/irods_resource_redirect.hpp"
 #include "irods/irods_stacktrace.hpp"
 #include "irods/irods_kvp_string_parser.hpp"
+#include "irods/load_digest_cache.hpp"
 
 // =-=-=-=-=-=-=-
 // stl includes
+#include <chrono>
 #include <iostream>
 #include <sstream>
 #include <vector>
@@ -40,6 +42,12 @@ const std::string DEFER_POLICY_KEY( "defer_policy" );
 /// @brief string specifying the prefer localhost deferral policy
 const std::string DEFER_POLICY_LOCALHOST( "localhost_defer_policy" );
 
+/// =-=-=-=-=-=-=-
+/// @brief Key to the number of seconds the cached load digests may be used
+///        before they are read from the catalog again.  zero disables caching.
+const std::string LOAD_DIGEST_TTL_KEY( "load_digest_ttl_in_seconds" );
+const int DEFAULT_LOAD_DIGEST_TTL = 60;
+
 /// @brief Check the general parameters passed in to most plugin functions
 template<typename DEST_TYPE>
 inline irods::error load_balanced_check_params(irods::plugin_context& _ctx)
@@ -177,7 +185,7 @@ irods::error load_balanced_file_read(irods::plugin_context& _ctx,
     }
 
     // call read on the child
-    const auto ret = resc->call<void*, const int>(_ctx.comm(), irods::RESOURCE_OP_READ, _ctx.fco(), _buf, _len);
+    const auto ret = resc->call<void*, const int>(_ctx.comm(), irods::RESOURCE_OP_READ_INDEX, _ctx.fco(), _buf, _len);
     if (!ret.ok()) {
         return PASSMSG("Failed calling operation on child resource.", ret);
     }
@@ -197,7 +205,8 @@ irods::error load_balanced_file_write(irods::plugin_context& _ctx,
     }
 
     // call write on the child
-    const auto ret = resc->call<const void*, const int>(_ctx.comm(), irods::RESOURCE_OP_WRITE, _ctx.fco(), _buf, _len);
+    const auto ret = resc->call<const void*, const int>(_ctx.comm(), irods::RESOURCE_OP_WRITE_INDEX,
+                                                        _ctx.fco(), _buf, _len);
     if (!ret.ok()) {
         return PASSMSG("Failed calling operation on child resource.", ret);
     }
@@ -541,12 +550,10 @@ irods::error load_balanced_file_notify(irods::plugin_context& _ctx,
 } // load_balanced_file_notify
 
 /// =-=-=-=-=-=-=-
-/// @brief get the loads, times and names from the resource monitoring table
-irods::error get_load_lists(
+/// @brief query the resource monitoring table for the latest load of each resource
+irods::error query_load_digests(
     irods::plugin_context& _ctx,
-    std::vector< std::string >&     _resc_names,
-    std::vector< int >&             _resc_loads,
-    std::vector< int >&             _resc_times ) {
+    std::vector< irods::experimental::load_digest_cache::load_digest >& _digests ) {
     // =-=-=-=-=-=-=-
     //
     int i = 0, j = 0, nresc = 0, status = 0;
@@ -569,11 +576,9 @@ irods::error get_load_lists(
     if ( status == 0 ) {
         nresc = genQueryOut->rowCnt;
         // =-=-=-=-=-=-=-
-        // vectors should be sized to number of resources
-        // these vectors will be indexed directly, not built
-        _resc_names.resize( nresc );
-        _resc_loads.resize( nresc );
-        _resc_times.resize( nresc );
+        // vector should be sized to number of rows
+        // this vector will be indexed directly, not built
+        _digests.resize( nresc );
 
         for ( i = 0; i < genQueryOut->attriCnt; i++ ) {
             for ( j = 0; j < nresc; j++ ) {
@@ -581,13 +586,13 @@ irods::error get_load_lists(
                 tResult += j * genQueryOut->sqlResult[i].len;
                 switch ( i ) {
                 case 0:
-                    _resc_names[j] = tResult;
-
+                    _digests[j].resource_name = tResult;
+                    break;
                 case 1:
-                    _resc_loads[j] = atoi( tResult );
+                    _digests[j].load_factor = atoi( tResult );
                     break;
                 case 2:
-                    _resc_times[j] = atoi( tResult );
+                    _digests[j].create_time = atoll( tResult );
                     break;
                 }
             }
@@ -604,6 +609,47 @@ irods::error get_load_lists(
 
     return SUCCESS();
 
+} // query_load_digests
+
+/// =-=-=-=-=-=-=-
+/// @brief get the loads, times and names from the resource monitoring table.
+///        the latest loads are shared by all agents on this server, and only
+///        read from the catalog again once they are older than the ttl of
+///        this resource.
+irods::error get_load_lists(
+    irods::plugin_context& _ctx,
+    std::vector< std::string >&     _resc_names,
+    std::vector< int >&             _resc_loads,
+    std::vector< int >&             _resc_times ) {
+    namespace ldc = irods::experimental::load_digest_cache;
+
+    auto digests = ldc::lookup();
+    if ( !digests ) {
+        digests.emplace();
+        irods::error ret = query_load_digests( _ctx, *digests );
+        if ( !ret.ok() ) {
+            return PASS( ret );
+        }
+
+        int ttl = DEFAULT_LOAD_DIGEST_TTL;
+        _ctx.prop_map().get< int >( LOAD_DIGEST_TTL_KEY, ttl );
+        if ( ttl > 0 ) {
+            ldc::assign( *digests, std::chrono::seconds( ttl ) );
+        }
+    }
+
+    _resc_names.reserve( digests->size() );
+    _resc_loads.reserve( digests->size() );
+    _resc_times.reserve( digests->size() );
+
+    for ( const auto& digest : *digests ) {
+        _resc_names.push_back( digest.resource_name );
+        _resc_loads.push_back( digest.load_factor );
+        _resc_times.push_back( static_cast< int >( digest.create_time ) );
+    }
+
+    return SUCCESS();
+
 } // get_load_lists
 
 
@@ -939,6 +985,21 @@ class load_balanced_resource : public irods::resource {
                     "load_balanced_resource :: using localhost policy, none specified" );
             }
 
+            int ttl = DEFAULT_LOAD_DIGEST_TTL;
+            if ( kvp.end() != kvp.find( LOAD_DIGEST_TTL_KEY ) ) {
+                try {
+                    ttl = boost::lexical_cast< int >( kvp[ LOAD_DIGEST_TTL_KEY ] );
+                }
+                catch ( const boost::bad_lexical_cast& ) {
+                    rodsLog(
+                        LOG_ERROR,
+                        "libload_balanced: invalid %s [%s]",
+                        LOAD_DIGEST_TTL_KEY.c_str(),
+                        kvp[ LOAD_DIGEST_TTL_KEY ].c_str() );
+                }
+            }
+            properties_.set< int >( LOAD_DIGEST_TTL_KEY, ttl );
+
         }
 
         // =-=-=-=-=-=-
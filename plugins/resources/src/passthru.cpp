@@ -226,7 +226,7 @@ irods::error passthru_file_read(
             result = PASSMSG( "failed getting the first child resource pointer.", ret );
         }
         else {
-            ret = resc->call<void*, const int>( _ctx.comm(), irods::RESOURCE_OP_READ, _ctx.fco(), _buf, _len );
+            ret = resc->call<void*, const int>( _ctx.comm(), irods::RESOURCE_OP_READ_INDEX, _ctx.fco(), _buf, _len );
             result = PASSMSG( "passthru_file_read_plugin - failed calling child read.", ret );
         }
     }
@@ -253,7 +253,8 @@ irods::error passthru_file_write(
             result = PASSMSG( "failed getting the first child resource pointer.", ret );
         }
         else {
-            ret = resc->call<const void*, const int>( _ctx.comm(), irods::RESOURCE_OP_WRITE, _ctx.fco(), _buf, _len );
+            ret = resc->call<const void*, const int>( _ctx.comm(), irods::RESOURCE_OP_WRITE_INDEX,
+                                                      _ctx.fco(), _buf, _len );
             result = PASSMSG( "passthru_file_write_plugin - failed calling child write.", ret );
         }
     }
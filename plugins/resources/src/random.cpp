@@ -246,7 +246,7 @@ irods::error random_file_read(
     }
 
     // call read on the child
-    const auto ret = resc->call<void*, const int>(_ctx.comm(), irods::RESOURCE_OP_READ, _ctx.fco(), _buf, _len);
+    const auto ret = resc->call<void*, const int>(_ctx.comm(), irods::RESOURCE_OP_READ_INDEX, _ctx.fco(), _buf, _len);
     if (!ret.ok()) {
         return PASSMSG("Failed calling operation on child resource.", ret);
     }
@@ -267,7 +267,8 @@ irods::error random_file_write(
     }
 
     // call write on the child
-    const auto ret = resc->call<const void*, const int>(_ctx.comm(), irods::RESOURCE_OP_WRITE, _ctx.fco(), _buf, _len);
+    const auto ret = resc->call<const void*, const int>(_ctx.comm(), irods::RESOURCE_OP_WRITE_INDEX,
+                                                        _ctx.fco(), _buf, _len);
     if (!ret.ok()) {
         return PASSMSG("Failed calling operation on child resource.", ret);
     }
@@ -33,6 +33,9 @@
 #include <string>
 #include <sstream>
 #include <fstream>
+#include <map>
+#include <memory>
+#include <algorithm>
 
 // =-=-=-=-=-=-=-
 // boost includes
@@ -62,6 +65,13 @@ typedef struct tarSubFileDesc {
     int fd;                         /* the fd of the opened cached subFile */
     char cacheFilePath[MAX_NAME_LEN];   /* the phy path name of the cached
                                          * subFile */
+    int indexed;                    /* served from the member index rather
+                                     * than the cache dir */
+    rodsLong_t memberOffset;        /* offset of the member data in the archive */
+    rodsLong_t memberSize;          /* size of the member data */
+    rodsLong_t memberPos;           /* read position within the member */
+    int direntInx;                  /* next entry of an indexed dir listing */
+    char memberPath[MAX_NAME_LEN];  /* member path of an indexed dir listing */
 } tarSubFileDesc_t;
 
 #define NUM_TAR_SUB_FILE_DESC 20
@@ -88,6 +98,25 @@ const int NUM_STRUCT_FILE_DESC = 16;
 structFileDesc_t PluginStructFileDesc[ NUM_STRUCT_FILE_DESC  ];
 tarSubFileDesc_t PluginTarSubFileDesc[ NUM_TAR_SUB_FILE_DESC ];
 
+// =-=-=-=-=-=-=-=-
+// member index of an uncompressed tar file, used to serve read only
+// access to members directly from the archive without staging it
+struct tar_member_t {
+    rodsLong_t offset;  // offset of the member data within the archive
+    rodsLong_t size;
+    mode_t     mode;
+    time_t     mtime;
+};
+
+struct tar_member_index_t {
+    std::map< std::string, tar_member_t >               members;
+    std::map< std::string, std::vector< std::string > > children;
+};
+
+// =-=-=-=-=-=-=-=-
+// member indices, one per entry in the PluginStructFileDesc table
+std::unique_ptr< tar_member_index_t > PluginTarMemberIndex[ NUM_STRUCT_FILE_DESC ];
+
 // =-=-=-=-=-=-=-=-
 // manager of resource plugins which are resolved and cached
 extern irods::resource_manager resc_mgr;
@@ -99,6 +128,9 @@ extern irods::resource_manager resc_mgr;
 irods::error tarfilesystem_resource_start( irods::plugin_property_map& ) {
     memset( PluginStructFileDesc, 0, sizeof( structFileDesc_t ) * NUM_STRUCT_FILE_DESC );
     memset( PluginTarSubFileDesc, 0, sizeof( tarSubFileDesc_t ) * NUM_TAR_SUB_FILE_DESC );
+    for ( auto& index : PluginTarMemberIndex ) {
+        index.reset();
+    }
     return SUCCESS();
 }
 
@@ -108,6 +140,9 @@ irods::error tarfilesystem_resource_start( irods::plugin_property_map& ) {
 irods::error tarfilesystem_resource_stop( irods::plugin_property_map& ) {
     memset( PluginStructFileDesc, 0, sizeof( structFileDesc_t ) * NUM_STRUCT_FILE_DESC );
     memset( PluginTarSubFileDesc, 0, sizeof( tarSubFileDesc_t ) * NUM_TAR_SUB_FILE_DESC );
+    for ( auto& index : PluginTarMemberIndex ) {
+        index.reset();
+    }
     return SUCCESS();
 }
 
@@ -593,6 +628,7 @@ int free_struct_file_desc( int _idx ) {
     }
 
     memset( &PluginStructFileDesc[ _idx ], 0, sizeof( structFileDesc_t ) );
+    PluginTarMemberIndex[ _idx ].reset();
 
     return 0;
 
@@ -622,7 +658,8 @@ irods::error tar_struct_file_open(
     specColl_t*        _spec_coll,
     int&               _struct_desc_index,
     const std::string& _resc_hier,
-    std::string&       _resc_host ) {
+    std::string&       _resc_host,
+    const bool         _stage = true ) {
     int status                  = 0;
     specCollCache_t* spec_cache = 0;
 
@@ -642,6 +679,22 @@ irods::error tar_struct_file_open(
     // look for opened PluginStructFileDesc
     _struct_desc_index = match_struct_file_desc( _spec_coll );
     if ( _struct_desc_index > 0 ) {
+        // =-=-=-=-=-=-=-
+        // an earlier read only operation may have left the archive unstaged
+        specColl_t* cached_spec_coll = PluginStructFileDesc[ _struct_desc_index ].specColl;
+        if ( _stage && strlen( cached_spec_coll->cacheDir ) == 0 ) {
+            std::string location;
+            irods::error ret = irods::get_loc_for_hier_string( cached_spec_coll->rescHier, location );
+            if ( !ret.ok() ) {
+                return PASSMSG( "tar_struct_file_open - failed in get_loc_for_hier_string", ret );
+            }
+
+            irods::error stage_err = stage_tar_struct_file( _struct_desc_index, location );
+            if ( !stage_err.ok() ) {
+                return PASSMSG( "stage_tar_struct_file failed.", stage_err );
+            }
+        }
+
         return SUCCESS();
     }
 
@@ -721,6 +774,13 @@ irods::error tar_struct_file_open(
     // =-=-=-=-=-=-=-
     // TODO :: need to deal with remote open here
 
+    // =-=-=-=-=-=-=-
+    // read only operations may be served from the member index instead,
+    // in which case staging is left to resolve_tar_member_index
+    if ( !_stage ) {
+        return CODE( _struct_desc_index );
+    }
+
     // =-=-=-=-=-=-=-
     // stage the tar file so we can get at its tasty innards
     irods::error stage_err = stage_tar_struct_file( _struct_desc_index, _resc_host );
@@ -735,6 +795,426 @@ irods::error tar_struct_file_open(
 
 } // tar_struct_file_open
 
+// =-=-=-=-=-=-=-
+// open the archive of a struct file for read via the irods api
+int open_tar_archive( int _index ) {
+    specColl_t* spec_coll = PluginStructFileDesc[ _index ].specColl;
+
+    // =-=-=-=-=-=-=-
+    // extract the host location from the resource hierarchy
+    std::string location;
+    irods::error ret = irods::get_loc_for_hier_string( spec_coll->rescHier, location );
+    if ( !ret.ok() ) {
+        irods::log( PASSMSG( "open_tar_archive - failed in get_loc_for_hier_string", ret ) );
+        return ret.code();
+    }
+
+    fileOpenInp_t f_inp;
+    memset( &f_inp, 0, sizeof( f_inp ) );
+    rstrcpy( f_inp.resc_name_,    spec_coll->resource, MAX_NAME_LEN );
+    rstrcpy( f_inp.resc_hier_,    spec_coll->rescHier, MAX_NAME_LEN );
+    rstrcpy( f_inp.objPath,       spec_coll->objPath,  MAX_NAME_LEN );
+    rstrcpy( f_inp.addr.hostAddr, location.c_str(),    NAME_LEN );
+    rstrcpy( f_inp.fileName,      spec_coll->phyPath,  MAX_NAME_LEN );
+    f_inp.mode  = getDefFileMode();
+    f_inp.flags = O_RDONLY;
+    return rsFileOpen( PluginStructFileDesc[ _index ].rsComm, &f_inp );
+
+} // open_tar_archive
+
+// =-=-=-=-=-=-=-
+// positioned read from an open archive via the irods api
+int read_tar_archive(
+    rsComm_t*  _comm,
+    int        _fd,
+    rodsLong_t _offset,
+    void*      _buf,
+    int        _len ) {
+    fileLseekInp_t lseek_inp;
+    memset( &lseek_inp, 0, sizeof( lseek_inp ) );
+    lseek_inp.fileInx = _fd;
+    lseek_inp.offset  = _offset;
+    lseek_inp.whence  = SEEK_SET;
+
+    fileLseekOut_t* lseek_out = NULL;
+    int status = rsFileLseek( _comm, &lseek_inp, &lseek_out );
+    free( lseek_out );
+    if ( status < 0 ) {
+        return status;
+    }
+
+    fileReadInp_t read_inp;
+    memset( &read_inp, 0, sizeof( read_inp ) );
+    read_inp.fileInx = _fd;
+    read_inp.len     = _len;
+
+    bytesBuf_t read_buf;
+    memset( &read_buf, 0, sizeof( read_buf ) );
+    read_buf.buf = _buf;
+    read_buf.len = _len;
+
+    return rsFileRead( _comm, &read_inp, &read_buf );
+
+} // read_tar_archive
+
+// =-=-=-=-=-=-=-
+// parse a numeric tar header field, either octal or gnu base-256
+rodsLong_t parse_tar_number( const char* _field, size_t _len ) {
+    rodsLong_t value = 0;
+    if ( static_cast< unsigned char >( _field[ 0 ] ) & 0x80 ) {
+        value = static_cast< unsigned char >( _field[ 0 ] ) & 0x3f;
+        for ( size_t i = 1; i < _len; ++i ) {
+            value = ( value << 8 ) | static_cast< unsigned char >( _field[ i ] );
+        }
+        return value;
+    }
+
+    size_t i = 0;
+    while ( i < _len && ( ' ' == _field[ i ] || '\0' == _field[ i ] ) ) {
+        ++i;
+    }
+    for ( ; i < _len && _field[ i ] >= '0' && _field[ i ] <= '7'; ++i ) {
+        value = ( value << 3 ) + ( _field[ i ] - '0' );
+    }
+
+    return value;
+
+} // parse_tar_number
+
+// =-=-=-=-=-=-=-
+// a header block is accepted only when it carries the ustar magic and
+// a valid checksum, which rules out compressed and pre-posix archives
+bool is_tar_header( const char* _block ) {
+    if ( memcmp( _block + 257, "ustar", 5 ) != 0 ) {
+        return false;
+    }
+
+    rodsLong_t sum = 0;
+    for ( int i = 0; i < 512; ++i ) {
+        sum += ( i >= 148 && i < 156 ) ? ' ' : static_cast< unsigned char >( _block[ i ] );
+    }
+
+    return sum == parse_tar_number( _block + 148, 8 );
+
+} // is_tar_header
+
+// =-=-=-=-=-=-=-
+// pull the path and size overrides out of a pax extended header.
+// returns false for sparse members which cannot be served as is
+bool parse_pax_header(
+    const std::string& _data,
+    std::string&       _path,
+    rodsLong_t&        _size ) {
+    size_t pos = 0;
+    while ( pos < _data.size() ) {
+        // =-=-=-=-=-=-=-
+        // each record is formatted as "<length> <key>=<value>\n"
+        const size_t     space = _data.find( ' ', pos );
+        const rodsLong_t len   = strtoll( _data.c_str() + pos, NULL, 10 );
+        if ( std::string::npos == space || len <= 0 ||
+                pos + len > _data.size() || space >= pos + len ) {
+            return false;
+        }
+
+        const std::string record = _data.substr( space + 1, pos + len - space - 2 );
+        const size_t      eq     = record.find( '=' );
+        if ( std::string::npos != eq ) {
+            const std::string key = record.substr( 0, eq );
+            if ( "path" == key ) {
+                _path = record.substr( eq + 1 );
+            }
+            else if ( "size" == key ) {
+                _size = strtoll( record.c_str() + eq + 1, NULL, 10 );
+            }
+            else if ( 0 == key.compare( 0, 11, "GNU.sparse." ) ) {
+                return false;
+            }
+        }
+
+        pos += len;
+    }
+
+    return true;
+
+} // parse_pax_header
+
+// =-=-=-=-=-=-=-
+// strip the decorations tar allows around member names
+std::string normalize_tar_member_path( std::string _path ) {
+    while ( 0 == _path.compare( 0, 2, "./" ) || 0 == _path.compare( 0, 1, "/" ) ) {
+        _path.erase( 0, '/' == _path[ 0 ] ? 1 : 2 );
+    }
+    while ( !_path.empty() && '/' == _path[ _path.size() - 1 ] ) {
+        _path.erase( _path.size() - 1 );
+    }
+
+    return _path;
+
+} // normalize_tar_member_path
+
+// =-=-=-=-=-=-=-
+// add a member to the index, registering it and any implied parent
+// directories with their parents for readdir
+void add_tar_member(
+    tar_member_index_t& _member_index,
+    const std::string&  _name,
+    const tar_member_t& _member ) {
+    const std::string name = normalize_tar_member_path( _name );
+    if ( name.empty() ) {
+        return;
+    }
+
+    // =-=-=-=-=-=-=-
+    // later entries replace earlier ones, just as they do on extraction
+    const bool known = _member_index.members.count( name ) > 0;
+    _member_index.members[ name ] = _member;
+    if ( known ) {
+        return;
+    }
+
+    std::string child = name;
+    while ( true ) {
+        const size_t      pos    = child.rfind( '/' );
+        const std::string parent = std::string::npos == pos ? "" : child.substr( 0, pos );
+        _member_index.children[ parent ].push_back( child.substr( std::string::npos == pos ? 0 : pos + 1 ) );
+        if ( parent.empty() || _member_index.members.count( parent ) > 0 ) {
+            break;
+        }
+
+        _member_index.members[ parent ] = tar_member_t{ 0, 0, S_IFDIR | 0750, _member.mtime };
+        child = parent;
+    }
+
+} // add_tar_member
+
+// =-=-=-=-=-=-=-
+// scan the headers of an uncompressed ustar, gnu or pax archive and build
+// an index of its members.  formats and member types which cannot be served
+// straight from the archive are reported as SYS_NOT_SUPPORTED
+irods::error build_tar_member_index(
+    int                                    _index,
+    std::unique_ptr< tar_member_index_t >& _member_index ) {
+    constexpr rodsLong_t block_size               = 512;
+    constexpr rodsLong_t max_extended_header_size = 1024 * 1024;
+
+    rsComm_t*   comm      = PluginStructFileDesc[ _index ].rsComm;
+    specColl_t* spec_coll = PluginStructFileDesc[ _index ].specColl;
+
+    int fd = open_tar_archive( _index );
+    if ( fd < 0 ) {
+        std::stringstream msg;
+        msg << "build_tar_member_index - failed to open archive [";
+        msg << spec_coll->phyPath;
+        msg << "]";
+        return ERROR( fd, msg.str() );
+    }
+
+    auto member_index = std::make_unique< tar_member_index_t >();
+    member_index->members[ "" ] = tar_member_t{ 0, 0, S_IFDIR | 0750, 0 };
+
+    irods::error result = SUCCESS();
+    char         block[ block_size ];
+    rodsLong_t   offset = 0;
+    std::string  ext_path;
+    rodsLong_t   ext_size = -1;
+    while ( true ) {
+        int status = read_tar_archive( comm, fd, offset, block, block_size );
+        if ( status != block_size ) {
+            result = ERROR( status < 0 ? status : SYS_NOT_SUPPORTED,
+                            "build_tar_member_index - truncated archive" );
+            break;
+        }
+
+        // =-=-=-=-=-=-=-
+        // the end of the archive is marked with zeroed blocks
+        if ( std::all_of( block, block + block_size, []( char _c ) { return '\0' == _c; } ) ) {
+            break;
+        }
+
+        if ( !is_tar_header( block ) ) {
+            result = ERROR( SYS_NOT_SUPPORTED, "build_tar_member_index - not an uncompressed tar archive" );
+            break;
+        }
+
+        rodsLong_t       size        = parse_tar_number( block + 124, 12 );
+        const char       type        = block[ 156 ];
+        const rodsLong_t data_offset = offset + block_size;
+
+        // =-=-=-=-=-=-=-
+        // gnu long names and pax headers describe the member which follows
+        if ( 'L' == type || 'x' == type || 'g' == type ) {
+            if ( size > max_extended_header_size ) {
+                result = ERROR( SYS_NOT_SUPPORTED, "build_tar_member_index - extended header too large" );
+                break;
+            }
+
+            if ( 'g' != type ) {
+                std::string data( size, '\0' );
+                status = read_tar_archive( comm, fd, data_offset, &data[ 0 ], size );
+                if ( status != size ) {
+                    result = ERROR( status < 0 ? status : SYS_NOT_SUPPORTED,
+                                    "build_tar_member_index - truncated extended header" );
+                    break;
+                }
+
+                if ( 'L' == type ) {
+                    ext_path = data.c_str();
+                }
+                else if ( !parse_pax_header( data, ext_path, ext_size ) ) {
+                    result = ERROR( SYS_NOT_SUPPORTED, "build_tar_member_index - unsupported pax header" );
+                    break;
+                }
+            }
+
+            offset = data_offset + ( ( size + block_size - 1 ) / block_size ) * block_size;
+            continue;
+        }
+
+        if ( ext_size >= 0 ) {
+            size = ext_size;
+        }
+
+        std::string name = ext_path;
+        if ( name.empty() ) {
+            name = std::string( block, strnlen( block, 100 ) );
+
+            // =-=-=-=-=-=-=-
+            // posix ustar splits long names across the prefix field
+            if ( 0 == memcmp( block + 257, "ustar\0", 6 ) && '\0' != block[ 345 ] ) {
+                name = std::string( block + 345, strnlen( block + 345, 155 ) ) + "/" + name;
+            }
+        }
+
+        ext_path.clear();
+        ext_size = -1;
+
+        // =-=-=-=-=-=-=-
+        // links, devices and sparse members are left to extraction
+        mode_t mode = parse_tar_number( block + 100, 8 ) & 07777;
+        if ( '0' == type || '\0' == type || '7' == type ) {
+            mode |= S_IFREG;
+        }
+        else if ( '5' == type ) {
+            mode |= S_IFDIR;
+        }
+        else {
+            std::stringstream msg;
+            msg << "build_tar_member_index - unsupported member type [";
+            msg << type;
+            msg << "] for [";
+            msg << name;
+            msg << "]";
+            result = ERROR( SYS_NOT_SUPPORTED, msg.str() );
+            break;
+        }
+
+        add_tar_member( *member_index, name, tar_member_t{
+                            data_offset,
+                            S_ISDIR( mode ) ? 0 : size,
+                            mode,
+                            static_cast< time_t >( parse_tar_number( block + 136, 12 ) ) } );
+
+        offset = data_offset + ( ( size + block_size - 1 ) / block_size ) * block_size;
+
+    } // while
+
+    fileCloseInp_t close_inp;
+    memset( &close_inp, 0, sizeof( close_inp ) );
+    close_inp.fileInx = fd;
+    rsFileClose( comm, &close_inp );
+
+    if ( result.ok() ) {
+        rodsLog( LOG_DEBUG, "build_tar_member_index - indexed %zu members of [%s]",
+                 member_index->members.size() - 1, spec_coll->phyPath );
+        _member_index = std::move( member_index );
+    }
+
+    return result;
+
+} // build_tar_member_index
+
+// =-=-=-=-=-=-=-
+// resolve the member index for read only access to a struct file, building
+// it on first use.  if the archive is already staged the cache dir remains
+// authoritative, and archives which cannot be indexed are staged as before.
+// in both cases a null index is returned
+irods::error resolve_tar_member_index(
+    int                  _index,
+    tar_member_index_t*& _member_index ) {
+    _member_index = nullptr;
+
+    specColl_t* spec_coll = PluginStructFileDesc[ _index ].specColl;
+    if ( strlen( spec_coll->cacheDir ) > 0 ) {
+        return SUCCESS();
+    }
+
+    if ( !PluginTarMemberIndex[ _index ] ) {
+        irods::error idx_err = build_tar_member_index( _index, PluginTarMemberIndex[ _index ] );
+        if ( !idx_err.ok() ) {
+            rodsLog( LOG_DEBUG, "resolve_tar_member_index - staging [%s] : %s",
+                     spec_coll->phyPath, idx_err.result().c_str() );
+
+            std::string location;
+            irods::error ret = irods::get_loc_for_hier_string( spec_coll->rescHier, location );
+            if ( !ret.ok() ) {
+                return PASSMSG( "resolve_tar_member_index - failed in get_loc_for_hier_string", ret );
+            }
+
+            irods::error stage_err = stage_tar_struct_file( _index, location );
+            if ( !stage_err.ok() ) {
+                return PASSMSG( "stage_tar_struct_file failed.", stage_err );
+            }
+
+            return SUCCESS();
+        }
+    }
+
+    _member_index = PluginTarMemberIndex[ _index ].get();
+    return SUCCESS();
+
+} // resolve_tar_member_index
+
+// =-=-=-=-=-=-=-
+// derive the path of a member within the archive from the sub file path
+irods::error compose_tar_member_path(
+    specColl_t*        _spec_coll,
+    const std::string& _sub_file_path,
+    std::string&       _member_path ) {
+    size_t len = strlen( _spec_coll->collection );
+    if ( _sub_file_path.compare( 0, len, _spec_coll->collection ) != 0 ) {
+        std::stringstream msg;
+        msg << "compose_tar_member_path - collection [";
+        msg << _spec_coll->collection;
+        msg << "] sub file path [";
+        msg << _sub_file_path;
+        msg << "] mismatch";
+        return ERROR( SYS_STRUCT_FILE_PATH_ERR, msg.str() );
+    }
+
+    _member_path = normalize_tar_member_path( _sub_file_path.substr( len ) );
+    return SUCCESS();
+
+} // compose_tar_member_path
+
+// =-=-=-=-=-=-=-
+// look up the member named by a sub file path in the member index
+const tar_member_t* find_tar_member(
+    int                       _struct_file_index,
+    const tar_member_index_t& _member_index,
+    const std::string&        _sub_file_path ) {
+    std::string member_path;
+    irods::error ret = compose_tar_member_path( PluginStructFileDesc[ _struct_file_index ].specColl,
+                                                _sub_file_path, member_path );
+    if ( !ret.ok() ) {
+        irods::log( ret );
+        return nullptr;
+    }
+
+    auto itr = _member_index.members.find( member_path );
+    return itr == _member_index.members.end() ? nullptr : &itr->second;
+
+} // find_tar_member
+
 // =-=-=-=-=-=-=-
 // create the phy path to the cache dir
 irods::error compose_cache_dir_physical_path( char*       _phy_path,
@@ -927,11 +1407,13 @@ irods::error tar_file_open(
     }
 
     // =-=-=-=-=-=-=-
-    // open and stage the tar file, get its index
+    // open the tar file and get its index, staging it unless the open is
+    // read only and may be served from the member index
+    const bool read_only = ( fco->flags() & O_ACCMODE ) == O_RDONLY;
     int struct_file_index = 0;
     std::string resc_host;
     irods::error open_err =  tar_struct_file_open( comm, spec_coll, struct_file_index,
-                             fco->resc_hier(), resc_host );
+                             fco->resc_hier(), resc_host, !read_only );
     if ( !open_err.ok() ) {
         std::stringstream msg;
         msg << "tar_struct_file_open error for [";
@@ -943,6 +1425,14 @@ irods::error tar_file_open(
     // use the cached specColl. specColl may have changed
     spec_coll = PluginStructFileDesc[ struct_file_index ].specColl;
 
+    tar_member_index_t* member_index = nullptr;
+    if ( read_only ) {
+        irods::error idx_err = resolve_tar_member_index( struct_file_index, member_index );
+        if ( !idx_err.ok() ) {
+            return PASSMSG( "tar_file_open_plugin - resolve_tar_member_index failed.", idx_err );
+        }
+    }
+
     // =-=-=-=-=-=-=-
     // allocate yet another index into another table
     int sub_index = alloc_tar_sub_file_desc();
@@ -954,6 +1444,42 @@ irods::error tar_file_open(
     // cache struct file index into sub file index
     PluginTarSubFileDesc[ sub_index ].structFileInx = struct_file_index;
 
+    // =-=-=-=-=-=-=-
+    // serve the member with positioned reads from the archive itself
+    if ( member_index ) {
+        const tar_member_t* member = find_tar_member( struct_file_index, *member_index, fco->sub_file_path() );
+        if ( !member || S_ISDIR( member->mode ) ) {
+            free_tar_sub_file_desc( sub_index );
+            std::stringstream msg;
+            msg << "tar_file_open_plugin - no such member [";
+            msg << fco->sub_file_path();
+            msg << "] in archive [";
+            msg << spec_coll->phyPath;
+            msg << "]";
+            return ERROR( UNIX_FILE_OPEN_ERR - ( member ? EISDIR : ENOENT ), msg.str() );
+        }
+
+        int status = open_tar_archive( struct_file_index );
+        if ( status < 0 ) {
+            free_tar_sub_file_desc( sub_index );
+            std::stringstream msg;
+            msg << "tar_file_open_plugin - failed to open archive [";
+            msg << spec_coll->phyPath;
+            msg << "], status = ";
+            msg << status;
+            return ERROR( status, msg.str() );
+        }
+
+        PluginTarSubFileDesc[ sub_index ].fd           = status;
+        PluginTarSubFileDesc[ sub_index ].indexed      = 1;
+        PluginTarSubFileDesc[ sub_index ].memberOffset = member->offset;
+        PluginTarSubFileDesc[ sub_index ].memberSize   = member->size;
+        PluginTarSubFileDesc[ sub_index ].memberPos    = 0;
+        PluginStructFileDesc[ struct_file_index ].openCnt++;
+        fco->file_descriptor( sub_index );
+        return CODE( sub_index );
+    }
+
     // =-=-=-=-=-=-=-
     // build a file open structure to pass off to the server api call
     fileOpenInp_t fileOpenInp;
@@ -1023,6 +1549,28 @@ irods::error tar_file_read(
         return ERROR( SYS_STRUCT_FILE_DESC_ERR, msg.str() );
     }
 
+    // =-=-=-=-=-=-=-
+    // indexed members are read directly from their extent in the archive
+    tarSubFileDesc_t& sub_desc = PluginTarSubFileDesc[ fco->file_descriptor() ];
+    if ( sub_desc.indexed ) {
+        const rodsLong_t remaining = sub_desc.memberSize - sub_desc.memberPos;
+        if ( remaining <= 0 ) {
+            return CODE( 0 );
+        }
+
+        int status = read_tar_archive( fco->comm(),
+                                       sub_desc.fd,
+                                       sub_desc.memberOffset + sub_desc.memberPos,
+                                       _buf,
+                                       static_cast< int >( std::min< rodsLong_t >( _len, remaining ) ) );
+        if ( status < 0 ) {
+            return ERROR( status, "tar_file_read_plugin - failed to read indexed member" );
+        }
+
+        sub_desc.memberPos += status;
+        return CODE( status );
+    }
+
     // =-=-=-=-=-=-=-
     // build a read structure and make the rs call
     fileReadInp_t fileReadInp;
@@ -1074,6 +1622,12 @@ irods::error tar_file_write(
         return ERROR( SYS_STRUCT_FILE_DESC_ERR, msg.str() );
     }
 
+    // =-=-=-=-=-=-=-
+    // indexed members are only ever opened read only
+    if ( PluginTarSubFileDesc[ fco->file_descriptor() ].indexed ) {
+        return ERROR( UNIX_FILE_WRITE_ERR - EBADF, "tar_file_write_plugin - member is open read only" );
+    }
+
     // =-=-=-=-=-=-=-
     // build a write structure and make the rs call
     const fileWriteInp_t fileWriteInp{
@@ -1281,7 +1835,7 @@ irods::error tar_file_stat(
     int struct_file_index = 0;
     std::string resc_host;
     irods::error open_err =  tar_struct_file_open( comm, spec_coll, struct_file_index,
-                             fco->resc_hier(), resc_host );
+                             fco->resc_hier(), resc_host, false );
     if ( !open_err.ok() ) {
         std::stringstream msg;
         msg << "tar_file_stat_plugin - tar_struct_file_open error for [";
@@ -1293,6 +1847,35 @@ irods::error tar_file_stat(
     // use the cached specColl. specColl may have changed
     spec_coll = PluginStructFileDesc[ struct_file_index ].specColl;
 
+    tar_member_index_t* member_index = nullptr;
+    irods::error idx_err = resolve_tar_member_index( struct_file_index, member_index );
+    if ( !idx_err.ok() ) {
+        return PASSMSG( "tar_file_stat_plugin - resolve_tar_member_index failed.", idx_err );
+    }
+
+    // =-=-=-=-=-=-=-
+    // answer from the member index when the archive is not staged
+    if ( member_index ) {
+        const tar_member_t* member = find_tar_member( struct_file_index, *member_index, fco->sub_file_path() );
+        if ( !member ) {
+            std::stringstream msg;
+            msg << "tar_file_stat_plugin - no such member [";
+            msg << fco->sub_file_path();
+            msg << "] in archive [";
+            msg << spec_coll->phyPath;
+            msg << "]";
+            return ERROR( UNIX_FILE_STAT_ERR - ENOENT, msg.str() );
+        }
+
+        memset( _statbuf, 0, sizeof( struct stat ) );
+        _statbuf->st_mode  = member->mode;
+        _statbuf->st_size  = member->size;
+        _statbuf->st_mtime = member->mtime;
+        _statbuf->st_ctime = member->mtime;
+        _statbuf->st_nlink = 1;
+        return CODE( 0 );
+    }
+
 
     // =-=-=-=-=-=-=-
     // build a file stat structure to pass off to the server api call
@@ -1364,6 +1947,29 @@ irods::error tar_file_lseek(
         return ERROR( -1, "tar_file_lseek_plugin - null comm pointer in structure_object" );
     }
 
+    // =-=-=-=-=-=-=-
+    // indexed members track their own position within the archive
+    tarSubFileDesc_t& sub_desc = PluginTarSubFileDesc[ fco->file_descriptor() ];
+    if ( sub_desc.indexed ) {
+        rodsLong_t base = 0;
+        if ( SEEK_CUR == _whence ) {
+            base = sub_desc.memberPos;
+        }
+        else if ( SEEK_END == _whence ) {
+            base = sub_desc.memberSize;
+        }
+        else if ( SEEK_SET != _whence ) {
+            return ERROR( UNIX_FILE_LSEEK_ERR - EINVAL, "tar_file_lseek_plugin - invalid whence" );
+        }
+
+        if ( base + _offset < 0 ) {
+            return ERROR( UNIX_FILE_LSEEK_ERR - EINVAL, "tar_file_lseek_plugin - negative offset" );
+        }
+
+        sub_desc.memberPos = base + _offset;
+        return CODE( sub_desc.memberPos );
+    }
+
     // =-=-=-=-=-=-=-
     // build a lseek structure and make the rs call
     fileLseekInp_t fileLseekInp;
@@ -1594,7 +2200,7 @@ irods::error tar_file_opendir(
     int struct_file_index = 0;
     std::string resc_host;
     irods::error open_err =  tar_struct_file_open( comm, spec_coll, struct_file_index,
-                             fco->resc_hier(), resc_host );
+                             fco->resc_hier(), resc_host, false );
     if ( !open_err.ok() ) {
         std::stringstream msg;
         msg << "tar_file_opendir_plugin - tar_struct_file_open error for [";
@@ -1611,6 +2217,12 @@ irods::error tar_file_opendir(
         return ERROR( -1, "tar_file_opendir_plugin - null spec_coll pointer in PluginStructFileDesc" );
     }
 
+    tar_member_index_t* member_index = nullptr;
+    irods::error idx_err = resolve_tar_member_index( struct_file_index, member_index );
+    if ( !idx_err.ok() ) {
+        return PASSMSG( "tar_file_opendir_plugin - resolve_tar_member_index failed.", idx_err );
+    }
+
     // =-=-=-=-=-=-=-
     // allocate yet another index into another table
     int sub_index = alloc_tar_sub_file_desc();
@@ -1618,6 +2230,42 @@ irods::error tar_file_opendir(
         return ERROR( sub_index, "tar_file_opendir_plugin - alloc_tar_sub_file_desc failed." );
     }
 
+    // =-=-=-=-=-=-=-
+    // cache struct file index into sub file index
+    PluginTarSubFileDesc[ sub_index ].structFileInx = struct_file_index;
+
+    // =-=-=-=-=-=-=-
+    // list the directory from the member index when the archive is not staged
+    if ( member_index ) {
+        std::string member_path;
+        irods::error comp_err = compose_tar_member_path( spec_coll, fco->sub_file_path(), member_path );
+        if ( !comp_err.ok() ) {
+            free_tar_sub_file_desc( sub_index );
+            return PASSMSG( "tar_file_opendir_plugin - compose_tar_member_path failed.", comp_err );
+        }
+
+        auto itr = member_index->members.find( member_path );
+        if ( itr == member_index->members.end() || !S_ISDIR( itr->second.mode ) ) {
+            free_tar_sub_file_desc( sub_index );
+            std::stringstream msg;
+            msg << "tar_file_opendir_plugin - no such directory [";
+            msg << fco->sub_file_path();
+            msg << "] in archive [";
+            msg << spec_coll->phyPath;
+            msg << "]";
+            const int err = itr == member_index->members.end() ? ENOENT : ENOTDIR;
+            return ERROR( UNIX_FILE_OPENDIR_ERR - err, msg.str() );
+        }
+
+        PluginTarSubFileDesc[ sub_index ].indexed   = 1;
+        PluginTarSubFileDesc[ sub_index ].direntInx = 0;
+        snprintf( PluginTarSubFileDesc[ sub_index ].memberPath, MAX_NAME_LEN, "%s", member_path.c_str() );
+        PluginStructFileDesc[ struct_file_index ].openCnt++;
+        fco->file_descriptor( sub_index );
+
+        return CODE( sub_index );
+    }
+
     // =-=-=-=-=-=-=-
     // build a file open structure to pass off to the server api call
     fileOpendirInp_t fileOpendirInp;
@@ -1687,13 +2335,17 @@ irods::error tar_file_closedir(
     }
 
     // =-=-=-=-=-=-=-
-    // build a file close dir structure to pass off to the server api call
-    fileClosedirInp_t fileClosedirInp;
-    memset( &fileClosedirInp, 0, sizeof( fileClosedirInp ) );
-    fileClosedirInp.fileInx = PluginTarSubFileDesc[ fco->file_descriptor() ].fd;
-    int status = rsFileClosedir( _ctx.comm(), &fileClosedirInp );
-    if ( status < 0 ) {
-        return ERROR( status, "tar_file_closedir_plugin - failed on call to rsFileClosedir" );
+    // build a file close dir structure to pass off to the server api call,
+    // indexed listings have nothing open on the resource
+    int status = 0;
+    if ( !PluginTarSubFileDesc[ fco->file_descriptor() ].indexed ) {
+        fileClosedirInp_t fileClosedirInp;
+        memset( &fileClosedirInp, 0, sizeof( fileClosedirInp ) );
+        fileClosedirInp.fileInx = PluginTarSubFileDesc[ fco->file_descriptor() ].fd;
+        status = rsFileClosedir( _ctx.comm(), &fileClosedirInp );
+        if ( status < 0 ) {
+            return ERROR( status, "tar_file_closedir_plugin - failed on call to rsFileClosedir" );
+        }
     }
 
     // =-=-=-=-=-=-=-
@@ -1735,6 +2387,33 @@ irods::error tar_file_readdir(
         return ERROR( SYS_STRUCT_FILE_DESC_ERR, msg.str() );
     }
 
+    // =-=-=-=-=-=-=-
+    // indexed listings walk the children recorded in the member index
+    tarSubFileDesc_t& sub_desc = PluginTarSubFileDesc[ fco->file_descriptor() ];
+    if ( sub_desc.indexed ) {
+        const auto& member_index = PluginTarMemberIndex[ sub_desc.structFileInx ];
+        if ( !member_index ) {
+            return ERROR( SYS_STRUCT_FILE_DESC_ERR, "tar_file_readdir_plugin - member index is no longer available" );
+        }
+
+        auto itr = member_index->children.find( sub_desc.memberPath );
+        if ( itr == member_index->children.end() ||
+                sub_desc.direntInx >= static_cast< int >( itr->second.size() ) ) {
+            // =-=-=-=-=-=-=-
+            // end of the directory listing, as reported by rsFileReaddir
+            return CODE( -1 );
+        }
+
+        if ( !( *_dirent_ptr ) ) {
+            *_dirent_ptr = static_cast< rodsDirent_t* >( malloc( sizeof( rodsDirent_t ) ) );
+            memset( *_dirent_ptr, 0, sizeof( rodsDirent_t ) );
+        }
+
+        snprintf( ( *_dirent_ptr )->d_name, sizeof( ( *_dirent_ptr )->d_name ), "%s",
+                  itr->second[ sub_desc.direntInx++ ].c_str() );
+        return CODE( 0 );
+    }
+
     // =-=-=-=-=-=-=-
     // build a file read dir structure to pass off to the server api call
     fileReaddirInp_t fileReaddirInp;
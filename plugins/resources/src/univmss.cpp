@@ -13,6 +13,8 @@
 #include "irods/irods_resource_redirect.hpp"
 #include "irods/irods_stacktrace.hpp"
 #include "irods/irods_re_structs.hpp"
+#include "irods/irods_default_paths.hpp"
+#include "irods/irods_kvp_string_parser.hpp"
 #include "irods/voting.hpp"
 
 #include <boost/lexical_cast.hpp>
@@ -20,9 +22,25 @@
 #include <boost/any.hpp>
 #include <boost/algorithm/string.hpp>
 
+#include <fmt/format.h>
+
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <charconv>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
 #include <cstring>
 #include <iostream>
+#include <map>
+#include <mutex>
+#include <optional>
 #include <sstream>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 #include <string>
 
@@ -51,6 +69,364 @@ inline irods::error univ_mss_check_param(
 /// @brief token to index the script property
 const std::string SCRIPT_PROP( "script" );
 
+// =-=-=-=-=-=-=-
+/// @brief token to index the mode property, and its values
+const std::string MODE_PROP( "mode" );
+const std::string MODE_ONE_SHOT( "one_shot" );
+const std::string MODE_PERSISTENT( "persistent" );
+
+namespace
+{
+    /// =-=-=-=-=-=-=-
+    /// @brief a long-running instance of the univmss script.
+    ///
+    /// the script is started once with the single argument "driver". every field exchanged with
+    /// it is terminated by a NUL, which cannot occur in an argument, so nothing is ever parsed or
+    /// evaluated by the shell. a request is "<id>", "<argument count>" and then the arguments the
+    /// script would otherwise receive on its command line. the script answers each request with
+    /// "<id>", "<exit status>" and "<output>". responses may arrive in any order, so several
+    /// requests may be in flight at once. if the script exits, the requests in flight fail and
+    /// the next request starts it again.
+    class univ_mss_driver
+    {
+      public:
+        explicit univ_mss_driver(std::string _script)
+            : script_{std::move(_script)}
+        {
+        }
+
+        /// @brief sends a request and waits for its response.
+        ///
+        /// @returns 0 if the script succeeded, EXEC_CMD_ERROR if it returned a non-zero status,
+        ///          or another negative error code if the script could not be reached.
+        auto execute(const std::vector<std::string>& _arguments, std::string& _output) -> int
+        {
+            std::unique_lock lock{mutex_};
+
+            // the reader thread does not survive a fork, so a child must start its own driver.
+            if (owner_pid_ != getpid()) {
+                if (fd_ >= 0) {
+                    close(fd_);
+                }
+                fd_ = -1;
+                pending_.clear();
+                owner_pid_ = getpid();
+            }
+
+            if (fd_ < 0) {
+                if (const auto ec = start(); ec < 0) {
+                    return ec;
+                }
+            }
+
+            const auto id = next_id_++;
+            const auto generation = generation_;
+            pending_[id].generation = generation;
+
+            // mutex_ is not held while sending. a script which stops reading must not keep the
+            // reader thread from handing out the responses it has already written.
+            lock.unlock();
+
+            auto line = fmt::format("{}{}{}{}", id, '\0', _arguments.size(), '\0');
+            for (const auto& argument : _arguments) {
+                line.append(argument).push_back('\0');
+            }
+
+            if (const auto ec = send_request(line, generation); ec < 0) {
+                lock.lock();
+                pending_.erase(id);
+                return ec;
+            }
+
+            lock.lock();
+            cv_.wait(lock, [this, id] { return pending_.at(id).result.has_value(); });
+
+            const auto result = std::move(*pending_.at(id).result);
+            pending_.erase(id);
+
+            if (result.status < 0) {
+                return result.status;
+            }
+
+            _output = result.output;
+
+            // match _rsExecCmd, which reports any non-zero exit status as EXEC_CMD_ERROR.
+            return 0 == result.status ? 0 : EXEC_CMD_ERROR;
+        } // execute
+
+      private:
+        struct response
+        {
+            int status;
+            std::string output;
+        };
+
+        struct pending_request
+        {
+            std::uint64_t generation;
+            std::optional<response> result;
+        };
+
+        /// @brief writes a whole request to the script. requests are sent one at a time so that
+        ///        their bytes are not interleaved, and each send gives up after NB_WRITE_TOUT_SEC.
+        auto send_request(const std::string& _line, std::uint64_t _generation) -> int
+        {
+            std::lock_guard send_lock{send_mutex_};
+
+            int fd = -1;
+            {
+                std::lock_guard lock{mutex_};
+
+                // the driver exited, or was restarted, since the request was registered.
+                if (_generation != generation_ || fd_ < 0) {
+                    return EXEC_CMD_ERROR;
+                }
+
+                fd = fd_;
+            }
+
+            // the reader thread takes send_mutex_ before closing the descriptor, so it stays open
+            // until the request has been sent.
+            for (std::size_t offset = 0; offset < _line.size();) {
+                const auto n = send(fd, _line.data() + offset, _line.size() - offset, MSG_NOSIGNAL);
+
+                if (n < 0) {
+                    if (EINTR == errno) {
+                        continue;
+                    }
+
+                    const auto ec = SYS_SOCK_WRITE_ERR - errno;
+                    rodsLog(LOG_ERROR, "univ_mss_driver - failed to send request to [%s], errno = [%d]", script_.c_str(), errno);
+
+                    // wake the reader so that the driver is restarted on the next request.
+                    std::lock_guard lock{mutex_};
+                    shutdown(fd, SHUT_RDWR);
+                    if (fd_ == fd) {
+                        fd_ = -1;
+                    }
+                    return ec;
+                }
+
+                offset += n;
+            }
+
+            return 0;
+        } // send_request
+
+        /// @brief forks and execs the script in driver mode. the caller must hold mutex_.
+        auto start() -> int
+        {
+            int fds[2];
+            if (socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds) < 0) {
+                return SYS_SOCK_OPEN_ERR - errno;
+            }
+
+            // everything the child needs is prepared before forking since only async-signal-safe
+            // functions may be called between fork and exec.
+            const auto cmd_path = irods::get_irods_home_directory().append("msiExecCmd_bin").append(script_).string();
+            const char* argv[] = {cmd_path.c_str(), "driver", nullptr};
+            const auto max_fd = sysconf(_SC_OPEN_MAX);
+            const auto dev_null = open("/dev/null", O_WRONLY | O_CLOEXEC);
+
+            const auto pid = fork();
+
+            if (0 == pid) {
+                dup2(fds[1], 0);
+                dup2(fds[1], 1);
+                if (dev_null >= 0) {
+                    dup2(dev_null, 2);
+                }
+
+                // do not let the driver hold the client connection, or anything else, open.
+                for (long fd = 3; fd < max_fd; ++fd) {
+                    close(static_cast<int>(fd));
+                }
+
+                execv(argv[0], const_cast<char* const*>(argv));
+                _exit(127);
+            }
+
+            if (dev_null >= 0) {
+                close(dev_null);
+            }
+
+            close(fds[1]);
+
+            if (pid < 0) {
+                close(fds[0]);
+                rodsLog(LOG_ERROR, "univ_mss_driver - failed to fork [%s], errno = [%d]", cmd_path.c_str(), errno);
+                return SYS_FORK_ERROR;
+            }
+
+            // a script which stops reading its requests must not block the agent forever.
+            timeval timeout{};
+            timeout.tv_sec = NB_WRITE_TOUT_SEC;
+            setsockopt(fds[0], SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+            fd_ = fds[0];
+            ++generation_;
+
+            rodsLog(LOG_DEBUG, "univ_mss_driver - started [%s] with pid [%d]", cmd_path.c_str(), pid);
+
+            std::thread{&univ_mss_driver::read_responses, this, fd_, pid, generation_}.detach();
+
+            return 0;
+        } // start
+
+        auto read_responses(int _fd, pid_t _pid, std::uint64_t _generation) -> void
+        {
+            std::string buffer;
+            char chunk[4096];
+
+            while (true) {
+                const auto n = read(_fd, chunk, sizeof(chunk));
+
+                if (n < 0 && EINTR == errno) {
+                    continue;
+                }
+
+                if (n <= 0) {
+                    break;
+                }
+
+                buffer.append(chunk, n);
+
+                std::size_t begin = 0;
+                std::lock_guard lock{mutex_};
+
+                // a response is complete once all three of its fields are.
+                while (true) {
+                    const auto end_of_id = buffer.find('\0', begin);
+                    const auto end_of_status = end_of_id == std::string::npos ? end_of_id : buffer.find('\0', end_of_id + 1);
+                    const auto end_of_output = end_of_status == std::string::npos ? end_of_status : buffer.find('\0', end_of_status + 1);
+
+                    if (end_of_output == std::string::npos) {
+                        break;
+                    }
+
+                    const auto* data = buffer.data();
+                    const auto id_begin = begin;
+                    begin = end_of_output + 1;
+
+                    std::uint64_t id{};
+                    int status{};
+
+                    if (std::from_chars(data + id_begin, data + end_of_id, id).ec != std::errc{} ||
+                        std::from_chars(data + end_of_id + 1, data + end_of_status, status).ec != std::errc{})
+                    {
+                        rodsLog(LOG_ERROR, "univ_mss_driver - ignoring malformed response from [%s]", script_.c_str());
+                        continue;
+                    }
+
+                    // a negative status would be mistaken for a driver failure.
+                    if (status < 0) {
+                        status = 1;
+                    }
+
+                    if (auto iter = pending_.find(id); iter != std::end(pending_) && iter->second.generation == _generation) {
+                        iter->second.result = response{status, buffer.substr(end_of_status + 1, end_of_output - end_of_status - 1)};
+                    }
+                }
+
+                buffer.erase(0, begin);
+                cv_.notify_all();
+            }
+
+            {
+                std::scoped_lock lock{send_mutex_, mutex_};
+
+                // the descriptor is closed while holding both locks so that its number cannot be
+                // reused while a request is being sent on it.
+                if (fd_ == _fd) {
+                    fd_ = -1;
+                }
+                close(_fd);
+
+                for (auto& [id, request] : pending_) {
+                    if (request.generation == _generation && !request.result) {
+                        request.result = response{EXEC_CMD_ERROR, {}};
+                    }
+                }
+            }
+
+            cv_.notify_all();
+
+            int status = 0;
+            waitpid(_pid, &status, 0);
+            rodsLog(LOG_NOTICE, "univ_mss_driver - [%s] with pid [%d] exited with status [%d]", script_.c_str(), _pid, status);
+        } // read_responses
+
+        const std::string script_;
+        std::mutex mutex_;
+        std::mutex send_mutex_;
+        std::condition_variable cv_;
+        pid_t owner_pid_ = getpid();
+        int fd_ = -1;
+        std::uint64_t generation_ = 0;
+        std::uint64_t next_id_ = 0;
+        std::unordered_map<std::uint64_t, pending_request> pending_;
+    }; // class univ_mss_driver
+
+    auto get_univ_mss_driver(const std::string& _script) -> univ_mss_driver&
+    {
+        // drivers are intentionally leaked. their reader threads may still be running when the
+        // agent exits, and the scripts exit on their own once the agent's end of the socket closes.
+        static std::mutex mutex;
+        static auto* drivers = new std::map<std::string, univ_mss_driver*>;
+
+        std::lock_guard lock{mutex};
+
+        auto& driver = (*drivers)[_script];
+        if (!driver) {
+            driver = new univ_mss_driver{_script};
+        }
+
+        return *driver;
+    } // get_univ_mss_driver
+} // anonymous namespace
+
+/// =-=-=-=-=-=-=-
+/// @brief run the script with the arguments in _exec_cmd_inp, either through a new process or
+///        through the persistent driver depending on the mode of the resource.
+int univ_mss_exec_cmd(
+    irods::plugin_context& _ctx,
+    execCmd_t*             _exec_cmd_inp,
+    execCmdOut_t**         _exec_cmd_out ) {
+    std::string mode;
+    if ( !_ctx.prop_map().get< std::string >( MODE_PROP, mode ).ok() || MODE_PERSISTENT != mode ) {
+        return _rsExecCmd( _exec_cmd_inp, _exec_cmd_out );
+    }
+
+    // split the arguments exactly as _rsExecCmd does, so that the script receives the same ones
+    // in either mode.
+    char* av[LONG_NAME_LEN]{};
+    initCmdArg( av, _exec_cmd_inp->cmdArgv, _exec_cmd_inp->cmd );
+
+    std::vector< std::string > arguments;
+    for ( int i = 1; av[i]; ++i ) {
+        arguments.emplace_back( av[i] );
+    }
+
+    for ( int i = 0; av[i]; ++i ) {
+        std::free( av[i] );
+    }
+
+    std::string output;
+    const int status = get_univ_mss_driver( _exec_cmd_inp->cmd ).execute( arguments, output );
+
+    // hand back the output the same way _rsExecCmd does so that callers need not care.
+    execCmdOut_t* out = static_cast< execCmdOut_t* >( std::malloc( sizeof( execCmdOut_t ) ) );
+    std::memset( out, 0, sizeof( execCmdOut_t ) );
+    out->stdoutBuf.buf = strdup( output.c_str() );
+    out->stdoutBuf.len = static_cast< int >( output.size() );
+    out->stderrBuf.buf = strdup( "" );
+    out->status = status;
+    *_exec_cmd_out = out;
+
+    return status;
+
+} // univ_mss_exec_cmd
+
 /// =-=-=-=-=-=-=-
 /// @brief interface for POSIX create
 irods::error univ_mss_file_create(
@@ -130,7 +506,7 @@ irods::error univ_mss_file_unlink(
     snprintf( execCmdInp.execAddr, sizeof( execCmdInp.execAddr ), "localhost" );
 
     execCmdOut_t *execCmdOut = NULL;
-    int status = _rsExecCmd( &execCmdInp, &execCmdOut );
+    int status = univ_mss_exec_cmd( _ctx, &execCmdInp, &execCmdOut );
     freeCmdExecOut( execCmdOut );
 
     if ( status < 0 ) {
@@ -191,7 +567,7 @@ irods::error univ_mss_file_stat(
     snprintf( cmdArgv, sizeof( cmdArgv ), "stat '%s' ", filename.c_str() );
     rstrcpy( execCmdInp.cmdArgv, cmdArgv, HUGE_NAME_LEN );
     rstrcpy( execCmdInp.execAddr, "localhost", LONG_NAME_LEN );
-    status = _rsExecCmd( &execCmdInp, &execCmdOut );
+    status = univ_mss_exec_cmd( _ctx, &execCmdInp, &execCmdOut );
 
     if ( status == 0 && NULL != execCmdOut ) { // JMC cppcheck - nullptr
         if ( execCmdOut->stdoutBuf.buf != NULL ) {
@@ -301,7 +677,7 @@ irods::error univ_mss_file_chmod(
     snprintf( execCmdInp.cmdArgv, sizeof( execCmdInp.cmdArgv ), "chmod '%s' %o", filename.c_str(), mode );
     snprintf( execCmdInp.execAddr, sizeof( execCmdInp.execAddr ), "%s", "localhost" );
     execCmdOut_t *execCmdOut = NULL;
-    status = _rsExecCmd( &execCmdInp, &execCmdOut );
+    status = univ_mss_exec_cmd( _ctx, &execCmdInp, &execCmdOut );
     freeCmdExecOut( execCmdOut );
 
     if ( status < 0 ) {
@@ -354,7 +730,7 @@ irods::error univ_mss_file_mkdir(
     snprintf( execCmdInp.cmdArgv, sizeof( execCmdInp.cmdArgv ), "mkdir '%s'", dirname.c_str() );
     snprintf( execCmdInp.execAddr, sizeof( execCmdInp.execAddr ), "%s", "localhost" );
     execCmdOut_t *execCmdOut = NULL;
-    status = _rsExecCmd( &execCmdInp, &execCmdOut );
+    status = univ_mss_exec_cmd( _ctx, &execCmdInp, &execCmdOut );
     freeCmdExecOut( execCmdOut );
     if ( status < 0 ) {
         status = UNIV_MSS_MKDIR_ERR - errno;
@@ -465,7 +841,7 @@ irods::error univ_mss_file_rename(
     snprintf( execCmdInp.cmdArgv, sizeof( execCmdInp.cmdArgv ), "mv '%s' '%s'", filename.c_str(), _new_file_name );
     snprintf( execCmdInp.execAddr, sizeof( execCmdInp.execAddr ), "%s", "localhost" );
     execCmdOut_t *execCmdOut = NULL;
-    status = _rsExecCmd( &execCmdInp, &execCmdOut );
+    status = univ_mss_exec_cmd( _ctx, &execCmdInp, &execCmdOut );
     freeCmdExecOut( execCmdOut );
 
     if ( status < 0 ) {
@@ -544,7 +920,7 @@ irods::error univ_mss_file_stage_to_cache(
     snprintf( execCmdInp.execAddr, sizeof( execCmdInp.execAddr ), "%s", "localhost" );
 
     execCmdOut_t *execCmdOut = NULL;
-    status = _rsExecCmd( &execCmdInp, &execCmdOut );
+    status = univ_mss_exec_cmd( _ctx, &execCmdInp, &execCmdOut );
     freeCmdExecOut( execCmdOut );
 
     if ( status < 0 ) {
@@ -623,7 +999,7 @@ irods::error univ_mss_file_sync_to_arch(
     rstrcpy( execCmdInp.cmd, script.c_str(), LONG_NAME_LEN );
     snprintf( execCmdInp.cmdArgv, sizeof( execCmdInp.cmdArgv ), "syncToArch '%s' '%s'", _cache_file_name, filename.c_str() );
     rstrcpy( execCmdInp.execAddr, "localhost", LONG_NAME_LEN );
-    status = _rsExecCmd( &execCmdInp, &execCmdOut );
+    status = univ_mss_exec_cmd( _ctx, &execCmdInp, &execCmdOut );
     if ( status == 0 ) {
         err = univ_mss_file_chmod( _ctx );
         if ( !err.ok() ) {
@@ -750,18 +1126,43 @@ class univ_mss_resource : public irods::resource {
             irods::resource( _inst_name, _context ) {
 
             // =-=-=-=-=-=-=-
-            // check the context string for inappropriate path behavior
-            if ( context_.find( "/" ) != std::string::npos ) {
+            // the context string is either the script name on its own, or key-value pairs
+            // naming the script and the mode in which to run it
+            std::string script = context_;
+            std::string mode   = MODE_ONE_SHOT;
+            if ( context_.find( "=" ) != std::string::npos ) {
+                irods::kvp_map_t kvp;
+                irods::error ret = irods::parse_kvp_string( context_, kvp );
+                if ( !ret.ok() ) {
+                    irods::log( PASS( ret ) );
+                }
+
+                script = kvp[ SCRIPT_PROP ];
+                if ( kvp.find( MODE_PROP ) != kvp.end() ) {
+                    mode = kvp[ MODE_PROP ];
+                }
+
+                if ( MODE_ONE_SHOT != mode && MODE_PERSISTENT != mode ) {
+                    rodsLog( LOG_ERROR, "univmss resource :: unknown mode [%s], using [%s]",
+                             mode.c_str(), MODE_ONE_SHOT.c_str() );
+                    mode = MODE_ONE_SHOT;
+                }
+            }
+
+            // =-=-=-=-=-=-=-
+            // check the script name for inappropriate path behavior
+            if ( script.find( "/" ) != std::string::npos ) {
                 std::stringstream msg;
                 msg << "univmss resource :: the path [";
-                msg << context_;
+                msg << script;
                 msg << "] should be a single file name which should reside in msiExecCmd_bin";
                 rodsLog( LOG_ERROR, "[%s]", msg.str().c_str() );
             }
 
             // =-=-=-=-=-=-=-
-            // assign context string as the univ mss script to call
-            properties_.set< std::string >( SCRIPT_PROP, context_ );
+            // assign the univ mss script to call and how to call it
+            properties_.set< std::string >( SCRIPT_PROP, script );
+            properties_.set< std::string >( MODE_PROP, mode );
         }
 
         // =-=-=-=-=-=-
@@ -1030,9 +1030,7 @@ Res* execAction3( char *actionName, Res** args, unsigned int nargs, int applyAll
         } else {
             // =-=-=-=-=-=-=-
             // didn't find a rule, try a msvc
-            irods::ms_table_entry ms_entry;
-            int actionInx = actionTableLookUp( ms_entry, action );
-            if ( actionInx >= 0 ) { /* rule */
+            if ( irods::resolve_microservice( action ) ) {
 
                 return execMicroService3( action, args, nargs, node, env, rei, errmsg, r );
             }
@@ -1060,11 +1058,10 @@ Res* execMicroService3( char *msName, Res **args, unsigned int nargs, Node *node
     Res *res = NULL;
 
     /* look up the micro service */
-    irods::ms_table_entry ms_entry;
-    int actionInx = actionTableLookUp( ms_entry, msName );
+    irods::ms_table_entry* ms_entry = irods::resolve_microservice( msName );
 
     char errbuf[ERR_MSG_LEN];
-    if ( actionInx < 0 ) {
+    if ( !ms_entry ) {
         int ret = NO_MICROSERVICE_FOUND_ERR;
         generateErrMsg( "execMicroService3: no micro service found", NODE_EXPR_POS( node ), node->base, errbuf );
         addRErrorMsg( errmsg, ret, errbuf );
@@ -1072,7 +1069,7 @@ Res* execMicroService3( char *msName, Res **args, unsigned int nargs, Node *node
 
     }
 
-    unsigned int numOfStrArgs = ms_entry.num_args();
+    unsigned int numOfStrArgs = ms_entry->num_args();
     if ( nargs != numOfStrArgs ) {
         int ret = ACTION_ARG_COUNT_MISMATCH;
         generateErrMsg( "execMicroService3: wrong number of arguments", NODE_EXPR_POS( node ), node->base, errbuf );
@@ -1124,7 +1121,7 @@ Res* execMicroService3( char *msName, Res **args, unsigned int nargs, Node *node
         reDebug( EXEC_MICRO_SERVICE_BEGIN, -4, &param, node, env, rei );
     }
 
-    ii = ms_entry.call( rei, myArgv );
+    ii = ms_entry->call( rei, myArgv );
 
     /* move errmsgs from rei to errmsg */
     if ( rei->rsComm != NULL ) {
@@ -152,6 +152,13 @@ def run_update(irods_config, cursor):
                         ['mysql', '='.join(['--defaults-file', f.name]), irods_config.database_config['db_name']],
                         stdin=sql_file)
 
+    elif new_schema_version == 12:
+        # Composite index for GenQuery searches on multiple AVUs. Each additional AVU condition is
+        # evaluated as a semi-join that looks up meta_ids through the existing name and value indexes
+        # and then object_ids by meta_id. The name and value are not indexed together, since values
+        # may exceed the size of an index entry.
+        database_connect.execute_sql_statement(cursor, "create index idx_objt_metamap4 on R_OBJT_METAMAP (meta_id, object_id);")
+
     else:
         raise IrodsError('Upgrade to schema version %d is unsupported.' % (new_schema_version))
 
@@ -5,8 +5,10 @@ if sys.version_info < (2, 7):
 else:
     import unittest
 
+import io
 import os
 import shutil
+import tarfile
 import tempfile
 
 from . import resource_suite
@@ -286,3 +288,136 @@ class Test_ibun(resource_suite.ResourceBase, unittest.TestCase):
             lib.remove_resource(self.admin, compound_resource)
             lib.remove_resource(self.admin, cache_resource)
             lib.remove_resource(self.admin, archive_resource)
+
+    def make_tar_archive(self, tar_path, members, tar_format):
+        """Writes the members, a list of (name, contents) tuples, to an uncompressed tar archive."""
+        with tarfile.open(tar_path, 'w', format=tar_format) as tar:
+            for name, contents in members:
+                info = tarfile.TarInfo(name)
+                info.size = len(contents)
+                info.mode = 0o644
+                tar.addfile(info, io.BytesIO(contents.encode('ascii')))
+
+    def mount_tar_archive(self, tar_path, tar_logical_path, mount_collection):
+        self.admin.assert_icommand(['iput', tar_path, tar_logical_path])
+        self.admin.assert_icommand(['imkdir', mount_collection])
+        self.admin.assert_icommand(['imcoll', '-m', 'tar', tar_logical_path, mount_collection])
+
+    def tar_archive_is_staged(self, mount_collection):
+        # Staging registers the cache directory of the archive as "<cache dir>;;;<hierarchy>;;;<flags>".
+        out, _, _ = self.admin.run_icommand(
+            ['iquest', '%s', "select COLL_INFO2 where COLL_NAME = '{}'".format(mount_collection)])
+        return ';;;' in out
+
+    def test_members_of_a_mounted_tar_archive_are_served_from_the_member_index(self):
+        base_name = 'test_members_of_a_mounted_tar_archive_are_served_from_the_member_index'
+        tar_path = os.path.join(self.admin.local_session_dir, base_name + '.tar')
+        tar_logical_path = os.path.join(self.admin.session_collection, base_name + '.tar')
+        mount_collection = os.path.join(self.admin.session_collection, base_name)
+        local_file = os.path.join(self.admin.local_session_dir, base_name + '.out')
+
+        # Long names are stored in a GNU long name header, a pax header or the ustar prefix field,
+        # depending on the format of the archive.
+        long_directory = 'directory_with_a_long_name_' + 'd' * 80
+        long_file_name = 'file_with_a_long_name_' + 'f' * 60
+        contents = ''.join(chr(ord('a') + i % 26) for i in range(5000))
+        members = [
+            ('short_file', 'short'),
+            ('{}/{}'.format(long_directory, long_file_name), contents),
+            ('{}/empty_file'.format(long_directory), '')
+        ]
+
+        for tar_format in [tarfile.GNU_FORMAT, tarfile.PAX_FORMAT, tarfile.USTAR_FORMAT]:
+            with self.subTest(tar_format=tar_format):
+                try:
+                    self.make_tar_archive(tar_path, members, tar_format)
+                    self.mount_tar_archive(tar_path, tar_logical_path, mount_collection)
+
+                    long_collection = '/'.join([mount_collection, long_directory])
+                    long_path = '/'.join([long_collection, long_file_name])
+
+                    # readdir
+                    out, _, ec = self.admin.run_icommand(['ils', mount_collection])
+                    self.assertEqual(ec, 0)
+                    self.assertIn('short_file', out)
+                    self.assertIn('C- ' + long_collection, out)
+
+                    out, _, ec = self.admin.run_icommand(['ils', long_collection])
+                    self.assertEqual(ec, 0)
+                    self.assertIn(long_file_name, out)
+                    self.assertIn('empty_file', out)
+
+                    # stat
+                    self.admin.assert_icommand(['ils', '-l', long_path], 'STDOUT_SINGLELINE', ' 5000 ')
+
+                    # full and partial reads
+                    self.admin.assert_icommand(['iget', '-f', long_path, local_file])
+                    with open(local_file, 'r') as f:
+                        self.assertEqual(f.read(), contents)
+
+                    out, _, ec = self.admin.run_icommand(['istream', 'read', '-o', '1000', '-c', '50', long_path])
+                    self.assertEqual(ec, 0)
+                    self.assertEqual(out, contents[1000:1050])
+
+                    # A read past the end of the member does not return the bytes which follow it in the archive.
+                    out, _, ec = self.admin.run_icommand(['istream', 'read', '-o', '4990', '-c', '100', long_path])
+                    self.assertEqual(ec, 0)
+                    self.assertEqual(out, contents[4990:])
+
+                    out, _, ec = self.admin.run_icommand(['istream', 'read', '/'.join([mount_collection, 'short_file'])])
+                    self.assertEqual(ec, 0)
+                    self.assertEqual(out, 'short')
+
+                    self.assertFalse(self.tar_archive_is_staged(mount_collection))
+
+                finally:
+                    self.admin.run_icommand(['imcoll', '-U', mount_collection])
+                    self.admin.run_icommand(['irm', '-rf', mount_collection, tar_logical_path])
+                    for path in [tar_path, local_file]:
+                        if os.path.exists(path):
+                            os.unlink(path)
+
+    def test_mounted_tar_archive_is_staged_when_its_member_index_cannot_be_built(self):
+        base_name = 'test_mounted_tar_archive_is_staged_when_its_member_index_cannot_be_built'
+        tar_path = os.path.join(self.admin.local_session_dir, base_name + '.tar')
+        tar_logical_path = os.path.join(self.admin.session_collection, base_name + '.tar')
+        mount_collection = os.path.join(self.admin.session_collection, base_name)
+        local_file = os.path.join(self.admin.local_session_dir, base_name + '.out')
+
+        try:
+            # Hard links are left to extraction, so the member index is not built for this archive.
+            contents = 'the contents of the file'
+            with tarfile.open(tar_path, 'w', format=tarfile.GNU_FORMAT) as tar:
+                info = tarfile.TarInfo('the_file')
+                info.size = len(contents)
+                tar.addfile(info, io.BytesIO(contents.encode('ascii')))
+
+                link = tarfile.TarInfo('the_hard_link')
+                link.type = tarfile.LNKTYPE
+                link.linkname = 'the_file'
+                tar.addfile(link)
+
+            self.mount_tar_archive(tar_path, tar_logical_path, mount_collection)
+            self.assertFalse(self.tar_archive_is_staged(mount_collection))
+
+            self.admin.assert_icommand(['ils', mount_collection], 'STDOUT_MULTILINE', ['the_file', 'the_hard_link'])
+            self.assertTrue(self.tar_archive_is_staged(mount_collection))
+
+            self.admin.assert_icommand(['ils', '-l', '/'.join([mount_collection, 'the_file'])],
+                                       'STDOUT_SINGLELINE', ' {} '.format(len(contents)))
+
+            self.admin.assert_icommand(['iget', '-f', '/'.join([mount_collection, 'the_hard_link']), local_file])
+            with open(local_file, 'r') as f:
+                self.assertEqual(f.read(), contents)
+
+            out, _, ec = self.admin.run_icommand(
+                ['istream', 'read', '-o', '4', '-c', '8', '/'.join([mount_collection, 'the_file'])])
+            self.assertEqual(ec, 0)
+            self.assertEqual(out, contents[4:12])
+
+        finally:
+            self.admin.run_icommand(['imcoll', '-U', mount_collection])
+            self.admin.run_icommand(['irm', '-rf', mount_collection, tar_logical_path])
+            for path in [tar_path, local_file]:
+                if os.path.exists(path):
+                    os.unlink(path)
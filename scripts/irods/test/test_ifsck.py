@@ -104,3 +104,93 @@ class Test_Ifsck(session.make_sessions_mixin([('otherrods', 'rods')], [('alice',
         # verify ifsck errors
         self.admin.assert_icommand(['ifsck', '-r', full_directory_path], 'STDOUT_SINGLELINE', 'WARNING: local file [{0}] is not registered in iRODS.'.format(full_path_filename2), desired_rc=3)
 
+
+    @unittest.skipIf(test.settings.RUN_IN_TOPOLOGY, "Skip for Topology Testing, checks vault")
+    def test_ifsck_checks_directories_looked_up_in_several_batches(self):
+        directory_name = 'test_ifsck_checks_directories_looked_up_in_several_batches'
+        full_directory_path = os.path.join(self.admin.local_session_dir, directory_name)
+        full_directory_logical_path = '{0}/{1}'.format(self.admin.session_collection, directory_name)
+
+        # More files than fit in a single lookup, so that the directory is looked up in several batches.
+        os.mkdir(full_directory_path)
+        filenames = ['file_{0:04d}'.format(i) for i in range(600)]
+        for f in filenames:
+            lib.make_file(os.path.join(full_directory_path, f), 10)
+        self.admin.assert_icommand(['ireg', '-r', full_directory_path, full_directory_logical_path])
+
+        # Every file is found in the catalog.
+        self.admin.assert_icommand(['ifsck', '-r', full_directory_path])
+
+        # Corrupt files in different batches and add unregistered files between them.
+        corrupted = [os.path.join(full_directory_path, f) for f in ['file_0010', 'file_0300', 'file_0599']]
+        for path in corrupted:
+            with open(path, 'a') as f:
+                f.write('corrupted')
+
+        unregistered = [os.path.join(full_directory_path, f) for f in ['file_0000_unregistered', 'file_0400_unregistered']]
+        for path in unregistered:
+            lib.make_file(path, 10)
+
+        out, _, ec = self.admin.run_icommand(['ifsck', '-r', full_directory_path])
+        self.assertEqual(ec, 3)
+
+        # The messages are printed in the order in which the files were found, i.e. sorted by path.
+        expected = sorted([(p, 'CORRUPTION: local file [{0}] size'.format(p)) for p in corrupted] +
+                          [(p, 'WARNING: local file [{0}] is not registered in iRODS.'.format(p)) for p in unregistered])
+        lines = out.splitlines()
+        self.assertEqual(len(lines), len(expected))
+        for line, (_, message) in zip(lines, expected):
+            self.assertIn(message, line)
+
+    @unittest.skipIf(test.settings.RUN_IN_TOPOLOGY, "Skip for Topology Testing, checks vault")
+    def test_ifsck_splits_lookups_of_long_paths(self):
+        directory_name = 'test_ifsck_splits_lookups_of_long_paths'
+        full_directory_path = os.path.join(self.admin.local_session_dir, directory_name)
+        full_directory_logical_path = '{0}/{1}'.format(self.admin.session_collection, directory_name)
+
+        # Fewer files than fit in a single lookup, but whose paths together exceed the size of a
+        # single lookup.
+        os.mkdir(full_directory_path)
+        paths = [os.path.join(full_directory_path, '{0:03d}_{1}'.format(i, 'x' * 200)) for i in range(150)]
+        for p in paths:
+            lib.make_file(p, 10)
+        self.admin.assert_icommand(['ireg', '-r', full_directory_path, full_directory_logical_path])
+
+        self.admin.assert_icommand(['ifsck', '-r', full_directory_path])
+
+        # The last file is only found by a later lookup.
+        with open(paths[-1], 'a') as f:
+            f.write('corrupted')
+
+        self.admin.assert_icommand(['ifsck', '-r', full_directory_path],
+                                   'STDOUT_SINGLELINE', 'CORRUPTION: local file [{0}] size'.format(paths[-1]),
+                                   desired_rc=3)
+
+    @unittest.skipIf(test.settings.RUN_IN_TOPOLOGY, "Skip for Topology Testing, checks vault")
+    def test_ifsck_checks_directories_containing_paths_with_quotes(self):
+        directory_name = 'test_ifsck_checks_directories_containing_paths_with_quotes'
+        full_directory_path = os.path.join(self.admin.local_session_dir, directory_name)
+        full_directory_logical_path = '{0}/{1}'.format(self.admin.session_collection, directory_name)
+
+        os.mkdir(full_directory_path)
+        paths = [os.path.join(full_directory_path, 'file_{0}'.format(i)) for i in range(10)]
+        for p in paths:
+            lib.make_file(p, 10)
+        self.admin.assert_icommand(['ireg', '-r', full_directory_path, full_directory_logical_path])
+
+        # A path containing a quote cannot be part of a batched lookup, so every file in the
+        # directory is looked up on its own.
+        quoted_path = os.path.join(full_directory_path, "file_with_a_'quote'")
+        lib.make_file(quoted_path, 10)
+
+        with open(paths[5], 'a') as f:
+            f.write('corrupted')
+
+        out, _, ec = self.admin.run_icommand(['ifsck', '-r', full_directory_path])
+        self.assertEqual(ec, 3)
+
+        # Only the corrupted file and the unregistered file are reported.
+        lines = out.splitlines()
+        self.assertEqual(len(lines), 2)
+        self.assertIn('CORRUPTION: local file [{0}] size'.format(paths[5]), lines[0])
+        self.assertIn(quoted_path, lines[1])
@@ -138,6 +138,53 @@ class Test_Iquest(ResourceBase, unittest.TestCase):
         self.assertTrue(re.match('^\d{11,11}$', timestamps[0]))
         self.assertTrue(re.match('^\d{11,11}$', timestamps[1]))
 
+    def test_iquest_matches_multiple_avus_by_name_and_value_pairs(self):
+        avus = {
+            'obj_a': [('multi_avu_a1', 'v1'), ('multi_avu_a2', 'v2')],
+            'obj_b': [('multi_avu_a1', 'v2'), ('multi_avu_a2', 'v1')],
+            'obj_c': [('multi_avu_a1', 'v1'), ('multi_avu_a2', 'v3')],
+            'obj_d': [('multi_avu_a1', 'v1'), ('multi_avu_a2', 'v2'), ('multi_avu_a3', 'v4')]
+        }
+
+        for data_name, pairs in avus.items():
+            self.admin.assert_icommand(['itouch', data_name])
+            for attribute, value in pairs:
+                self.admin.assert_icommand(['imeta', 'add', '-d', data_name, attribute, value])
+
+        def query(conditions):
+            gql = "select DATA_NAME where COLL_NAME = '{0}' and {1}".format(self.admin.session_collection, conditions)
+            out, _, _ = self.admin.run_icommand(['iquest', '%s', gql])
+            return sorted(line for line in out.splitlines() if not line.startswith('CAT_NO_ROWS_FOUND'))
+
+        # Each value is matched with the name in the same position, so obj_b does not match.
+        self.assertEqual(['obj_a', 'obj_d'], query(
+            "META_DATA_ATTR_NAME = 'multi_avu_a1' and META_DATA_ATTR_VALUE = 'v1' and "
+            "META_DATA_ATTR_NAME = 'multi_avu_a2' and META_DATA_ATTR_VALUE = 'v2'"))
+
+        self.assertEqual(['obj_b'], query(
+            "META_DATA_ATTR_NAME = 'multi_avu_a1' and META_DATA_ATTR_VALUE = 'v2' and "
+            "META_DATA_ATTR_NAME = 'multi_avu_a2' and META_DATA_ATTR_VALUE = 'v1'"))
+
+        # A compound condition stays with its own AVU.
+        self.assertEqual(['obj_a', 'obj_c', 'obj_d'], query(
+            "META_DATA_ATTR_NAME = 'multi_avu_a1' and META_DATA_ATTR_VALUE = 'v1' and "
+            "META_DATA_ATTR_NAME = 'multi_avu_a2' and META_DATA_ATTR_VALUE = 'v2' || = 'v3'"))
+
+        self.assertEqual(['obj_a', 'obj_b', 'obj_d'], query(
+            "META_DATA_ATTR_NAME = 'multi_avu_a1' || = 'multi_avu_a2' and META_DATA_ATTR_VALUE = 'v2' and "
+            "META_DATA_ATTR_NAME = 'multi_avu_a2' and META_DATA_ATTR_VALUE like 'v%'"))
+
+        # Every AVU must match.
+        self.assertEqual(['obj_d'], query(
+            "META_DATA_ATTR_NAME = 'multi_avu_a1' and META_DATA_ATTR_VALUE = 'v1' and "
+            "META_DATA_ATTR_NAME = 'multi_avu_a2' and META_DATA_ATTR_VALUE = 'v2' and "
+            "META_DATA_ATTR_NAME = 'multi_avu_a3' and META_DATA_ATTR_VALUE = 'v4'"))
+
+        self.assertEqual([], query(
+            "META_DATA_ATTR_NAME = 'multi_avu_a1' and META_DATA_ATTR_VALUE = 'v1' and "
+            "META_DATA_ATTR_NAME = 'multi_avu_a2' and META_DATA_ATTR_VALUE = 'v3' and "
+            "META_DATA_ATTR_NAME = 'multi_avu_a3' and META_DATA_ATTR_VALUE = 'v4'"))
+
     def test_iquest_totaldatasize(self):
         self.admin.assert_icommand("iquest \"select sum(DATA_SIZE) where COLL_NAME like '/" +
                                    self.admin.zone_name + "/home/%'\"", 'STDOUT_SINGLELINE', "DATA_SIZE")  # selects total data size
@@ -1,6 +1,7 @@
 from __future__ import print_function
 import os
 import sys
+import textwrap
 
 if sys.version_info < (2, 7):
     import unittest2 as unittest
@@ -10,6 +11,8 @@ else:
 from . import session
 from .. import test
 from .. import lib
+from ..configuration import IrodsConfig
+from ..core_file import temporary_core_file
 
 class Test_Irm(session.make_sessions_mixin([('otherrods', 'rods')], [('alice', 'apass')]), unittest.TestCase):
 
@@ -109,3 +112,87 @@ class Test_Irm(session.make_sessions_mixin([('otherrods', 'rods')], [('alice', '
             self.user.assert_icommand(['irmtrash'])
             self.admin.assert_icommand(['irm', '-r', '-f', collection_path])
             self.admin.assert_icommand(['irmtrash', '-M'])
+
+    @unittest.skipIf(test.settings.RUN_IN_TOPOLOGY, "Skip for Topology Testing")
+    def test_irm_r_removes_data_objects_listed_over_several_pages(self):
+        resource = 'test_irm_r_several_pages_resc'
+        local_dir = os.path.join(self.admin.local_session_dir, 'test_irm_r_several_pages')
+        collection = os.path.join(self.admin.session_collection, 'test_irm_r_several_pages')
+
+        # 300 data objects with two replicas each span three pages of 256 rows, and the replicas of
+        # some data objects are split between two pages.
+        file_count = 300
+        lib.make_large_local_tmp_dir(local_dir, file_count, 10)
+
+        try:
+            lib.create_ufs_resource(self.admin, resource)
+            self.admin.assert_icommand(['iput', '-r', local_dir, collection])
+            self.admin.assert_icommand(['irepl', '-r', '-R', resource, collection])
+
+            physical_paths = self.admin.run_icommand(['iquest', '%s',
+                "select DATA_PATH where COLL_NAME = '{}'".format(collection)])[0].split()
+            self.assertEqual(2 * file_count, len(physical_paths))
+
+            self.admin.assert_icommand(['irm', '-r', '-f', collection])
+
+            self.admin.assert_icommand(['ils', collection], 'STDERR', 'does not exist')
+            self.admin.assert_icommand(['iquest', "select DATA_ID where COLL_NAME like '{}%'".format(collection)],
+                                       'STDOUT', 'CAT_NO_ROWS_FOUND')
+
+            for physical_path in physical_paths:
+                self.assertFalse(os.path.exists(physical_path), msg=physical_path)
+
+        finally:
+            self.admin.run_icommand(['irm', '-r', '-f', collection])
+            lib.remove_resource(self.admin, resource)
+
+    @unittest.skipIf(test.settings.RUN_IN_TOPOLOGY, "Skip for Topology Testing")
+    def test_irm_r_invokes_resource_unlink_peps_for_every_replica(self):
+        # Replicas are unlinked concurrently only when nothing observes the plugin operation. With a PEP
+        # defined, every replica must still be unlinked through the resource plugin.
+        local_dir = os.path.join(self.admin.local_session_dir, 'test_irm_r_unlink_peps')
+        collection = os.path.join(self.admin.session_collection, 'test_irm_r_unlink_peps')
+        message = 'test_irm_r_invokes_resource_unlink_peps_for_every_replica'
+
+        rule_map = {
+            'irods_rule_engine_plugin-irods_rule_language': textwrap.dedent('''
+                pep_resource_unlink_post(*INSTANCE, *CONTEXT, *OUT) {{
+                    writeLine("serverLog", "{0}");
+                }}
+            '''.format(message)),
+            'irods_rule_engine_plugin-python': textwrap.dedent('''
+                def pep_resource_unlink_post(rule_args, callback, rei):
+                    callback.writeLine('serverLog', '{0}')
+            '''.format(message))
+        }
+
+        file_count = 20
+        lib.make_large_local_tmp_dir(local_dir, file_count, 10)
+
+        try:
+            self.admin.assert_icommand(['iput', '-r', local_dir, collection])
+
+            physical_paths = self.admin.run_icommand(['iquest', '%s',
+                "select DATA_PATH where COLL_NAME = '{}'".format(collection)])[0].split()
+            self.assertEqual(file_count, len(physical_paths))
+
+            config = IrodsConfig()
+
+            with temporary_core_file() as core:
+                core.add_rule(rule_map[config.default_rule_engine_plugin])
+
+                log_offset = lib.get_file_size_by_path(config.server_log_path)
+                self.admin.assert_icommand(['irm', '-r', '-f', collection])
+
+                lib.delayAssert(
+                    lambda: lib.log_message_occurrences_equals_count(
+                        msg=message,
+                        count=file_count,
+                        server_log_path=config.server_log_path,
+                        start_index=log_offset))
+
+            for physical_path in physical_paths:
+                self.assertFalse(os.path.exists(physical_path), msg=physical_path)
+
+        finally:
+            self.admin.run_icommand(['irm', '-r', '-f', collection])
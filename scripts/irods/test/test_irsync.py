@@ -317,3 +317,65 @@ class Test_iRsync(ResourceBase, unittest.TestCase):
 
         # sync dir to coll
         self.user0.assert_icommand("irsync -r {local_dir} i:{base_name}".format(**locals()), "STDOUT_SINGLELINE", ustrings.recurse_ok_string())
+
+    @unittest.skip('irsync does not accept -b until the icommands add it to the options of irsync')
+    def test_irsync_r_b_synchronizes_trees_in_bulk(self):
+        base_name = 'test_irsync_r_b_synchronizes_trees_in_bulk'
+        local_dir = os.path.join(self.testing_tmp_dir, base_name)
+        local_dirs = lib.make_deep_local_tmp_dir(local_dir, 3, 20, 100)
+
+        # sync dir to coll
+        _, _, ec = self.user0.run_icommand(['irsync', '-r', '-b', local_dir, 'i:' + base_name])
+        self.assertEqual(ec, 0)
+
+        for dir, files in local_dirs.items():
+            partial_path = dir.replace(self.testing_tmp_dir + '/', '', 1)
+            rods_files = set(lib.get_object_names_from_entries(self.user0.get_entries_in_collection(partial_path)))
+            self.assertEqual(set(files), rods_files)
+
+        # Nothing is listed once the trees are in sync.
+        self.user0.assert_icommand(['irsync', '-r', '-b', '-l', local_dir, 'i:' + base_name], 'EMPTY')
+
+        # Checksums of the data objects are compared with the checksums of the local files.
+        self.user0.assert_icommand(['ichksum', '-r', base_name], 'STDOUT_SINGLELINE')
+        self.user0.assert_icommand(['irsync', '-r', '-b', '-l', local_dir, 'i:' + base_name], 'EMPTY')
+
+        # A file with the same size but different contents, a file with a different size and a new
+        # file are listed in the same format as without -b.
+        same_size = os.path.join(local_dir, 'junk0001')
+        with open(same_size, 'r+') as f:
+            f.write('x')
+
+        larger = os.path.join(local_dir, 'junk0002')
+        with open(larger, 'a') as f:
+            f.write('larger')
+
+        new_file = os.path.join(local_dir, 'new_file')
+        lib.make_file(new_file, 10)
+
+        out, _, ec = self.user0.run_icommand(['irsync', '-r', '-b', '-l', local_dir, 'i:' + base_name])
+        self.assertEqual(ec, 0)
+        self.assertEqual(sorted(out.splitlines()), sorted([
+            '{0}   {1}   N'.format(same_size, 100),
+            '{0}   {1}   N'.format(larger, 106),
+            '{0}   {1}   N'.format(new_file, 10)
+        ]))
+
+        # -l does not transfer anything.
+        self.user0.assert_icommand(['ils', os.path.join(base_name, 'new_file')], 'STDERR_SINGLELINE', 'does not exist')
+
+        _, _, ec = self.user0.run_icommand(['irsync', '-r', '-b', local_dir, 'i:' + base_name])
+        self.assertEqual(ec, 0)
+        self.user0.assert_icommand(['irsync', '-r', '-b', '-l', local_dir, 'i:' + base_name], 'EMPTY')
+
+        # sync coll back to dir
+        shutil.rmtree(local_dir)
+        _, _, ec = self.user0.run_icommand(['irsync', '-r', '-b', 'i:' + base_name, local_dir])
+        self.assertEqual(ec, 0)
+
+        for dir, files in local_dirs.items():
+            self.assertEqual(set(files) | ({'new_file'} if dir == local_dir else set()),
+                             set(f for f in os.listdir(dir) if os.path.isfile(os.path.join(dir, f))))
+
+        with open(larger, 'r') as f:
+            self.assertTrue(f.read().endswith('larger'))
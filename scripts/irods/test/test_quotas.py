@@ -91,3 +91,61 @@ class Test_Quotas(resource_suite.ResourceBase, unittest.TestCase):
 
         finally:
             self.admin.assert_icommand(['iadmin', 'rmgroup', 'test_group_3507'])
+
+    def test_incremental_quota_usage_matches_iadmin_cu(self):
+        def get_id(name):
+            out, _, _ = self.admin.run_icommand(['iquest', '%s', "select USER_ID where USER_NAME = '{}'".format(name)])
+            return out.strip()
+
+        user_id = get_id(self.user0.username)
+        group_id = get_id('public')
+
+        def get_quota_state():
+            usage, _, _ = self.admin.run_icommand(['iquest', '%s %s', "select QUOTA_USAGE_RESC_ID, QUOTA_USAGE "
+                                                   "where QUOTA_USAGE_USER_ID = '{}'".format(user_id)])
+            over, _, _ = self.admin.run_icommand(['iquest', '%s %s %s', "select QUOTA_USER_ID, QUOTA_RESC_ID, QUOTA_OVER "
+                                                  "where QUOTA_USER_ID in ('{}', '{}')".format(user_id, group_id)])
+
+            # "iadmin cu" does not keep rows for resources on which the user no longer has any data.
+            usage = sorted(line for line in usage.splitlines() if re.match(r'^\d+ [1-9]\d*$', line))
+            over = sorted(line for line in over.splitlines() if re.match(r'^\d+ \d+ -?\d+$', line))
+            return usage, over
+
+        filename_1 = os.path.join(self.user0.local_session_dir, 'test_incremental_quota_usage_1')
+        filename_2 = os.path.join(self.user0.local_session_dir, 'test_incremental_quota_usage_2')
+        lib.make_file(filename_1, 1000, contents='arbitrary')
+        lib.make_file(filename_2, 2000, contents='arbitrary')
+
+        try:
+            self.admin.assert_icommand(['iadmin', 'suq', self.user0.username, 'total', '1000000000'])
+            self.admin.assert_icommand(['iadmin', 'suq', self.user0.username, self.testresc, '1000000000'])
+            self.admin.assert_icommand(['iadmin', 'sgq', 'public', self.testresc, '1000000000'])
+            self.admin.assert_icommand(['iadmin', 'cu'])
+
+            data_object_1 = os.path.basename(filename_1)
+            data_object_2 = os.path.basename(filename_2)
+
+            self.user0.assert_icommand(['iput', '-R', self.testresc, filename_1, data_object_1])
+            self.user0.assert_icommand(['iput', filename_2, data_object_2])
+            self.user0.assert_icommand(['irepl', '-R', self.testresc, data_object_2])
+            self.user0.assert_icommand(['irepl', '-R', self.anotherresc, data_object_1])
+            self.user0.assert_icommand(['irm', '-f', data_object_2])
+            self.user0.assert_icommand(['itrim', '-N1', '-S', self.testresc, data_object_1],
+                                       'STDOUT_SINGLELINE', 'Number of files trimmed = 1.')
+
+            # Overwriting a replica changes its size.
+            lib.make_file(filename_1, 3000, contents='arbitrary')
+            self.user0.assert_icommand(['iput', '-f', '-R', self.anotherresc, filename_1, data_object_1])
+
+            incremental = get_quota_state()
+            self.assertNotEqual(incremental, ([], []))
+
+            self.admin.assert_icommand(['iadmin', 'cu'])
+            self.assertEqual(incremental, get_quota_state())
+
+        finally:
+            self.user0.run_icommand(['irm', '-f', os.path.basename(filename_1), os.path.basename(filename_2)])
+            self.admin.run_icommand(['iadmin', 'suq', self.user0.username, 'total', '0'])
+            self.admin.run_icommand(['iadmin', 'suq', self.user0.username, self.testresc, '0'])
+            self.admin.run_icommand(['iadmin', 'sgq', 'public', self.testresc, '0'])
+            self.admin.run_icommand(['iadmin', 'cu'])
@@ -2095,6 +2095,82 @@ class Test_Resource_CompoundWithUnivmss(ChunkyDevTest, ResourceSuite, unittest.T
             os.unlink(filepath)
 
 
+class Test_Resource_CompoundWithUnivmssPersistent(ResourceBase, unittest.TestCase):
+
+    def setUp(self):
+        with session.make_session_for_existing_admin() as admin_session:
+            admin_session.assert_icommand("iadmin modresc demoResc name origResc", 'STDOUT_SINGLELINE', 'rename', input='yes\n')
+            admin_session.assert_icommand("iadmin mkresc demoResc compound", 'STDOUT_SINGLELINE', 'compound')
+            irods_config = IrodsConfig()
+            admin_session.assert_icommand("iadmin mkresc cacheResc 'unixfilesystem' " + test.settings.HOSTNAME_1 + ":" +
+                                          irods_config.irods_directory + "/cacheRescVault", 'STDOUT_SINGLELINE', 'unixfilesystem')
+            admin_session.assert_icommand("iadmin mkresc archiveResc univmss " + test.settings.HOSTNAME_1 + ":" +
+                                          irods_config.irods_directory + "/archiveRescVault 'script=univMSSInterface.sh;mode=persistent'",
+                                          'STDOUT_SINGLELINE', 'univmss')
+            admin_session.assert_icommand("iadmin addchildtoresc demoResc cacheResc cache")
+            admin_session.assert_icommand("iadmin addchildtoresc demoResc archiveResc archive")
+        super(Test_Resource_CompoundWithUnivmssPersistent, self).setUp()
+
+    def tearDown(self):
+        super(Test_Resource_CompoundWithUnivmssPersistent, self).tearDown()
+        with session.make_session_for_existing_admin() as admin_session:
+            admin_session.assert_icommand("iadmin rmchildfromresc demoResc archiveResc")
+            admin_session.assert_icommand("iadmin rmchildfromresc demoResc cacheResc")
+            admin_session.assert_icommand("iadmin rmresc archiveResc")
+            admin_session.assert_icommand("iadmin rmresc cacheResc")
+            admin_session.assert_icommand("iadmin rmresc demoResc")
+            admin_session.assert_icommand("iadmin modresc origResc name demoResc", 'STDOUT_SINGLELINE', 'rename', input='yes\n')
+        irods_config = IrodsConfig()
+        shutil.rmtree(irods_config.irods_directory + "/archiveRescVault", ignore_errors=True)
+        shutil.rmtree(irods_config.irods_directory + "/cacheRescVault", ignore_errors=True)
+
+    def test_put_trim_stage_and_remove_through_the_driver(self):
+        # a quote and spaces must reach the script untouched, since arguments are never evaluated.
+        filename = "persistent driver's file.txt"
+        filepath = lib.create_local_testfile(filename)
+        logical_path = os.path.join(self.admin.session_collection, filename)
+        get_path = filepath + '.get'
+
+        try:
+            self.admin.assert_icommand(['iput', filepath, logical_path])
+            self.admin.assert_icommand(['ils', '-l', logical_path], 'STDOUT_SINGLELINE', ' archiveResc ')
+
+            # remove the cache replica so that the get has to stage from the archive.
+            self.admin.assert_icommand(['itrim', '-n0', '-N1', logical_path], 'STDOUT_SINGLELINE', 'files trimmed')
+            self.admin.assert_icommand(['iget', logical_path, get_path])
+
+            with open(filepath) as expected, open(get_path) as actual:
+                self.assertEqual(expected.read(), actual.read())
+
+            self.admin.assert_icommand(['irm', '-f', logical_path])
+            self.admin.assert_icommand_fail(['ils', logical_path], 'STDOUT_SINGLELINE', filename)
+
+        finally:
+            for path in [filepath, get_path]:
+                if os.path.exists(path):
+                    os.unlink(path)
+
+    def test_many_requests_are_served_by_the_driver(self):
+        local_dir = os.path.abspath('test_many_requests_are_served_by_the_driver')
+        logical_path = os.path.join(self.admin.session_collection, os.path.basename(local_dir))
+        file_count = 20
+
+        try:
+            lib.make_large_local_tmp_dir(local_dir, file_count, 10)
+            self.admin.assert_icommand(['iput', '-r', local_dir, logical_path])
+
+            # every file must have its archive replica.
+            _, out, _ = self.admin.assert_icommand(['iquest', '%s',
+                "select count(DATA_ID) where COLL_NAME = '{}' and DATA_RESC_NAME = 'archiveResc'".format(logical_path)],
+                'STDOUT')
+            self.assertEqual(file_count, int(out.strip()))
+
+            self.admin.assert_icommand(['irm', '-rf', logical_path])
+
+        finally:
+            shutil.rmtree(local_dir, ignore_errors=True)
+
+
 class Test_Resource_Compound(ChunkyDevTest, ResourceSuite, unittest.TestCase):
     plugin_name = IrodsConfig().default_rule_engine_plugin
     class_name = 'Test_Resource_Compound'
@@ -3142,6 +3218,173 @@ class Test_Resource_Compound(ChunkyDevTest, ResourceSuite, unittest.TestCase):
             # Make sure the archive vault is put back to a workable permissions set.
             os.chmod(archive_vault_path, 0o750)
 
+    def set_cache_eviction_context(self, policy, check_interval_in_seconds=0):
+        # The cache holds three 1000 byte replicas before it exceeds the high watermark, and two once evicted from.
+        self.admin.assert_icommand(['iadmin', 'modresc', 'demoResc', 'context',
+            'auto_repl=on;'
+            'cache_eviction_high_watermark_in_bytes=2500;'
+            'cache_eviction_low_watermark_in_bytes=2000;'
+            'cache_eviction_policy={};'
+            'cache_access_time_granularity_in_seconds=1;'
+            'cache_eviction_check_interval_in_seconds={}'.format(policy, check_interval_in_seconds)])
+
+    def put_cache_eviction_test_files(self, count):
+        logical_paths = []
+        for i in range(count):
+            filename = 'cache_eviction_test_file_{}'.format(i)
+            lib.make_file(filename, 1000, 'arbitrary')
+            logical_paths.append(os.path.join(self.admin.session_collection, filename))
+            self.admin.assert_icommand(['iput', filename, logical_paths[-1]])
+            os.unlink(filename)
+            # Keep the modify times of the replicas apart.
+            time.sleep(1)
+        return logical_paths
+
+    def get_and_wait_for_recorded_cache_access(self, logical_path):
+        data_id = self.admin.run_icommand(['iquest', '%s', "select DATA_ID where COLL_NAME = '{}' and DATA_NAME = '{}'"
+            .format(os.path.dirname(logical_path), os.path.basename(logical_path))])[0].split()[0]
+
+        self.admin.assert_icommand(['iget', '-f', logical_path, os.devnull])
+
+        # The access is recorded after the client disconnects.
+        lib.delayAssert(lambda: data_id in self.admin.run_icommand(['iquest', '%s',
+            "select META_RESC_ATTR_VALUE where RESC_NAME = 'cacheResc' and META_RESC_ATTR_NAME = 'irods::compound::cache_access'"])[0])
+
+        # Keep the access apart from the modify times of the replicas written afterwards.
+        time.sleep(1)
+
+    def test_cache_eviction_lru_evicts_the_least_recently_used_replica(self):
+        self.set_cache_eviction_context('lru')
+
+        logical_paths = self.put_cache_eviction_test_files(1)
+        self.get_and_wait_for_recorded_cache_access(logical_paths[0])
+        logical_paths += self.put_cache_eviction_test_files(1)
+
+        # The second replica was written after the first one was read, so the first one is evicted.
+        logical_paths += self.put_cache_eviction_test_files(1)
+        lib.delayAssert(lambda: not lib.replica_exists_on_resource(self.admin, logical_paths[0], 'cacheResc'))
+
+        self.assertTrue(lib.replica_exists_on_resource(self.admin, logical_paths[0], 'archiveResc'))
+        self.assertTrue(lib.replica_exists_on_resource(self.admin, logical_paths[1], 'cacheResc'))
+        self.assertTrue(lib.replica_exists_on_resource(self.admin, logical_paths[2], 'cacheResc'))
+
+        # The accesses of evicted replicas are forgotten.
+        self.admin.assert_icommand(['imeta', 'ls', '-R', 'cacheResc'], 'STDOUT', 'None')
+
+    def test_cache_eviction_lfu_evicts_the_least_frequently_used_replica(self):
+        self.set_cache_eviction_context('lfu')
+
+        logical_paths = self.put_cache_eviction_test_files(1)
+        self.get_and_wait_for_recorded_cache_access(logical_paths[0])
+        logical_paths += self.put_cache_eviction_test_files(2)
+
+        # The second replica was never read, so it is evicted even though the first one was used longer ago.
+        lib.delayAssert(lambda: not lib.replica_exists_on_resource(self.admin, logical_paths[1], 'cacheResc'))
+
+        self.assertTrue(lib.replica_exists_on_resource(self.admin, logical_paths[0], 'cacheResc'))
+        self.assertTrue(lib.replica_exists_on_resource(self.admin, logical_paths[2], 'cacheResc'))
+
+    def test_cache_eviction_recorded_accesses_are_not_visible_on_data_objects(self):
+        self.set_cache_eviction_context('lru')
+
+        logical_paths = self.put_cache_eviction_test_files(1)
+        self.get_and_wait_for_recorded_cache_access(logical_paths[0])
+
+        self.admin.assert_icommand(['imeta', 'ls', '-d', logical_paths[0]], 'STDOUT', 'None')
+
+        # Removing the cache replica forgets its accesses.
+        self.admin.assert_icommand(['irm', '-f', logical_paths[0]])
+        lib.delayAssert(lambda: 'irods::compound::cache_access' not in self.admin.run_icommand(['imeta', 'ls', '-R', 'cacheResc'])[0])
+
+    def test_cache_eviction_checks_the_usage_at_most_once_per_check_interval(self):
+        self.set_cache_eviction_context('lru', check_interval_in_seconds=3600)
+
+        # The first put checks the usage, which is below the high watermark, and leaves the eviction lock claimed.
+        logical_paths = self.put_cache_eviction_test_files(1)
+        lib.delayAssert(lambda: 'irods::compound::cache_eviction_lock' in self.admin.run_icommand(['imeta', 'ls', '-R', 'demoResc'])[0])
+
+        # The cache exceeds the high watermark, but no agent checks it before the interval elapses.
+        logical_paths += self.put_cache_eviction_test_files(2)
+        time.sleep(3)
+        for logical_path in logical_paths:
+            self.assertTrue(lib.replica_exists_on_resource(self.admin, logical_path, 'cacheResc'))
+
+        # Once the claim is gone, the next agent to grow the cache checks its usage and evicts.
+        self.admin.assert_icommand(['imeta', 'rmw', '-R', 'demoResc', 'irods::compound::cache_eviction_lock', '%', '%'])
+        logical_paths += self.put_cache_eviction_test_files(1)
+        lib.delayAssert(lambda: not lib.replica_exists_on_resource(self.admin, logical_paths[0], 'cacheResc'))
+
+        # Only one claim remains.
+        out = self.admin.run_icommand(['imeta', 'ls', '-R', 'demoResc', 'irods::compound::cache_eviction_lock'])[0]
+        self.assertEqual(1, out.count('attribute: irods::compound::cache_eviction_lock'))
+
+    def get_sync_queue(self):
+        return self.admin.run_icommand(['iquest', '%s %s',
+            "select META_RESC_ATTR_VALUE, META_RESC_ATTR_UNITS where RESC_NAME = 'demoResc' and META_RESC_ATTR_NAME = 'irods::compound::sync_pending'"])[0]
+
+    def test_async_auto_repl_syncs_to_the_archive_after_the_client_disconnects(self):
+        self.admin.assert_icommand(['iadmin', 'modresc', 'demoResc', 'context', 'auto_repl=async'])
+
+        filename = 'async_auto_repl_file'
+        lib.make_file(filename, 1000, 'arbitrary')
+        logical_path = os.path.join(self.user0.session_collection, filename)
+        self.user0.assert_icommand(['iput', filename, logical_path])
+        os.unlink(filename)
+
+        lib.delayAssert(lambda: lib.replica_exists_on_resource(self.user0, logical_path, 'archiveResc'))
+        lib.delayAssert(lambda: 'CAT_NO_ROWS_FOUND' in self.get_sync_queue())
+        self.assertEqual('1', lib.get_replica_status(self.user0, filename, 1))
+
+        # The queue is kept on the compound resource, not on the data object.
+        self.user0.assert_icommand(['imeta', 'ls', '-d', logical_path], 'STDOUT', 'None')
+
+    def test_async_auto_repl_sync_queue_cannot_be_modified_by_owners(self):
+        self.admin.assert_icommand(['iadmin', 'modresc', 'demoResc', 'context', 'auto_repl=async'])
+
+        filename = 'async_auto_repl_file'
+        lib.make_file(filename, 1000, 'arbitrary')
+        logical_path = os.path.join(self.user0.session_collection, filename)
+        self.user0.assert_icommand(['iput', filename, logical_path])
+        os.unlink(filename)
+
+        data_id = self.user0.run_icommand(['iquest', '%s', "select DATA_ID where COLL_NAME = '{}' and DATA_NAME = '{}'"
+            .format(self.user0.session_collection, filename)])[0].split()[0]
+
+        # An entry queued far in the future is never taken over.
+        token = '{}:owner_test'.format(2**40)
+        self.admin.assert_icommand(['imeta', 'add', '-R', 'demoResc', 'irods::compound::sync_pending', data_id, token])
+
+        try:
+            self.user0.assert_icommand(['imeta', 'rm', '-R', 'demoResc', 'irods::compound::sync_pending', data_id, token],
+                                       'STDERR', 'CAT_INSUFFICIENT_PRIVILEGE_LEVEL')
+            self.assertIn(token, self.get_sync_queue())
+        finally:
+            self.admin.assert_icommand(['imeta', 'rm', '-R', 'demoResc', 'irods::compound::sync_pending', data_id, token])
+
+    def test_async_auto_repl_abandoned_syncs_are_taken_over_by_other_agents(self):
+        # Write a data object to the cache only.
+        self.admin.assert_icommand(['iadmin', 'modresc', 'demoResc', 'context', 'auto_repl=off'])
+
+        filename = 'abandoned_sync_file'
+        lib.make_file(filename, 1000, 'arbitrary')
+        logical_path = os.path.join(self.admin.session_collection, filename)
+        self.admin.assert_icommand(['iput', filename, logical_path])
+        os.unlink(filename)
+        self.assertFalse(lib.replica_exists_on_resource(self.admin, logical_path, 'archiveResc'))
+
+        data_id = self.admin.run_icommand(['iquest', '%s', "select DATA_ID where COLL_NAME = '{}' and DATA_NAME = '{}'"
+            .format(self.admin.session_collection, filename)])[0].split()[0]
+
+        # Leave a queue entry behind as an agent which exited before performing the sync would.
+        self.admin.assert_icommand(['iadmin', 'modresc', 'demoResc', 'context',
+            'auto_repl=async;async_sync_orphan_age_in_seconds=0;async_sync_retry_interval_in_seconds=0'])
+        self.admin.assert_icommand(['imeta', 'add', '-R', 'demoResc', 'irods::compound::sync_pending', data_id, '0:abandoned'])
+
+        # Agents which do not use the compound resource drain the queue as well.
+        lib.delayAssert(lambda: self.admin.run_icommand(['ils'])[2] == 0 and
+                                lib.replica_exists_on_resource(self.admin, logical_path, 'archiveResc'))
+        lib.delayAssert(lambda: 'CAT_NO_ROWS_FOUND' in self.get_sync_queue())
+
 
 class Test_Resource_ReplicationWithinReplication(ChunkyDevTest, ResourceSuite, unittest.TestCase):
 
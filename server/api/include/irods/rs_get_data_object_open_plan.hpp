@@ -0,0 +1,37 @@
+#ifndef IRODS_RS_GET_DATA_OBJECT_OPEN_PLAN_HPP
+#define IRODS_RS_GET_DATA_OBJECT_OPEN_PLAN_HPP
+
+/// \file
+
+struct RsComm;
+struct BytesBuf;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Returns everything the server needs to open or create a data object in a single round trip.
+///
+/// See rc_get_data_object_open_plan() for the format of the input and output.
+///
+/// \param[in]     _comm       A pointer to a RsComm.
+/// \param[in]     _json_input A JSON string describing the data object and the access level.
+/// \param[in,out] _output     The address to a BytesBuf pointer. On success, it will point
+///                            to a JSON string containing the plan. On failure, the pointer
+///                            is not modified.
+///
+/// \return An integer.
+/// \retval  0                        On success.
+/// \retval  CAT_NO_ACCESS_PERMISSION If the data object exists but the client lacks the
+///                                   requested access.
+/// \retval  SYS_NOT_SUPPORTED        If a ticket or strict access control is in effect.
+/// \retval <0                        On failure.
+///
+/// \since 4.3.1
+auto rs_get_data_object_open_plan(RsComm* _comm, const char* _json_input, BytesBuf** _output) -> int;
+
+#ifdef __cplusplus
+} // extern "C"
+#endif
+
+#endif // IRODS_RS_GET_DATA_OBJECT_OPEN_PLAN_HPP
@@ -107,50 +107,6 @@ namespace
         return totalRowCount;
     } // getNumSubfilesInBunfileObj
 
-int chkPreProcDeleteRule(
-    rsComm_t* rsComm,
-    dataObjInp_t& dataObjUnlinkInp,
-    dataObjInfo_t* dataObjInfoHead) {
-
-    ruleExecInfo_t rei{};
-    initReiWithDataObjInp(&rei, rsComm, &dataObjUnlinkInp);
-    clearKeyVal(rei.condInputData);
-    free(rei.condInputData);
-    dataObjInfo_t* tmpDataObjInfo = dataObjInfoHead;
-    int status = 0;
-    while (tmpDataObjInfo) {
-        /* have to go through the loop to test each copy (resource). */
-        rei.doi = tmpDataObjInfo;
-
-        // make resource properties available as rule session variables
-        rei.condInputData = (keyValPair_t *)malloc(sizeof(keyValPair_t));
-        memset(rei.condInputData, 0, sizeof(keyValPair_t));
-        irods::get_resc_properties_as_kvp(rei.doi->rescHier, rei.condInputData);
-
-        status = applyRule("acDataDeletePolicy", NULL, &rei, NO_SAVE_REI );
-        clearKeyVal(rei.condInputData);
-        free(rei.condInputData);
-
-        if (status < 0 &&
-            status != NO_MORE_RULES_ERR &&
-            status != SYS_DELETE_DISALLOWED) {
-            rodsLog(LOG_ERROR,
-                    "%s: acDataDeletePolicy err for %s. stat = %d",
-                    __FUNCTION__, dataObjUnlinkInp.objPath, status );
-            return status;
-        }
-
-        if (rei.status == SYS_DELETE_DISALLOWED) {
-            rodsLog(LOG_ERROR,
-                    "%s:acDataDeletePolicy disallowed delete of %s",
-                    __FUNCTION__, dataObjUnlinkInp.objPath );
-            return rei.status;
-        }
-        tmpDataObjInfo = tmpDataObjInfo->next;
-    }
-    return status;
-}
-
 int rsMvDataObjToTrash(
     rsComm_t *rsComm,
     dataObjInp_t& dataObjInp,
@@ -452,6 +408,50 @@ int rsMvDataObjToTrash(
     } // get_path_permissions_check_setting
 } // anonymous namespace
 
+int chkPreProcDeleteRule(
+    rsComm_t* rsComm,
+    dataObjInp_t& dataObjUnlinkInp,
+    dataObjInfo_t* dataObjInfoHead) {
+
+    ruleExecInfo_t rei{};
+    initReiWithDataObjInp(&rei, rsComm, &dataObjUnlinkInp);
+    clearKeyVal(rei.condInputData);
+    free(rei.condInputData);
+    dataObjInfo_t* tmpDataObjInfo = dataObjInfoHead;
+    int status = 0;
+    while (tmpDataObjInfo) {
+        /* have to go through the loop to test each copy (resource). */
+        rei.doi = tmpDataObjInfo;
+
+        // make resource properties available as rule session variables
+        rei.condInputData = (keyValPair_t *)malloc(sizeof(keyValPair_t));
+        memset(rei.condInputData, 0, sizeof(keyValPair_t));
+        irods::get_resc_properties_as_kvp(rei.doi->rescHier, rei.condInputData);
+
+        status = applyRule("acDataDeletePolicy", NULL, &rei, NO_SAVE_REI );
+        clearKeyVal(rei.condInputData);
+        free(rei.condInputData);
+
+        if (status < 0 &&
+            status != NO_MORE_RULES_ERR &&
+            status != SYS_DELETE_DISALLOWED) {
+            rodsLog(LOG_ERROR,
+                    "%s: acDataDeletePolicy err for %s. stat = %d",
+                    __FUNCTION__, dataObjUnlinkInp.objPath, status );
+            return status;
+        }
+
+        if (rei.status == SYS_DELETE_DISALLOWED) {
+            rodsLog(LOG_ERROR,
+                    "%s:acDataDeletePolicy disallowed delete of %s",
+                    __FUNCTION__, dataObjUnlinkInp.objPath );
+            return rei.status;
+        }
+        tmpDataObjInfo = tmpDataObjInfo->next;
+    }
+    return status;
+}
+
 int rsDataObjUnlink(rsComm_t* rsComm, dataObjInp_t* dataObjUnlinkInp)
 {
     try {
@@ -20,6 +20,7 @@
 #include <span>
 #include <string>
 #include <string_view>
+#include <unordered_map>
 
 namespace {
     using log_api = irods::experimental::log::api;
@@ -505,9 +506,11 @@ irods::error add_resc_hier_name_to_query_out( genQueryOut_t *_out, int& _pos ) {
     sqlResult->attriInx = COL_D_RESC_HIER;
 
     // =-=-=-=-=-=-=-
-    // cache hier strings for leaf id
+    // cache hier strings for leaf id. a page of rows usually names only a
+    // handful of distinct resources, so each hierarchy is resolved once.
     size_t max_len = 0;
     std::vector<std::string> resc_hiers(_out->rowCnt);
+    std::unordered_map<rodsLong_t, std::string> hier_cache;
     for ( int i = 0; i < _out->rowCnt; ++i ) {
         char* leaf_id_str = &sqlResult->value[i*sqlResult->len];
 
@@ -520,11 +523,17 @@ irods::error add_resc_hier_name_to_query_out( genQueryOut_t *_out, int& _pos ) {
             continue;
         }
 
-        std::string hier;
-        ret = resc_mgr.leaf_id_to_hier( leaf_id, resc_hiers[i] );
-        if(!ret.ok()) {
-            irods::log(PASS(ret));
-            continue;
+        if ( const auto iter = hier_cache.find( leaf_id ); iter != hier_cache.end() ) {
+            resc_hiers[i] = iter->second;
+        }
+        else {
+            ret = resc_mgr.leaf_id_to_hier( leaf_id, resc_hiers[i] );
+            if(!ret.ok()) {
+                irods::log(PASS(ret));
+                continue;
+            }
+
+            hier_cache.emplace( leaf_id, resc_hiers[i] );
         }
 
         if(resc_hiers[i].size() > max_len ) {
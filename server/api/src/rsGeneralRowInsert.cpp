@@ -8,6 +8,10 @@
 #include "irods/icatHighLevelRoutines.hpp"
 #include "irods/miscServerFunct.hpp"
 #include "irods/irods_configuration_keywords.hpp"
+#include "irods/load_digest_cache.hpp"
+
+#include <cstdlib>
+#include <ctime>
 
 int
 rsGeneralRowInsert( rsComm_t *rsComm, generalRowInsertInp_t *generalRowInsertInp ) {
@@ -49,6 +53,14 @@ rsGeneralRowInsert( rsComm_t *rsComm, generalRowInsertInp_t *generalRowInsertInp
         rodsLog( LOG_NOTICE,
                  "rsGeneralRowInsert: rcGeneralRowInsert failed" );
     }
+    else if ( strcmp( generalRowInsertInp->tableName, "serverloaddigest" ) == 0 ) {
+        // Make the new digest visible to the load_balanced resources on this server
+        // without waiting for their cached snapshot of the catalog to expire.
+        irods::experimental::load_digest_cache::insert_or_assign( {
+            generalRowInsertInp->arg1,
+            std::atoi( generalRowInsertInp->arg2 ),
+            static_cast<std::int64_t>( std::time( nullptr ) ) } );
+    }
     return status;
 }
 
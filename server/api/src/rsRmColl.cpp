@@ -5,6 +5,7 @@
 
 #include "irods/rmColl.h"
 #include "irods/objMetaOpr.hpp"
+#include "irods/physPath.hpp"
 #include "irods/specColl.hpp"
 #include "irods/icatHighLevelRoutines.hpp"
 #include "irods/openCollection.h"
@@ -27,21 +28,639 @@
 #include "irods/rsFileRmdir.hpp"
 #include "irods/rsDataObjRename.hpp"
 #include "irods/rsGenQuery.hpp"
+#include "irods/rsFileUnlink.hpp"
+#include "irods/rsUnregDataObj.hpp"
+#include "irods/unregDataObj.h"
 
 #include "irods/irods_resource_backport.hpp"
 #include "irods/irods_configuration_keywords.hpp"
+#include "irods/irods_hierarchy_parser.hpp"
+#include "irods/irods_server_properties.hpp"
+#include "irods/irods_at_scope_exit.hpp"
 #include "irods/scoped_privileged_client.hpp"
 #include "irods/irods_logger.hpp"
+#include "irods/thread_pool.hpp"
 
 #define IRODS_FILESYSTEM_ENABLE_SERVER_SIDE_API
 #include "irods/filesystem.hpp"
 
+#include <algorithm>
 #include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <unistd.h>
 
 namespace ix = irods::experimental;
 
 namespace
 {
+    // The number of threads used to unlink replicas when the advanced setting is not defined.
+    constexpr int default_number_of_concurrent_unlink_threads = 4;
+
+    // What the recursive removal engine needs to know about the resource holding a replica.
+    // It is looked up once per leaf resource instead of once per replica.
+    struct leaf_resource_info
+    {
+        bool usable;
+        bool local;
+        bool skip_vault_path_check;
+        std::string vault_path;
+
+        // True if replicas can be unlinked with unlink(2) from a worker thread. The resource must be a
+        // standalone unixfilesystem resource served by this server, without PEPs for the unlink operation.
+        bool unlink_concurrently;
+    }; // struct leaf_resource_info
+
+    struct data_object_entry
+    {
+        std::vector<DataObjInfo> replicas;
+        std::vector<int> unlink_status;
+        int status;
+
+        // True if the data object was handed to rsDataObjUnlink.
+        bool removed_individually;
+    }; // struct data_object_entry
+
+    struct removal_result
+    {
+        int status;
+
+        // False if the collection could not be listed. The caller must remove the
+        // remaining data objects one at a time.
+        bool listed;
+
+        // True if progress could not be reported to the client.
+        bool cancelled;
+    }; // struct removal_result
+
+    auto get_number_of_concurrent_unlink_threads() -> int
+    {
+        try {
+            const auto n = irods::get_advanced_setting<int>(irods::KW_CFG_NUMBER_OF_CONCURRENT_UNLINK_THREADS);
+
+            if (n > 0) {
+                return n;
+            }
+        }
+        catch (...) {
+        }
+
+        return default_number_of_concurrent_unlink_threads;
+    } // get_number_of_concurrent_unlink_threads
+
+    // Data objects can be removed in batches unless the request relies on the per-object
+    // behavior of rsDataObjUnlink (age limits, bundles, unregistering, special collections).
+    auto can_remove_in_batches(collInp_t& _coll_inp, const dataObjInfo_t* _coll_info) -> bool
+    {
+        if (UNREG_OPR == _coll_inp.oprType ||
+            isHomeColl(_coll_inp.collName) ||
+            getValByKey(&_coll_inp.condInput, AGE_KW) ||
+            getValByKey(&_coll_inp.condInput, EMPTY_BUNDLE_ONLY_KW) ||
+            (_coll_info && _coll_info->specColl))
+        {
+            return false;
+        }
+
+        // Catalog updates are committed once per batch, which requires a local catalog.
+        std::string svc_role;
+        if (const auto err = get_catalog_service_role(svc_role); !err.ok()) {
+            irods::log(PASS(err));
+            return false;
+        }
+
+        return irods::KW_CFG_SERVICE_ROLE_PROVIDER == svc_role;
+    } // can_remove_in_batches
+
+    auto get_leaf_resource_info(const dataObjInfo_t& _replica) -> leaf_resource_info
+    {
+        leaf_resource_info info{};
+
+        std::string resc_class;
+        if (!irods::get_resource_property<std::string>(_replica.rescId, irods::RESOURCE_CLASS, resc_class).ok() ||
+            irods::RESOURCE_CLASS_BUNDLE == resc_class)
+        {
+            return info;
+        }
+
+        std::string location;
+        if (!irods::is_hier_live(_replica.rescHier).ok() ||
+            !irods::get_loc_for_hier_string(_replica.rescHier, location).ok())
+        {
+            return info;
+        }
+
+        const auto err = irods::get_resource_property<bool>(
+            _replica.rescId, irods::RESOURCE_SKIP_VAULT_PATH_CHECK_ON_UNLINK, info.skip_vault_path_check);
+
+        if (!err.ok()) {
+            info.skip_vault_path_check = false;
+        }
+
+        if (!info.skip_vault_path_check &&
+            !irods::get_vault_path_for_hier_string(_replica.rescHier, info.vault_path).ok())
+        {
+            return info;
+        }
+
+        rodsServerHost_t* host{};
+        if (irods::get_resource_property<rodsServerHost_t*>(_replica.rescId, irods::RESOURCE_HOST, host).ok() && host) {
+            info.local = (LOCAL_HOST == host->localFlag);
+        }
+
+        // unix_file_unlink is a plain unlink(2) of the physical path. Doing the same without the plugin
+        // touches neither the agent's connection nor the rule engine, so it is safe from any thread.
+        if (info.local && std::string_view{_replica.rescHier} == _replica.rescName) {
+            std::string resc_type;
+            irods::resource_ptr resc;
+
+            info.unlink_concurrently =
+                irods::get_resource_property<std::string>(_replica.rescId, irods::RESOURCE_TYPE, resc_type).ok() &&
+                "unixfilesystem" == resc_type && resc_mgr.resolve(_replica.rescId, resc).ok() &&
+                !resc->policy_enforcement_points_exist(irods::RESOURCE_OP_UNLINK);
+        }
+
+        info.usable = true;
+
+        return info;
+    } // get_leaf_resource_info
+
+    auto make_replica(genQueryOut_t& _out, int _row) -> DataObjInfo
+    {
+        const auto value = [&_out, _row](int _column) -> const char* {
+            const auto* result = getSqlResultByInx(&_out, _column);
+            return result ? &result->value[result->len * _row] : "";
+        };
+
+        DataObjInfo info{};
+
+        snprintf(info.objPath, MAX_NAME_LEN, "%s/%s", value(COL_COLL_NAME), value(COL_DATA_NAME));
+        rstrcpy(info.rescHier, value(COL_D_RESC_HIER), MAX_NAME_LEN);
+
+        // A replica whose hierarchy cannot be resolved keeps a resource id of zero and is
+        // left to rsDataObjUnlink.
+        if (const auto err = resc_mgr.hier_to_leaf_id(info.rescHier, info.rescId); !err.ok()) {
+            info.rescId = 0;
+        }
+
+        irods::hierarchy_parser parser{info.rescHier};
+        rstrcpy(info.rescName, parser.last_resc().c_str(), NAME_LEN);
+
+        rstrcpy(info.dataType, value(COL_DATA_TYPE_NAME), NAME_LEN);
+        info.dataSize = strtoll(value(COL_DATA_SIZE), 0, 0);
+        rstrcpy(info.chksum, value(COL_D_DATA_CHECKSUM), NAME_LEN);
+        rstrcpy(info.version, value(COL_DATA_VERSION), NAME_LEN);
+        rstrcpy(info.filePath, value(COL_D_DATA_PATH), MAX_NAME_LEN);
+        rstrcpy(info.dataOwnerName, value(COL_D_OWNER_NAME), NAME_LEN);
+        rstrcpy(info.dataOwnerZone, value(COL_D_OWNER_ZONE), NAME_LEN);
+        info.replNum = atoi(value(COL_DATA_REPL_NUM));
+        info.replStatus = atoi(value(COL_D_REPL_STATUS));
+        rstrcpy(info.statusString, value(COL_D_DATA_STATUS), NAME_LEN);
+        info.dataId = strtoll(value(COL_D_DATA_ID), 0, 0);
+        info.collId = strtoll(value(COL_D_COLL_ID), 0, 0);
+        info.dataMapId = atoi(value(COL_D_MAP_ID));
+        rstrcpy(info.dataComments, value(COL_D_COMMENTS), LONG_NAME_LEN);
+        rstrcpy(info.dataExpiry, value(COL_D_EXPIRY), TIME_LEN);
+        rstrcpy(info.dataCreate, value(COL_D_CREATE_TIME), TIME_LEN);
+        rstrcpy(info.dataModify, value(COL_D_MODIFY_TIME), TIME_LEN);
+        rstrcpy(info.dataMode, value(COL_DATA_MODE), SHORT_STR_LEN);
+        info.writeFlag = getWriteFlag(O_WRONLY);
+
+        return info;
+    } // make_replica
+
+    // Links the replicas into the list expected by the policy enforcement points.
+    auto link_replicas(data_object_entry& _object) -> dataObjInfo_t*
+    {
+        for (std::size_t i = 1; i < _object.replicas.size(); ++i) {
+            _object.replicas[i - 1].next = &_object.replicas[i];
+        }
+
+        return &_object.replicas.front();
+    } // link_replicas
+
+    auto unlink_local_replica(rsComm_t& _comm, const dataObjInfo_t& _replica, const char* _in_pdmo) -> int
+    {
+        fileUnlinkInp_t unlink_inp{};
+        rstrcpy(unlink_inp.fileName, _replica.filePath, MAX_NAME_LEN);
+        rstrcpy(unlink_inp.rescHier, _replica.rescHier, MAX_NAME_LEN);
+        rstrcpy(unlink_inp.objPath, _replica.objPath, MAX_NAME_LEN);
+        rstrcpy(unlink_inp.in_pdmo, _in_pdmo, MAX_NAME_LEN);
+        return _rsFileUnlink(&_comm, &unlink_inp);
+    } // unlink_local_replica
+
+    auto remove_individually(rsComm_t& _comm, const dataObjInp_t& _unlink_inp, const char* _path) -> int
+    {
+        // rsDataObjUnlink adds keywords to its input, so each call gets its own copy.
+        dataObjInp_t inp{};
+        inp.oprType = _unlink_inp.oprType;
+        rstrcpy(inp.objPath, _path, MAX_NAME_LEN);
+        replKeyVal(&_unlink_inp.condInput, &inp.condInput);
+
+        const auto ec = rsDataObjUnlink(&_comm, &inp);
+        clearKeyVal(&inp.condInput);
+
+        return ec;
+    } // remove_individually
+
+    auto apply_post_proc_for_delete(rsComm_t& _comm, dataObjInp_t& _unlink_inp, data_object_entry& _object) -> void
+    {
+        ruleExecInfo_t rei;
+        initReiWithDataObjInp(&rei, &_comm, &_unlink_inp);
+        rei.doi = link_replicas(_object);
+        rei.status = _object.status;
+
+        // make resource properties available as rule session variables
+        irods::get_resc_properties_as_kvp(rei.doi->rescHier, rei.condInputData);
+
+        rei.status = applyRule("acPostProcForDelete", NULL, &rei, NO_SAVE_REI);
+        if (rei.status < 0) {
+            rodsLog(LOG_NOTICE,
+                    "%s: acPostProcForDelete error for %s. status = %d",
+                    __FUNCTION__, _unlink_inp.objPath, rei.status);
+        }
+
+        clearKeyVal(rei.condInputData);
+        free(rei.condInputData);
+    } // apply_post_proc_for_delete
+
+    // Unregisters the replicas of one batch within a single catalog transaction. If anything
+    // fails, the transaction is rolled back and the replicas are unregistered one at a time.
+    class batch_unregistration
+    {
+    public:
+        batch_unregistration(rsComm_t& _comm, keyValPair_t& _cond_input)
+            : comm_{_comm}
+            , cond_input_{_cond_input}
+        {
+        }
+
+        auto unregister(data_object_entry& _object, dataObjInfo_t& _replica) -> void
+        {
+            _replica.flags |= NO_COMMIT_FLAG;
+
+            if (const auto ec = unregister_replica(_replica); ec < 0) {
+                set_status(_object, ec);
+                replay();
+                return;
+            }
+
+            uncommitted_.emplace_back(&_object, &_replica);
+        } // unregister
+
+        auto commit() -> void
+        {
+            if (uncommitted_.empty()) {
+                return;
+            }
+
+            if (const auto ec = chlCommit(&comm_); ec < 0) {
+                ix::log::api::error("Failed to commit the removal of {} replicas [error_code={}].",
+                                    uncommitted_.size(), ec);
+                replay();
+                return;
+            }
+
+            uncommitted_.clear();
+        } // commit
+
+    private:
+        auto unregister_replica(dataObjInfo_t& _replica) -> int
+        {
+            unregDataObj_t unreg_inp{};
+            unreg_inp.dataObjInfo = &_replica;
+            unreg_inp.condInput = &cond_input_;
+            return rsUnregDataObj(&comm_, &unreg_inp);
+        } // unregister_replica
+
+        auto replay() -> void
+        {
+            chlRollback(&comm_);
+
+            for (auto& [object, replica] : uncommitted_) {
+                replica->flags &= ~NO_COMMIT_FLAG;
+
+                if (const auto ec = unregister_replica(*replica); ec < 0) {
+                    set_status(*object, ec);
+                }
+            }
+
+            uncommitted_.clear();
+        } // replay
+
+        static auto set_status(data_object_entry& _object, int _ec) -> void
+        {
+            if (_object.status >= 0) {
+                _object.status = _ec;
+            }
+        } // set_status
+
+        rsComm_t& comm_;
+        keyValPair_t& cond_input_;
+        std::vector<std::pair<data_object_entry*, dataObjInfo_t*>> uncommitted_;
+    }; // class batch_unregistration
+
+    // Reports the removed data objects to the client every FILE_CNT_PER_STAT_OUT objects.
+    // Returns false if the client could not be reached.
+    auto report_progress(rsComm_t& _comm, const char* _path, collOprStat_t** _coll_opr_stat, int& _saved_status)
+        -> bool
+    {
+        if (!_coll_opr_stat) {
+            return true;
+        }
+
+        if (++(*_coll_opr_stat)->filesCnt < FILE_CNT_PER_STAT_OUT) {
+            return true;
+        }
+
+        rstrcpy((*_coll_opr_stat)->lastObjPath, _path, MAX_NAME_LEN);
+
+        if (const auto ec = svrSendCollOprStat(&_comm, *_coll_opr_stat); ec < 0) {
+            rodsLogError(LOG_ERROR, ec, "%s: svrSendCollOprStat failed for %s. status = %d", __FUNCTION__, _path, ec);
+            *_coll_opr_stat = NULL;
+            _saved_status = ec;
+            return false;
+        }
+
+        std::free(*_coll_opr_stat);
+        *_coll_opr_stat = static_cast<collOprStat_t*>(std::malloc(sizeof(collOprStat_t)));
+        std::memset(*_coll_opr_stat, 0, sizeof(collOprStat_t));
+
+        return true;
+    } // report_progress
+
+    // Removes one page of data objects. Objects the engine cannot handle are given to rsDataObjUnlink.
+    // The remaining replicas are unlinked, concurrently where the leaf resource allows it, and
+    // unregistered in a single transaction.
+    auto remove_batch(rsComm_t& _comm,
+                      dataObjInp_t& _unlink_inp,
+                      std::vector<data_object_entry>& _objects,
+                      std::map<rodsLong_t, leaf_resource_info>& _leaf_resources,
+                      collOprStat_t** _coll_opr_stat,
+                      int& _saved_status) -> bool
+    {
+        std::map<rodsLong_t, std::vector<std::pair<data_object_entry*, std::size_t>>> replicas_by_leaf;
+
+        for (auto& object : _objects) {
+            rstrcpy(_unlink_inp.objPath, object.replicas.front().objPath, MAX_NAME_LEN);
+
+            const auto usable = [&_leaf_resources](const dataObjInfo_t& _replica) {
+                // Intermediate and locked replicas are left to rsDataObjUnlink, which rejects them.
+                if (GOOD_REPLICA != _replica.replStatus && STALE_REPLICA != _replica.replStatus) {
+                    return false;
+                }
+
+                auto iter = _leaf_resources.find(_replica.rescId);
+                if (std::end(_leaf_resources) == iter) {
+                    iter = _leaf_resources.emplace(_replica.rescId, get_leaf_resource_info(_replica)).first;
+                }
+
+                // Replicas outside of a vault are only unregistered, which rsDataObjUnlink handles.
+                const auto& leaf = iter->second;
+                return leaf.usable &&
+                       (leaf.skip_vault_path_check || has_prefix(_replica.filePath, leaf.vault_path.data()));
+            };
+
+            if (object.replicas.front().dataType == std::string_view{BUNDLE_STR} ||
+                !std::all_of(std::begin(object.replicas), std::end(object.replicas), usable))
+            {
+                object.removed_individually = true;
+                object.status = remove_individually(_comm, _unlink_inp, _unlink_inp.objPath);
+                continue;
+            }
+
+            object.status = chkPreProcDeleteRule(&_comm, _unlink_inp, link_replicas(object));
+            if (object.status < 0) {
+                continue;
+            }
+
+            object.unlink_status.assign(object.replicas.size(), 0);
+            for (std::size_t i = 0; i < object.replicas.size(); ++i) {
+                replicas_by_leaf[object.replicas[i].rescId].emplace_back(&object, i);
+            }
+        }
+
+        // Only replicas marked unlink_concurrently are given to the pool. The workers call nothing but
+        // unlink(2), because the connection of the agent, the server-to-server connections it holds and
+        // the rule engine cannot be shared between threads. Every other replica is unlinked on this
+        // thread while the pool runs.
+        {
+            const char* in_pdmo = getValByKey(&_unlink_inp.condInput, IN_PDMO_KW);
+            if (!in_pdmo) {
+                in_pdmo = "";
+            }
+
+            std::optional<irods::thread_pool> pool;
+
+            for (auto& [leaf_id, replicas] : replicas_by_leaf) {
+                const auto& leaf = _leaf_resources.at(leaf_id);
+
+                if (!leaf.unlink_concurrently) {
+                    continue;
+                }
+
+                if (!pool) {
+                    pool.emplace(get_number_of_concurrent_unlink_threads());
+                }
+
+                for (auto& [object, i] : replicas) {
+                    const char* path = object->replicas[i].filePath;
+                    int* status = &object->unlink_status[i];
+
+                    irods::thread_pool::post(*pool, [path, status] {
+                        // The same error code as unix_file_unlink.
+                        *status = (unlink(path) < 0) ? UNIX_FILE_UNLINK_ERR - errno : 0;
+                    });
+                }
+            }
+
+            for (auto& [leaf_id, replicas] : replicas_by_leaf) {
+                const auto& leaf = _leaf_resources.at(leaf_id);
+
+                if (leaf.unlink_concurrently) {
+                    continue;
+                }
+
+                for (auto& [object, i] : replicas) {
+                    auto& replica = object->replicas[i];
+                    object->unlink_status[i] =
+                        leaf.local ? unlink_local_replica(_comm, replica, in_pdmo) : l3Unlink(&_comm, &replica);
+                }
+            }
+
+            if (pool) {
+                pool->join();
+            }
+        }
+
+        batch_unregistration unregistration{_comm, _unlink_inp.condInput};
+
+        for (auto& object : _objects) {
+            if (object.removed_individually || object.status < 0) {
+                continue;
+            }
+
+            for (std::size_t i = 0; i < object.replicas.size(); ++i) {
+                auto& replica = object.replicas[i];
+
+                if (const auto ec = object.unlink_status[i]; ec < 0) {
+                    ix::log::api::info("Failed to physically unlink replica [error_code={}, path={}, hierarchy={}].",
+                                       ec, replica.objPath, replica.rescHier);
+
+                    // The same errors are tolerated as in dataObjUnlinkS.
+                    if (const auto error_number = getErrno(ec); ENOENT != error_number && EACCES != error_number) {
+                        object.status = ec;
+                        continue;
+                    }
+                }
+
+                unregistration.unregister(object, replica);
+            }
+        }
+
+        unregistration.commit();
+
+        bool keep_going = true;
+
+        for (auto& object : _objects) {
+            const auto* path = object.replicas.front().objPath;
+
+            if (!object.removed_individually) {
+                rstrcpy(_unlink_inp.objPath, path, MAX_NAME_LEN);
+                apply_post_proc_for_delete(_comm, _unlink_inp, object);
+            }
+
+            if (object.status < 0) {
+                rodsLog(LOG_ERROR, "_rsPhyRmColl:rsDataObjUnlink failed for %s. stat = %d", path, object.status);
+                _saved_status = object.status;
+            }
+            else if (keep_going) {
+                keep_going = report_progress(_comm, path, _coll_opr_stat, _saved_status);
+            }
+        }
+
+        return keep_going;
+    } // remove_batch
+
+    // Removes the data objects in a collection, not including its subcollections. The catalog is
+    // listed in pages of MAX_SQL_ROWS rows ordered by data id so that the replicas of a data object
+    // are adjacent. The last data object of a page is carried into the next page because more of
+    // its replicas may follow.
+    auto remove_data_objects(rsComm_t& _comm,
+                             const char* _collection,
+                             dataObjInp_t& _unlink_inp,
+                             collOprStat_t** _coll_opr_stat) -> removal_result
+    {
+        removal_result result{0, true, false};
+
+        genQueryInp_t gen_inp{};
+        irods::at_scope_exit clear_gen_inp{[&gen_inp] { clearGenQueryInp(&gen_inp); }};
+
+        char condition[MAX_NAME_LEN];
+        snprintf(condition, MAX_NAME_LEN, " = '%s'", _collection);
+        addInxVal(&gen_inp.sqlCondInp, COL_COLL_NAME, condition);
+
+        addInxIval(&gen_inp.selectInp, COL_D_DATA_ID, ORDER_BY);
+        for (const auto column : {COL_DATA_NAME, COL_COLL_NAME, COL_D_COLL_ID, COL_DATA_REPL_NUM, COL_DATA_VERSION,
+                                  COL_DATA_TYPE_NAME, COL_DATA_SIZE, COL_D_DATA_PATH, COL_D_OWNER_NAME,
+                                  COL_D_OWNER_ZONE, COL_D_REPL_STATUS, COL_D_DATA_STATUS, COL_D_DATA_CHECKSUM,
+                                  COL_D_EXPIRY, COL_D_MAP_ID, COL_D_COMMENTS, COL_D_CREATE_TIME,
+                                  COL_D_MODIFY_TIME, COL_DATA_MODE, COL_D_RESC_HIER})
+        {
+            addInxIval(&gen_inp.selectInp, column, 1);
+        }
+
+        // The same permission rsDataObjUnlink requires when it looks up a data object. The query
+        // fails as a whole if any data object is not accessible.
+        if (!getValByKey(&_unlink_inp.condInput, ADMIN_RMTRASH_KW) ||
+            LOCAL_PRIV_USER_AUTH != _comm.proxyUser.authInfo.authFlag)
+        {
+            addKeyVal(&gen_inp.condInput, USER_NAME_CLIENT_KW, _comm.clientUser.userName);
+            addKeyVal(&gen_inp.condInput, RODS_ZONE_CLIENT_KW, _comm.clientUser.rodsZone);
+            addKeyVal(&gen_inp.condInput, ACCESS_PERMISSION_KW, ACCESS_MODIFY_OBJECT);
+        }
+
+        gen_inp.maxRows = MAX_SQL_ROWS;
+
+        std::map<rodsLong_t, leaf_resource_info> leaf_resources;
+        std::vector<data_object_entry> objects;
+
+        // Close the query on every path which abandons it before the last page, including a failure to
+        // read a page and the client going away.
+        const auto close_query = [&_comm, &gen_inp] {
+            if (gen_inp.continueInx > 0) {
+                genQueryOut_t* gen_out{};
+                gen_inp.maxRows = 0;
+                rsGenQuery(&_comm, &gen_inp, &gen_out);
+                freeGenQueryOut(&gen_out);
+                gen_inp.continueInx = 0;
+            }
+        };
+
+        irods::at_scope_exit close_abandoned_query{[&close_query] { close_query(); }};
+
+        while (true) {
+            genQueryOut_t* gen_out{};
+            irods::at_scope_exit free_gen_out{[&gen_out] { freeGenQueryOut(&gen_out); }};
+
+            if (const auto ec = rsGenQuery(&_comm, &gen_inp, &gen_out); ec < 0) {
+                if (CAT_NO_ROWS_FOUND != ec) {
+                    ix::log::api::info("Falling back to removing data objects one at a time "
+                                       "[error_code={}, collection={}].", ec, _collection);
+                    result.listed = false;
+                }
+
+                // If a page after the first failed, the statement is still open on the catalog. Close it
+                // before the caller lists the collection again.
+                close_query();
+
+                break;
+            }
+
+            for (int row = 0; row < gen_out->rowCnt; ++row) {
+                auto replica = make_replica(*gen_out, row);
+
+                if (objects.empty() || objects.back().replicas.front().dataId != replica.dataId) {
+                    objects.push_back({});
+                }
+
+                objects.back().replicas.push_back(replica);
+            }
+
+            gen_inp.continueInx = gen_out->continueInx;
+
+            std::vector<data_object_entry> carried_over;
+            if (gen_inp.continueInx > 0 && !objects.empty()) {
+                carried_over.push_back(std::move(objects.back()));
+                objects.pop_back();
+            }
+
+            if (!remove_batch(_comm, _unlink_inp, objects, leaf_resources, _coll_opr_stat, result.status)) {
+                result.cancelled = true;
+                break;
+            }
+
+            objects = std::move(carried_over);
+
+            if (gen_inp.continueInx == 0) {
+                break;
+            }
+        }
+
+        if (!objects.empty() && result.listed && !result.cancelled) {
+            result.cancelled =
+                !remove_batch(_comm, _unlink_inp, objects, leaf_resources, _coll_opr_stat, result.status);
+        }
+
+        return result;
+    } // remove_data_objects
+
     int rsRmColl_impl(rsComm_t* rsComm,
                       collInp_t* rmCollInp,
                       collOprStat_t** collOprStat)
@@ -350,8 +969,22 @@ _rsPhyRmColl( rsComm_t *rsComm, collInp_t *rmCollInp,
         addKeyVal( &dataObjInp.condInput, EMPTY_BUNDLE_ONLY_KW, "" );
     }
     // =-=-=-=-=-=-=-
+
+    // Remove the data objects in batches when possible. Whatever is left behind is removed
+    // one at a time below.
+    bool data_objects_removed = false;
+    bool cancelled = false;
+    if ( can_remove_in_batches( *rmCollInp, dataObjInfo ) ) {
+        const auto result = remove_data_objects( *rsComm, rmCollInp->collName, dataObjInp, collOprStat );
+        if ( result.status < 0 ) {
+            savedStatus = result.status;
+        }
+        data_objects_removed = result.listed;
+        cancelled = result.cancelled;
+    }
+
     collEnt_t *collEnt = NULL;
-    while ( ( status = rsReadCollection( rsComm, &handleInx, &collEnt ) ) >= 0 ) {
+    while ( !cancelled && ( status = rsReadCollection( rsComm, &handleInx, &collEnt ) ) >= 0 ) {
         if ( entCnt == 0 ) {
             entCnt ++;
             /* cannot rm non-empty home collection */
@@ -360,7 +993,7 @@ _rsPhyRmColl( rsComm_t *rsComm, collInp_t *rmCollInp,
                 return CANT_RM_NON_EMPTY_HOME_COLL;
             }
         }
-        if ( collEnt->objType == DATA_OBJ_T ) {
+        if ( collEnt->objType == DATA_OBJ_T && !data_objects_removed ) {
             snprintf( dataObjInp.objPath, MAX_NAME_LEN, "%s/%s",
                       collEnt->collName, collEnt->dataName );
 
@@ -1,5 +1,6 @@
 #include "irods/rsTicketAdmin.hpp"
 
+#include "irods/connection_broker.hpp"
 #include "irods/rcConnect.h"
 #include "irods/ticketAdmin.h"
 #include "irods/icatHighLevelRoutines.hpp"
@@ -38,6 +39,9 @@ int rsTicketAdmin(rsComm_t* rsComm, ticketAdminInp_t* ticketAdminInp)
     else {
         if (strcmp(ticketAdminInp->arg1, "session") == 0) {
             ticketAdminInp->arg3 = rsComm->clientAddr;
+
+            // The session ticket now lives in the agent on the other side of the connection.
+            irods::connection_broker::exclude(rodsServerHost->conn);
         }
 
         status = rcTicketAdmin(rodsServerHost->conn, ticketAdminInp);
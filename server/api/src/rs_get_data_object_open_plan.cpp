@@ -0,0 +1,15 @@
+#include "irods/rs_get_data_object_open_plan.hpp"
+
+#include "irods/plugins/api/api_plugin_number.h"
+#include "irods/rodsErrorTable.h"
+
+#include "irods/irods_server_api_call.hpp"
+
+auto rs_get_data_object_open_plan(RsComm* _comm, const char* _json_input, BytesBuf** _output) -> int
+{
+    if (!_json_input || !_output) {
+        return SYS_INVALID_INPUT_PARAM;
+    }
+
+    return irods::server_api_call_without_policy(GET_DATA_OBJECT_OPEN_PLAN_APN, _comm, _json_input, _output);
+}
@@ -0,0 +1,143 @@
+#ifndef IRODS_ACCESS_CHECK_CACHE_HPP
+#define IRODS_ACCESS_CHECK_CACHE_HPP
+
+/// \file
+///
+/// \brief A per-agent cache of successful catalog permission checks.
+///
+/// Recursive operations check the same parent collections and group memberships over and over.
+/// The database plugin records each successful check here so that repeated checks within a short
+/// window do not go back to the catalog. Failed checks are never cached.
+///
+/// The cache is local to the agent. Changes made by the agent itself must be reported through
+/// erase() or clear(). Changes made by other agents become visible once the cached decision expires.
+///
+/// \since 4.3.0
+
+#include "irods/rodsType.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace irods::access_check_cache
+{
+    /// \brief The kind of permission check a decision belongs to.
+    ///
+    /// \since 4.3.0
+    enum class check_type
+    {
+        collection,
+        collection_id,
+        data_object,
+        data_object_id,
+        group_membership
+    }; // enum class check_type
+
+    /// \brief Identifies a single permission check.
+    ///
+    /// \since 4.3.0
+    struct key
+    {
+        check_type type;
+
+        /// The logical path or catalog id of the object, or the name of the group.
+        std::string target;
+
+        std::string user_name;
+        std::string user_zone;
+
+        /// The access level that was checked for. Empty for group membership checks.
+        std::string access_level;
+    }; // struct key
+
+    /// \brief The result of a successful permission check.
+    ///
+    /// \since 4.3.0
+    struct decision
+    {
+        /// The catalog id returned by the check.
+        rodsLong_t object_id;
+
+        /// The inheritance flag of the collection, or -1 if the check did not report it.
+        int inherit_flag;
+    }; // struct decision
+
+    /// \brief Counters describing how effective the cache has been.
+    ///
+    /// \since 4.3.0
+    struct statistics
+    {
+        /// The number of checks answered without querying the catalog.
+        std::uint64_t hits;
+
+        /// The number of checks that had to query the catalog.
+        std::uint64_t misses;
+
+        /// The number of catalog queries avoided. A single check may run several queries.
+        std::uint64_t queries_avoided;
+
+        /// The number of decisions dropped because of a change made by this agent.
+        std::uint64_t invalidations;
+    }; // struct statistics
+
+    /// \brief Sets how many decisions are kept and for how long.
+    ///
+    /// The cache is disabled until this is called. Existing decisions are dropped.
+    ///
+    /// \param[in] _max_entries The number of decisions to hold. Expired decisions are purged when
+    ///                         the cache is full, and everything is dropped if that does not make room.
+    /// \param[in] _ttl         How long a decision is trusted. Zero disables the cache.
+    ///
+    /// \since 4.3.0
+    auto configure(std::size_t _max_entries, std::chrono::seconds _ttl) -> void;
+
+    /// \brief Returns the decision for a check if one was cached and has not expired.
+    ///
+    /// Lookups are counted toward get_statistics().
+    ///
+    /// \param[in] _key             The check.
+    /// \param[in] _queries_avoided The number of catalog queries the check would have run.
+    ///
+    /// \since 4.3.0
+    auto lookup(const key& _key, std::uint64_t _queries_avoided = 1) -> std::optional<decision>;
+
+    /// \brief Records the decision for a successful check.
+    ///
+    /// \param[in] _key      The check.
+    /// \param[in] _decision The result of the check.
+    ///
+    /// \since 4.3.0
+    auto insert(key _key, const decision& _decision) -> void;
+
+    /// \brief Drops every decision about a target and, for a logical path, everything beneath it.
+    ///
+    /// Must be called when the agent deletes or renames an object.
+    ///
+    /// \param[in] _target The logical path or catalog id.
+    ///
+    /// \since 4.3.0
+    auto erase(std::string_view _target) -> void;
+
+    /// \brief Drops every decision.
+    ///
+    /// Must be called when the agent modifies permissions, users or groups.
+    ///
+    /// \since 4.3.0
+    auto clear() -> void;
+
+    /// \brief Returns the number of decisions in the cache.
+    ///
+    /// \since 4.3.0
+    auto size() -> std::size_t;
+
+    /// \brief Returns the counters accumulated since the agent started.
+    ///
+    /// \since 4.3.0
+    auto get_statistics() -> statistics;
+} // namespace irods::access_check_cache
+
+#endif // IRODS_ACCESS_CHECK_CACHE_HPP
@@ -25,6 +25,24 @@ namespace irods::experimental::catalog
     auto new_database_connection(bool _read_server_config = false)
         -> std::tuple<std::string, nanodbc::connection>;
 
+    /// \brief Returns the connection to the catalog shared by this process
+    ///
+    /// The connection is established by new_database_connection() on first use and
+    /// reused by later calls, so an agent pays for a single database login no matter
+    /// how many catalog operations it services. A new connection is established if the
+    /// process has been forked since, or if the connection has been lost.
+    ///
+    /// Callers must not leave a transaction open on the returned connection. Use
+    /// execute_transaction() or a scoped nanodbc::transaction so that an unfinished
+    /// transaction is rolled back before the connection is handed out again.
+    ///
+    /// \returns Tuple of the database type (string) and the database connection
+    ///
+    /// \throws std::runtime_error If a new connection is needed and cannot be established.
+    ///
+    /// \since 4.3.0
+    auto get_database_connection() -> std::tuple<std::string, nanodbc::connection>;
+
     /// \brief Provides a transaction to the provided function and executes it
     ///
     /// \param[in] _db_conn Established connection to the database
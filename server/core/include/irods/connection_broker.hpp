@@ -0,0 +1,104 @@
+#ifndef IRODS_CONNECTION_BROKER_HPP
+#define IRODS_CONNECTION_BROKER_HPP
+
+/// \file
+///
+/// \brief Keeps authenticated server-to-server connections alive across agents.
+///
+/// Agents disconnect from other servers when they exit, which means every client session on a
+/// catalog consumer pays for a fresh connection to, and login with, the catalog provider. When
+/// enabled, the main server runs a broker process that holds idle server-to-server connections
+/// on behalf of the agents. An agent that exits cleanly hands its connections to the broker over
+/// a UNIX domain socket, and the next agent needing a connection to the same server for the same
+/// proxy and client users leases one instead of connecting and logging in again.
+///
+/// Connections are only shared between agents serving the same proxy and client users. The other
+/// server's agent keeps per-session state beyond the users, e.g. a session ticket. Connections on
+/// which such state was set must be passed to exclude, and are disconnected rather than brokered.
+///
+/// The other server's agent adopts the trace context sent when the connection was opened. Agents
+/// leasing a connection send their own trace context with rc_set_trace_context, so that requests
+/// are never attributed to another client's trace.
+///
+/// Only connections that are logged in and not protected by TLS are brokered. TLS session state
+/// lives in the process that established it and cannot be passed to another.
+///
+/// \since 4.3.0
+
+#include "irods/rcConnect.h"
+
+#include <chrono>
+#include <cstddef>
+
+namespace irods::connection_broker
+{
+    /// \brief The environment variable holding the path of the broker's UNIX domain socket.
+    ///
+    /// Agents only consult the broker when this is set.
+    ///
+    /// \since 4.3.0
+    inline constexpr const char* const socket_path_env_var = "irodsConnectionBrokerSocket";
+
+    /// \brief Runs the broker in the calling process until SIGTERM is received.
+    ///
+    /// \param[in] _socket_path          The path of the UNIX domain socket to listen on.
+    /// \param[in] _max_idle_connections The number of idle connections to hold. The least recently
+    ///                                  released connection is disconnected to make room.
+    /// \param[in] _idle_timeout         How long a connection may remain idle before it is disconnected.
+    ///
+    /// \returns An integer.
+    /// \retval 0        On success.
+    /// \retval non-zero On failure.
+    ///
+    /// \since 4.3.0
+    auto run(const char* _socket_path, std::size_t _max_idle_connections, std::chrono::seconds _idle_timeout)
+        -> int;
+
+    /// \brief Leases an idle, logged in connection from the broker.
+    ///
+    /// \param[in] _host        The name of the server the connection must be to.
+    /// \param[in] _port        The port of the server the connection must be to.
+    /// \param[in] _proxy_user  The proxy user the connection must be authenticated as.
+    /// \param[in] _proxy_zone  The zone of the proxy user.
+    /// \param[in] _client_user The client user the connection must be acting for.
+    /// \param[in] _client_zone The zone of the client user.
+    ///
+    /// Connections closed or reset by the other server are discarded, and the next matching one is
+    /// tried.
+    ///
+    /// \returns A connection owned by the caller, or nullptr if the broker is not running or does
+    ///          not hold a usable matching connection.
+    ///
+    /// \since 4.3.0
+    auto lease(const char* _host,
+               int _port,
+               const char* _proxy_user,
+               const char* _proxy_zone,
+               const char* _client_user,
+               const char* _client_zone) -> rcComm_t*;
+
+    /// \brief Hands an idle connection to the broker.
+    ///
+    /// On success the connection is freed without being disconnected, and must not be used again.
+    ///
+    /// \param[in] _conn The connection. It must not have a request in flight.
+    ///
+    /// \returns A boolean.
+    /// \retval true  If the broker took the connection.
+    /// \retval false If the connection cannot be brokered. The caller still owns it.
+    ///
+    /// \since 4.3.0
+    auto release(rcComm_t* _conn) -> bool;
+
+    /// \brief Prevents a connection from being handed to the broker.
+    ///
+    /// Must be called for a connection once the other server holds state specific to the current
+    /// client session, so that the state is not inherited by the agent of another session.
+    ///
+    /// \param[in] _conn The connection.
+    ///
+    /// \since 4.3.0
+    auto exclude(const rcComm_t* _conn) -> void;
+} // namespace irods::connection_broker
+
+#endif // IRODS_CONNECTION_BROKER_HPP
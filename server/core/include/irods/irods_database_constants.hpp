@@ -116,6 +116,7 @@ namespace irods
     const std::string DATABASE_OP_GET_DELAY_RULE_INFO{"database_get_delay_rule_info"};
     const std::string DATABASE_OP_DATA_OBJECT_FINALIZE{"database_data_object_finalize"};
     const std::string DATABASE_OP_CHECK_AUTH_CREDENTIALS{"database_check_auth_credentials"};
+    const std::string DATABASE_OP_GET_DATA_OBJECT_OPEN_PLAN{"database_get_data_object_open_plan"};
 }; // namespace irods
 
 #endif // IRODS_DATABASE_CONSTANTS_HPP
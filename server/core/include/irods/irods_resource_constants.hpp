@@ -1,10 +1,13 @@
 #ifndef __IRODS_RESOURCE_CONSTANTS_HPP__
 #define __IRODS_RESOURCE_CONSTANTS_HPP__
 
+#include <cstddef>
 #include <string>
 
 namespace irods
 {
+    enum class operation_index : std::size_t;
+
     // =-=-=-=-=-=-=-
     /// @brief delimiter used for parsing resource context strings
     extern const std::string RESOURCE_DELIMITER;
@@ -73,6 +76,12 @@ namespace irods
     extern const std::string RESOURCE_OP_REBALANCE;
     extern const std::string RESOURCE_OP_NOTIFY;
 
+    // =-=-=-=-=-=-=-
+    /// @brief dispatch table indices for the operations called once per
+    ///        buffer, which lets callers skip looking them up by name
+    extern const operation_index RESOURCE_OP_READ_INDEX;
+    extern const operation_index RESOURCE_OP_WRITE_INDEX;
+
     // =-=-=-=-=-=-=-
     /// @brief constants for icat resource properties
     extern const std::string RESOURCE_HOST;
@@ -103,6 +103,14 @@ namespace irods
             /// @brief exec the pdmos ( post disconnect maintenance operations ) in order
             int call_maintenance_operations( rcComm_t* );
 
+            // =-=-=-=-=-=-=-
+            /// @brief determine if any resource deferred work until the client is idle
+            bool need_idle_maintenance_operations( );
+
+            // =-=-=-=-=-=-=-
+            /// @brief perform the work resources deferred until the client is idle
+            int call_idle_maintenance_operations( rsComm_t* );
+
             // =-=-=-=-=-=-=-
             /// @brief construct a vector of all resource hierarchies in the system
             std::vector<std::string> get_all_resc_hierarchies( void );
@@ -142,6 +142,17 @@ int getAndDisconnRcatHost(int rcatType,
 /// \endparblock
 int disconnectAllSvrToSvrConn();
 
+/// \brief Releases all server-to-server connections made by this agent.
+///
+/// \parblock
+/// Same as disconnectAllSvrToSvrConn(), except that each connection is first offered to the
+/// connection broker so that a later agent can reuse it. Connections the broker does not take
+/// are disconnected. Must only be called once no request is in flight on any connection.
+/// \endparblock
+///
+/// \since 4.3.0
+int releaseAllSvrToSvrConn();
+
 int svrReconnect(rsComm_t *rsComm);
 
 int getAndConnRemoteZone(rsComm_t *rsComm,
@@ -7,6 +7,8 @@
 #include "irods/rcGlobalExtern.h"
 #include "irods/rcMisc.h"
 
+#include <cstdint>
+
 #define DISCONN_STATUS             -1
 #define SEND_RCV_RETRY_CNT         1
 #define SEND_RCV_SLEEP_TIME        2 /* in sec */
@@ -33,9 +35,21 @@ int chkApiPermission(rsComm_t* rsComm, int apiInx);
 
 int handlePortalOpr(rsComm_t* rsComm);
 
-int sendApiReply(rsComm_t* rsComm, int apiInx, int retVal, void*& myOutStruct, bytesBuf_t* myOutBsBBuf);
-
-int sendAndProcApiReply(rsComm_t* rsComm, int apiInx, int status, void*& myOutStruct, bytesBuf_t* myOutBsBBuf);
+// If _bytes_sent is not null, it receives the length of the packed output struct plus the length of the output byte
+// stream, i.e. the bytes the API handler produced for the client.
+int sendApiReply(rsComm_t* rsComm,
+                 int apiInx,
+                 int retVal,
+                 void*& myOutStruct,
+                 bytesBuf_t* myOutBsBBuf,
+                 std::uint64_t* _bytes_sent = nullptr);
+
+int sendAndProcApiReply(rsComm_t* rsComm,
+                        int apiInx,
+                        int status,
+                        void*& myOutStruct,
+                        bytesBuf_t* myOutBsBBuf,
+                        std::uint64_t* _bytes_sent = nullptr);
 
 int readAndProcClientMsg( rsComm_t *rsComm, int retApiStatus );
 
@@ -0,0 +1,175 @@
+#include "irods/access_check_cache.hpp"
+
+#include <iterator>
+#include <map>
+#include <tuple>
+#include <utility>
+
+namespace
+{
+    // clang-format off
+    using clock_type = std::chrono::steady_clock;
+    using subkey     = std::tuple<irods::access_check_cache::check_type, std::string, std::string, std::string>;
+    // clang-format on
+
+    struct entry
+    {
+        irods::access_check_cache::decision decision;
+        clock_type::time_point expiration;
+    }; // struct entry
+
+    // Decisions are grouped by target so that everything known about a logical path, and about
+    // the paths beneath it, can be found with a range lookup.
+    using target_map_type = std::map<subkey, entry, std::less<>>;
+    using map_type = std::map<std::string, target_map_type, std::less<>>;
+
+    //
+    // Global Variables
+    //
+
+    map_type g_map;
+    std::size_t g_size = 0;
+    std::size_t g_max_entries = 0;
+    std::chrono::seconds g_ttl{0};
+    irods::access_check_cache::statistics g_stats{};
+
+    auto make_subkey(irods::access_check_cache::key&& _key) -> subkey
+    {
+        return {_key.type, std::move(_key.user_name), std::move(_key.user_zone), std::move(_key.access_level)};
+    } // make_subkey
+
+    auto erase_targets(map_type::iterator _first, map_type::iterator _last) -> void
+    {
+        for (auto iter = _first; iter != _last; ++iter) {
+            g_size -= iter->second.size();
+            g_stats.invalidations += iter->second.size();
+        }
+
+        g_map.erase(_first, _last);
+    } // erase_targets
+
+    auto purge_expired() -> void
+    {
+        const auto now = clock_type::now();
+
+        for (auto target = g_map.begin(); target != g_map.end();) {
+            auto& decisions = target->second;
+
+            for (auto iter = decisions.begin(); iter != decisions.end();) {
+                if (iter->second.expiration <= now) {
+                    iter = decisions.erase(iter);
+                    --g_size;
+                }
+                else {
+                    ++iter;
+                }
+            }
+
+            target = decisions.empty() ? g_map.erase(target) : std::next(target);
+        }
+    } // purge_expired
+} // anonymous namespace
+
+namespace irods::access_check_cache
+{
+    auto configure(std::size_t _max_entries, std::chrono::seconds _ttl) -> void
+    {
+        g_map.clear();
+        g_size = 0;
+        g_max_entries = _max_entries;
+        g_ttl = _ttl;
+    } // configure
+
+    auto lookup(const key& _key, std::uint64_t _queries_avoided) -> std::optional<decision>
+    {
+        if (g_ttl.count() <= 0 || g_max_entries == 0) {
+            return std::nullopt;
+        }
+
+        if (auto target = g_map.find(_key.target); target != std::end(g_map)) {
+            auto& decisions = target->second;
+
+            const auto iter = decisions.find(std::tie(_key.type, _key.user_name, _key.user_zone, _key.access_level));
+
+            if (iter != std::end(decisions)) {
+                if (clock_type::now() < iter->second.expiration) {
+                    ++g_stats.hits;
+                    g_stats.queries_avoided += _queries_avoided;
+                    return iter->second.decision;
+                }
+
+                decisions.erase(iter);
+                --g_size;
+
+                if (decisions.empty()) {
+                    g_map.erase(target);
+                }
+            }
+        }
+
+        ++g_stats.misses;
+
+        return std::nullopt;
+    } // lookup
+
+    auto insert(key _key, const decision& _decision) -> void
+    {
+        if (g_ttl.count() <= 0 || g_max_entries == 0) {
+            return;
+        }
+
+        if (g_size >= g_max_entries) {
+            purge_expired();
+
+            if (g_size >= g_max_entries) {
+                g_map.clear();
+                g_size = 0;
+            }
+        }
+
+        auto& decisions = g_map[std::move(_key.target)];
+        const auto [iter, inserted] =
+            decisions.insert_or_assign(make_subkey(std::move(_key)), entry{_decision, clock_type::now() + g_ttl});
+
+        if (inserted) {
+            ++g_size;
+        }
+    } // insert
+
+    auto erase(std::string_view _target) -> void
+    {
+        if (g_map.empty() || _target.empty()) {
+            return;
+        }
+
+        // Every path beneath the target sorts between "<target>/" and "<target>0".
+        std::string prefix{_target};
+        if (prefix.back() != '/') {
+            prefix += '/';
+        }
+        const auto first = g_map.lower_bound(prefix);
+        prefix.back() = '0';
+        erase_targets(first, g_map.lower_bound(prefix));
+
+        if (auto iter = g_map.find(_target); iter != std::end(g_map)) {
+            erase_targets(iter, std::next(iter));
+        }
+    } // erase
+
+    auto clear() -> void
+    {
+        g_stats.invalidations += g_size;
+        g_map.clear();
+        g_size = 0;
+    } // clear
+
+    auto size() -> std::size_t
+    {
+        return g_size;
+    } // size
+
+    auto get_statistics() -> statistics
+    {
+        return g_stats;
+    } // get_statistics
+} // namespace irods::access_check_cache
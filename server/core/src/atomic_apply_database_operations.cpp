@@ -1219,7 +1219,7 @@ namespace irods::experimental
             namespace ic = irods::experimental::catalog;
 
             try {
-                std::tie(db_instance_name, db_conn) = ic::new_database_connection();
+                std::tie(db_instance_name, db_conn) = ic::get_database_connection();
             }
             catch (const std::exception& e) {
                 log_db::error(e.what());
@@ -11,6 +11,8 @@
 #include <fmt/format.h>
 #include <nanodbc/nanodbc.h>
 
+#include <unistd.h>
+
 #include <fstream>
 #include <functional>
 #include <stdexcept>
@@ -103,6 +105,32 @@ namespace irods::experimental::catalog {
         }
     } // new_database_connection
 
+    auto get_database_connection() -> std::tuple<std::string, nanodbc::connection>
+    {
+        namespace log = irods::experimental::log;
+
+        // The connection is intentionally never destroyed. A child process that inherits it
+        // must not disconnect it, as that would close the session of the parent.
+        static std::string db_instance_name;
+        static nanodbc::connection* db_conn = nullptr;
+        static pid_t owner_pid = -1;
+
+        if (db_conn && owner_pid == getpid() && db_conn->connected()) {
+            log::database::debug("Reusing catalog connection [pid={}].", owner_pid);
+            return {db_instance_name, *db_conn};
+        }
+
+        auto [instance_name, conn] = new_database_connection();
+
+        db_instance_name = std::move(instance_name);
+        db_conn = new nanodbc::connection{std::move(conn)};
+        owner_pid = getpid();
+
+        log::database::debug("Established catalog connection for reuse [pid={}].", owner_pid);
+
+        return {db_instance_name, *db_conn};
+    } // get_database_connection
+
     auto execute_transaction(
         nanodbc::connection& _db_conn,
         std::function<int(nanodbc::transaction&)> _func) -> int
@@ -0,0 +1,592 @@
+#include "irods/connection_broker.hpp"
+
+#include "irods/irods_at_scope_exit.hpp"
+#include "irods/irods_logger.hpp"
+#include "irods/irods_threads.hpp"
+#include "irods/rodsError.h"
+#include "irods/rodsErrorTable.h"
+#include "irods/stringOpr.h"
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <iterator>
+#include <vector>
+
+namespace
+{
+    // clang-format off
+    namespace log = irods::experimental::log;
+
+    using log_network = log::network;
+    using log_server  = log::server;
+    using clock_type  = std::chrono::steady_clock;
+    // clang-format on
+
+    // Bounds how long either side waits on the other, so that a wedged peer cannot stall an agent.
+    constexpr auto socket_timeout_in_seconds = 5;
+
+    enum class operation : int
+    {
+        lease = 1,
+        release,
+        found,
+        not_found
+    };
+
+    // Identifies the connections that can be used interchangeably.
+    struct connection_key
+    {
+        char host[NAME_LEN];
+        int port;
+        char proxy_user[NAME_LEN];
+        char proxy_zone[NAME_LEN];
+        char client_user[NAME_LEN];
+        char client_zone[NAME_LEN];
+    };
+
+    // The parts of an rcComm_t, beyond the socket, needed to resume using a connection.
+    struct connection_state
+    {
+        irodsProt_t irods_prot;
+        int window_size;
+        userInfo_t proxy_user;
+        userInfo_t client_user;
+        version_t server_version;
+        char negotiation_results[MAX_NAME_LEN];
+        char session_signature[33];
+    };
+
+    struct message
+    {
+        operation op;
+        connection_key key;
+        connection_state state;
+    };
+
+    struct idle_connection
+    {
+        message msg;
+        int fd;
+        clock_type::time_point released_at;
+    };
+
+    volatile std::sig_atomic_t stop_requested = 0;
+
+    // The connections of this agent on which the other server holds state belonging to the
+    // current client session. See irods::connection_broker::exclude.
+    std::vector<const rcComm_t*> excluded_connections; // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+    auto make_key(connection_key& _key,
+                  const char* _host,
+                  int _port,
+                  const char* _proxy_user,
+                  const char* _proxy_zone,
+                  const char* _client_user,
+                  const char* _client_zone) -> void
+    {
+        rstrcpy(_key.host, _host, NAME_LEN);
+        _key.port = _port;
+        rstrcpy(_key.proxy_user, _proxy_user, NAME_LEN);
+        rstrcpy(_key.proxy_zone, _proxy_zone, NAME_LEN);
+        rstrcpy(_key.client_user, _client_user, NAME_LEN);
+        rstrcpy(_key.client_zone, _client_zone, NAME_LEN);
+    } // make_key
+
+    auto keys_match(const connection_key& _lhs, const connection_key& _rhs) -> bool
+    {
+        return _lhs.port == _rhs.port && std::strncmp(_lhs.host, _rhs.host, NAME_LEN) == 0 &&
+               std::strncmp(_lhs.proxy_user, _rhs.proxy_user, NAME_LEN) == 0 &&
+               std::strncmp(_lhs.proxy_zone, _rhs.proxy_zone, NAME_LEN) == 0 &&
+               std::strncmp(_lhs.client_user, _rhs.client_user, NAME_LEN) == 0 &&
+               std::strncmp(_lhs.client_zone, _rhs.client_zone, NAME_LEN) == 0;
+    } // keys_match
+
+    auto set_socket_timeouts(int _sock) -> void
+    {
+        timeval tv{};
+        tv.tv_sec = socket_timeout_in_seconds;
+        setsockopt(_sock, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+        setsockopt(_sock, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+    } // set_socket_timeouts
+
+    // Sends a message, along with the file descriptor _fd when it is not negative.
+    auto send_message(int _sock, const message& _msg, int _fd) -> bool
+    {
+        msghdr msg{};
+
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+        iovec io{.iov_base = const_cast<message*>(&_msg), .iov_len = sizeof(message)};
+        msg.msg_iov = &io;
+        msg.msg_iovlen = 1;
+
+        alignas(cmsghdr) std::array<char, CMSG_SPACE(sizeof(int))> control_buf{};
+
+        if (_fd >= 0) {
+            msg.msg_control = control_buf.data();
+            msg.msg_controllen = control_buf.size();
+
+            cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+            cmsg->cmsg_level = SOL_SOCKET;
+            cmsg->cmsg_type = SCM_RIGHTS;
+            cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+            std::memcpy(CMSG_DATA(cmsg), &_fd, sizeof(int));
+        }
+
+        return sendmsg(_sock, &msg, MSG_NOSIGNAL) == static_cast<ssize_t>(sizeof(message));
+    } // send_message
+
+    // Receives a message. _fd is set to the file descriptor that accompanied it, or -1.
+    auto receive_message(int _sock, message& _msg, int& _fd) -> bool
+    {
+        _fd = -1;
+
+        msghdr msg{};
+
+        iovec io{.iov_base = &_msg, .iov_len = sizeof(message)};
+        msg.msg_iov = &io;
+        msg.msg_iovlen = 1;
+
+        alignas(cmsghdr) std::array<char, CMSG_SPACE(sizeof(int))> control_buf{};
+        msg.msg_control = control_buf.data();
+        msg.msg_controllen = control_buf.size();
+
+        const auto n = recvmsg(_sock, &msg, MSG_WAITALL);
+
+        for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+            if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS) {
+                std::memcpy(&_fd, CMSG_DATA(cmsg), sizeof(int));
+            }
+        }
+
+        if (n != static_cast<ssize_t>(sizeof(message))) {
+            if (_fd >= 0) {
+                close(_fd);
+                _fd = -1;
+            }
+
+            return false;
+        }
+
+        return true;
+    } // receive_message
+
+    auto connect_to_broker() -> int
+    {
+        const char* socket_path = std::getenv(irods::connection_broker::socket_path_env_var);
+
+        if (!socket_path || !*socket_path) {
+            return -1;
+        }
+
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        std::strncpy(addr.sun_path, socket_path, sizeof(addr.sun_path) - 1);
+
+        const auto sock = socket(AF_UNIX, SOCK_STREAM, 0);
+
+        if (sock < 0) {
+            return -1;
+        }
+
+        set_socket_timeouts(sock);
+
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        if (connect(sock, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+            log_network::trace("Could not connect to connection broker [errno={}].", errno);
+            close(sock);
+            return -1;
+        }
+
+        return sock;
+    } // connect_to_broker
+
+    // A connection held by the broker must be idle. Anything to read means the other server has
+    // closed or reset it, or sent something that would be taken as the reply to the next request.
+    auto is_usable(int _fd) -> bool
+    {
+        int error = 0;
+        socklen_t len = sizeof(error);
+
+        if (getsockopt(_fd, SOL_SOCKET, SO_ERROR, &error, &len) != 0 || error != 0) {
+            log_network::debug("Leased connection has a pending error [errno={}].", error);
+            return false;
+        }
+
+        char c{};
+        const auto n = recv(_fd, &c, 1, MSG_PEEK | MSG_DONTWAIT);
+
+        if (n < 0) {
+            if (EAGAIN == errno || EWOULDBLOCK == errno) {
+                return true;
+            }
+
+            log_network::debug("Leased connection is broken [errno={}].", errno);
+            return false;
+        }
+
+        log_network::debug("Leased connection is not idle [{}].", n == 0 ? "closed by peer" : "unexpected data");
+
+        return false;
+    } // is_usable
+
+    // Rebuilds a logged in rcComm_t around a socket received from another process.
+    auto make_connection(const message& _msg, int _fd) -> rcComm_t*
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-no-malloc, cppcoreguidelines-owning-memory)
+        auto* conn = static_cast<rcComm_t*>(std::calloc(1, sizeof(rcComm_t)));
+
+        // NOLINTNEXTLINE(cppcoreguidelines-no-malloc, cppcoreguidelines-owning-memory)
+        conn->thread_ctx = static_cast<thread_context*>(std::calloc(1, sizeof(thread_context)));
+        allocate_error_stack_if_necessary(&conn->rError);
+
+        conn->irodsProt = _msg.state.irods_prot;
+        rstrcpy(conn->host, _msg.key.host, NAME_LEN);
+        conn->portNum = _msg.key.port;
+        conn->sock = _fd;
+        conn->loggedIn = 1;
+        conn->windowSize = _msg.state.window_size;
+        conn->proxyUser = _msg.state.proxy_user;
+        conn->clientUser = _msg.state.client_user;
+
+        // NOLINTNEXTLINE(cppcoreguidelines-no-malloc, cppcoreguidelines-owning-memory)
+        conn->svrVersion = static_cast<version_t*>(std::malloc(sizeof(version_t)));
+        *conn->svrVersion = _msg.state.server_version;
+
+        std::memcpy(conn->negotiation_results, _msg.state.negotiation_results, sizeof(conn->negotiation_results));
+        std::memcpy(conn->session_signature, _msg.state.session_signature, sizeof(conn->session_signature));
+
+        socklen_t len = sizeof(conn->localAddr);
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        getsockname(_fd, reinterpret_cast<sockaddr*>(&conn->localAddr), &len);
+        len = sizeof(conn->remoteAddr);
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        getpeername(_fd, reinterpret_cast<sockaddr*>(&conn->remoteAddr), &len);
+
+        return conn;
+    } // make_connection
+
+    // Politely ends the session of an idle connection held by the broker.
+    auto disconnect(idle_connection& _conn) -> void
+    {
+        log_server::debug("Disconnecting idle connection to [{}:{}] for [{}#{}].",
+                          _conn.msg.key.host,
+                          _conn.msg.key.port,
+                          _conn.msg.key.client_user,
+                          _conn.msg.key.client_zone);
+
+        rcDisconnect(make_connection(_conn.msg, _conn.fd));
+    } // disconnect
+
+    auto handle_request(int _client_sock, std::deque<idle_connection>& _pool, std::size_t _max_idle_connections)
+        -> void
+    {
+        message request{};
+        int fd = -1;
+
+        if (!receive_message(_client_sock, request, fd)) {
+            log_server::warn("Connection broker received an incomplete request.");
+            return;
+        }
+
+        if (operation::release == request.op) {
+            struct stat st{};
+
+            if (fd < 0 || fstat(fd, &st) != 0 || !S_ISSOCK(st.st_mode)) {
+                log_server::warn("Connection broker received a release request without a socket.");
+                if (fd >= 0) {
+                    close(fd);
+                }
+                return;
+            }
+
+            if (_pool.size() >= _max_idle_connections) {
+                disconnect(_pool.front());
+                _pool.pop_front();
+            }
+
+            log_server::debug("Holding connection to [{}:{}] for [{}#{}] [idle_connections={}].",
+                              request.key.host,
+                              request.key.port,
+                              request.key.client_user,
+                              request.key.client_zone,
+                              _pool.size() + 1);
+
+            _pool.push_back({request, fd, clock_type::now()});
+
+            return;
+        }
+
+        if (fd >= 0) {
+            close(fd);
+        }
+
+        if (operation::lease != request.op) {
+            log_server::warn("Connection broker received an unknown request [op={}].", static_cast<int>(request.op));
+            return;
+        }
+
+        // Hand out the most recently released match, as it is the least likely to have been
+        // dropped by the other server.
+        const auto iter = std::find_if(std::rbegin(_pool), std::rend(_pool), [&request](const idle_connection& _c) {
+            return keys_match(_c.msg.key, request.key);
+        });
+
+        if (iter == std::rend(_pool)) {
+            message reply{};
+            reply.op = operation::not_found;
+            send_message(_client_sock, reply, -1);
+            return;
+        }
+
+        message reply = iter->msg;
+        reply.op = operation::found;
+
+        if (send_message(_client_sock, reply, iter->fd)) {
+            log_server::debug("Leased connection to [{}:{}] for [{}#{}].",
+                              request.key.host,
+                              request.key.port,
+                              request.key.client_user,
+                              request.key.client_zone);
+
+            close(iter->fd);
+            _pool.erase(std::next(iter).base());
+        }
+    } // handle_request
+} // anonymous namespace
+
+namespace irods::connection_broker
+{
+    auto run(const char* _socket_path, std::size_t _max_idle_connections, std::chrono::seconds _idle_timeout) -> int
+    {
+        log::set_server_type("connection_broker");
+
+        std::signal(SIGTERM, [](int) { stop_requested = 1; });
+        std::signal(SIGINT, [](int) { stop_requested = 1; });
+        std::signal(SIGHUP, [](int) { stop_requested = 1; });
+        std::signal(SIGPIPE, SIG_IGN);
+        std::signal(SIGCHLD, SIG_DFL);
+
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        std::strncpy(addr.sun_path, _socket_path, sizeof(addr.sun_path) - 1);
+
+        unlink(addr.sun_path);
+
+        const auto listen_sock = socket(AF_UNIX, SOCK_STREAM, 0);
+
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        if (listen_sock < 0 || bind(listen_sock, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 ||
+            listen(listen_sock, SOMAXCONN) < 0)
+        {
+            log_server::error("Connection broker failed to listen on [{}] [errno={}].", _socket_path, errno);
+            return SYS_SOCK_LISTEN_ERR;
+        }
+
+        log_server::info("Connection broker listening on [{}] [max_idle_connections={}, idle_timeout={}s].",
+                         _socket_path,
+                         _max_idle_connections,
+                         _idle_timeout.count());
+
+        std::deque<idle_connection> pool;
+        std::vector<pollfd> fds;
+
+        while (!stop_requested) {
+            // Disconnect the connections that have been idle too long.
+            const auto now = clock_type::now();
+            while (!pool.empty() && now - pool.front().released_at >= _idle_timeout) {
+                disconnect(pool.front());
+                pool.pop_front();
+            }
+
+            // The idle connections are watched too. An idle connection never has anything to
+            // read, so becoming readable means the other server has closed it.
+            fds.clear();
+            fds.push_back({listen_sock, POLLIN, 0});
+            for (const auto& c : pool) {
+                fds.push_back({c.fd, POLLIN, 0});
+            }
+
+            constexpr auto poll_timeout_in_milliseconds = 1000;
+            if (poll(fds.data(), fds.size(), poll_timeout_in_milliseconds) < 0) {
+                if (EINTR == errno) {
+                    continue;
+                }
+
+                log_server::error("Connection broker failed to poll sockets [errno={}].", errno);
+                break;
+            }
+
+            // Drop the connections closed by the other side. fds[i + 1] describes pool[i].
+            for (auto i = fds.size() - 1; i > 0; --i) {
+                if (fds[i].revents != 0) {
+                    log_server::debug("Idle connection to [{}:{}] was closed by the remote server.",
+                                      pool[i - 1].msg.key.host,
+                                      pool[i - 1].msg.key.port);
+                    close(pool[i - 1].fd);
+                    pool.erase(std::begin(pool) + static_cast<std::ptrdiff_t>(i - 1));
+                }
+            }
+
+            if (fds[0].revents & POLLIN) {
+                const auto client_sock = accept(listen_sock, nullptr, nullptr);
+
+                if (client_sock >= 0) {
+                    const irods::at_scope_exit close_client_sock{[client_sock] { close(client_sock); }};
+                    set_socket_timeouts(client_sock);
+                    handle_request(client_sock, pool, _max_idle_connections);
+                }
+            }
+        }
+
+        log_server::info("Connection broker shutting down [idle_connections={}].", pool.size());
+
+        for (auto& c : pool) {
+            disconnect(c);
+        }
+
+        close(listen_sock);
+        unlink(addr.sun_path);
+
+        return 0;
+    } // run
+
+    auto lease(const char* _host,
+               int _port,
+               const char* _proxy_user,
+               const char* _proxy_zone,
+               const char* _client_user,
+               const char* _client_zone) -> rcComm_t*
+    {
+        message request{};
+        request.op = operation::lease;
+        make_key(request.key, _host, _port, _proxy_user, _proxy_zone, _client_user, _client_zone);
+
+        // A connection can break between the broker's last check and the lease, e.g. when the
+        // other server restarts. Broken connections are dropped and the next match is tried. The
+        // caller connects afresh once the broker runs out of matches.
+        constexpr auto max_attempts = 3;
+
+        for (int attempt = 0; attempt < max_attempts; ++attempt) {
+            const auto sock = connect_to_broker();
+
+            if (sock < 0) {
+                return nullptr;
+            }
+
+            const irods::at_scope_exit close_sock{[sock] { close(sock); }};
+
+            if (!send_message(sock, request, -1)) {
+                return nullptr;
+            }
+
+            message reply{};
+            int fd = -1;
+
+            if (!receive_message(sock, reply, fd) || operation::found != reply.op || fd < 0) {
+                if (fd >= 0) {
+                    close(fd);
+                }
+
+                return nullptr;
+            }
+
+            if (!is_usable(fd)) {
+                close(fd);
+                continue;
+            }
+
+            log_network::debug("Leased connection to [{}:{}] from connection broker.", _host, _port);
+
+            return make_connection(reply, fd);
+        }
+
+        return nullptr;
+    } // lease
+
+    auto release(rcComm_t* _conn) -> bool
+    {
+        if (!_conn || 1 != _conn->loggedIn || _conn->ssl_on || _conn->ssl || !_conn->svrVersion) {
+            return false;
+        }
+
+        // Connections with a reconnection thread cannot be moved to another process.
+        if (_conn->thread_ctx && _conn->thread_ctx->reconnThr) {
+            return false;
+        }
+
+        if (const auto iter = std::find(std::begin(excluded_connections), std::end(excluded_connections), _conn);
+            iter != std::end(excluded_connections))
+        {
+            excluded_connections.erase(iter);
+            log_network::debug("Connection to [{}:{}] carries session state and is not brokered.",
+                               _conn->host,
+                               _conn->portNum);
+            return false;
+        }
+
+        if (!is_usable(_conn->sock)) {
+            return false;
+        }
+
+        const auto sock = connect_to_broker();
+
+        if (sock < 0) {
+            return false;
+        }
+
+        const irods::at_scope_exit close_sock{[sock] { close(sock); }};
+
+        message request{};
+        request.op = operation::release;
+        make_key(request.key,
+                 _conn->host,
+                 _conn->portNum,
+                 _conn->proxyUser.userName,
+                 _conn->proxyUser.rodsZone,
+                 _conn->clientUser.userName,
+                 _conn->clientUser.rodsZone);
+
+        request.state.irods_prot = _conn->irodsProt;
+        request.state.window_size = _conn->windowSize;
+        request.state.proxy_user = _conn->proxyUser;
+        request.state.client_user = _conn->clientUser;
+        request.state.server_version = *_conn->svrVersion;
+        std::memcpy(request.state.negotiation_results,
+                    _conn->negotiation_results,
+                    sizeof(request.state.negotiation_results));
+        std::memcpy(
+            request.state.session_signature, _conn->session_signature, sizeof(request.state.session_signature));
+
+        if (!send_message(sock, request, _conn->sock)) {
+            return false;
+        }
+
+        log_network::debug("Released connection to [{}:{}] to connection broker.", _conn->host, _conn->portNum);
+
+        // The broker holds its own copy of the socket now.
+        close(_conn->sock);
+        freeRcComm(_conn);
+
+        return true;
+    } // release
+
+    auto exclude(const rcComm_t* _conn) -> void
+    {
+        if (_conn && std::find(std::begin(excluded_connections), std::end(excluded_connections), _conn) ==
+                         std::end(excluded_connections))
+        {
+            excluded_connections.push_back(_conn);
+        }
+    } // exclude
+} // namespace irods::connection_broker
@@ -26,6 +26,16 @@
 #include "irods/irods_random.hpp"
 #include "irods/irods_file_object.hpp"
 #include "irods/rodsPath.h"
+#include "irods/irods_at_scope_exit.hpp"
+#include "irods/rs_get_data_object_open_plan.hpp"
+
+#define IRODS_FILESYSTEM_ENABLE_SERVER_SIDE_API
+#include "irods/filesystem.hpp"
+
+#define IRODS_REPLICA_ENABLE_SERVER_SIDE_API
+#include "irods/replica_proxy.hpp"
+
+#include <nlohmann/json.hpp>
 
 #include <boost/filesystem/operations.hpp>
 #include <boost/filesystem/convenience.hpp>
@@ -38,6 +48,7 @@
 #include <sys/wait.h>
 
 #include <algorithm>
+#include <optional>
 
 using namespace boost::filesystem;
 
@@ -1092,6 +1103,86 @@ int matchDataObjInfoByCondInput( dataObjInfo_t **dataObjInfoHead,
     }
 }
 
+namespace
+{
+    // Looks up the replicas of a data object, its parent collection and the permission of the
+    // client in a single catalog round trip. Returns std::nullopt if the plan cannot stand in for
+    // getDataObjInfo() and the special collection checks that follow a failed lookup. Otherwise,
+    // returns the status getDataObjInfoIncSpecColl() would have returned.
+    auto get_data_obj_info_from_open_plan(rsComm_t& _comm,
+                                          const dataObjInp_t& _inp,
+                                          const char* _access_level,
+                                          dataObjInfo_t** _info) -> std::optional<int>
+    {
+        namespace ir = irods::experimental::replica;
+
+        using json = nlohmann::json;
+
+        if (getValByKey(&_inp.condInput, TICKET_KW) || getValByKey(&_inp.condInput, ADMIN_KW) ||
+            getValByKey(&_inp.condInput, QUERY_BY_DATA_ID_KW))
+        {
+            return std::nullopt;
+        }
+
+        const auto input = json{{"logical_path", _inp.objPath}, {"access_level", _access_level}}.dump();
+
+        // Errors, including a missing permission, are left to the regular lookup so that they are
+        // reported exactly as before.
+        bytesBuf_t* output{};
+        if (rs_get_data_object_open_plan(&_comm, input.c_str(), &output) != 0 || !output) {
+            return std::nullopt;
+        }
+
+        irods::at_scope_exit free_output{[output] { freeBBuf(output); }};
+
+        try {
+            const auto* p = static_cast<const char*>(output->buf);
+            const auto plan = json::parse(p, p + output->len);
+
+            // A parent collection that is not registered may be part of a mounted collection, and
+            // a special parent collection must be resolved by the special collection code.
+            const auto& collection = plan.at("collection");
+            if (collection.is_null() || !collection.at("coll_type").get_ref<const std::string&>().empty() ||
+                plan.at("is_collection").get<bool>())
+            {
+                return std::nullopt;
+            }
+
+            const auto& replicas = plan.at("replicas");
+
+            if (replicas.empty()) {
+                return CAT_NO_ROWS_FOUND;
+            }
+
+            const auto write_flag = getWriteFlag(_inp.openFlags);
+
+            for (const auto& r : replicas) {
+                auto [replica, replica_lm] = ir::make_replica_proxy(_inp.objPath, r);
+
+                // Hierarchy information is not stored in the catalog.
+                replica.hierarchy(resc_mgr.leaf_id_to_hier(replica.resource_id()));
+                replica.resource(irods::hierarchy_parser{replica.hierarchy().data()}.last_resc());
+                replica.get()->writeFlag = write_flag;
+
+                constexpr int is_single_object = 1;
+                constexpr int prepend_object = 0;
+                queueDataObjInfo(_info, replica_lm.release(), is_single_object, prepend_object);
+            }
+
+            return 0;
+        }
+        catch (const std::exception& e) {
+            irods::log(LOG_NOTICE, fmt::format("[{}:{}] - falling back to regular lookup for [{}]: {}",
+                                               __FUNCTION__, __LINE__, _inp.objPath, e.what()));
+
+            freeAllDataObjInfo(*_info);
+            *_info = nullptr;
+
+            return std::nullopt;
+        }
+    } // get_data_obj_info_from_open_plan
+} // anonymous namespace
+
 int
 getDataObjInfoIncSpecColl( rsComm_t *rsComm, dataObjInp_t *dataObjInp,
                            dataObjInfo_t **dataObjInfo ) {
@@ -1133,18 +1224,24 @@ getDataObjInfoIncSpecColl( rsComm_t *rsComm, dataObjInp_t *dataObjInp,
         status = getDataObjInfo( rsComm, dataObjInp, dataObjInfo,
                                  NULL, 0 );
     }
-    else if ( writeFlag > 0 && dataObjInp->oprType != REPLICATE_OPR ) {
-        status = getDataObjInfo( rsComm, dataObjInp, dataObjInfo,
-                                 ACCESS_MODIFY_OBJECT, 0 );
-    }
-    else if (getValByKey(&dataObjInp->condInput, DATA_ACCESS_KW)) {
-        char* data_access_kw = getValByKey(&dataObjInp->condInput, DATA_ACCESS_KW);
-        status = getDataObjInfo( rsComm, dataObjInp, dataObjInfo,
-                                 data_access_kw, 0 );
-    }
     else {
+        char* access_level = const_cast<char*>( ACCESS_READ_OBJECT );
+        if ( writeFlag > 0 && dataObjInp->oprType != REPLICATE_OPR ) {
+            access_level = const_cast<char*>( ACCESS_MODIFY_OBJECT );
+        }
+        else if ( char* data_access_kw = getValByKey( &dataObjInp->condInput, DATA_ACCESS_KW ) ) {
+            access_level = data_access_kw;
+        }
+
+        // The open plan answers in a single round trip what the lookup below and the special
+        // collection checks after it would need several round trips for.
+        const auto plan_status = get_data_obj_info_from_open_plan( *rsComm, *dataObjInp, access_level, dataObjInfo );
+        if ( plan_status ) {
+            return *plan_status;
+        }
+
         status = getDataObjInfo( rsComm, dataObjInp, dataObjInfo,
-                                 ACCESS_READ_OBJECT, 0 );
+                                 access_level, 0 );
     }
 
     if ( status < 0 && dataObjInp->specColl == NULL ) {
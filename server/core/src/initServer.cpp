@@ -22,6 +22,7 @@
 #include "irods/rsModDataObjMeta.hpp"
 #include "irods/rs_replica_close.hpp"
 #include "irods/sockComm.h"
+#include "irods/tracing.hpp"
 #include "irods/objMetaOpr.hpp"
 #include "irods/finalize_utilities.hpp"
 #include "irods/irods_configuration_parser.hpp"
@@ -831,6 +832,18 @@ initRsCommWithStartupPack( rsComm_t *rsComm, startupPack_t *startupPack ) {
         else {
             rstrcpy( rsComm->option, tmpStr, LONG_NAME_LEN );
         }
+
+        // Continue the trace of the client. Clients which do not send a trace context get a new one
+        // so that the log records of this agent and the servers it connects to can be correlated.
+        namespace tracing = irods::experimental::tracing;
+
+        if (tmpStr = getenv(SP_TRACE_PARENT); tmpStr) {
+            if (auto trace_context = tracing::from_traceparent(tmpStr); trace_context) {
+                tracing::set_root_context(std::move(*trace_context));
+            }
+        }
+
+        tracing::current_or_new_context();
     }
 
     if (const auto ec = setLocalAddr(rsComm->sock, &rsComm->localAddr); ec == USER_RODS_HOSTNAME_ERR) {
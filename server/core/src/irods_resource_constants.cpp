@@ -1,4 +1,5 @@
 #include "irods/irods_resource_constants.hpp"
+#include "irods/irods_plugin_base.hpp"
 
 namespace irods
 {
@@ -43,6 +44,9 @@ namespace irods
     const std::string RESOURCE_OP_REBALANCE( "resource_rebalance" );
     const std::string RESOURCE_OP_NOTIFY( "resource_notify" );
 
+    const operation_index RESOURCE_OP_READ_INDEX = get_operation_index(RESOURCE_OP_READ);
+    const operation_index RESOURCE_OP_WRITE_INDEX = get_operation_index(RESOURCE_OP_WRITE);
+
     const std::string RESOURCE_HOST( "resource_property_host" );
     const std::string RESOURCE_ID( "resource_property_id" );
     const std::string RESOURCE_FREESPACE( "resource_property_freespace" );
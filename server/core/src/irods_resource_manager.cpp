@@ -908,6 +908,42 @@ namespace irods
         return result;
     } // call_maintenance_operations
 
+// =-=-=-=-=-=-=-
+// public - determine if any resource deferred work until the client is idle
+    bool resource_manager::need_idle_maintenance_operations( ) {
+        for ( auto& [name, resc] : resource_name_map_ ) {
+            bool flg = false;
+            resc->need_idle_maintenance_operation( flg );
+            if ( flg ) {
+                return true;
+            }
+        }
+
+        return false;
+    } // need_idle_maintenance_operations
+
+// =-=-=-=-=-=-=-
+// public - perform the work resources deferred until the client is idle
+    int resource_manager::call_idle_maintenance_operations( rsComm_t* _comm ) {
+        int result = 0;
+
+        for ( auto& [name, resc] : resource_name_map_ ) {
+            bool flg = false;
+            resc->need_idle_maintenance_operation( flg );
+            if ( !flg ) {
+                continue;
+            }
+
+            error ret = resc->idle_maintenance_operation( _comm );
+            if ( !ret.ok() ) {
+                log( PASSMSG( "resource_manager::call_idle_maintenance_operations - op failed", ret ) );
+                result = ret.code();
+            }
+        }
+
+        return result;
+    } // call_idle_maintenance_operations
+
     /*
      * construct a vector of all resource hierarchies in the system
      * throws irods::exception
@@ -347,22 +347,26 @@ namespace irods
             THROW(SYS_INVALID_INPUT_PARAM, "null comm pointer");
         }
 
+        irods::file_object_ptr file_obj = std::get<irods::file_object_ptr>(_file_obj_result);
+        irods::error fac_err = std::get<irods::error>(_file_obj_result);
+
         // =-=-=-=-=-=-=-
         // if this is a special collection then we need to get the hier
         // pass that along and bail as it is not a data object, or if
         // it is just a not-so-special collection then we continue with
-        // processing the operation, as this may be a create op
+        // processing the operation, as this may be a create op.
+        // a data object registered in the catalog cannot share its path
+        // with a collection, so the lookup is skipped in that case.
+        const bool is_registered_data_object = fac_err.ok() && file_obj && file_obj->data_id() > 0;
         rodsObjStat_t *rodsObjStatOut = NULL;
-        if (collStat(_comm, &_data_obj_inp, &rodsObjStatOut) >= 0 && rodsObjStatOut->specColl) {
+        if (!is_registered_data_object &&
+            collStat(_comm, &_data_obj_inp, &rodsObjStatOut) >= 0 && rodsObjStatOut->specColl) {
             std::string hier = rodsObjStatOut->specColl->rescHier;
             freeRodsObjStat( rodsObjStatOut );
             return {irods::file_object_ptr{}, hier};
         }
         freeRodsObjStat(rodsObjStatOut);
 
-        irods::file_object_ptr file_obj = std::get<irods::file_object_ptr>(_file_obj_result);
-        irods::error fac_err = std::get<irods::error>(_file_obj_result);
-
         auto key_word = get_keyword_from_inp(_data_obj_inp);
 
         // Providing a replica number means the client is attempting to target an existing replica.
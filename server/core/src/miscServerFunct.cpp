@@ -3,6 +3,7 @@
 #include "irods/QUANTAnet_rbudpBase_c.h"
 #include "irods/QUANTAnet_rbudpSender_c.h"
 #include "irods/QUANTAnet_rbudpReceiver_c.h"
+#include "irods/connection_broker.hpp"
 #include "irods/dataObjOpen.h"
 #include "irods/dataObjLseek.h"
 #include "irods/irods_configuration_keywords.hpp"
@@ -16,6 +17,7 @@
 #include "irods/rcPortalOpr.h"
 #include "irods/rcConnect.h"
 #include "irods/rodsConnect.h"
+#include "irods/set_trace_context.h"
 #include "irods/sockComm.h"
 #include "irods/modAccessControl.h"
 #include "irods/rsDataObjOpen.hpp"
@@ -45,6 +47,7 @@
 #include "irods/irods_resource_manager.hpp"
 #include "irods/irods_default_paths.hpp"
 #include "irods/irods_logger.hpp"
+#include "irods/tracing.hpp"
 
 #include <boost/filesystem.hpp>
 #include <boost/thread/thread.hpp>
@@ -130,6 +133,35 @@ int
 svrToSvrConnect( rsComm_t *rsComm, rodsServerHost_t *rodsServerHost ) {
     int status;
 
+    /* Reuse a connection left logged in by an earlier agent, if the
+     * connection broker holds one */
+    if ( rodsServerHost->conn == NULL && getenv( RECONNECT_ENV ) == NULL ) {
+        rodsServerHost->conn = irods::connection_broker::lease(
+                                   rodsServerHost->hostName->name,
+                                   ( ( zoneInfo_t * ) rodsServerHost->zoneInfo )->portNum,
+                                   rsComm->myEnv.rodsUserName, rsComm->myEnv.rodsZone,
+                                   rsComm->clientUser.userName, rsComm->clientUser.rodsZone );
+
+        /* The other server's agent still holds the trace of the agent
+         * which opened the connection. Attribute its work to ours. */
+        if ( rodsServerHost->conn ) {
+            namespace tracing = irods::experimental::tracing;
+
+            const auto traceparent = tracing::to_traceparent( tracing::current_or_new_context() );
+            status = rc_set_trace_context( rodsServerHost->conn, traceparent.c_str() );
+
+            /* Servers without the API keep the old trace, which is harmless.
+             * Any other failure means the connection is unusable. */
+            if ( status < 0 && status != SYS_UNMATCHED_API_NUM ) {
+                rodsLog( LOG_DEBUG,
+                         "svrToSvrConnect: could not set the trace context on a leased connection to %s, status = %d",
+                         rodsServerHost->hostName->name, status );
+                rcDisconnect( rodsServerHost->conn );
+                rodsServerHost->conn = NULL;
+            }
+        }
+    }
+
     status = svrToSvrConnectNoLogin( rsComm, rodsServerHost );
 
     if ( status < 0 ) {
@@ -33,16 +33,19 @@
 #include "irods/server_utilities.hpp"
 #include "irods/sockCommNetworkInterface.hpp"
 #include "irods/sslSockComm.h"
+#include "irods/tracing.hpp"
 #include "irods/version.hpp"
 
 #include <csignal>
 #include <cstdlib>
+#include <poll.h>
 #include <sys/socket.h>
 #include <sys/un.h>
 #include <sys/types.h>
 #include <sys/wait.h>
 
 #include <fmt/format.h>
+#include <nlohmann/json.hpp>
 
 #include <cstring>
 #include <memory>
@@ -203,7 +206,7 @@ int receiveDataFromServer(int conn_tmp_socket)
     return status;
 } // receiveDataFromServer
 
-void cleanup()
+void cleanup(bool _release_svr_to_svr_conns = false)
 {
     std::string svc_role;
     irods::error ret = get_catalog_service_role(svc_role);
@@ -219,7 +222,12 @@ void cleanup()
 
         irods::replica_state_table::deinit();
 
-        disconnectAllSvrToSvrConn();
+        if (_release_svr_to_svr_conns) {
+            releaseAllSvrToSvrConn();
+        }
+        else {
+            disconnectAllSvrToSvrConn();
+        }
     }
 
     if (irods::KW_CFG_SERVICE_ROLE_PROVIDER == svc_role) {
@@ -323,6 +331,27 @@ void set_log_levels_for_all_log_categories()
     log_ns::sql::set_level(log_ns::get_level_from_config(irods::KW_CFG_LOG_LEVEL_CATEGORY_SQL));
 } // set_log_levels_for_all_log_categories
 
+// Directs the spans of this agent to advanced_settings.tracing.sink. Spans are not recorded by default.
+void configure_tracing()
+{
+    std::string sink;
+
+    try {
+        const auto config = irods::get_advanced_setting<nlohmann::json>(irods::KW_CFG_TRACING);
+
+        if (const auto iter = config.find(irods::KW_CFG_SINK); iter != std::end(config)) {
+            sink = iter->get<std::string>();
+        }
+    }
+    catch (...) {
+        return;
+    }
+
+    if (!irods::experimental::tracing::configure_sink(sink, log_ns::get_server_hostname())) {
+        log_agent::error("Unsupported trace sink [{}]. Spans will not be recorded.", sink);
+    }
+} // configure_tracing
+
 void setup_signal_handlers()
 {
     signal(SIGINT, irodsAgentSignalExit);
@@ -567,6 +596,7 @@ int runIrodsAgentFactory(sockaddr_un agent_addr)
 
         set_eviction_age_for_dns_and_hostname_caches();
         set_log_levels_for_all_log_categories();
+        configure_tracing();
 
         if (const auto err = setRECacheSaltFromEnv(); !err.ok()) {
             log_agent::error("rodsAgent::main: Failed to set RE cache mutex name\n%s", err.result());
@@ -706,8 +736,10 @@ int runIrodsAgentFactory(sockaddr_un agent_addr)
         return ret.code();
     }
 
-    const auto cleanup_and_free_rsComm_members = [&rsComm] {
-        cleanup();
+    // Server-to-server connections are only handed to the connection broker when the
+    // client disconnected cleanly, as only then is it known that none are mid-request.
+    const auto cleanup_and_free_rsComm_members = [&rsComm](bool _release_svr_to_svr_conns = false) {
+        cleanup(_release_svr_to_svr_conns);
         if (rsComm.thread_ctx) {
             std::free(rsComm.thread_ctx); // NOLINT(cppcoreguidelines-no-malloc, cppcoreguidelines-owning-memory)
         }
@@ -729,7 +761,7 @@ int runIrodsAgentFactory(sockaddr_un agent_addr)
 
     new_net_obj->to_server(&rsComm);
 
-    cleanup_and_free_rsComm_members();
+    cleanup_and_free_rsComm_members(0 == status);
 
     // clang-format off
     (0 == status)
@@ -770,6 +802,32 @@ static void set_rule_engine_globals(RsComm* _comm)
     irods::set_server_property<int>(irods::PROXY_USER_PRIV_KW, _comm->clientUser.authInfo.authFlag);
 } // set_rule_engine_globals
 
+// Gives resources a chance to perform deferred work (e.g. queued archive syncs) while the
+// client is connected but has not sent its next request. Resources bound the time they take,
+// so a client that sends a request during the operation is only delayed, never starved.
+static void perform_idle_maintenance(RsComm* _comm)
+{
+    // How long the client must be quiet before it is considered idle.
+    constexpr int idle_delay_in_milliseconds = 100;
+
+    if (!resc_mgr.need_idle_maintenance_operations()) {
+        return;
+    }
+
+    // Decrypted bytes buffered by OpenSSL are not visible to poll().
+    if (_comm->ssl && SSL_pending(_comm->ssl) > 0) {
+        return;
+    }
+
+    pollfd pfd{.fd = _comm->sock, .events = POLLIN, .revents = 0};
+    if (poll(&pfd, 1, idle_delay_in_milliseconds) != 0) {
+        return;
+    }
+
+    resc_mgr.call_idle_maintenance_operations(_comm);
+    freeRErrorContent(&_comm->rError);
+} // perform_idle_maintenance
+
 int agentMain(RsComm* rsComm)
 {
     if (!rsComm) {
@@ -854,6 +912,8 @@ int agentMain(RsComm* rsComm)
             rsComm->ssl_do_shutdown = 0;
         }
 
+        perform_idle_maintenance(rsComm);
+
         status = readAndProcClientMsg(rsComm, READ_HEADER_TIMEOUT);
         if (status < 0) {
             if (status == DISCONN_STATUS) {
@@ -1,4 +1,5 @@
 #include "irods/rcMisc.h"
+#include "irods/connection_broker.hpp"
 #include "irods/rodsConnect.h"
 #include "irods/rsGlobalExtern.hpp"
 #include "irods/rcGlobalExtern.h"
@@ -731,6 +732,28 @@ disconnectAllSvrToSvrConn() {
     return 0;
 }
 
+/* releaseAllSvrToSvrConn - same as disconnectAllSvrToSvrConn except that
+ * the connections are handed to the connection broker, if it is running,
+ * so that later agents can reuse them. Must only be called once the
+ * connections are idle.
+ */
+int
+releaseAllSvrToSvrConn() {
+    rodsServerHost_t *tmpRodsServerHost;
+
+    tmpRodsServerHost = ServerHostHead;
+    while ( tmpRodsServerHost != NULL ) {
+        if ( tmpRodsServerHost->conn != NULL ) {
+            if ( !irods::connection_broker::release( tmpRodsServerHost->conn ) ) {
+                rcDisconnect( tmpRodsServerHost->conn );
+            }
+            tmpRodsServerHost->conn = NULL;
+        }
+        tmpRodsServerHost = tmpRodsServerHost->next;
+    }
+    return 0;
+}
+
 /* getAndConnRemoteZone - get the remote zone host (result given in
  * rodsServerHost) based on the dataObjInp->objPath as zoneHint.
  * If the host is a remote zone, automatically connect to the host.
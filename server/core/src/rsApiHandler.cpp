@@ -14,6 +14,9 @@
 #include "irods/plugins/api/api_plugin_number.h"
 #include "irods/client_api_allowlist.hpp"
 #include "irods/key_value_proxy.hpp"
+#include "irods/api_statistics.hpp"
+#include "irods/irods_at_scope_exit.hpp"
+#include "irods/tracing.hpp"
 
 #include <boost/thread.hpp>
 #include <boost/thread/mutex.hpp>
@@ -38,6 +41,7 @@ jmp_buf Jenv;
 #include <cstring>
 #include <iterator>
 #include <algorithm>
+#include <chrono>
 
 namespace ix = irods::experimental;
 
@@ -99,6 +103,30 @@ int rsApiHandler(rsComm_t*   rsComm,
 
     rsComm->apiInx = apiInx;
 
+    // Every request which reaches this point is counted toward the API statistics. Requests
+    // rejected before the handler is invoked keep the initial error code.
+    const auto start_time = std::chrono::steady_clock::now();
+    const auto bytes_in = static_cast<std::uint64_t>(std::max(inputStructBBuf->len, 0)) +
+                          static_cast<std::uint64_t>(std::max(bsBBuf->len, 0));
+    std::uint64_t bytes_out = 0;
+    int api_status = SYS_API_INPUT_ERR;
+
+    irods::api_entry_table& RsApiTable = irods::get_server_api_table();
+
+    irods::experimental::tracing::span api_span{
+        RsApiTable[apiInx] ? std::string_view{RsApiTable[apiInx]->operation_name} : std::string_view{"unknown"},
+        irods::experimental::tracing::span_kind::server};
+    api_span.set_attribute("irods.api.number", apiNumber);
+
+    irods::at_scope_exit record_api_statistics{[&] {
+        namespace stats = irods::experimental::api_statistics;
+        stats::record(apiNumber, api_status, bytes_in, bytes_out, std::chrono::steady_clock::now() - start_time);
+
+        api_span.set_attribute("irods.api.bytes_in", static_cast<std::int64_t>(bytes_in));
+        api_span.set_attribute("irods.api.bytes_out", static_cast<std::int64_t>(bytes_out));
+        api_span.set_error_code(api_status);
+    }};
+
     // Clear the session properties stored in the connection object.
     // This is required to avoid incorrect behavior when multiple API calls are
     // invoked via the same connection object.
@@ -124,8 +152,6 @@ int rsApiHandler(rsComm_t*   rsComm,
         return status;
     }
 
-    irods::api_entry_table& RsApiTable = irods::get_server_api_table();
-
     /* some sanity check */
     if ( inputStructBBuf->len > 0 && RsApiTable[apiInx]->inPackInstruct == NULL ) {
         rodsLog( LOG_NOTICE,
@@ -235,7 +261,7 @@ int rsApiHandler(rsComm_t*   rsComm,
     }
 
     if (retVal != SYS_NO_HANDLER_REPLY_MSG) {
-        status = sendAndProcApiReply(rsComm, apiInx, retVal, myOutStruct, &myOutBsBBuf);
+        status = sendAndProcApiReply(rsComm, apiInx, retVal, myOutStruct, &myOutBsBBuf, &bytes_out);
     }
 
     // clear the incoming packing instruction
@@ -258,15 +284,24 @@ int rsApiHandler(rsComm_t*   rsComm,
     }
 
     if (retVal >= 0 && status < 0) {
+        api_status = status;
         return status;
     }
 
+    // The handler replied to the client on its own, which is not an error.
+    api_status = (SYS_NO_HANDLER_REPLY_MSG == retVal) ? 0 : retVal;
+
     return retVal;
 }
 
-int sendAndProcApiReply(rsComm_t* rsComm, int apiInx, int status, void*& myOutStruct, bytesBuf_t* myOutBsBBuf)
+int sendAndProcApiReply(rsComm_t* rsComm,
+                        int apiInx,
+                        int status,
+                        void*& myOutStruct,
+                        bytesBuf_t* myOutBsBBuf,
+                        std::uint64_t* _bytes_sent)
 {
-    const int retval = sendApiReply(rsComm, apiInx, status, myOutStruct, myOutBsBBuf);
+    const int retval = sendApiReply(rsComm, apiInx, status, myOutStruct, myOutBsBBuf, _bytes_sent);
 
     clearBBuf(myOutBsBBuf);
     freeRErrorContent(&rsComm->rError);
@@ -282,7 +317,12 @@ int sendAndProcApiReply(rsComm_t* rsComm, int apiInx, int status, void*& myOutSt
     return retval;
 }
 
-int sendApiReply(rsComm_t* rsComm, int apiInx, int retVal, void*& myOutStruct, bytesBuf_t* myOutBsBBuf)
+int sendApiReply(rsComm_t* rsComm,
+                 int apiInx,
+                 int retVal,
+                 void*& myOutStruct,
+                 bytesBuf_t* myOutBsBBuf,
+                 std::uint64_t* _bytes_sent)
 {
     int status = 0;
     bytesBuf_t* outStructBBuf = nullptr;
@@ -357,6 +397,12 @@ int sendApiReply(rsComm_t* rsComm, int apiInx, int retVal, void*& myOutStruct, b
         myRErrorBBuf = nullptr;
     }
 
+    // Counted the same way as the requests of batch_execute, which only ever see the packed output struct.
+    if (_bytes_sent) {
+        *_bytes_sent = static_cast<std::uint64_t>(myOutStructBBuf ? std::max(myOutStructBBuf->len, 0) : 0) +
+                       static_cast<std::uint64_t>(myOutBsBBuf ? std::max(myOutBsBBuf->len, 0) : 0);
+    }
+
     ret = sendRodsMsg(net_obj, RODS_API_REPLY_T, myOutStructBBuf, myOutBsBBuf, myRErrorBBuf, retVal, rsComm->irodsProt);
 
     if ( !ret.ok() ) {
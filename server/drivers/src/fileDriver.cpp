@@ -95,7 +95,7 @@ irods::error fileRead(
     // =-=-=-=-=-=-=-
     // make the call to the "read" interface
     resc    = boost::dynamic_pointer_cast< irods::resource >( ptr );
-    ret_err = resc->call< void*, const int >( _comm, irods::RESOURCE_OP_READ, _object, _buf, _len );
+    ret_err = resc->call< void*, const int >( _comm, irods::RESOURCE_OP_READ_INDEX, _object, _buf, _len );
 
     // =-=-=-=-=-=-=-
     // pass along an error from the interface or return SUCCESS
@@ -127,7 +127,7 @@ irods::error fileWrite(
     // =-=-=-=-=-=-=-
     // make the call to the "write" interface
     resc    = boost::dynamic_pointer_cast< irods::resource >( ptr );
-    ret_err = resc->call< const void*, const int >( _comm, irods::RESOURCE_OP_WRITE, _object, _buf, _len );
+    ret_err = resc->call< const void*, const int >( _comm, irods::RESOURCE_OP_WRITE_INDEX, _object, _buf, _len );
 
     // =-=-=-=-=-=-=-
     // pass along an error from the interface or return SUCCESS
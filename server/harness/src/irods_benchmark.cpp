@@ -0,0 +1,785 @@
+/// \file
+///
+/// \brief Generates load against a running server and reports throughput and latency as JSON.
+///
+/// Each workload runs on a configurable number of threads. Every thread owns one connection
+/// from a connection_pool and repeats a single operation until the requested duration has
+/// elapsed or the requested number of iterations has completed. The time taken by each
+/// successful operation is recorded so that the latency percentiles can be compared between
+/// releases. Failed operations are counted separately.
+
+#include "irods/bulk_apply_metadata_operations.h"
+#include "irods/connection_pool.hpp"
+#include "irods/dataObjGet.h"
+#include "irods/dataObjPut.h"
+#include "irods/dstream.hpp"
+#include "irods/execMyRule.h"
+#include "irods/filesystem.hpp"
+#include "irods/irods_at_scope_exit.hpp"
+#include "irods/irods_client_api_table.hpp"
+#include "irods/irods_configuration_keywords.hpp"
+#include "irods/irods_exception.hpp"
+#include "irods/irods_query.hpp"
+#include "irods/msParam.h"
+#include "irods/parseCommandLine.h"
+#include "irods/putUtil.h"
+#include "irods/rcMisc.h"
+#include "irods/rodsClient.h"
+#include "irods/rodsErrorTable.h"
+#include "irods/rodsPath.h"
+#include "irods/transport/default_transport.hpp"
+
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+#include <fmt/format.h>
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <unistd.h>
+
+namespace
+{
+    namespace fs = irods::experimental::filesystem;
+    namespace io = irods::experimental::io;
+    namespace po = boost::program_options;
+
+    using json = nlohmann::json;
+    using clock_type = std::chrono::steady_clock;
+
+    struct options
+    {
+        std::vector<std::string> workloads;
+        int threads;
+        int duration_in_seconds;
+        std::int64_t iterations;
+        std::string collection;
+        std::string resource;
+        std::string local_directory;
+        int object_count;
+        std::int64_t small_file_size;
+        std::int64_t large_file_size;
+        int transfer_threads;
+        int bulk_file_count;
+        std::string rule;
+        std::string rule_engine_instance;
+        std::string output;
+        bool keep_data;
+    }; // struct options
+
+    struct workload_context
+    {
+        const options& opts;
+        rodsEnv& env;
+
+        // The collection holding the data objects of the workload.
+        fs::path collection;
+
+        // A local directory owned by the workload.
+        boost::filesystem::path local_directory;
+    }; // struct workload_context
+
+    // Executes one operation of a workload and returns the number of bytes transferred.
+    // Failures are reported by throwing an exception.
+    using operation_type = std::function<std::uint64_t(RcComm&, workload_context&, int, std::int64_t)>;
+
+    // Prepares the data needed by the operations of a workload.
+    using setup_type = std::function<void(RcComm&, workload_context&)>;
+
+    struct workload
+    {
+        std::string_view description;
+        setup_type setup;
+        operation_type operation;
+    }; // struct workload
+
+    struct thread_result
+    {
+        std::vector<std::int64_t> latencies_in_microseconds;
+        std::uint64_t bytes = 0;
+        std::uint64_t errors = 0;
+        std::string last_error;
+    }; // struct thread_result
+
+    auto throw_if_error(int _ec, std::string_view _operation) -> void
+    {
+        if (_ec < 0) {
+            THROW(_ec, fmt::format("{} failed", _operation));
+        }
+    } // throw_if_error
+
+    auto write_local_file(const boost::filesystem::path& _path, std::int64_t _size) -> void
+    {
+        std::ofstream out{_path.c_str(), std::ios::binary | std::ios::trunc};
+        std::vector<char> buffer(std::min<std::int64_t>(_size, 4 * 1024 * 1024), 'x');
+
+        for (std::int64_t remaining = _size; remaining > 0;) {
+            const auto n = std::min<std::int64_t>(remaining, static_cast<std::int64_t>(buffer.size()));
+            out.write(buffer.data(), n);
+            remaining -= n;
+        }
+
+        if (!out) {
+            throw std::runtime_error{fmt::format("could not write local file [{}]", _path.string())};
+        }
+    } // write_local_file
+
+    auto thread_file(const workload_context& _ctx, int _thread) -> boost::filesystem::path
+    {
+        return _ctx.local_directory / fmt::format("t{}", _thread);
+    } // thread_file
+
+    auto put_data_object(RcComm& _conn,
+                         const workload_context& _ctx,
+                         const fs::path& _path,
+                         const boost::filesystem::path& _local_path,
+                         std::int64_t _size,
+                         int _threads) -> void
+    {
+        DataObjInp input{};
+        irods::at_scope_exit free_memory{[&input] { clearKeyVal(&input.condInput); }};
+
+        std::strncpy(input.objPath, _path.c_str(), sizeof(input.objPath) - 1);
+        input.dataSize = _size;
+        input.numThreads = _threads;
+        input.oprType = PUT_OPR;
+        addKeyVal(&input.condInput, FORCE_FLAG_KW, "");
+
+        if (!_ctx.opts.resource.empty()) {
+            addKeyVal(&input.condInput, DEST_RESC_NAME_KW, _ctx.opts.resource.c_str());
+        }
+
+        throw_if_error(rcDataObjPut(&_conn, &input, const_cast<char*>(_local_path.c_str())), "rcDataObjPut");
+    } // put_data_object
+
+    auto get_data_object(RcComm& _conn,
+                         const fs::path& _path,
+                         const boost::filesystem::path& _local_path,
+                         int _threads) -> void
+    {
+        DataObjInp input{};
+        irods::at_scope_exit free_memory{[&input] { clearKeyVal(&input.condInput); }};
+
+        std::strncpy(input.objPath, _path.c_str(), sizeof(input.objPath) - 1);
+        input.numThreads = _threads;
+        input.oprType = GET_OPR;
+        addKeyVal(&input.condInput, FORCE_FLAG_KW, "");
+
+        throw_if_error(rcDataObjGet(&_conn, &input, const_cast<char*>(_local_path.c_str())), "rcDataObjGet");
+    } // get_data_object
+
+    auto create_empty_data_objects(RcComm& _conn, const workload_context& _ctx) -> void
+    {
+        io::client::default_transport xport{_conn};
+
+        for (int i = 0; i < _ctx.opts.object_count; ++i) {
+            io::odstream out{xport, _ctx.collection / fmt::format("obj{}", i)};
+
+            if (!out) {
+                throw std::runtime_error{"could not create data object"};
+            }
+        }
+    } // create_empty_data_objects
+
+    // Returns the AVUs attached to data object "obj<_index>" by the multi_avu_query workload.
+    auto multi_avu_query_avus(std::int64_t _index) -> std::vector<std::pair<std::string, std::string>>
+    {
+        return {{"irods_benchmark_avu_0", std::to_string(_index % 2)},
+                {"irods_benchmark_avu_1", std::to_string(_index % 5)},
+                {"irods_benchmark_avu_2", std::to_string(_index % 10)},
+                {"irods_benchmark_avu_3", std::to_string(_index % 100)},
+                {"irods_benchmark_avu_4", std::to_string(_index)}};
+    } // multi_avu_query_avus
+
+    //
+    // Workloads
+    //
+
+    auto make_workloads() -> std::map<std::string, workload, std::less<>>
+    {
+        std::map<std::string, workload, std::less<>> workloads;
+
+        workloads["small_put_get"] = {
+            "Puts a small file and gets it back.",
+            [](RcComm&, workload_context& _ctx) {
+                for (int i = 0; i < _ctx.opts.threads; ++i) {
+                    write_local_file(thread_file(_ctx, i), _ctx.opts.small_file_size);
+                }
+            },
+            [](RcComm& _conn, workload_context& _ctx, int _thread, std::int64_t _iteration) {
+                const auto name = fmt::format("t{}_{}", _thread, _iteration % _ctx.opts.object_count);
+                const auto path = _ctx.collection / name;
+                const auto local_path = thread_file(_ctx, _thread);
+                const auto size = _ctx.opts.small_file_size;
+
+                put_data_object(_conn, _ctx, path, local_path, size, NO_THREADING);
+                get_data_object(_conn, path, local_path.string() + ".get", NO_THREADING);
+
+                return static_cast<std::uint64_t>(2 * size);
+            }};
+
+        workloads["stat"] = {
+            "Stats data objects.",
+            create_empty_data_objects,
+            [](RcComm& _conn, workload_context& _ctx, int _thread, std::int64_t _iteration) -> std::uint64_t {
+                const auto index = (_thread + _iteration * _ctx.opts.threads) % _ctx.opts.object_count;
+
+                const auto path = _ctx.collection / fmt::format("obj{}", index);
+
+                if (!fs::client::is_data_object(fs::client::status(_conn, path))) {
+                    THROW(OBJ_PATH_DOES_NOT_EXIST, "data object not found");
+                }
+
+                return 0;
+            }};
+
+        workloads["genquery"] = {
+            "Lists every data object in a collection one GenQuery page at a time.",
+            create_empty_data_objects,
+            [](RcComm& _conn, workload_context& _ctx, int, std::int64_t) -> std::uint64_t {
+                const auto query_string =
+                    fmt::format("select DATA_NAME, DATA_SIZE where COLL_NAME = '{}'", _ctx.collection.c_str());
+
+                std::int64_t rows = 0;
+
+                for (auto&& row : irods::query<RcComm>{&_conn, query_string}) {
+                    static_cast<void>(row);
+                    ++rows;
+                }
+
+                if (rows != _ctx.opts.object_count) {
+                    THROW(CAT_NO_ROWS_FOUND, fmt::format("expected {} rows, got {}", _ctx.opts.object_count, rows));
+                }
+
+                return 0;
+            }};
+
+        workloads["metadata"] = {
+            "Adds an AVU to a data object and finds the data object by that AVU.",
+            [](RcComm& _conn, workload_context& _ctx) {
+                io::client::default_transport xport{_conn};
+
+                for (int i = 0; i < _ctx.opts.threads; ++i) {
+                    io::odstream out{xport, _ctx.collection / fmt::format("t{}", i)};
+
+                    if (!out) {
+                        throw std::runtime_error{"could not create data object"};
+                    }
+                }
+            },
+            [](RcComm& _conn, workload_context& _ctx, int _thread, std::int64_t _iteration) -> std::uint64_t {
+                const auto attribute = fmt::format("irods_benchmark_{}", getpid());
+                const auto value = fmt::format("{}_{}", _thread, _iteration);
+
+                fs::client::add_metadata(_conn, _ctx.collection / fmt::format("t{}", _thread), {attribute, value});
+
+                const auto query_string = fmt::format("select DATA_NAME where COLL_NAME = '{}' and "
+                                                      "META_DATA_ATTR_NAME = '{}' and META_DATA_ATTR_VALUE = '{}'",
+                                                      _ctx.collection.c_str(),
+                                                      attribute,
+                                                      value);
+
+                if (irods::query<RcComm>{&_conn, query_string}.size() != 1) {
+                    THROW(CAT_NO_ROWS_FOUND, "metadata not found");
+                }
+
+                return 0;
+            }};
+
+        workloads["multi_avu_query"] = {
+            "Finds a data object by five AVUs among --object-count objects sharing most of them.",
+            [](RcComm& _conn, workload_context& _ctx) {
+                create_empty_data_objects(_conn, _ctx);
+
+                // Every data object gets the same five attributes. Their values are chosen so that each
+                // condition alone matches 1/2, 1/5, 1/10 and 1/100 of the objects, and the last one matches
+                // exactly one object. The catalog is therefore the same for a given --object-count.
+                constexpr int entities_per_request = 1000;
+
+                for (int first = 0; first < _ctx.opts.object_count; first += entities_per_request) {
+                    const auto last = std::min(first + entities_per_request, _ctx.opts.object_count);
+                    auto entities = json::array();
+
+                    for (int i = first; i < last; ++i) {
+                        auto operations = json::array();
+
+                        for (auto&& [attribute, value] : multi_avu_query_avus(i)) {
+                            operations.push_back({{"operation", "add"}, {"attribute", attribute}, {"value", value}});
+                        }
+
+                        entities.push_back({{"entity_name", (_ctx.collection / fmt::format("obj{}", i)).string()},
+                                            {"entity_type", "data_object"},
+                                            {"operations", operations}});
+                    }
+
+                    const auto input = json{{"entities", entities}}.dump();
+                    char* output{};
+                    irods::at_scope_exit free_output{[&output] { std::free(output); }};
+
+                    throw_if_error(rc_bulk_apply_metadata_operations(&_conn, input.c_str(), &output),
+                                   "rc_bulk_apply_metadata_operations");
+                }
+            },
+            [](RcComm& _conn, workload_context& _ctx, int _thread, std::int64_t _iteration) -> std::uint64_t {
+                const auto index = (_thread + _iteration * _ctx.opts.threads) % _ctx.opts.object_count;
+
+                auto query_string = fmt::format("select DATA_NAME where COLL_NAME = '{}'", _ctx.collection.c_str());
+
+                for (auto&& [attribute, value] : multi_avu_query_avus(index)) {
+                    query_string += fmt::format(" and META_DATA_ATTR_NAME = '{}' and META_DATA_ATTR_VALUE = '{}'",
+                                                attribute,
+                                                value);
+                }
+
+                std::string name;
+
+                for (auto&& row : irods::query<RcComm>{&_conn, query_string}) {
+                    if (!name.empty()) {
+                        THROW(SYS_INTERNAL_ERR, "more than one data object matched");
+                    }
+
+                    name = row[0];
+                }
+
+                if (name != fmt::format("obj{}", index)) {
+                    THROW(CAT_NO_ROWS_FOUND, fmt::format("expected obj{}, got [{}]", index, name));
+                }
+
+                return 0;
+            }};
+
+        workloads["large_transfer"] = {
+            "Puts a large file and gets it back using parallel transfer.",
+            [](RcComm&, workload_context& _ctx) {
+                for (int i = 0; i < _ctx.opts.threads; ++i) {
+                    write_local_file(thread_file(_ctx, i), _ctx.opts.large_file_size);
+                }
+            },
+            [](RcComm& _conn, workload_context& _ctx, int _thread, std::int64_t) {
+                const auto path = _ctx.collection / fmt::format("t{}", _thread);
+                const auto local_path = thread_file(_ctx, _thread);
+                const auto size = _ctx.opts.large_file_size;
+                const auto transfer_threads = _ctx.opts.transfer_threads;
+
+                put_data_object(_conn, _ctx, path, local_path, size, transfer_threads);
+                get_data_object(_conn, path, local_path.string() + ".get", transfer_threads);
+
+                return static_cast<std::uint64_t>(2 * size);
+            }};
+
+        workloads["bulk_put"] = {
+            "Puts a directory of small files using bulk upload (iput -b).",
+            [](RcComm&, workload_context& _ctx) {
+                for (int i = 0; i < _ctx.opts.threads; ++i) {
+                    const auto dir = thread_file(_ctx, i);
+                    boost::filesystem::create_directories(dir);
+
+                    for (int j = 0; j < _ctx.opts.bulk_file_count; ++j) {
+                        write_local_file(dir / fmt::format("f{}", j), _ctx.opts.small_file_size);
+                    }
+                }
+            },
+            [](RcComm& _conn, workload_context& _ctx, int _thread, std::int64_t) {
+                auto local_dir = thread_file(_ctx, _thread).string();
+                auto target = (_ctx.collection / fmt::format("t{}", _thread)).string();
+                std::string program = "irods_benchmark";
+                char* argv[] = {program.data(), local_dir.data(), target.data()};
+
+                RodsPathInp path_input{};
+                irods::at_scope_exit free_path_input{[&path_input] {
+                    for (int i = 0; i < path_input.numSrc; ++i) {
+                        clearRodsPath(&path_input.srcPath[i]);
+                        clearRodsPath(&path_input.targPath[i]);
+                    }
+
+                    clearRodsPath(path_input.destPath);
+                    std::free(path_input.srcPath);
+                    std::free(path_input.targPath);
+                    std::free(path_input.destPath);
+                }};
+
+                const auto ec =
+                    parseCmdLinePath(3, argv, 1, &_ctx.env, UNKNOWN_FILE_T, UNKNOWN_OBJ_T, 0, &path_input);
+                throw_if_error(ec, "parseCmdLinePath");
+
+                rodsArguments_t args{};
+                args.bulk = True;
+                args.recursive = True;
+                args.force = True;
+
+                if (!_ctx.opts.resource.empty()) {
+                    args.resource = True;
+                    args.resourceString = const_cast<char*>(_ctx.opts.resource.c_str());
+                }
+
+                auto* conn = &_conn;
+                throw_if_error(putUtil(&conn, &_ctx.env, &args, &path_input), "putUtil");
+
+                return static_cast<std::uint64_t>(_ctx.opts.bulk_file_count * _ctx.opts.small_file_size);
+            }};
+
+        workloads["rule_exec"] = {
+            "Executes a rule (irule).",
+            [](RcComm&, workload_context&) {},
+            [](RcComm& _conn, workload_context& _ctx, int, std::int64_t) -> std::uint64_t {
+                ExecMyRuleInp input{};
+                MsParamArray* out_params{};
+
+                irods::at_scope_exit free_memory{[&input, &out_params] {
+                    clearKeyVal(&input.condInput);
+
+                    if (out_params) {
+                        clearMsParamArray(out_params, 1);
+                        std::free(out_params);
+                    }
+                }};
+
+                std::snprintf(input.myRule, sizeof(input.myRule), "@external rule { %s }", _ctx.opts.rule.c_str());
+                std::strncpy(input.outParamDesc, "null", sizeof(input.outParamDesc) - 1);
+
+                if (!_ctx.opts.rule_engine_instance.empty()) {
+                    addKeyVal(&input.condInput, irods::KW_CFG_INSTANCE_NAME, _ctx.opts.rule_engine_instance.c_str());
+                }
+
+                throw_if_error(rcExecMyRule(&_conn, &input, &out_params), "rcExecMyRule");
+
+                return 0;
+            }};
+
+        return workloads;
+    } // make_workloads
+
+    //
+    // Reporting
+    //
+
+    // Returns the value at or below which _p (0, 1] of the sorted samples fall (nearest rank).
+    auto percentile(const std::vector<std::int64_t>& _sorted, double _p) -> std::int64_t
+    {
+        if (_sorted.empty()) {
+            return 0;
+        }
+
+        const auto rank = static_cast<std::size_t>(std::ceil(_p * static_cast<double>(_sorted.size())));
+
+        return _sorted[std::clamp<std::size_t>(rank, 1, _sorted.size()) - 1];
+    } // percentile
+
+    auto make_report(std::string_view _name,
+                     const workload& _workload,
+                     std::vector<thread_result>& _results,
+                     std::chrono::microseconds _elapsed) -> json
+    {
+        std::vector<std::int64_t> latencies;
+        std::uint64_t bytes = 0;
+        std::uint64_t errors = 0;
+        std::string last_error;
+
+        for (auto&& r : _results) {
+            latencies.insert(std::end(latencies),
+                             std::begin(r.latencies_in_microseconds),
+                             std::end(r.latencies_in_microseconds));
+            bytes += r.bytes;
+            errors += r.errors;
+
+            if (!r.last_error.empty()) {
+                last_error = std::move(r.last_error);
+            }
+        }
+
+        std::sort(std::begin(latencies), std::end(latencies));
+
+        const auto seconds = std::max(static_cast<double>(_elapsed.count()) / 1'000'000, 1e-9);
+
+        // Only successful operations have a latency.
+        const auto successes = latencies.size();
+
+        std::int64_t sum = 0;
+        for (auto l : latencies) {
+            sum += l;
+        }
+
+        json report{{"name", std::string{_name}},
+                    {"description", std::string{_workload.description}},
+                    {"operations", successes + errors},
+                    {"errors", errors},
+                    {"elapsed_seconds", seconds},
+                    {"throughput_operations_per_second", static_cast<double>(successes) / seconds},
+                    {"throughput_bytes_per_second", static_cast<double>(bytes) / seconds},
+                    {"latency_microseconds",
+                     {{"min", latencies.empty() ? 0 : latencies.front()},
+                      {"mean", latencies.empty() ? 0 : sum / static_cast<std::int64_t>(latencies.size())},
+                      {"p50", percentile(latencies, 0.50)},
+                      {"p99", percentile(latencies, 0.99)},
+                      {"p999", percentile(latencies, 0.999)},
+                      {"max", latencies.empty() ? 0 : latencies.back()}}}};
+
+        if (!last_error.empty()) {
+            report["last_error"] = last_error;
+        }
+
+        return report;
+    } // make_report
+
+    //
+    // Execution
+    //
+
+    auto run_workload(irods::connection_pool& _pool,
+                      rodsEnv& _env,
+                      const options& _opts,
+                      std::string_view _name,
+                      const workload& _workload,
+                      const boost::filesystem::path& _local_root) -> json
+    {
+        const auto name = std::string{_name};
+        workload_context ctx{_opts, _env, fs::path{_opts.collection} / name, _local_root / name};
+
+        boost::filesystem::create_directories(ctx.local_directory);
+
+        {
+            auto conn = _pool.get_connection();
+            fs::client::create_collections(conn, ctx.collection);
+            _workload.setup(conn, ctx);
+        }
+
+        std::vector<thread_result> results(_opts.threads);
+        std::vector<std::thread> threads;
+        threads.reserve(_opts.threads);
+
+        const auto start = clock_type::now();
+        const auto deadline = start + std::chrono::seconds{_opts.duration_in_seconds};
+
+        for (int t = 0; t < _opts.threads; ++t) {
+            threads.emplace_back([&, t] {
+                auto& result = results[t];
+                auto conn = _pool.get_connection();
+
+                // Client utilities such as putUtil modify the environment they are given, so each
+                // thread works on its own copy.
+                auto env = _env;
+                workload_context thread_ctx{_opts, env, ctx.collection, ctx.local_directory};
+
+                for (std::int64_t i = 0;; ++i) {
+                    if (_opts.iterations > 0 ? i >= _opts.iterations : clock_type::now() >= deadline) {
+                        break;
+                    }
+
+                    const auto op_start = clock_type::now();
+
+                    // Failed operations are only counted. They often fail fast, and would skew the
+                    // latency percentiles of the operations which completed.
+                    try {
+                        result.bytes += _workload.operation(conn, thread_ctx, t, i);
+                    }
+                    catch (const irods::exception& e) {
+                        ++result.errors;
+                        result.last_error = fmt::format("[{}] {}", e.code(), e.client_display_what());
+                        continue;
+                    }
+                    catch (const std::exception& e) {
+                        ++result.errors;
+                        result.last_error = e.what();
+                        continue;
+                    }
+
+                    const auto op_elapsed = clock_type::now() - op_start;
+                    result.latencies_in_microseconds.push_back(
+                        std::chrono::duration_cast<std::chrono::microseconds>(op_elapsed).count());
+                }
+            });
+        }
+
+        for (auto&& t : threads) {
+            t.join();
+        }
+
+        const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(clock_type::now() - start);
+
+        return make_report(_name, _workload, results, elapsed);
+    } // run_workload
+
+    auto parse_options(int _argc, char* _argv[], const std::map<std::string, workload, std::less<>>& _workloads)
+        -> std::optional<options>
+    {
+        options opts{};
+
+        std::string workload_list;
+        for (auto&& [name, w] : _workloads) {
+            workload_list += fmt::format("  {:<16}{}\n", name, w.description);
+        }
+
+        po::options_description desc{"Options"};
+        // clang-format off
+        desc.add_options()
+            ("help,h", "Show this message.")
+            ("workload,w", po::value<std::vector<std::string>>(&opts.workloads),
+             "A workload to run. May be repeated. Defaults to every workload.")
+            ("threads,t", po::value<int>(&opts.threads)->default_value(4),
+             "The number of concurrent clients.")
+            ("duration,d", po::value<int>(&opts.duration_in_seconds)->default_value(10),
+             "The number of seconds to run each workload.")
+            ("iterations,n", po::value<std::int64_t>(&opts.iterations)->default_value(0),
+             "The number of operations run by each client. Overrides --duration.")
+            ("collection,c", po::value<std::string>(&opts.collection),
+             "The collection to run in. Defaults to a new collection in the home collection.")
+            ("resource,R", po::value<std::string>(&opts.resource),
+             "The resource to write to.")
+            ("local-directory", po::value<std::string>(&opts.local_directory),
+             "The directory holding local files. Defaults to a new directory in the temporary directory.")
+            ("object-count", po::value<int>(&opts.object_count)->default_value(1000),
+             "The number of data objects used by the stat, genquery and multi_avu_query workloads.")
+            ("small-file-size", po::value<std::int64_t>(&opts.small_file_size)->default_value(4096),
+             "The size of a small file in bytes.")
+            ("large-file-size", po::value<std::int64_t>(&opts.large_file_size)->default_value(64 * 1024 * 1024),
+             "The size of a large file in bytes.")
+            ("transfer-threads", po::value<int>(&opts.transfer_threads)->default_value(4),
+             "The number of threads used by each large transfer.")
+            ("bulk-file-count", po::value<int>(&opts.bulk_file_count)->default_value(50),
+             "The number of files uploaded by each bulk put.")
+            ("rule", po::value<std::string>(&opts.rule)->default_value("*a = 1"),
+             "The rule text executed by the rule_exec workload.")
+            ("rule-engine-instance", po::value<std::string>(&opts.rule_engine_instance),
+             "The rule engine plugin instance which executes the rule.")
+            ("output,o", po::value<std::string>(&opts.output)->default_value("-"),
+             "The file the JSON report is written to. Defaults to stdout.")
+            ("keep-data", po::bool_switch(&opts.keep_data),
+             "Do not remove the data created by the workloads.");
+        // clang-format on
+
+        po::variables_map vm;
+
+        try {
+            po::store(po::parse_command_line(_argc, _argv, desc), vm);
+            po::notify(vm);
+        }
+        catch (const po::error& e) {
+            std::cerr << "error: " << e.what() << '\n';
+            return std::nullopt;
+        }
+
+        if (vm.count("help")) {
+            std::cout << "Usage: irods_benchmark [OPTION]...\n\n"
+                         "Runs workloads against the server defined by the iRODS client environment\n"
+                         "and prints throughput and latency as JSON.\n\n"
+                      << desc << "\nWorkloads:\n"
+                      << workload_list;
+            std::exit(0);
+        }
+
+        if (opts.threads < 1 || opts.object_count < 1 || opts.bulk_file_count < 1 || opts.transfer_threads < 1) {
+            std::cerr << "error: --threads, --object-count, --bulk-file-count and --transfer-threads must be "
+                         "greater than zero.\n";
+            return std::nullopt;
+        }
+
+        if (opts.workloads.empty()) {
+            for (auto&& [name, w] : _workloads) {
+                opts.workloads.push_back(name);
+            }
+        }
+
+        for (auto&& name : opts.workloads) {
+            if (!_workloads.contains(name)) {
+                std::cerr << "error: unknown workload [" << name << "]\n\nWorkloads:\n" << workload_list;
+                return std::nullopt;
+            }
+        }
+
+        return opts;
+    } // parse_options
+} // anonymous namespace
+
+int main(int _argc, char* _argv[])
+{
+    const auto workloads = make_workloads();
+
+    auto opts = parse_options(_argc, _argv, workloads);
+
+    if (!opts) {
+        return 1;
+    }
+
+    load_client_api_plugins();
+
+    rodsEnv env;
+    if (const auto ec = getRodsEnv(&env); ec < 0) {
+        std::cerr << "error: could not read the client environment [" << ec << "]\n";
+        return 1;
+    }
+
+    if (opts->collection.empty()) {
+        opts->collection = fmt::format("{}/irods_benchmark_{}", env.rodsHome, getpid());
+    }
+
+    boost::filesystem::path local_root = opts->local_directory.empty()
+                                             ? boost::filesystem::temp_directory_path() /
+                                                   fmt::format("irods_benchmark_{}", getpid())
+                                             : boost::filesystem::path{opts->local_directory};
+
+    try {
+        // One connection per client thread.
+        auto pool = irods::make_connection_pool(opts->threads);
+
+        irods::at_scope_exit remove_data{[&] {
+            if (opts->keep_data) {
+                return;
+            }
+
+            try {
+                auto conn = pool->get_connection();
+                fs::client::remove_all(conn, opts->collection, fs::remove_options::no_trash);
+                boost::filesystem::remove_all(local_root);
+            }
+            catch (const std::exception& e) {
+                std::cerr << "warning: could not remove benchmark data: " << e.what() << '\n';
+            }
+        }};
+
+        json report{{"host", env.rodsHost},
+                    {"port", env.rodsPort},
+                    {"zone", env.rodsZone},
+                    {"server_version", static_cast<RcComm&>(pool->get_connection()).svrVersion->relVersion},
+                    {"threads", opts->threads},
+                    {"duration_seconds", opts->duration_in_seconds},
+                    {"iterations", opts->iterations},
+                    {"workloads", json::array()}};
+
+        for (auto&& name : opts->workloads) {
+            std::cerr << "running workload [" << name << "] ...\n";
+            const auto& w = workloads.find(name)->second;
+            report["workloads"].push_back(run_workload(*pool, env, *opts, name, w, local_root));
+        }
+
+        if (opts->output == "-") {
+            std::cout << report.dump(4) << '\n';
+        }
+        else {
+            std::ofstream{opts->output} << report.dump(4) << '\n';
+        }
+    }
+    catch (const irods::exception& e) {
+        std::cerr << "error: " << e.client_display_what() << '\n';
+        return 1;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "error: " << e.what() << '\n';
+        return 1;
+    }
+
+    return 0;
+} // main
@@ -390,4 +390,25 @@ auto chl_check_auth_credentials(RsComm& _comm,
                                 const char* _password,
                                 int* _correct) -> int;
 
+/// \brief High-level wrapper for looking up everything needed to open or create a data object.
+///
+/// Returns the parent collection, whether the logical path names a collection, every replica of the
+/// data object and whether the client has the requested access, all from a single statement.
+///
+/// \param[in]     _comm         The communication object.
+/// \param[in]     _logical_path The absolute logical path of the data object.
+/// \param[in]     _access_level The access level to check for (e.g. "read_object").
+/// \param[in,out] _plan         The string that will hold the plan as JSON.
+///
+/// \return An integer.
+/// \retval  0 On success.
+/// \retval SYS_NOT_SUPPORTED If a ticket or strict access control is in effect.
+/// \retval <0 On failure.
+///
+/// \since 4.3.1
+auto chl_get_data_object_open_plan(RsComm& _comm,
+                                   const char* _logical_path,
+                                   const char* _access_level,
+                                   std::string* _plan) -> int;
+
 #endif // IRODS_ICAT_HIGHLEVEL_ROUTINES_HPP
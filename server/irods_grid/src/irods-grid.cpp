@@ -13,6 +13,7 @@
 #include <boost/lexical_cast.hpp>
 
 #include "irods/rodsClient.h"
+#include "irods/api_statistics.hpp"
 #include "irods/irods_server_control_plane.hpp"
 #include "irods/irods_buffer_encryption.hpp"
 #include "irods/server_control_plane_command.hpp"
@@ -27,7 +28,7 @@ irods::error usage(T& ostream) {
     ostream << " " << std::endl;
     ostream << "Sends a message on control channel for possible grid-wide operations" << std::endl;
     ostream << " " << std::endl;
-    ostream << "action: ( required ) status, ping, pause, resume, shutdown" << std::endl;
+    ostream << "action: ( required ) status, metrics, ping, pause, resume, shutdown" << std::endl;
     ostream << " " << std::endl;
     ostream << "option: --force-after=seconds or --wait-forever" << std::endl;
     ostream << " " << std::endl;
@@ -37,9 +38,14 @@ irods::error usage(T& ostream) {
     ostream << " " << std::endl;
     ostream << "Status - returns a status of the server (or servers) requested in a validated" << std::endl;
     ostream << "json document which includes iRODS Server PID, iRODS Server hostname," << std::endl;
-    ostream << "Delay Server PID, Agent PIDs and their age, Server status" << std::endl;
+    ostream << "Delay Server PID, Agent PIDs and their age, Server status, API statistics" << std::endl;
     ostream << " irods-grid status --all" << std::endl;
     ostream << " " << std::endl;
+    ostream << "Metrics - returns the request counts, error counts, bytes transferred and latency" << std::endl;
+    ostream << "histograms of every API handled by the server (or servers) requested in the" << std::endl;
+    ostream << "Prometheus text exposition format" << std::endl;
+    ostream << " irods-grid metrics --all" << std::endl;
+    ostream << " " << std::endl;
     ostream << "Ping - attempt a connection to a server or servers" << std::endl;
     ostream << " irods-grid ping --all" << std::endl;
     ostream << " " << std::endl;
@@ -67,7 +73,7 @@ irods::error parse_program_options(
     // clang-format off
     po::options_description opt_desc( "options" );
     opt_desc.add_options()
-    ( "action", "either 'status', 'ping', 'shutdown', 'pause', or 'resume'" )
+    ( "action", "either 'status', 'metrics', 'ping', 'shutdown', 'pause', or 'resume'" )
     ( "help,h", "show command usage" )
     ( "all", "operation applies to all servers in the grid" )
     ( "hosts", po::value<std::string>(), "operation applies to a list of hosts in the grid" )
@@ -75,6 +81,7 @@ irods::error parse_program_options(
     ( "wait-forever", "wait indefinitely for a graceful shutdown" )
     ( "ping", "attempt a connection to a server(s)" )
     ( "status", "display status a server(s)" )
+    ( "metrics", "display API statistics of a server(s) in Prometheus format" )
     ( "shutdown", "gracefully shutdown a server(s)" )
     ( "pause", "refuse new client connections" )
     ( "reload", "Reload a server(s) configuration")
@@ -111,6 +118,7 @@ irods::error parse_program_options(
             boost::unordered_map< std::string, std::string > cmd_map;
             // clang-format off
             cmd_map[ "status"   ] = irods::SERVER_CONTROL_STATUS;
+            cmd_map[ "metrics"  ] = irods::SERVER_CONTROL_METRICS;
             cmd_map[ "ping"     ] = irods::SERVER_CONTROL_PING;
             cmd_map[ "pause"    ] = irods::SERVER_CONTROL_PAUSE;
             cmd_map[ "resume"   ] = irods::SERVER_CONTROL_RESUME;
@@ -323,6 +331,28 @@ std::string format_grid_message( const std::string& _status)
 
 } // format_grid_message
 
+std::string format_metrics_message(const std::string& _status)
+{
+    namespace stats = irods::experimental::api_statistics;
+
+    const auto obj = nlohmann::json::parse(format_grid_message(_status));
+
+    std::vector<stats::host_counters> hosts;
+
+    try {
+        for (auto&& host : obj.at("hosts")) {
+            hosts.push_back({host.at("hostname").get<std::string>(),
+                             host.at("api_statistics").get<std::vector<stats::api_counters>>()});
+        }
+    }
+    catch (const nlohmann::json::exception& e) {
+        THROW(-1, std::string{"unexpected metrics response: "} + e.what());
+    }
+
+    return stats::to_prometheus_text(hosts);
+
+} // format_metrics_message
+
 irods::error get_and_verify_client_environment(
     rodsEnv& _env ) {
     _getRodsEnv( _env );
@@ -456,8 +486,13 @@ int main(
 
         if ( irods::SERVER_CONTROL_SUCCESS != rep_str ) {
             try {
-                rep_str = format_grid_message( rep_str );
-                std::cout << rep_str << std::endl;
+                if (irods::SERVER_CONTROL_METRICS == cmd.command) {
+                    std::cout << format_metrics_message(rep_str);
+                }
+                else {
+                    rep_str = format_grid_message( rep_str );
+                    std::cout << rep_str << std::endl;
+                }
             } catch ( const irods::exception& e_ ) {
                 std::cerr << e_.message_stack()[0];
             }
@@ -1,10 +1,12 @@
 #include "irods/irods_server_control_plane.hpp"
 
+#include "irods/api_statistics.hpp"
 #include "irods/genQuery.h"
 #include "irods/irods_buffer_encryption.hpp"
 #include "irods/irods_exception.hpp"
 #include "irods/irods_logger.hpp"
 #include "irods/irods_resource_manager.hpp"
+#include "irods/irods_server_api_table.hpp"
 #include "irods/irods_server_properties.hpp"
 #include "irods/irods_server_state.hpp"
 #include "irods/irods_stacktrace.hpp"
@@ -342,6 +344,23 @@ namespace irods
         return static_cast<int>(age);
     } // get_pid_age
 
+    // Returns the API statistics recorded by the agents of this server.
+    static auto get_api_statistics() -> nlohmann::json
+    {
+        namespace stats = irods::experimental::api_statistics;
+
+        auto counters = stats::snapshot();
+        auto& api_table = get_server_api_table();
+
+        for (auto&& c : counters) {
+            if (const auto iter = api_table.find(c.api_number); iter != std::end(api_table) && iter->second) {
+                c.api_name = iter->second->operation_name;
+            }
+        }
+
+        return counters;
+    } // get_api_statistics
+
     static error operation_status(
         const std::string&, // _wait_option,
         const size_t,       // _wait_seconds,
@@ -375,6 +394,7 @@ namespace irods
         }
 
         obj["agents"] = arr;
+        obj["api_statistics"] = get_api_statistics();
 
         _output += obj.dump(4);
         _output += ",";
@@ -382,6 +402,21 @@ namespace irods
         return SUCCESS();
     } // operation_status
 
+    static auto operation_metrics(const std::string&, // _wait_option
+                                  const size_t,       // _wait_seconds
+                                  std::string& _output) -> error
+    {
+        rodsEnv my_env;
+        _reloadRodsEnv(my_env);
+
+        const nlohmann::json obj{{"hostname", my_env.rodsHost}, {"api_statistics", get_api_statistics()}};
+
+        _output += obj.dump(4);
+        _output += ",";
+
+        return SUCCESS();
+    } // operation_metrics
+
     static error operation_ping(
         const std::string&, // _wait_option,
         const size_t,       // _wait_seconds,
@@ -461,6 +496,7 @@ namespace irods
         op_map_[SERVER_CONTROL_STATUS] = operation_status;
         op_map_[SERVER_CONTROL_PING]   = operation_ping;
         op_map_[SERVER_CONTROL_RELOAD] = operation_reload;
+        op_map_[SERVER_CONTROL_METRICS] = operation_metrics;
         if (_prop == KW_CFG_RULE_ENGINE_CONTROL_PLANE_PORT) {
             op_map_[SERVER_CONTROL_SHUTDOWN] = rule_engine_operation_shutdown;
         }
@@ -1,7 +1,9 @@
 #include "irods/rodsServer.hpp"
 
+#include "irods/api_statistics.hpp"
 #include "irods/client_api_allowlist.hpp"
 #include "irods/client_connection.hpp"
+#include "irods/connection_broker.hpp"
 #include "irods/irods_at_scope_exit.hpp"
 #include "irods/irods_buffer_encryption.hpp"
 #include "irods/irods_configuration_keywords.hpp"
@@ -26,7 +28,9 @@
 #include "irods/irods_logger.hpp"
 #include "irods/hostname_cache.hpp"
 #include "irods/dns_cache.hpp"
+#include "irods/load_digest_cache.hpp"
 #include "irods/server_utilities.hpp"
+#include "irods/tracing.hpp"
 #include "irods/process_manager.hpp"
 #include "irods/irods_default_paths.hpp"
 #include "irods/irods_signal.hpp"
@@ -119,6 +123,9 @@ pid_t agent_spawning_pid{};
 char unix_domain_socket_directory[] = "/tmp/irods_sockets_XXXXXX";
 char agent_factory_socket_file[sizeof(sockaddr_un::sun_path)]{};
 
+pid_t connection_broker_pid{};
+char connection_broker_socket_file[sizeof(sockaddr_un::sun_path)]{};
+
 unsigned int ServerBootTime;
 int SvrSock;
 
@@ -422,6 +429,30 @@ namespace
         return _default;
     } // get_cache_clearer_sleep_time
 
+    auto get_connection_pool_setting(const char* _keyword, int _default) -> int
+    {
+        try {
+            const auto config_handle = irods::server_properties::instance().map();
+            const auto& adv_settings = config_handle.get_json().at(irods::KW_CFG_ADVANCED_SETTINGS);
+
+            const auto pool_iter = adv_settings.find(irods::KW_CFG_SERVER_TO_SERVER_CONNECTION_POOL);
+
+            if (pool_iter != std::end(adv_settings)) {
+                const auto iter = pool_iter->find(_keyword);
+
+                if (iter != std::end(*pool_iter)) {
+                    if (const auto val = iter->get<int>(); val >= 0) {
+                        return val;
+                    }
+                }
+            }
+        }
+        catch (...) {
+        }
+
+        return _default;
+    } // get_connection_pool_setting
+
     void log_stacktrace_files()
     {
         namespace fs = boost::filesystem;
@@ -1254,6 +1285,14 @@ int main(int argc, char** argv)
     dnsc::init("irods_dns_cache", irods::get_dns_cache_shared_memory_size());
     irods::at_scope_exit deinit_dns_cache{[] { dnsc::deinit(); }};
 
+    namespace ldc = irods::experimental::load_digest_cache;
+    ldc::init("irods_load_digest_cache");
+    irods::at_scope_exit deinit_load_digest_cache{[] { ldc::deinit(); }};
+
+    namespace api_stats = irods::experimental::api_statistics;
+    api_stats::init("irods_api_statistics");
+    irods::at_scope_exit deinit_api_statistics{[] { api_stats::deinit(); }};
+
     ix::replica_access_table::init();
     irods::at_scope_exit deinit_replica_access_table{[] { ix::replica_access_table::deinit(); }};
 
@@ -1298,6 +1337,66 @@ int main(int argc, char** argv)
     local_addr.sun_family = AF_UNIX;
     std::snprintf(local_addr.sun_path, sizeof(local_addr.sun_path), "%s", agent_factory_socket_file);
 
+    // The connection broker is disabled unless the administrator allows it to hold idle connections.
+    const auto max_idle_connections =
+        get_connection_pool_setting(irods::KW_CFG_MAX_IDLE_CONNECTIONS, 0);
+    const auto idle_timeout_in_seconds =
+        get_connection_pool_setting(irods::KW_CFG_IDLE_TIMEOUT_IN_SECONDS, 60);
+
+    if (max_idle_connections > 0) {
+        log_server::info("Setting up UNIX domain socket for connection broker ...");
+        get64RandomBytes(random_suffix);
+        std::snprintf(connection_broker_socket_file, sizeof(connection_broker_socket_file), "%s/irods_broker_%s", unix_domain_socket_directory, random_suffix);
+
+        // Agents inherit the environment through the agent factory. This must be set before the
+        // agent factory is launched.
+        setenv(irods::connection_broker::socket_path_env_var, connection_broker_socket_file, 1);
+    }
+
+    const auto launch_connection_broker = [&] {
+        try {
+            if (max_idle_connections <= 0) {
+                return;
+            }
+
+            // Return immediately if the connection broker exists.
+            if (connection_broker_pid > 0 && waitpid(connection_broker_pid, nullptr, WNOHANG) != -1) {
+                return;
+            }
+
+            log_server::info("Forking connection broker ...");
+
+            connection_broker_pid = fork();
+
+            if (connection_broker_pid == 0) {
+                close(pid_file_fd);
+
+                try {
+                    const auto ec = irods::connection_broker::run(connection_broker_socket_file,
+                                                                  static_cast<std::size_t>(max_idle_connections),
+                                                                  std::chrono::seconds{idle_timeout_in_seconds});
+
+#if __has_feature(address_sanitizer) || defined(__SANITIZE_ADDRESS__)
+                    __lsan_do_leak_check();
+#endif
+
+                    // See the agent factory (below) for why _exit() is used here.
+                    _exit(ec == 0 ? 0 : 1);
+                }
+                catch (...) {
+                    _exit(1);
+                }
+            }
+            else if (connection_broker_pid < 0) {
+                log_server::error("Error forking connection broker, errno = [{}]: {}", errno, strerror(errno));
+                connection_broker_pid = 0;
+            }
+        }
+        catch (...) {
+            // Do not allow exceptions to escape the CRON task!
+        }
+    }; // launch_connection_broker
+
     const auto launch_agent_factory = [&] {
         try {
             // Return immediately if the agent factory exists.
@@ -1384,11 +1483,15 @@ int main(int argc, char** argv)
         }
     }; // launch_agent_factory
 
+    launch_connection_broker();
     launch_agent_factory();
     ix::cron::cron_builder agent_watcher;
     const auto agent_factory_watcher_sleep_time_in_seconds =
         get_advanced_setting(irods::KW_CFG_AGENT_FACTORY_WATCHER_SLEEP_TIME_IN_SECONDS, 5);
-    agent_watcher.interval(agent_factory_watcher_sleep_time_in_seconds).task(launch_agent_factory);
+    agent_watcher.interval(agent_factory_watcher_sleep_time_in_seconds).task([&] {
+        launch_connection_broker();
+        launch_agent_factory();
+    });
     ix::cron::cron::instance().add_task(agent_watcher.build());
 
     {
@@ -1511,6 +1614,16 @@ int main(int argc, char** argv)
                 log_server::info(
                     "Agent factory has completed shutdown [exit_code={}].", WEXITSTATUS(agent_factory_status));
 
+                // Shut down the connection broker after the agents so that it does not miss
+                // connections released by agents that are still exiting.
+                if (connection_broker_pid > 0) {
+                    kill(connection_broker_pid, SIGTERM);
+                    int connection_broker_status = 0;
+                    waitpid(connection_broker_pid, &connection_broker_status, 0);
+                    log_server::info("Connection broker has completed shutdown [exit_code={}].",
+                                     WEXITSTATUS(connection_broker_status));
+                }
+
                 log_server::info("iRODS Server is exiting with state [{}].", to_string(state));
                 break;
             }
@@ -1617,6 +1730,7 @@ int main(int argc, char** argv)
 
     close(agent_conn_socket);
     unlink(agent_factory_socket_file);
+    unlink(connection_broker_socket_file);
     rmdir(unix_domain_socket_directory);
 
     log_server::info("iRODS Server is done.");
@@ -1630,11 +1744,16 @@ void serverExit(int _signal)
 
     close(agent_conn_socket);
     unlink(agent_factory_socket_file);
+    unlink(connection_broker_socket_file);
     rmdir(unix_domain_socket_directory);
 
     // Wake and terminate agent spawning process
     kill(agent_spawning_pid, SIGTERM);
 
+    if (connection_broker_pid > 0) {
+        kill(connection_broker_pid, SIGTERM);
+    }
+
 #if __has_feature(address_sanitizer) || defined(__SANITIZE_ADDRESS__)
     // Calling this function is likely not async-signal-safe, but it is okay because
     // the code has been compiled with Address Sanitizer enabled. For that reason,
@@ -1945,9 +2064,19 @@ int execAgent(int newSock, startupPack_t* startupPack)
         log_server::error("Failed to send SP_API_VERSION to agent");
     }
 
+    std::string opt_str(startupPack->option);
+
+    // Hand the trace context of the client to the agent separately from the option string.
+    if (const auto trace_context = ix::tracing::extract_from_startup_option(opt_str); trace_context) {
+        const auto traceparent = ix::tracing::to_traceparent(*trace_context);
+        status = sendEnvironmentVarStrToSocket(SP_TRACE_PARENT, traceparent.c_str(), tmp_socket);
+        if (status < 0) {
+            log_server::error("Failed to send SP_TRACE_PARENT to agent");
+        }
+    }
+
     // If the client-server negotiation request is in the option variable, set that env var
     // and strip it out
-    std::string opt_str(startupPack->option);
     std::size_t pos = opt_str.find(REQ_SVR_NEG);
     if (std::string::npos != pos) {
         std::string trunc_str = opt_str.substr(0, pos);
@@ -1963,7 +2092,7 @@ int execAgent(int newSock, startupPack_t* startupPack)
         }
     }
     else {
-        status = sendEnvironmentVarStrToSocket(SP_OPTION, startupPack->option, tmp_socket);
+        status = sendEnvironmentVarStrToSocket(SP_OPTION, opt_str.c_str(), tmp_socket);
         if (status < 0) {
             log_server::error("Failed to send SP_OPTION to agent");
         }
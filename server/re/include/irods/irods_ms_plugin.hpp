@@ -3,7 +3,12 @@
 
 // =-=-=-=-=-=-=-
 // STL Includes
+#include <cstddef>
+#include <functional>
 #include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 // =-=-=-=-=-=-=-
 // dlopen, etc
@@ -30,6 +35,11 @@ namespace irods {
 
             typedef int ( *ms_func_ptr )( ... );
 
+            /// \brief Invokes the microservice with the arguments collected by the rule engine.
+            ///
+            /// \since 4.3.0
+            using invoker_type = std::function<int(ruleExecInfo_t*, std::vector<msParam_t*>&)>;
+
             // =-=-=-=-=-=-=-
             // Attributes
 
@@ -50,6 +60,19 @@ namespace irods {
                 unsigned int,                // num ms args
                 boost::any );       // function pointer
 
+            // =-=-=-=-=-=-=-
+            // NOTE :: called internally for static plugins
+            //         with a known signature
+            template<typename... types_t>
+            ms_table_entry(
+                const std::string&              _name,
+                unsigned int                    _num_args,
+                std::function<int(types_t...)> _fcn )
+                : ms_table_entry( _name, _num_args, boost::any( _fcn ) )
+            {
+                invoker_ = make_invoker( std::move( _fcn ) );
+            } // ctor
+
             // =-=-=-=-=-=-=-
             // copy ctor
             ms_table_entry( const ms_table_entry& _rhs );
@@ -81,6 +104,7 @@ namespace irods {
 
                     operation_name_ = _op;
                     operations_[operation_name_] = _f;
+                    invoker_ = make_invoker( std::move( _f ) );
 
                     return SUCCESS();
 
@@ -118,9 +142,53 @@ namespace irods {
             unsigned int num_args() { return num_args_; }
 
         private:
+            // Matches the signatures microservices are written with: any number of msParam_t*
+            // followed by the ruleExecInfo_t*.
+            template<typename... types_t>
+            struct is_microservice_signature : std::false_type {};
+
+            template<typename... types_t>
+            struct is_microservice_signature<msParam_t*, types_t...> : is_microservice_signature<types_t...> {};
+
+            template<typename... types_t>
+            struct is_microservice_signature<ruleExecInfo_t*, types_t...>
+                : std::bool_constant<sizeof...(types_t) == 0> {};
+
+            template<typename... types_t>
+            static invoker_type make_invoker( std::function<int(types_t...)> _f ) {
+                if constexpr ( is_microservice_signature<types_t...>::value ) {
+                    constexpr auto arity = sizeof...( types_t ) - 1;
+
+                    return [f = std::move( _f )]( ruleExecInfo_t* _rei, std::vector<msParam_t*>& _params ) {
+                        if ( _params.size() != arity ) {
+                            return static_cast<int>( SYS_INVALID_INPUT_PARAM );
+                        }
+
+                        return invoke( f, _rei, _params, std::make_index_sequence<arity>{} );
+                    };
+                }
+                else {
+                    // Anything else can only be called through call_handler().
+                    return {};
+                }
+            } // make_invoker
+
+            template<typename function_type, std::size_t... indices>
+            static int invoke(
+                const function_type&     _f,
+                ruleExecInfo_t*          _rei,
+                std::vector<msParam_t*>& _params,
+                std::index_sequence<indices...> ) {
+                return _f( _params[indices]..., _rei );
+            } // invoke
+
             std::string operation_name_;
             unsigned int num_args_;
 
+            // Calls the operation directly, without looking it up by name. Empty when the
+            // operation was added through the untyped constructor.
+            invoker_type invoker_;
+
     }; // class ms_table_entry
 
 // =-=-=-=-=-=-=-
@@ -132,6 +200,19 @@ namespace irods {
 // and then register that ms with the table
     error load_microservice_plugin( ms_table& _table, const std::string& _ms );
 
+    /// \brief Returns the table entry of a microservice, loading its plugin if necessary.
+    ///
+    /// Entries are owned by the microservice table and live as long as the agent, so the
+    /// returned pointer may be kept and called repeatedly. Names that cannot be loaded are
+    /// remembered and not searched for again until the rule engine plugins are restarted.
+    ///
+    /// \param[in] _name The name of the microservice.
+    ///
+    /// \return The entry, or nullptr if the name is reserved for rules or no plugin provides it.
+    ///
+    /// \since 4.3.0
+    auto resolve_microservice(const std::string& _name) -> ms_table_entry*;
+
 
 }; // namespace irods
 
@@ -7,6 +7,7 @@
 #include "irods/irods_re_structs.hpp"
 #include "irods/irods_state_table.h"
 
+#include <cstdint>
 #include <iostream>
 #include <list>
 #include <vector>
@@ -387,6 +388,19 @@ namespace irods {
 
     };
 
+    /// \brief Returns a value that changes whenever rule engine plugins are loaded, started or stopped.
+    ///
+    /// Anything derived from the set of rules that exist (e.g. whether a PEP is defined) is only
+    /// valid for the generation it was computed in. The first generation is 1.
+    ///
+    /// \since 4.3.0
+    auto get_rule_engine_generation() noexcept -> std::uint64_t;
+
+    /// \brief Invalidates everything computed for the current rule engine generation.
+    ///
+    /// \since 4.3.0
+    auto increment_rule_engine_generation() noexcept -> void;
+
     // load rule engines from plugins DONE
     template<typename T, typename C>
     class rule_engine_manager final {
@@ -398,6 +412,8 @@ namespace irods {
                     irods::log( PASS( err ) );
                 }
             });
+
+            increment_rule_engine_generation();
         }
 
         ~rule_engine_manager() {
@@ -422,12 +438,16 @@ namespace irods {
             std::for_each(begin(re_packs_), end(re_packs_), [](re_pack_inp<T> &_inp) {
                 _inp.re_->start_operation(_inp.re_ctx_);
             });
+
+            increment_rule_engine_generation();
         }
 
         void call_stop_operations() {
             std::for_each(begin(re_packs_), end(re_packs_), [](re_pack_inp<T> &_inp) {
                 _inp.re_->stop_operation(_inp.re_ctx_);
             });
+
+            increment_rule_engine_generation();
         }
 
         microservice_manager<C> &ms_mgr_;
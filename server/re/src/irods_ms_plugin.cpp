@@ -43,7 +43,8 @@ namespace irods {
         const ms_table_entry& _rhs ) :
         plugin_base( _rhs ),
         operation_name_( _rhs.operation_name_ ),
-        num_args_( _rhs.num_args_ ) {
+        num_args_( _rhs.num_args_ ),
+        invoker_( _rhs.invoker_ ) {
     } // cctor
 
     ms_table_entry& ms_table_entry::operator=(
@@ -51,6 +52,7 @@ namespace irods {
         plugin_base::operator=( _rhs );
         num_args_       = _rhs.num_args_;
         operation_name_ = _rhs.operation_name_;
+        invoker_        = _rhs.invoker_;
         return *this;
     } // operator=
 
@@ -64,6 +66,10 @@ namespace irods {
             return SYS_INVALID_INPUT_PARAM;
         }
 
+        if ( invoker_ ) {
+            return invoker_( _rei, _params );
+        }
+
         int status = 0;
         if ( _params.size() == 0 ) {
             status = call_handler<ruleExecInfo_t*>( _rei );
@@ -5,16 +5,31 @@
 #include "irods/irods_exception.hpp"
 #include "irods/irods_ms_plugin.hpp"
 
+#include <atomic>
 #include <vector>
 
 #include <boost/any.hpp>
-int actionTableLookUp( irods::ms_table_entry& _entry, char* _action );
 
 namespace irods{
 
     // extern variable for the re plugin globals
     std::unique_ptr<struct global_re_plugin_mgr> re_plugin_globals;
 
+    namespace
+    {
+        std::atomic<std::uint64_t> g_rule_engine_generation{1};
+    } // anonymous namespace
+
+    auto get_rule_engine_generation() noexcept -> std::uint64_t
+    {
+        return g_rule_engine_generation.load();
+    } // get_rule_engine_generation
+
+    auto increment_rule_engine_generation() noexcept -> void
+    {
+        ++g_rule_engine_generation;
+    } // increment_rule_engine_generation
+
     void var_arg_to_list(std::list<boost::any>& _l) {
         (void) _l;
     }
@@ -105,10 +120,8 @@ namespace irods{
             msParam_t msParams[10];
         } ar;
 
-        irods::ms_table_entry ms_entry;
-        int actionInx;
-        actionInx = actionTableLookUp( ms_entry,const_cast<char*>( msName .c_str()));
-        if ( actionInx < 0 ) {
+        irods::ms_table_entry* ms_entry = resolve_microservice( msName );
+        if ( !ms_entry ) {
             return ERROR( NO_MICROSERVICE_FOUND_ERR, "default_microservice_manager: no microservice found " + msName);
         }
 
@@ -122,13 +135,13 @@ namespace irods{
             i++;
         }
 
-        unsigned int numOfStrArgs = ms_entry.num_args();
+        unsigned int numOfStrArgs = ms_entry->num_args();
         if ( nargs != numOfStrArgs ) {
             return ERROR( ACTION_ARG_COUNT_MISMATCH, "execMicroService3: wrong number of arguments");
         }
 
         std::vector<msParam_t *> &myArgv = ar.myArgv;
-        int status = ms_entry.call( rei, myArgv );
+        int status = ms_entry->call( rei, myArgv );
         if ( status < 0 ) {
             return ERROR(status,"exec_microservice_adapter failed");
         }
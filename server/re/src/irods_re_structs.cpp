@@ -26,40 +26,75 @@
 #define IRODS_IO_TRANSPORT_ENABLE_SERVER_SIDE_API
 #include "irods/transport/default_transport.hpp"
 
+#include <cstdint>
 #include <list>
+#include <unordered_set>
 
 extern int ProcessType;
 
 extern const packInstruct_t RodsPackTable[];
 irods::ms_table& get_microservice_table();
 
+namespace
+{
+    // Names that no microservice plugin provides. Loading a plugin searches the plugin directory
+    // and attempts a dlopen, so failures are remembered instead of being retried on every call.
+    std::unordered_set<std::string> g_unresolved_microservices;
+
+    // The rule engine generation g_unresolved_microservices was built in.
+    std::uint64_t g_unresolved_microservices_generation = 0;
+} // anonymous namespace
+
+auto irods::resolve_microservice(const std::string& _name) -> ms_table_entry*
+{
+    if ( _name.size() >= 2 && _name[0] == 'a' && _name[1] == 'c' ) {
+        return nullptr;
+    }
+
+    irods::ms_table& MicrosTable = get_microservice_table();
+
+    if ( const auto iter = MicrosTable.find( _name ); iter != MicrosTable.end() ) {
+        return iter->second;
+    }
+
+    // A restart of the rule engine plugins is when new microservice plugins are expected to appear.
+    if ( const auto generation = get_rule_engine_generation(); generation != g_unresolved_microservices_generation ) {
+        g_unresolved_microservices.clear();
+        g_unresolved_microservices_generation = generation;
+    }
+
+    if ( g_unresolved_microservices.count( _name ) > 0 ) {
+        return nullptr;
+    }
+
+    rodsLog( LOG_DEBUG, "resolve_microservice - [%s] not found, load it.", _name.c_str() );
+    irods::error ret = irods::load_microservice_plugin( MicrosTable, _name );
+    if ( !ret.ok() ) {
+        irods::log( PASS( ret ) );
+        g_unresolved_microservices.insert( _name );
+        return nullptr;
+    }
+
+    rodsLog( LOG_DEBUG, "resolve_microservice - loaded [%s]", _name.c_str() );
+
+    return MicrosTable[ _name ];
+} // resolve_microservice
+
 // =-=-=-=-=-=-=-
 // function to look up and / or load a microservice for execution
 int actionTableLookUp( irods::ms_table_entry& _entry, char* _action ) {
-    irods::ms_table& MicrosTable = get_microservice_table();
-
     std::string str_act( _action );
 
     if ( str_act[0] == 'a' && str_act[1] == 'c' ) {
         return -1;
     }
 
-    // =-=-=-=-=-=-=
-    // look up Action in microservice table.  If it returns
-    // the end() iterator, is is not found so try to load it.
-    if ( !MicrosTable.has_entry( str_act ) ) {
-        rodsLog( LOG_DEBUG, "actionTableLookUp - [%s] not found, load it.", _action );
-        irods::error ret = irods::load_microservice_plugin( MicrosTable, str_act );
-        if ( !ret.ok() ) {
-            irods::log( PASS( ret ) );
-            return UNMATCHED_ACTION_ERR;
-        }
-        else {   // if loaded
-            rodsLog( LOG_DEBUG, "actionTableLookUp - loaded [%s]", _action );
-        } // else
-    }  // if not found
+    auto* entry = irods::resolve_microservice( str_act );
+    if ( !entry ) {
+        return UNMATCHED_ACTION_ERR;
+    }
 
-    _entry = *MicrosTable[ str_act ];
+    _entry = *entry;
 
     return 0;
 
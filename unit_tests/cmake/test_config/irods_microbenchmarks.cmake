@@ -0,0 +1,12 @@
+set(IRODS_TEST_TARGET irods_microbenchmarks)
+
+set(IRODS_TEST_SOURCE_FILES ${CMAKE_CURRENT_SOURCE_DIR}/src/main.cpp
+                            ${CMAKE_CURRENT_SOURCE_DIR}/src/test_microbenchmarks.cpp)
+
+set(IRODS_TEST_INCLUDE_PATH ${IRODS_EXTERNALS_FULLPATH_BOOST}/include
+                            ${IRODS_EXTERNALS_FULLPATH_FMT}/include)
+
+set(IRODS_COMPILE_DEFINITIONS_PRIVATE CATCH_CONFIG_ENABLE_BENCHMARKING)
+
+set(IRODS_TEST_LINK_LIBRARIES irods_common
+                              "${IRODS_EXTERNALS_FULLPATH_FMT}/lib/libfmt.so")
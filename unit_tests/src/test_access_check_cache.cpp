@@ -0,0 +1,142 @@
+#include <catch2/catch.hpp>
+
+#include "irods/access_check_cache.hpp"
+
+#include <chrono>
+#include <string>
+#include <thread>
+
+namespace acc = irods::access_check_cache;
+
+using namespace std::chrono_literals;
+
+namespace
+{
+    // Mimics the way the mid-level routines consult the cache before querying the catalog.
+    auto check(const acc::key& _key, rodsLong_t _object_id, std::uint64_t _queries = 1) -> rodsLong_t
+    {
+        if (const auto cached = acc::lookup(_key, _queries); cached) {
+            return cached->object_id;
+        }
+
+        acc::insert(_key, {_object_id, -1});
+
+        return _object_id;
+    }
+
+    auto collection_key(const std::string& _path) -> acc::key
+    {
+        return {acc::check_type::collection, _path, "alice", "tempZone", "delete object"};
+    }
+
+    auto data_object_key(const std::string& _path) -> acc::key
+    {
+        return {acc::check_type::data_object, _path, "alice", "tempZone", "delete object"};
+    }
+} // anonymous namespace
+
+TEST_CASE("access_check_cache")
+{
+    acc::configure(100, 60s);
+
+    SECTION("decisions are keyed by user and access level")
+    {
+        check(collection_key("/tempZone/home/alice"), 10);
+        REQUIRE(acc::lookup(collection_key("/tempZone/home/alice")));
+
+        auto other_user = collection_key("/tempZone/home/alice");
+        other_user.user_name = "bob";
+        REQUIRE_FALSE(acc::lookup(other_user));
+
+        auto other_level = collection_key("/tempZone/home/alice");
+        other_level.access_level = "own";
+        REQUIRE_FALSE(acc::lookup(other_level));
+    }
+
+    SECTION("erase drops the target and everything beneath it")
+    {
+        check(collection_key("/tempZone/home/alice/dir"), 10);
+        check(collection_key("/tempZone/home/alice/dir/sub"), 11);
+        check(data_object_key("/tempZone/home/alice/dir/sub/file"), 12);
+        check(collection_key("/tempZone/home/alice/dir-2"), 13);
+        check(collection_key("/tempZone/home/alice/dir0"), 14);
+        check({acc::check_type::data_object_id, "12", "alice", "tempZone", "read object"}, 12);
+        REQUIRE(acc::size() == 6);
+
+        acc::erase("/tempZone/home/alice/dir");
+        REQUIRE(acc::size() == 3);
+        REQUIRE(acc::lookup(collection_key("/tempZone/home/alice/dir-2")));
+        REQUIRE(acc::lookup(collection_key("/tempZone/home/alice/dir0")));
+
+        acc::erase("12");
+        REQUIRE(acc::size() == 2);
+
+        acc::clear();
+        REQUIRE(acc::size() == 0);
+    }
+
+    SECTION("decisions expire")
+    {
+        acc::configure(100, 1s);
+
+        check(collection_key("/tempZone/home/alice"), 10);
+        REQUIRE(acc::lookup(collection_key("/tempZone/home/alice")));
+
+        std::this_thread::sleep_for(1100ms);
+        REQUIRE_FALSE(acc::lookup(collection_key("/tempZone/home/alice")));
+        REQUIRE(acc::size() == 0);
+    }
+
+    SECTION("the number of decisions is bounded")
+    {
+        acc::configure(10, 60s);
+
+        for (int i = 0; i < 25; ++i) {
+            check(data_object_key("/tempZone/home/alice/file" + std::to_string(i)), i);
+            REQUIRE(acc::size() <= 10);
+        }
+    }
+
+    SECTION("a zero lifetime disables the cache")
+    {
+        acc::configure(100, 0s);
+
+        check(collection_key("/tempZone/home/alice"), 10);
+        REQUIRE(acc::size() == 0);
+        REQUIRE_FALSE(acc::lookup(collection_key("/tempZone/home/alice")));
+    }
+
+    SECTION("catalog queries avoided during a recursive remove")
+    {
+        constexpr auto data_object_count = 1000;
+        const std::string collection = "/tempZone/home/alice/dir";
+        const auto before = acc::get_statistics();
+
+        // Removing each data object checks the data object, its parent collection and a group
+        // membership. Only the first check of the collection and of the membership reach the catalog.
+        for (int i = 0; i < data_object_count; ++i) {
+            const auto path = collection + "/file" + std::to_string(i);
+            check(data_object_key(path), 100 + i);
+            check(collection_key(collection), 10);
+            check({acc::check_type::group_membership, "rodsadmin", "alice", "tempZone", ""}, 20, 2);
+
+            // The agent unregistered the data object.
+            acc::erase(path);
+        }
+
+        acc::erase(collection);
+
+        const auto after = acc::get_statistics();
+        const auto hits = after.hits - before.hits;
+        const auto misses = after.misses - before.misses;
+        const auto queries_avoided = after.queries_avoided - before.queries_avoided;
+
+        UNSCOPED_INFO("hits=" << hits << ", misses=" << misses << ", queries_avoided=" << queries_avoided);
+        CHECK(misses == data_object_count + 2);
+        CHECK(hits == 2 * (data_object_count - 1));
+        CHECK(queries_avoided == 3 * (data_object_count - 1));
+        CHECK(acc::size() == 1);
+    }
+
+    acc::configure(0, 0s);
+}
@@ -0,0 +1,180 @@
+#include <catch2/catch.hpp>
+
+#include "irods/api_statistics.hpp"
+#include "irods/irods_at_scope_exit.hpp"
+
+#include <chrono>
+#include <numeric>
+#include <string>
+
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace stats = irods::experimental::api_statistics;
+
+using namespace std::chrono_literals;
+
+namespace
+{
+    auto find_api(const std::vector<stats::api_counters>& _counters, int _api_number) -> const stats::api_counters*
+    {
+        for (auto&& c : _counters) {
+            if (c.api_number == _api_number) {
+                return &c;
+            }
+        }
+
+        return nullptr;
+    }
+} // anonymous namespace
+
+TEST_CASE("api_statistics")
+{
+    REQUIRE_FALSE(stats::record(700, 0, 1, 1, 1us));
+
+    stats::init("irods_api_statistics_test");
+    irods::at_scope_exit cleanup{[] { stats::deinit(); }};
+
+    SECTION("requests, errors and bytes are counted per API number")
+    {
+        REQUIRE(stats::record(700, 0, 100, 10, 5us));
+        REQUIRE(stats::record(700, -1, 50, 0, 3us));
+        REQUIRE(stats::record(20000, 0, 1, 2, 1ms));
+        REQUIRE_FALSE(stats::record(0, 0, 1, 2, 1ms));
+
+        const auto counters = stats::snapshot();
+        REQUIRE(counters.size() == 2);
+        CHECK(counters[0].api_number == 700);
+        CHECK(counters[1].api_number == 20000);
+
+        const auto& c = counters[0];
+        CHECK(c.requests == 2);
+        CHECK(c.errors == 1);
+        CHECK(c.bytes_in == 150);
+        CHECK(c.bytes_out == 10);
+        CHECK(c.latency_sum_in_microseconds == 8);
+    }
+
+    SECTION("latencies are counted in power-of-two buckets")
+    {
+        stats::record(701, 0, 0, 0, 0us);
+        stats::record(701, 0, 0, 0, 1us);
+        stats::record(701, 0, 0, 0, 3us);
+        stats::record(701, 0, 0, 0, 4us);
+        stats::record(701, 0, 0, 0, 1h);
+
+        const auto counters = stats::snapshot();
+        const auto* c = find_api(counters, 701);
+        REQUIRE(c);
+
+        const auto& buckets = c->latency_buckets;
+        CHECK(buckets[0] == 1); // < 1us
+        CHECK(buckets[1] == 1); // < 2us
+        CHECK(buckets[2] == 1); // < 4us
+        CHECK(buckets[3] == 1); // < 8us
+        CHECK(buckets.back() == 1);
+        CHECK(std::accumulate(std::begin(buckets), std::end(buckets), std::uint64_t{0}) == c->requests);
+    }
+
+    SECTION("api numbers which collide in the table get their own slot")
+    {
+        // The table holds 1024 slots, so these hash to the same starting slot.
+        stats::record(702, 0, 0, 0, 1us);
+        stats::record(702 + 1024, 0, 0, 0, 1us);
+        stats::record(702 + 1024, 0, 0, 0, 1us);
+
+        const auto counters = stats::snapshot();
+        REQUIRE(find_api(counters, 702));
+        REQUIRE(find_api(counters, 702 + 1024));
+        CHECK(find_api(counters, 702)->requests == 1);
+        CHECK(find_api(counters, 702 + 1024)->requests == 2);
+    }
+
+    SECTION("requests recorded by child processes are visible to the parent")
+    {
+        constexpr auto child_count = 4;
+        constexpr auto requests_per_child = 1000;
+
+        for (int i = 0; i < child_count; ++i) {
+            if (const auto pid = fork(); pid == 0) {
+                for (int j = 0; j < requests_per_child; ++j) {
+                    stats::record(703, 0, 1, 1, 10us);
+                }
+
+                _exit(0);
+            }
+        }
+
+        for (int i = 0; i < child_count; ++i) {
+            int status = 0;
+            wait(&status);
+        }
+
+        const auto counters = stats::snapshot();
+        const auto* c = find_api(counters, 703);
+        REQUIRE(c);
+        CHECK(c->requests == child_count * requests_per_child);
+        CHECK(c->bytes_in == child_count * requests_per_child);
+    }
+
+    SECTION("prometheus text format")
+    {
+        stats::record(704, -1, 0, 0, 3us);
+        stats::record(704, 0, 0, 0, 100s);
+
+        auto counters = stats::snapshot();
+        counters.front().api_name = "api_\"quoted\"";
+
+        const auto text = stats::to_prometheus_text({{"host.example.org", counters}});
+        const std::string labels = R"(hostname="host.example.org",api_number="704",api_name="api_\"quoted\"")";
+
+        CHECK(text.find("# TYPE irods_api_requests_total counter\n") != std::string::npos);
+        CHECK(text.find("irods_api_requests_total{" + labels + "} 2\n") != std::string::npos);
+        CHECK(text.find("irods_api_errors_total{" + labels + "} 1\n") != std::string::npos);
+        CHECK(text.find("# TYPE irods_api_request_duration_seconds histogram\n") != std::string::npos);
+        CHECK(text.find("irods_api_request_duration_seconds_bucket{" + labels + ",le=\"4e-06\"} 1\n") !=
+              std::string::npos);
+        CHECK(text.find("irods_api_request_duration_seconds_bucket{" + labels + ",le=\"+Inf\"} 2\n") !=
+              std::string::npos);
+        CHECK(text.find("irods_api_request_duration_seconds_count{" + labels + "} 2\n") != std::string::npos);
+    }
+
+    SECTION("counters survive a round trip through JSON")
+    {
+        stats::record(705, -1, 7, 9, 2us);
+
+        const nlohmann::json json = stats::snapshot();
+        const auto counters = json.get<std::vector<stats::api_counters>>();
+
+        const auto* c = find_api(counters, 705);
+        REQUIRE(c);
+        CHECK(c->errors == 1);
+        CHECK(c->bytes_in == 7);
+        CHECK(c->bytes_out == 9);
+        CHECK(c->latency_buckets[2] == 1);
+    }
+
+    stats::reset();
+    CHECK(stats::snapshot().empty());
+}
+
+TEST_CASE("api_statistics recording overhead", "[!benchmark]")
+{
+    stats::init("irods_api_statistics_benchmark");
+    irods::at_scope_exit cleanup{[] { stats::deinit(); }};
+
+    BENCHMARK("record")
+    {
+        return stats::record(700, 0, 128, 128, 250us);
+    };
+
+    BENCHMARK("snapshot of 100 APIs")
+    {
+        for (int i = 1; i <= 100; ++i) {
+            stats::record(i, 0, 0, 0, 1us);
+        }
+
+        return stats::snapshot().size();
+    };
+}
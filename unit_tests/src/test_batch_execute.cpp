@@ -0,0 +1,190 @@
+#include <catch2/catch.hpp>
+
+#include "irods/apiNumber.h"
+#include "irods/batch_execute.h"
+#include "irods/client_connection.hpp"
+#include "irods/dataObjInpOut.h"
+#include "irods/dstream.hpp"
+#include "irods/filesystem.hpp"
+#include "irods/getRodsEnv.h"
+#include "irods/irods_at_scope_exit.hpp"
+#include "irods/objInfo.h"
+#include "irods/objStat.h"
+#include "irods/plugins/api/api_plugin_number.h"
+#include "irods/rcMisc.h"
+#include "irods/rodsErrorTable.h"
+#include "irods/rodsKeyWdDef.h"
+#include "irods/transport/default_transport.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+using json = nlohmann::json;
+
+namespace fs = irods::experimental::filesystem;
+namespace ia = irods::experimental::api;
+namespace io = irods::experimental::io;
+
+extern "C" auto load_client_api_plugins() -> void;
+
+TEST_CASE("batch_execute")
+{
+    load_client_api_plugins();
+
+    rodsEnv env;
+    _getRodsEnv(env);
+
+    irods::experimental::client_connection conn;
+    auto* conn_ptr = static_cast<RcComm*>(conn);
+
+    const auto sandbox = fs::path{env.rodsHome} / "unit_testing_sandbox_batch_execute";
+    REQUIRE(fs::client::create_collection(conn, sandbox));
+
+    irods::at_scope_exit remove_sandbox{[&conn, &sandbox] {
+        fs::client::remove_all(conn, sandbox, fs::remove_options::no_trash);
+    }};
+
+    const auto make_stat_request = [conn_ptr](const fs::path& _p) {
+        DataObjInp input{};
+        std::strncpy(input.objPath, _p.c_str(), MAX_NAME_LEN - 1);
+
+        std::string packed_input;
+        REQUIRE(ia::pack_batch_request_input(*conn_ptr, OBJ_STAT_AN, &input, packed_input) == 0);
+
+        return json{{"api_number", OBJ_STAT_AN}, {"input", packed_input}};
+    };
+
+    const auto requests = json::array({
+        make_stat_request(sandbox),
+        make_stat_request(sandbox / "does_not_exist"),
+        make_stat_request(fs::path{env.rodsHome})
+    });
+
+    SECTION("every request is executed by default")
+    {
+        const auto json_input = json{{"requests", requests}}.dump();
+
+        char* json_output{};
+        irods::at_scope_exit free_memory{[&json_output] { std::free(json_output); }};
+
+        CHECK(rc_batch_execute(conn_ptr, json_input.c_str(), &json_output) < 0);
+
+        const auto results = json::parse(json_output).at("results");
+        REQUIRE(results.size() == 3);
+
+        CHECK(results[0].at("status").get<int>() >= 0);
+        CHECK(results[1].at("status").get<int>() < 0);
+        CHECK(results[2].at("status").get<int>() >= 0);
+
+        for (const auto index : {0, 2}) {
+            rodsObjStat_t* obj_stat{};
+            irods::at_scope_exit free_stat{[&obj_stat] { freeRodsObjStat(obj_stat); }};
+
+            const auto output = results[index].at("output").get<std::string>();
+            auto** obj_stat_ptr = reinterpret_cast<void**>(&obj_stat);
+            REQUIRE(ia::unpack_batch_request_output(*conn_ptr, OBJ_STAT_AN, output, obj_stat_ptr) == 0);
+            REQUIRE(obj_stat);
+            CHECK(obj_stat->objType == COLL_OBJ_T);
+        }
+    }
+
+    SECTION("execution stops at the first error when requested")
+    {
+        const auto json_input = json{{"stop_on_error", true}, {"requests", requests}}.dump();
+
+        char* json_output{};
+        irods::at_scope_exit free_memory{[&json_output] { std::free(json_output); }};
+
+        const auto ec = rc_batch_execute(conn_ptr, json_input.c_str(), &json_output);
+
+        const auto results = json::parse(json_output).at("results");
+        REQUIRE(results.size() == 2);
+        CHECK(results[1].at("status").get<int>() == ec);
+    }
+
+    SECTION("batches cannot be nested")
+    {
+        const auto inner = json{{"requests", json::array()}}.dump();
+
+        BytesBuf input{};
+        input.buf = const_cast<char*>(inner.c_str());
+        input.len = static_cast<int>(inner.size()) + 1;
+
+        std::string packed_input;
+        REQUIRE(ia::pack_batch_request_input(*conn_ptr, BATCH_EXECUTE_APN, &input, packed_input) == 0);
+
+        const auto json_input =
+            json{{"requests", json::array({{{"api_number", BATCH_EXECUTE_APN}, {"input", packed_input}}})}}.dump();
+
+        char* json_output{};
+        irods::at_scope_exit free_memory{[&json_output] { std::free(json_output); }};
+
+        CHECK(rc_batch_execute(conn_ptr, json_input.c_str(), &json_output) == SYS_NOT_SUPPORTED);
+    }
+
+    SECTION("APIs which report progress to the client are rejected")
+    {
+        // Enough data objects for a recursive removal to report its progress at least once.
+        const auto collection = sandbox / "rm_coll";
+        REQUIRE(fs::client::create_collection(conn, collection));
+
+        for (int i = 0; i < FILE_CNT_PER_STAT_OUT * 2; ++i) {
+            io::client::default_transport tp{*conn_ptr};
+            io::odstream{tp, collection / ("data_object_" + std::to_string(i))} << "data";
+        }
+
+        const auto make_rm_coll_request = [conn_ptr](const fs::path& _p, bool _recursive) {
+            CollInp input{};
+            std::strncpy(input.collName, _p.c_str(), MAX_NAME_LEN - 1);
+
+            if (_recursive) {
+                addKeyVal(&input.condInput, RECURSIVE_OPR__KW, "");
+                addKeyVal(&input.condInput, FORCE_FLAG_KW, "");
+            }
+
+            std::string packed_input;
+            const auto ec = ia::pack_batch_request_input(*conn_ptr, RM_COLL_AN, &input, packed_input);
+            clearKeyVal(&input.condInput);
+            REQUIRE(ec == 0);
+
+            return json{{"api_number", RM_COLL_AN}, {"input", packed_input}};
+        };
+
+        const auto empty_collection = sandbox / "rm_coll_empty";
+        REQUIRE(fs::client::create_collection(conn, empty_collection));
+
+        const auto json_input = json{{"requests", json::array({
+            make_rm_coll_request(collection, true),
+            make_rm_coll_request(empty_collection, false),
+            make_stat_request(collection)
+        })}}.dump();
+
+        char* json_output{};
+        irods::at_scope_exit free_memory{[&json_output] { std::free(json_output); }};
+
+        CHECK(rc_batch_execute(conn_ptr, json_input.c_str(), &json_output) == SYS_NOT_SUPPORTED);
+
+        const auto results = json::parse(json_output).at("results");
+        REQUIRE(results.size() == 3);
+
+        CHECK(results[0].at("status").get<int>() == SYS_NOT_SUPPORTED);
+        CHECK(results[1].at("status").get<int>() >= 0);
+        CHECK(results[2].at("status").get<int>() >= 0);
+
+        // The connection is still in sync with the server.
+        CHECK(fs::client::exists(conn, collection / "data_object_0"));
+        CHECK_FALSE(fs::client::exists(conn, empty_collection));
+    }
+
+    SECTION("malformed input is rejected")
+    {
+        char* json_output{};
+        irods::at_scope_exit free_memory{[&json_output] { std::free(json_output); }};
+
+        REQUIRE(rc_batch_execute(conn_ptr, R"({"requests": {}})", &json_output) == JSON_VALIDATION_ERROR);
+        REQUIRE(json::parse(json_output).contains("error_message"));
+    }
+}
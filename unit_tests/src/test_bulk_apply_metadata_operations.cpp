@@ -0,0 +1,138 @@
+#include <catch2/catch.hpp>
+
+#include "irods/bulk_apply_metadata_operations.h"
+#include "irods/client_connection.hpp"
+#include "irods/filesystem.hpp"
+#include "irods/getRodsEnv.h"
+#include "irods/irods_at_scope_exit.hpp"
+#include "irods/rodsErrorTable.h"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using json = nlohmann::json;
+
+namespace fs = irods::experimental::filesystem;
+
+extern "C" auto load_client_api_plugins() -> void;
+
+namespace
+{
+    auto has_metadata(RcComm& _conn, const fs::path& _p, const std::string& _attribute) -> bool
+    {
+        const auto md = fs::client::get_metadata(_conn, _p);
+        return std::any_of(std::begin(md), std::end(md), [&_attribute](const fs::metadata& _m) {
+            return _m.attribute == _attribute;
+        });
+    }
+} // anonymous namespace
+
+TEST_CASE("bulk_apply_metadata_operations")
+{
+    load_client_api_plugins();
+
+    rodsEnv env;
+    _getRodsEnv(env);
+
+    irods::experimental::client_connection conn;
+    auto* conn_ptr = static_cast<RcComm*>(conn);
+
+    const auto sandbox = fs::path{env.rodsHome} / "unit_testing_sandbox_bulk_metadata";
+
+    std::vector<fs::path> collections;
+
+    for (int i = 0; i < 3; ++i) {
+        collections.push_back(sandbox / ("coll_" + std::to_string(i)));
+        REQUIRE(fs::client::create_collections(conn, collections.back()));
+    }
+
+    irods::at_scope_exit remove_sandbox{[&conn, &sandbox] {
+        fs::client::remove_all(conn, sandbox, fs::remove_options::no_trash);
+    }};
+
+    const auto make_entity = [](const fs::path& _p, const json& _operations) {
+        return json{{"entity_name", _p.string()}, {"entity_type", "collection"}, {"operations", _operations}};
+    };
+
+    SECTION("operations are applied to every entity")
+    {
+        auto entities = json::array();
+
+        for (auto&& p : collections) {
+            entities.push_back(make_entity(p, json::array({
+                {{"operation", "add"}, {"attribute", "bulk_a0"}, {"value", "v0"}, {"units", "u0"}},
+                {{"operation", "add"}, {"attribute", "bulk_a1"}, {"value", "v1"}},
+                {{"operation", "remove"}, {"attribute", "bulk_a1"}, {"value", "v1"}},
+                {{"operation", "add"}, {"attribute", "bulk_a0"}, {"value", "v0"}, {"units", "u0"}}
+            })));
+        }
+
+        const auto json_input = json{{"entities", entities}}.dump();
+
+        char* json_output{};
+        irods::at_scope_exit free_memory{[&json_output] { std::free(json_output); }};
+
+        REQUIRE(rc_bulk_apply_metadata_operations(conn_ptr, json_input.c_str(), &json_output) == 0);
+        REQUIRE(json::parse(json_output).at("errors").empty());
+
+        for (auto&& p : collections) {
+            CHECK(fs::client::get_metadata(conn, p).size() == 1);
+            CHECK(has_metadata(conn, p, "bulk_a0"));
+            CHECK_FALSE(has_metadata(conn, p, "bulk_a1"));
+        }
+    }
+
+    SECTION("failed entities are reported and skipped")
+    {
+        const auto json_input = json{{"entities", json::array({
+            make_entity(collections[0], json::array({
+                {{"operation", "add"}, {"attribute", "bulk_ok"}, {"value", "v"}}
+            })),
+            make_entity(sandbox / "does_not_exist", json::array({
+                {{"operation", "add"}, {"attribute", "bulk_ok"}, {"value", "v"}}
+            })),
+            make_entity(collections[1], json::array({
+                {{"operation", "add"}, {"attribute", "bulk_skipped"}, {"value", "v"}},
+                {{"operation", "modify"}, {"attribute", "bulk_skipped"}, {"value", "v"}}
+            })),
+            make_entity(collections[2], json::array({
+                {{"operation", "add"}, {"attribute", "bulk_ok"}, {"value", "v"}}
+            }))
+        })}}.dump();
+
+        char* json_output{};
+        irods::at_scope_exit free_memory{[&json_output] { std::free(json_output); }};
+
+        REQUIRE(rc_bulk_apply_metadata_operations(conn_ptr, json_input.c_str(), &json_output) ==
+                SYS_INVALID_INPUT_PARAM);
+
+        const auto errors = json::parse(json_output).at("errors");
+        REQUIRE(errors.size() == 2);
+
+        CHECK(errors[0].at("entity_index").get<int>() == 1);
+        CHECK(errors[0].at("operation_index").get<int>() == -1);
+        CHECK(errors[0].at("error_code").get<int>() == SYS_INVALID_INPUT_PARAM);
+
+        CHECK(errors[1].at("entity_index").get<int>() == 2);
+        CHECK(errors[1].at("operation_index").get<int>() == 1);
+        CHECK(errors[1].at("error_code").get<int>() == INVALID_OPERATION);
+
+        CHECK(has_metadata(conn, collections[0], "bulk_ok"));
+        CHECK(fs::client::get_metadata(conn, collections[1]).empty());
+        CHECK(has_metadata(conn, collections[2], "bulk_ok"));
+    }
+
+    SECTION("malformed input is rejected")
+    {
+        char* json_output{};
+        irods::at_scope_exit free_memory{[&json_output] { std::free(json_output); }};
+
+        REQUIRE(rc_bulk_apply_metadata_operations(conn_ptr, R"({"entities": {}})", &json_output) ==
+                JSON_VALIDATION_ERROR);
+        REQUIRE(json::parse(json_output).at("errors").size() == 1);
+    }
+}
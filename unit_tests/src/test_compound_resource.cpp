@@ -0,0 +1,92 @@
+#include <catch2/catch.hpp>
+
+#include "irods/client_connection.hpp"
+#include "irods/dstream.hpp"
+#include "irods/filesystem.hpp"
+#include "irods/irods_at_scope_exit.hpp"
+#include "irods/irods_query.hpp"
+#include "irods/resource_administration.hpp"
+#include "irods/rodsClient.h"
+#include "irods/transport/default_transport.hpp"
+#include "unit_test_utils.hpp"
+
+#include <fmt/format.h>
+
+#include <chrono>
+#include <string>
+#include <thread>
+
+// clang-format off
+namespace adm = irods::experimental::administration;
+namespace fs  = irods::experimental::filesystem;
+namespace io  = irods::experimental::io;
+// clang-format on
+
+TEST_CASE("asynchronous syncs to the archive are performed while the client is connected")
+{
+    load_client_api_plugins();
+
+    const std::string compound_resc = "test_compound_resc";
+    const std::string cache_resc = "test_compound_cache_resc";
+    const std::string archive_resc = "test_compound_archive_resc";
+
+    irods::experimental::client_connection conn;
+    RcComm& comm = static_cast<RcComm&>(conn);
+
+    adm::resource_registration_info compound_info;
+    compound_info.resource_name = compound_resc;
+    compound_info.resource_type = adm::resource_type::compound;
+    compound_info.context_string = "auto_repl=async";
+
+    REQUIRE_NOTHROW(adm::client::add_resource(comm, compound_info));
+    unit_test_utils::add_ufs_resource(comm, cache_resc, "test_compound_cache_vault");
+    unit_test_utils::add_ufs_resource(comm, archive_resc, "test_compound_archive_vault");
+    REQUIRE_NOTHROW(adm::client::add_child_resource(comm, compound_resc, cache_resc, "cache"));
+    REQUIRE_NOTHROW(adm::client::add_child_resource(comm, compound_resc, archive_resc, "archive"));
+
+    rodsEnv env;
+    _getRodsEnv(env);
+
+    const auto sandbox = fs::path{env.rodsHome} / "test_compound_resource";
+    if (!fs::client::exists(comm, sandbox)) {
+        REQUIRE(fs::client::create_collection(comm, sandbox));
+    }
+
+    irods::at_scope_exit cleanup{[&] {
+        fs::client::remove_all(comm, sandbox, fs::remove_options::no_trash);
+
+        adm::client::remove_child_resource(comm, compound_resc, cache_resc);
+        adm::client::remove_child_resource(comm, compound_resc, archive_resc);
+        adm::client::remove_resource(comm, cache_resc);
+        adm::client::remove_resource(comm, archive_resc);
+        adm::client::remove_resource(comm, compound_resc);
+    }};
+
+    const auto path = sandbox / "data_object";
+
+    {
+        io::client::default_transport tp{conn};
+        io::odstream{tp, path, io::root_resource_name{compound_resc}} << "queued for sync";
+    }
+
+    const auto gql = fmt::format("select DATA_REPL_STATUS where COLL_NAME = '{}' and DATA_NAME = '{}' and "
+                                 "DATA_RESC_NAME = '{}'",
+                                 path.parent_path().c_str(),
+                                 path.object_name().c_str(),
+                                 archive_resc);
+
+    // The client stays connected and idle. The agent performs the queued sync between requests, so a good archive
+    // replica appears well before the connection is closed.
+    bool archive_replica_is_good = false;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{30};
+
+    while (!archive_replica_is_good && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds{500});
+
+        for (auto&& row : irods::query<RcComm>{&comm, gql}) {
+            archive_replica_is_good = ("1" == row[0]);
+        }
+    }
+
+    CHECK(archive_replica_is_good);
+}
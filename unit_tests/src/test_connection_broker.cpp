@@ -0,0 +1,160 @@
+#include <catch2/catch.hpp>
+
+#include "irods/connection_broker.hpp"
+#include "irods/irods_at_scope_exit.hpp"
+#include "irods/rcConnect.h"
+#include "irods/stringOpr.h"
+#include "irods/tracing.hpp"
+
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <array>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <thread>
+
+namespace cb = irods::connection_broker;
+
+using namespace std::chrono_literals;
+
+namespace
+{
+    // Builds a logged in connection around one end of a socket pair. The other end stands in for
+    // the remote server.
+    auto make_connection(const char* _client_user, int _sock) -> rcComm_t*
+    {
+        auto* conn = static_cast<rcComm_t*>(std::calloc(1, sizeof(rcComm_t)));
+
+        rstrcpy(conn->host, "provider.example.org", NAME_LEN);
+        conn->portNum = 1247;
+        conn->sock = _sock;
+        conn->loggedIn = 1;
+        rstrcpy(conn->proxyUser.userName, "rods", NAME_LEN);
+        rstrcpy(conn->proxyUser.rodsZone, "tempZone", NAME_LEN);
+        rstrcpy(conn->clientUser.userName, _client_user, NAME_LEN);
+        rstrcpy(conn->clientUser.rodsZone, "tempZone", NAME_LEN);
+
+        conn->svrVersion = static_cast<version_t*>(std::calloc(1, sizeof(version_t)));
+        rstrcpy(conn->svrVersion->relVersion, "rods4.3.0", NAME_LEN);
+
+        return conn;
+    }
+
+    auto lease(const char* _client_user) -> rcComm_t*
+    {
+        return cb::lease("provider.example.org", 1247, "rods", "tempZone", _client_user, "tempZone");
+    }
+
+    auto free_connection(rcComm_t* _conn) -> void
+    {
+        if (_conn) {
+            close(_conn->sock);
+            freeRcComm(_conn);
+        }
+    }
+} // anonymous namespace
+
+TEST_CASE("connection_broker")
+{
+    const auto socket_path = std::filesystem::temp_directory_path() /
+                             ("irods_test_connection_broker_" + std::to_string(getpid()) + ".sock");
+
+    setenv(cb::socket_path_env_var, socket_path.c_str(), 1);
+
+    const auto broker_pid = fork();
+    REQUIRE(broker_pid >= 0);
+
+    if (0 == broker_pid) {
+        std::_Exit(cb::run(socket_path.c_str(), 8, std::chrono::seconds{60}));
+    }
+
+    irods::at_scope_exit stop_broker{[broker_pid] {
+        kill(broker_pid, SIGTERM);
+        waitpid(broker_pid, nullptr, 0);
+        unsetenv(cb::socket_path_env_var);
+    }};
+
+    for (int i = 0; i < 50 && !std::filesystem::exists(socket_path); ++i) {
+        std::this_thread::sleep_for(100ms);
+    }
+
+    REQUIRE(std::filesystem::exists(socket_path));
+
+    std::array<int, 2> socks{};
+    REQUIRE(socketpair(AF_UNIX, SOCK_STREAM, 0, socks.data()) == 0);
+
+    irods::at_scope_exit close_remote_end{[&socks] { close(socks[1]); }};
+
+    SECTION("connections are only leased for the client user they were established for")
+    {
+        REQUIRE(cb::release(make_connection("alice", socks[0])));
+
+        CHECK(lease("bob") == nullptr);
+
+        auto* conn = lease("alice");
+        irods::at_scope_exit free_conn{[conn] { free_connection(conn); }};
+        REQUIRE(conn);
+        CHECK(std::string{conn->clientUser.userName} == "alice");
+
+        // The leased socket must still reach the same peer.
+        REQUIRE(send(conn->sock, "x", 1, 0) == 1);
+        char c{};
+        REQUIRE(recv(socks[1], &c, 1, 0) == 1);
+        CHECK(c == 'x');
+
+        // A connection can only be leased once.
+        CHECK(lease("alice") == nullptr);
+    }
+
+    SECTION("connections are leased regardless of the trace they were opened in")
+    {
+        namespace tracing = irods::experimental::tracing;
+
+        irods::at_scope_exit reset_root{[] { tracing::set_root_context({}); }};
+
+        tracing::set_root_context({"0af7651916cd43dd8448eb211c80319c", "b7ad6b7169203331"});
+        REQUIRE(cb::release(make_connection("alice", socks[0])));
+
+        tracing::set_root_context({"4bf92f3577b34da6a3ce929d0e0e4736", "00f067aa0ba902b7"});
+        auto* conn = lease("alice");
+        irods::at_scope_exit free_conn{[conn] { free_connection(conn); }};
+        CHECK(conn);
+    }
+
+    SECTION("connections carrying session state are not brokered")
+    {
+        auto* conn = make_connection("alice", socks[0]);
+        irods::at_scope_exit free_conn{[conn] { free_connection(conn); }};
+
+        cb::exclude(conn);
+
+        CHECK_FALSE(cb::release(conn));
+        CHECK(lease("alice") == nullptr);
+    }
+
+    SECTION("connections closed by the remote server are not brokered")
+    {
+        auto* conn = make_connection("alice", socks[0]);
+        irods::at_scope_exit free_conn{[conn] { free_connection(conn); }};
+
+        close(socks[1]);
+        socks[1] = -1;
+
+        CHECK_FALSE(cb::release(conn));
+    }
+
+    SECTION("connections closed by the remote server while idle are not leased")
+    {
+        REQUIRE(cb::release(make_connection("alice", socks[0])));
+
+        close(socks[1]);
+        socks[1] = -1;
+
+        CHECK(lease("alice") == nullptr);
+    }
+}
@@ -7,12 +7,15 @@
 #include "irods/irods_query.hpp"
 #include "irods/replica.hpp"
 #include "irods/rodsClient.h"
+#include "irods/transport/async_transport.hpp"
 #include "irods/transport/default_transport.hpp"
 
 #include <boost/filesystem.hpp>
 #include <fmt/format.h>
 
 #include <chrono>
+#include <iterator>
+#include <string>
 #include <string_view>
 
 #include <unistd.h>
@@ -303,6 +306,77 @@ TEST_CASE("dstream", "[iostreams]")
         ds.read(buf, 2);
         REQUIRE(std::string_view(buf, 2) == "cd");
     }
+
+    SECTION("async transport reads ahead and writes behind transparently")
+    {
+        const auto path = sandbox / "data_object.txt";
+
+        std::string contents(100'000, '\0');
+        for (std::size_t i = 0; i < contents.size(); ++i) {
+            contents[i] = static_cast<char>('a' + i % 26);
+        }
+
+        // The async transport uses its connection from a background thread, so it is given a
+        // connection of its own.
+        auto async_conn = conn_pool->get_connection();
+
+        // Small buffers so that every operation spans several requests.
+        io::client::native_transport tp{async_conn};
+        io::async_transport async_tp{tp, 4096, 2};
+
+        {
+            io::odstream out{async_tp, path};
+            REQUIRE(out);
+            out.write(contents.data(), contents.size());
+            out.close();
+            REQUIRE(out);
+        }
+
+        REQUIRE(irods::experimental::replica::replica_size<rcComm_t>(conn, path, 0) == contents.size());
+
+        io::idstream in{async_tp, path};
+        REQUIRE(in);
+        REQUIRE(std::string(std::istreambuf_iterator<char>{in}, {}) == contents);
+
+        // Seeking behaves exactly as it does with the wrapped transport.
+        in.clear();
+        in.seekg(10'000);
+        char buf[4]{};
+        in.read(buf, sizeof(buf));
+        REQUIRE(std::string_view(buf, sizeof(buf)) == std::string_view(contents).substr(10'000, sizeof(buf)));
+
+        const auto async_position = in.tellg();
+
+        io::client::native_transport sync_tp{conn};
+        io::idstream sync_in{sync_tp, path};
+        sync_in.seekg(10'000);
+        sync_in.read(buf, sizeof(buf));
+        REQUIRE(sync_in.tellg() == async_position);
+
+        in.seekg(-3, std::ios_base::end);
+        in.read(buf, 3);
+        REQUIRE(std::string_view(buf, 3) == std::string_view(contents).substr(contents.size() - 3));
+    }
+
+    SECTION("stream buffer size can be configured before opening")
+    {
+        const auto path = sandbox / "data_object.txt";
+        const std::string contents(10'000, 'x');
+
+        io::client::native_transport tp{conn};
+
+        {
+            io::odstream out;
+            REQUIRE(out.rdbuf()->pubsetbuf(nullptr, 64 * 1024));
+            out.open(tp, path);
+            out.write(contents.data(), contents.size());
+        }
+
+        io::idstream in;
+        REQUIRE(in.rdbuf()->pubsetbuf(nullptr, 64 * 1024));
+        in.open(tp, path);
+        REQUIRE(std::string(std::istreambuf_iterator<char>{in}, {}) == contents);
+    }
 }
 
 auto get_hostname() noexcept -> std::string
@@ -0,0 +1,233 @@
+#include <catch2/catch.hpp>
+
+#include "irods/client_connection.hpp"
+#include "irods/dataObjClose.h"
+#include "irods/dataObjInpOut.h"
+#include "irods/dataObjOpen.h"
+#include "irods/dstream.hpp"
+#include "irods/filesystem.hpp"
+#include "irods/getRodsEnv.h"
+#include "irods/get_data_object_open_plan.h"
+#include "irods/irods_at_scope_exit.hpp"
+#include "irods/rcMisc.h"
+#include "irods/rodsClient.h"
+#include "irods/rodsErrorTable.h"
+#include "irods/transport/default_transport.hpp"
+#include "irods/user_administration.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <fcntl.h>
+
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <utility>
+
+// clang-format off
+namespace adm = irods::experimental::administration;
+namespace fs  = irods::experimental::filesystem;
+namespace io  = irods::experimental::io;
+
+using json = nlohmann::json;
+// clang-format on
+
+namespace
+{
+    auto get_open_plan(RcComm& _comm, const fs::path& _path, std::string_view _access_level = "read_object")
+        -> std::pair<int, json>
+    {
+        const auto input = json{{"logical_path", _path.c_str()}, {"access_level", _access_level}}.dump();
+
+        BytesBuf* output{};
+        const auto ec = rc_get_data_object_open_plan(&_comm, input.c_str(), &output);
+
+        if (ec != 0) {
+            return {ec, json{}};
+        }
+
+        irods::at_scope_exit free_output{[output] { freeBBuf(output); }};
+
+        const auto* p = static_cast<const char*>(output->buf);
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        return {ec, json::parse(p, p + output->len)};
+    } // get_open_plan
+
+    auto open_and_close(RcComm& _comm, const fs::path& _path, int _flags) -> int
+    {
+        DataObjInp open_inp{};
+        std::strncpy(open_inp.objPath, _path.c_str(), sizeof(open_inp.objPath) - 1);
+        open_inp.openFlags = _flags;
+
+        const auto fd = rcDataObjOpen(&_comm, &open_inp);
+        clearKeyVal(&open_inp.condInput);
+
+        if (fd < 0) {
+            return fd;
+        }
+
+        OpenedDataObjInp close_inp{};
+        close_inp.l1descInx = fd;
+
+        return rcDataObjClose(&_comm, &close_inp);
+    } // open_and_close
+} // anonymous namespace
+
+TEST_CASE("rc_get_data_object_open_plan")
+{
+    load_client_api_plugins();
+
+    rodsEnv env;
+    _getRodsEnv(env);
+
+    irods::experimental::client_connection conn;
+    auto& comm = static_cast<RcComm&>(conn);
+
+    const auto sandbox = fs::path{env.rodsHome} / "test_get_data_object_open_plan";
+
+    if (!fs::client::exists(comm, sandbox)) {
+        REQUIRE(fs::client::create_collection(comm, sandbox));
+    }
+
+    irods::at_scope_exit remove_sandbox{[&comm, &sandbox] {
+        fs::client::remove_all(comm, sandbox, fs::remove_options::no_trash);
+    }};
+
+    const auto data_object = sandbox / "data_object";
+
+    {
+        io::client::default_transport tp{comm};
+        io::odstream{tp, data_object} << "open plan";
+    }
+
+    SECTION("existing data object")
+    {
+        const auto [ec, plan] = get_open_plan(comm, data_object);
+        REQUIRE(ec == 0);
+
+        CHECK_FALSE(plan.at("collection").is_null());
+        CHECK(plan.at("collection").at("coll_type").get<std::string>().empty());
+        CHECK_FALSE(plan.at("is_collection").get<bool>());
+        CHECK(plan.at("permission_granted").get<bool>());
+
+        const auto& replicas = plan.at("replicas");
+        REQUIRE(replicas.size() == 1);
+        CHECK(replicas[0].at("data_repl_num").get<std::string>() == "0");
+        CHECK(replicas[0].at("data_size").get<std::string>() == "9");
+        CHECK(replicas[0].at("data_is_dirty").get<std::string>() == std::to_string(GOOD_REPLICA));
+        CHECK(replicas[0].at("coll_id").get<std::string>() == plan.at("collection").at("coll_id").get<std::string>());
+    }
+
+    SECTION("data object does not exist")
+    {
+        const auto [ec, plan] = get_open_plan(comm, sandbox / "missing", "modify_object");
+        REQUIRE(ec == 0);
+
+        CHECK_FALSE(plan.at("collection").is_null());
+        CHECK_FALSE(plan.at("permission_granted").get<bool>());
+        CHECK(plan.at("replicas").empty());
+    }
+
+    SECTION("parent collection does not exist")
+    {
+        const auto [ec, plan] = get_open_plan(comm, sandbox / "missing" / "data_object");
+        REQUIRE(ec == 0);
+
+        CHECK(plan.at("collection").is_null());
+        CHECK(plan.at("replicas").empty());
+    }
+
+    SECTION("logical path names a collection")
+    {
+        const auto [ec, plan] = get_open_plan(comm, sandbox);
+        REQUIRE(ec == 0);
+
+        CHECK(plan.at("is_collection").get<bool>());
+        CHECK(plan.at("replicas").empty());
+    }
+
+    SECTION("invalid input")
+    {
+        BytesBuf* output{};
+        CHECK(rc_get_data_object_open_plan(&comm, nullptr, &output) == SYS_INVALID_INPUT_PARAM);
+        CHECK(rc_get_data_object_open_plan(&comm, "{}", nullptr) == SYS_INVALID_INPUT_PARAM);
+        CHECK(rc_get_data_object_open_plan(&comm, "not json", &output) == INPUT_ARG_NOT_WELL_FORMED_ERR);
+        CHECK(rc_get_data_object_open_plan(&comm, R"({"logical_path": "/tempZone"})", &output) ==
+              INPUT_ARG_NOT_WELL_FORMED_ERR);
+    }
+
+    SECTION("replicas are not returned without permission")
+    {
+        adm::user alice{"alice"};
+        REQUIRE_NOTHROW(adm::client::add_user(conn, alice));
+        irods::at_scope_exit remove_user{[&conn, &alice] { adm::client::remove_user(conn, alice); }};
+
+        REQUIRE_NOTHROW(adm::client::modify_user(conn, alice, adm::user_password_property{"rods"}));
+
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-array-to-pointer-decay)
+        irods::experimental::client_connection alice_conn{env.rodsHost, env.rodsPort, {alice.name, env.rodsZone}};
+        REQUIRE(alice_conn);
+
+        CHECK(get_open_plan(static_cast<RcComm&>(alice_conn), data_object).first == CAT_NO_ACCESS_PERMISSION);
+    }
+
+    SECTION("open and create go through the plan")
+    {
+        CHECK(open_and_close(comm, data_object, O_RDONLY) == 0);
+        CHECK(open_and_close(comm, data_object, O_WRONLY) == 0);
+        CHECK(open_and_close(comm, sandbox / "created", O_CREAT | O_WRONLY) == 0);
+        CHECK(open_and_close(comm, sandbox / "missing", O_RDONLY) == OBJ_PATH_DOES_NOT_EXIST);
+    }
+}
+
+TEST_CASE("open and close latency", "[!benchmark]")
+{
+    // Measures the cost of catalog lookups during open. Run against a server backed by a local
+    // PostgreSQL database so that the numbers are not dominated by network latency.
+    load_client_api_plugins();
+
+    rodsEnv env;
+    _getRodsEnv(env);
+
+    irods::experimental::client_connection conn;
+    auto& comm = static_cast<RcComm&>(conn);
+
+    const auto sandbox = fs::path{env.rodsHome} / "test_open_and_close_latency";
+
+    if (!fs::client::exists(comm, sandbox)) {
+        REQUIRE(fs::client::create_collection(comm, sandbox));
+    }
+
+    irods::at_scope_exit remove_sandbox{[&comm, &sandbox] {
+        fs::client::remove_all(comm, sandbox, fs::remove_options::no_trash);
+    }};
+
+    const auto data_object = sandbox / "data_object";
+
+    {
+        io::client::default_transport tp{comm};
+        io::odstream{tp, data_object} << "open and close latency";
+    }
+
+    BENCHMARK("open plan")
+    {
+        return get_open_plan(comm, data_object).first;
+    };
+
+    BENCHMARK("open for read and close")
+    {
+        return open_and_close(comm, data_object, O_RDONLY);
+    };
+
+    BENCHMARK("open for write and close")
+    {
+        return open_and_close(comm, data_object, O_WRONLY);
+    };
+
+    int counter = 0;
+
+    BENCHMARK("create and close")
+    {
+        return open_and_close(comm, sandbox / ("created_" + std::to_string(counter++)), O_CREAT | O_WRONLY);
+    };
+}
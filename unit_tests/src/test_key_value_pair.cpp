@@ -0,0 +1,138 @@
+#include <catch2/catch.hpp>
+
+#include "irods/dataObjInpOut.h"
+#include "irods/irods_at_scope_exit.hpp"
+#include "irods/key_value_proxy.hpp"
+#include "irods/objInfo.h"
+#include "irods/rcMisc.h"
+#include "irods/rodsKeyWdDef.h"
+
+#include <string>
+
+namespace ix = irods::experimental;
+
+TEST_CASE("keyValPair_t lookup and removal")
+{
+    keyValPair_t kvp{};
+    irods::at_scope_exit free_kvp{[&kvp] { clearKeyVal(&kvp); }};
+
+    // Keywords sharing a first character, and one that is a prefix of another.
+    addKeyVal(&kvp, "rescName", "a");
+    addKeyVal(&kvp, "rescHier", "b");
+    addKeyVal(&kvp, "resc", "c");
+    addKeyVal(&kvp, "forceFlag", "");
+
+    REQUIRE(kvp.len == 4);
+    CHECK(std::string{getValByKey(&kvp, "rescName")} == "a");
+    CHECK(std::string{getValByKey(&kvp, "rescHier")} == "b");
+    CHECK(std::string{getValByKey(&kvp, "resc")} == "c");
+    CHECK(std::string{getValByKey(&kvp, "forceFlag")}.empty());
+    CHECK_FALSE(getValByKey(&kvp, "res"));
+    CHECK_FALSE(getValByKey(&kvp, ""));
+
+    // Updating an existing keyword does not add an entry.
+    REQUIRE(addKeyVal(&kvp, "rescHier", "d") == 1);
+    REQUIRE(kvp.len == 4);
+    CHECK(std::string{getValByKey(&kvp, "rescHier")} == "d");
+
+    // Removal preserves the order of the remaining entries.
+    rmKeyVal(&kvp, "rescName");
+    REQUIRE(kvp.len == 3);
+    CHECK_FALSE(getValByKey(&kvp, "rescName"));
+    CHECK(std::string{kvp.keyWord[0]} == "rescHier");
+    CHECK(std::string{kvp.keyWord[1]} == "resc");
+    CHECK(std::string{kvp.keyWord[2]} == "forceFlag");
+
+    // Removing a missing keyword is not an error.
+    CHECK(rmKeyVal(&kvp, "rescName") == 0);
+    REQUIRE(kvp.len == 3);
+
+    rmKeyVal(&kvp, "rescHier");
+    rmKeyVal(&kvp, "resc");
+    rmKeyVal(&kvp, "forceFlag");
+    REQUIRE(kvp.len == 0);
+    CHECK(kvp.keyWord == nullptr);
+    CHECK(kvp.value == nullptr);
+}
+
+TEST_CASE("key_value_proxy lookup does not match keyword prefixes")
+{
+    keyValPair_t kvp{};
+    irods::at_scope_exit free_kvp{[&kvp] { clearKeyVal(&kvp); }};
+
+    addKeyVal(&kvp, "rescName", "a");
+    addKeyVal(&kvp, "resc", "b");
+
+    const auto proxy = ix::make_key_value_proxy(kvp);
+
+    CHECK(proxy.contains("resc"));
+    CHECK(proxy.contains("rescName"));
+    CHECK_FALSE(proxy.contains("res"));
+    CHECK_FALSE(proxy.contains("rescNameX"));
+    CHECK(proxy.at("resc").value() == "b");
+    CHECK(proxy.find("rescName") != proxy.cend());
+    CHECK(proxy.find("rescNam") == proxy.cend());
+}
+
+// Run with: irods_key_value_pair "[!benchmark]"
+TEST_CASE("keyValPair_t open/put condInput workload", "[!benchmark]")
+{
+    // The keywords a put typically carries in its condInput.
+    const char* const keywords[] = {
+        DEST_RESC_NAME_KW, DATA_TYPE_KW, FORCE_FLAG_KW, REG_CHKSUM_KW, RESC_HIER_STR_KW,
+        DATA_INCLUDED_KW, OPEN_TYPE_KW, RECURSIVE_OPR__KW, NUM_THREADS_KW, DEF_RESC_NAME_KW,
+        SELECTED_HIERARCHY_KW, KEY_VALUE_PASSTHROUGH_KW};
+
+    // The keywords looked up while a put is handled, most of which are absent.
+    const char* const lookups[] = {
+        RESC_HIER_STR_KW, DEST_RESC_NAME_KW, FORCE_FLAG_KW, ADMIN_KW, REPL_NUM_KW, RESC_NAME_KW,
+        VERIFY_CHKSUM_KW, REG_CHKSUM_KW, DATA_TYPE_KW, NO_OPEN_FLAG_KW, PHYOPEN_BY_SIZE_KW,
+        RESC_HIER_STR_KW, LOCK_TYPE_KW, DEST_RESC_NAME_KW, OPEN_TYPE_KW, NUM_THREADS_KW};
+
+    keyValPair_t kvp{};
+    irods::at_scope_exit free_kvp{[&kvp] { clearKeyVal(&kvp); }};
+
+    for (const auto* k : keywords) {
+        addKeyVal(&kvp, k, "value");
+    }
+
+    BENCHMARK("getValByKey")
+    {
+        int found = 0;
+        for (int i = 0; i < 8; ++i) {
+            for (const auto* k : lookups) {
+                found += getValByKey(&kvp, k) ? 1 : 0;
+            }
+        }
+        return found;
+    };
+
+    BENCHMARK("key_value_proxy::contains")
+    {
+        const auto proxy = ix::make_key_value_proxy(kvp);
+        int found = 0;
+        for (int i = 0; i < 8; ++i) {
+            for (const auto* k : lookups) {
+                found += proxy.contains(k) ? 1 : 0;
+            }
+        }
+        return found;
+    };
+
+    BENCHMARK("build, copy and clear")
+    {
+        keyValPair_t tmp{};
+        for (const auto* k : keywords) {
+            addKeyVal(&tmp, k, "value");
+        }
+
+        keyValPair_t copy{};
+        replKeyVal(&tmp, &copy);
+        rmKeyVal(&copy, FORCE_FLAG_KW);
+
+        const auto len = copy.len;
+        clearKeyVal(&copy);
+        clearKeyVal(&tmp);
+        return len;
+    };
+}
@@ -0,0 +1,63 @@
+#include <catch2/catch.hpp>
+
+#include "irods/load_digest_cache.hpp"
+#include "irods/irods_at_scope_exit.hpp"
+
+#include <chrono>
+#include <thread>
+
+namespace ldc = irods::experimental::load_digest_cache;
+
+using namespace std::chrono_literals;
+
+TEST_CASE("load_digest_cache")
+{
+    ldc::init("irods_load_digest_cache_test", 100'000);
+    irods::at_scope_exit cleanup{[] { ldc::deinit(); }};
+
+    SECTION("lookup requires a snapshot")
+    {
+        REQUIRE_FALSE(ldc::lookup());
+
+        // Pushed digests are kept, but do not make the cache authoritative on their own.
+        REQUIRE(ldc::insert_or_assign({"resc_a", 10, 100}));
+        REQUIRE(ldc::size() == 1);
+        REQUIRE_FALSE(ldc::lookup());
+    }
+
+    SECTION("assign / update / expiration")
+    {
+        ldc::assign({{"resc_a", 10, 100}, {"resc_a", 30, 50}, {"resc_b", 20, 100}}, 3s);
+
+        auto digests = ldc::lookup();
+        REQUIRE(digests);
+        REQUIRE(digests->size() == 2);
+        REQUIRE(digests->at(0).resource_name == "resc_a");
+        REQUIRE(digests->at(0).load_factor == 10);
+        REQUIRE(digests->at(1).resource_name == "resc_b");
+
+        // Older digests do not replace newer ones.
+        REQUIRE_FALSE(ldc::insert_or_assign({"resc_b", 90, 99}));
+        REQUIRE(ldc::insert_or_assign({"resc_b", 5, 200}));
+        REQUIRE(ldc::insert_or_assign({"resc_c", 1, 200}));
+
+        digests = ldc::lookup();
+        REQUIRE(digests);
+        REQUIRE(digests->size() == 3);
+        REQUIRE(digests->at(1).load_factor == 5);
+        REQUIRE(digests->at(1).create_time == 200);
+
+        std::this_thread::sleep_for(3s);
+        REQUIRE_FALSE(ldc::lookup());
+    }
+
+    SECTION("clear")
+    {
+        ldc::assign({{"resc_a", 10, 100}}, 60s);
+        REQUIRE(ldc::lookup());
+
+        ldc::clear();
+        REQUIRE(ldc::size() == 0);
+        REQUIRE_FALSE(ldc::lookup());
+    }
+}
@@ -0,0 +1,410 @@
+// Microbenchmarks for the hot paths which do not require a server.
+//
+// Every test case is tagged [!benchmark], so none of them run by default. To run them and collect
+// machine-readable results for trend tracking, run:
+//
+//     irods_microbenchmarks "[!benchmark]" --reporter xml --out microbenchmarks.xml
+//
+// The dispatch of plugin operations is measured separately by irods_plugin_operation_dispatch.
+
+#include <catch2/catch.hpp>
+
+#include "irods/authenticate.h"
+#include "irods/base64.hpp"
+#include "irods/genQuery.h"
+#include "irods/irods_at_scope_exit.hpp"
+#include "irods/irods_hasher_factory.hpp"
+#include "irods/ADLER32Strategy.hpp"
+#include "irods/MD5Strategy.hpp"
+#include "irods/SHA1Strategy.hpp"
+#include "irods/SHA256Strategy.hpp"
+#include "irods/SHA512Strategy.hpp"
+#include "irods/irods_hierarchy_parser.hpp"
+#include "irods/irods_lookup_table.hpp"
+#include "irods/key_value_proxy.hpp"
+#include "irods/obf.h"
+#include "irods/packStruct.h"
+#include "irods/rcGlobalExtern.h"
+#include "irods/rcMisc.h"
+#include "irods/rodsKeyWdDef.h"
+
+#include <fmt/format.h>
+
+#include <array>
+#include <cstdlib>
+#include <cstring>
+#include <numeric>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+    // The total row count reported by the pages of results below, i.e. 40 pages of MAX_SQL_ROWS.
+    constexpr int catalog_row_count = 40 * MAX_SQL_ROWS;
+
+    const std::string logical_path = "/tempZone/home/alice/projects/sequencing/run_0042/sample_0007.fastq.gz";
+    const std::string hierarchy = "root_repl;site_a_passthru;site_a_compound;site_a_cache";
+
+    auto make_data_object_input() -> DataObjInp
+    {
+        DataObjInp input{};
+        std::strncpy(input.objPath, logical_path.c_str(), sizeof(input.objPath) - 1);
+        input.createMode = 0600;
+        input.openFlags = O_WRONLY | O_CREAT | O_TRUNC;
+        input.dataSize = 268'435'456;
+        input.numThreads = 4;
+        input.oprType = PUT_OPR;
+
+        addKeyVal(&input.condInput, DEST_RESC_NAME_KW, "root_repl");
+        addKeyVal(&input.condInput, RESC_HIER_STR_KW, hierarchy.c_str());
+        addKeyVal(&input.condInput, DATA_TYPE_KW, "generic");
+        addKeyVal(&input.condInput, FORCE_FLAG_KW, "");
+        addKeyVal(&input.condInput, REG_CHKSUM_KW, "");
+        addKeyVal(&input.condInput, DATA_SIZE_KW, "268435456");
+
+        return input;
+    } // make_data_object_input
+
+    // Fills a page of results as the catalog would for
+    // "select COLL_NAME, DATA_NAME, DATA_SIZE, DATA_MODIFY_TIME".
+    auto make_query_page(int _first_row, int _row_count) -> GenQueryOut*
+    {
+        auto* out = static_cast<GenQueryOut*>(std::calloc(1, sizeof(GenQueryOut)));
+        out->rowCnt = _row_count;
+        out->attriCnt = 4;
+        out->totalRowCount = catalog_row_count;
+
+        const std::array<int, 4> columns{COL_COLL_NAME, COL_DATA_NAME, COL_DATA_SIZE, COL_D_MODIFY_TIME};
+        const std::array<int, 4> lengths{64, 32, 16, 16};
+
+        for (int c = 0; c < out->attriCnt; ++c) {
+            auto& result = out->sqlResult[c];
+            result.attriInx = columns[c];
+            result.len = lengths[c];
+            result.value = static_cast<char*>(std::calloc(_row_count, result.len));
+
+            for (int r = 0; r < _row_count; ++r) {
+                const auto row = _first_row + r;
+                auto* value = result.value + r * result.len;
+
+                switch (c) {
+                    case 0: fmt::format_to_n(value, result.len - 1, "/tempZone/home/alice/r{:04}", row / 1000); break;
+                    case 1: fmt::format_to_n(value, result.len - 1, "sample_{:06}.fastq.gz", row); break;
+                    case 2: fmt::format_to_n(value, result.len - 1, "{}", 1'000'000 + row); break;
+                    case 3: fmt::format_to_n(value, result.len - 1, "{:011}", 1'650'000'000 + row); break;
+                }
+            }
+        }
+
+        return out;
+    } // make_query_page
+
+    auto hash(const std::string& _scheme, const std::string& _data) -> std::string
+    {
+        irods::Hasher hasher;
+        irods::getHasher(_scheme, hasher);
+        hasher.update(_data);
+
+        std::string digest;
+        hasher.digest(digest);
+
+        return digest;
+    } // hash
+} // anonymous namespace
+
+TEST_CASE("packstruct", "[!benchmark]")
+{
+    auto input = make_data_object_input();
+    irods::at_scope_exit free_input{[&input] { clearKeyVal(&input.condInput); }};
+
+    const char* peer_version = "rods4.3.0";
+
+    for (auto protocol : {NATIVE_PROT, XML_PROT}) {
+        const std::string suffix = (NATIVE_PROT == protocol) ? " (native)" : " (xml)";
+
+        BytesBuf* packed = nullptr;
+        REQUIRE(pack_struct(&input, &packed, "DataObjInp_PI", nullptr, 0, protocol, peer_version) == 0);
+        irods::at_scope_exit free_packed{[&packed] { freeBBuf(packed); }};
+
+        BENCHMARK("pack DataObjInp" + suffix)
+        {
+            BytesBuf* out = nullptr;
+            pack_struct(&input, &out, "DataObjInp_PI", nullptr, 0, protocol, peer_version);
+            freeBBuf(out);
+            return out;
+        };
+
+        BENCHMARK("unpack DataObjInp" + suffix)
+        {
+            DataObjInp* out = nullptr;
+            auto** out_ptr = reinterpret_cast<void**>(&out);
+            unpack_struct(packed->buf, out_ptr, "DataObjInp_PI", nullptr, protocol, peer_version);
+            clearKeyVal(&out->condInput);
+            std::free(out);
+            return out;
+        };
+
+        // A full page of GenQuery results is the largest structure most clients receive.
+        auto* page = make_query_page(0, MAX_SQL_ROWS);
+        irods::at_scope_exit free_page{[&page] { freeGenQueryOut(&page); }};
+
+        BytesBuf* packed_page = nullptr;
+        REQUIRE(pack_struct(page, &packed_page, "GenQueryOut_PI", nullptr, 0, protocol, peer_version) == 0);
+        irods::at_scope_exit free_packed_page{[&packed_page] { freeBBuf(packed_page); }};
+
+        BENCHMARK("pack GenQueryOut page" + suffix)
+        {
+            BytesBuf* out = nullptr;
+            pack_struct(page, &out, "GenQueryOut_PI", nullptr, 0, protocol, peer_version);
+            freeBBuf(out);
+            return out;
+        };
+
+        BENCHMARK("unpack GenQueryOut page" + suffix)
+        {
+            GenQueryOut* out = nullptr;
+            auto** out_ptr = reinterpret_cast<void**>(&out);
+            unpack_struct(packed_page->buf, out_ptr, "GenQueryOut_PI", nullptr, protocol, peer_version);
+            freeGenQueryOut(&out);
+            return out;
+        };
+    }
+}
+
+TEST_CASE("hierarchy_parser", "[!benchmark]")
+{
+    irods::hierarchy_parser parser{hierarchy};
+
+    std::string leaf;
+    REQUIRE(parser.last_resc(leaf).ok());
+    REQUIRE(leaf == "site_a_cache");
+
+    BENCHMARK("parse")
+    {
+        return irods::hierarchy_parser{hierarchy};
+    };
+
+    BENCHMARK("str")
+    {
+        std::string s;
+        parser.str(s);
+        return s;
+    };
+
+    BENCHMARK("walk with next")
+    {
+        std::string current;
+        parser.first_resc(current);
+
+        for (std::string next; parser.next(current, next).ok(); current = next) {}
+
+        return current;
+    };
+
+    BENCHMARK("resc_in_hier")
+    {
+        return parser.resc_in_hier("site_a_compound");
+    };
+}
+
+TEST_CASE("key_value_proxy", "[!benchmark]")
+{
+    auto input = make_data_object_input();
+    irods::at_scope_exit free_input{[&input] { clearKeyVal(&input.condInput); }};
+
+    auto proxy = irods::experimental::make_key_value_proxy(input.condInput);
+
+    REQUIRE(proxy.contains(RESC_HIER_STR_KW));
+    REQUIRE(proxy[RESC_HIER_STR_KW].value() == hierarchy);
+
+    BENCHMARK("getValByKey")
+    {
+        return getValByKey(&input.condInput, DATA_SIZE_KW);
+    };
+
+    BENCHMARK("key_value_proxy::contains")
+    {
+        return proxy.contains(DATA_SIZE_KW);
+    };
+
+    BENCHMARK("key_value_proxy::operator[]")
+    {
+        return proxy[DATA_SIZE_KW].value();
+    };
+
+    BENCHMARK("addKeyVal and rmKeyVal")
+    {
+        addKeyVal(&input.condInput, REPL_NUM_KW, "2");
+        rmKeyVal(&input.condInput, REPL_NUM_KW);
+        return input.condInput.len;
+    };
+
+    BENCHMARK("make_key_value_proxy with 6 pairs")
+    {
+        auto [p, lm] = irods::experimental::make_key_value_proxy({{DEST_RESC_NAME_KW, "root_repl"},
+                                                                  {RESC_HIER_STR_KW, hierarchy},
+                                                                  {DATA_TYPE_KW, "generic"},
+                                                                  {FORCE_FLAG_KW, ""},
+                                                                  {REG_CHKSUM_KW, ""},
+                                                                  {DATA_SIZE_KW, "268435456"}});
+        return p.size();
+    };
+}
+
+TEST_CASE("hasher", "[!benchmark]")
+{
+    const std::string small(4 * 1024, 'x');
+    const std::string large(1024 * 1024, 'x');
+
+    REQUIRE(hash(irods::MD5_NAME, "") == "d41d8cd98f00b204e9800998ecf8427e");
+
+    const auto schemes = {
+        irods::ADLER32_NAME, irods::MD5_NAME, irods::SHA1_NAME, irods::SHA256_NAME, irods::SHA512_NAME};
+
+    for (auto&& scheme : schemes) {
+        BENCHMARK(scheme + " of 4 KiB")
+        {
+            return hash(scheme, small);
+        };
+
+        BENCHMARK(scheme + " of 1 MiB")
+        {
+            return hash(scheme, large);
+        };
+    }
+}
+
+TEST_CASE("base64", "[!benchmark]")
+{
+    // The size of an authentication challenge and the size of a small payload.
+    for (std::size_t size : {64, 4096}) {
+        std::vector<unsigned char> data(size);
+        std::iota(std::begin(data), std::end(data), static_cast<unsigned char>(0));
+
+        std::vector<unsigned char> encoded(size * 2);
+        unsigned long encoded_size = encoded.size();
+        REQUIRE(irods::base64_encode(data.data(), data.size(), encoded.data(), &encoded_size) == 0);
+
+        std::vector<unsigned char> decoded(size * 2);
+        unsigned long decoded_size = decoded.size();
+        REQUIRE(irods::base64_decode(encoded.data(), encoded_size, decoded.data(), &decoded_size) == 0);
+        REQUIRE(decoded_size == size);
+        REQUIRE(std::equal(std::begin(data), std::end(data), std::begin(decoded)));
+
+        BENCHMARK("encode " + std::to_string(size) + " bytes")
+        {
+            unsigned long n = encoded.size();
+            return irods::base64_encode(data.data(), data.size(), encoded.data(), &n);
+        };
+
+        BENCHMARK("decode " + std::to_string(size) + " bytes")
+        {
+            unsigned long n = decoded.size();
+            return irods::base64_decode(encoded.data(), encoded_size, decoded.data(), &n);
+        };
+    }
+}
+
+TEST_CASE("obf", "[!benchmark]")
+{
+    const char* password = "correct horse battery staple";
+    const char* key = "a1b2c3d4e5f6a7b8c9d0e1f2a3b4c5d6";
+
+    std::array<char, MAX_PASSWORD_LEN + 100> encoded{};
+    std::array<char, MAX_PASSWORD_LEN + 100> decoded{};
+
+    obfEncodeByKey(password, key, encoded.data());
+    obfDecodeByKey(encoded.data(), key, decoded.data());
+    REQUIRE(std::string_view{decoded.data()} == password);
+
+    BENCHMARK("obfEncodeByKey")
+    {
+        obfEncodeByKey(password, key, encoded.data());
+        return encoded[0];
+    };
+
+    BENCHMARK("obfDecodeByKey")
+    {
+        obfDecodeByKey(encoded.data(), key, decoded.data());
+        return decoded[0];
+    };
+
+    // The encoding used by the .irodsA file, which is decoded by every client on startup.
+    std::array<char, MAX_PASSWORD_LEN + 100> file_encoded{};
+    obfiEncode(password, file_encoded.data(), 0);
+
+    BENCHMARK("obfiEncode")
+    {
+        obfiEncode(password, file_encoded.data(), 0);
+        return file_encoded[0];
+    };
+
+    BENCHMARK("obfiDecode")
+    {
+        return obfiDecode(file_encoded.data(), decoded.data(), 0);
+    };
+}
+
+// Iterating over irods::query needs a server, since it calls rcGenQuery directly. Only the parsing
+// of the query string is measured here.
+TEST_CASE("genquery", "[!benchmark]")
+{
+    const std::string query_string = "select COLL_NAME, DATA_NAME, DATA_SIZE, DATA_MODIFY_TIME "
+                                     "where COLL_NAME like '/tempZone/home/alice/%' and DATA_SIZE > '0'";
+
+    BENCHMARK("fillGenQueryInpFromStrCond")
+    {
+        GenQueryInp input{};
+        fillGenQueryInpFromStrCond(const_cast<char*>(query_string.c_str()), &input);
+        clearGenQueryInp(&input);
+        return input.maxRows;
+    };
+}
+
+TEST_CASE("lookup_table", "[!benchmark]")
+{
+    // The properties every resource plugin reads on every operation.
+    irods::plugin_property_map properties;
+    properties.set<std::string>("resource_property_name", "site_a_cache");
+    properties.set<std::string>("resource_property_location", "provider-a.example.org");
+    properties.set<std::string>("resource_property_path", "/var/lib/irods/Vault");
+    properties.set<std::string>("resource_property_type", "unixfilesystem");
+    properties.set<std::string>("resource_property_context", "minimum_free_space_for_create_in_bytes=0");
+    properties.set<rodsLong_t>("resource_property_id", 10'014);
+    properties.set<int>("resource_property_status", INT_RESC_STATUS_UP);
+
+    std::string location;
+    REQUIRE(properties.get<std::string>("resource_property_location", location).ok());
+    REQUIRE(location == "provider-a.example.org");
+
+    BENCHMARK("get<std::string>")
+    {
+        std::string value;
+        properties.get<std::string>("resource_property_path", value);
+        return value;
+    };
+
+    BENCHMARK("get<rodsLong_t>")
+    {
+        rodsLong_t value{};
+        properties.get<rodsLong_t>("resource_property_id", value);
+        return value;
+    };
+
+    BENCHMARK("get with mismatched type")
+    {
+        int value{};
+        return properties.get<int>("resource_property_id", value).code();
+    };
+
+    BENCHMARK("set<std::string>")
+    {
+        return properties.set<std::string>("resource_property_context", "minimum_free_space_for_create_in_bytes=0");
+    };
+
+    BENCHMARK("has_entry")
+    {
+        return properties.has_entry("resource_property_status");
+    };
+}
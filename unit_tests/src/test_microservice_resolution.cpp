@@ -0,0 +1,135 @@
+#include <catch2/catch.hpp>
+
+#include "irods/irods_at_scope_exit.hpp"
+#include "irods/irods_default_paths.hpp"
+#include "irods/irods_ms_plugin.hpp"
+#include "irods/irods_re_plugin.hpp"
+#include "irods/irods_re_structs.hpp"
+#include "irods/msParam.h"
+#include "irods/rodsErrorTable.h"
+
+#include <boost/any.hpp>
+#include <boost/filesystem.hpp>
+
+#include <cstdlib>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+namespace fs = boost::filesystem;
+
+TEST_CASE("typed microservice invocation")
+{
+    ruleExecInfo_t rei{};
+    std::vector<msParam_t> storage(3);
+    std::vector<msParam_t*> params{&storage[0], &storage[1], &storage[2]};
+
+    std::vector<msParam_t*> received;
+    ruleExecInfo_t* received_rei = nullptr;
+
+    std::function<int(msParam_t*, msParam_t*, msParam_t*, ruleExecInfo_t*)> msi =
+        [&](msParam_t* _p0, msParam_t* _p1, msParam_t* _p2, ruleExecInfo_t* _rei) {
+            received = {_p0, _p1, _p2};
+            received_rei = _rei;
+            return 42;
+        };
+
+    SECTION("arguments are passed in order, followed by the rule execution info")
+    {
+        irods::ms_table_entry entry{"msi_unit_test", 3, msi};
+
+        CHECK(entry.call(&rei, params) == 42);
+        CHECK(received == params);
+        CHECK(received_rei == &rei);
+    }
+
+    SECTION("entries built by plugins and copies of entries invoke the operation the same way")
+    {
+        irods::ms_table_entry entry{3};
+        REQUIRE(entry.add_operation("msi_unit_test", msi).ok());
+
+        irods::ms_table_entry copy{entry};
+        irods::ms_table_entry assigned;
+        assigned = entry;
+
+        for (auto* e : {&entry, &copy, &assigned}) {
+            received.clear();
+            CHECK(e->call(&rei, params) == 42);
+            CHECK(received == params);
+        }
+    }
+
+    SECTION("a call with the wrong number of arguments is rejected without invoking the operation")
+    {
+        irods::ms_table_entry entry{"msi_unit_test", 3, msi};
+
+        params.pop_back();
+        CHECK(entry.call(&rei, params) == SYS_INVALID_INPUT_PARAM);
+        CHECK(received.empty());
+    }
+
+    SECTION("microservices without arguments receive only the rule execution info")
+    {
+        std::function<int(ruleExecInfo_t*)> no_args = [&](ruleExecInfo_t* _rei) {
+            received_rei = _rei;
+            return 7;
+        };
+        irods::ms_table_entry entry{"msi_unit_test", 0, no_args};
+
+        std::vector<msParam_t*> none;
+        CHECK(entry.call(&rei, none) == 7);
+        CHECK(received_rei == &rei);
+    }
+
+    SECTION("entries built from an untyped operation fall back to the call handler")
+    {
+        irods::ms_table_entry entry{"msi_unit_test", 3, boost::any{msi}};
+
+        CHECK(entry.call(&rei, params) == 42);
+        CHECK(received == params);
+        CHECK(received_rei == &rei);
+    }
+}
+
+TEST_CASE("resolve_microservice")
+{
+    SECTION("names reserved for rules are never resolved")
+    {
+        CHECK(irods::resolve_microservice("acPostProcForPut") == nullptr);
+    }
+
+    SECTION("a failed lookup is retried once the rule engine generation changes")
+    {
+        // Microservice plugins are loaded from <irods_plugins_home>/microservices.
+        const auto plugins_home = fs::temp_directory_path() / ("irods_test_microservice_resolution_" +
+                                                               std::to_string(getpid()));
+        fs::create_directories(plugins_home / "microservices");
+
+        irods::at_scope_exit cleanup{[&plugins_home] {
+            unsetenv("IRODS_PLUGINS_HOME");
+            fs::remove_all(plugins_home);
+        }};
+
+        REQUIRE(setenv("IRODS_PLUGINS_HOME", (plugins_home.string() + "/").c_str(), 1) == 0);
+
+        const std::string name = "msi_unit_test_resolution";
+
+        CHECK(irods::resolve_microservice(name) == nullptr);
+
+        // Any microservice plugin serves as the plugin which appears after the failed lookup.
+        fs::copy_file(irods::get_irods_default_plugin_directory() / "microservices" / "libmsi_get_hostname.so",
+                      plugins_home / "microservices" / ("lib" + name + ".so"));
+
+        // The failure is remembered until the rule engine plugins are restarted.
+        CHECK(irods::resolve_microservice(name) == nullptr);
+
+        irods::increment_rule_engine_generation();
+
+        auto* entry = irods::resolve_microservice(name);
+        REQUIRE(entry);
+        CHECK(entry->num_args() == 1);
+        CHECK(irods::resolve_microservice(name) == entry);
+    }
+}
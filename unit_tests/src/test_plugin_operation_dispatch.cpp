@@ -0,0 +1,149 @@
+#include <catch2/catch.hpp>
+
+#include "irods/irods_plugin_base.hpp"
+#include "irods/rodsErrorTable.h"
+
+#include <array>
+#include <cstring>
+#include <functional>
+#include <string>
+
+namespace
+{
+    const std::string read_op = "unit_test_read";
+
+    // Builds a chain of plugins in which every plugin forwards the read operation to the next one,
+    // the way a coordinating resource forwards to its child. The last plugin copies the buffer.
+    class plugin_chain
+    {
+      public:
+        explicit plugin_chain(int _hops, bool _call_by_index)
+        {
+            plugins_.reserve(_hops);
+
+            for (int i = 0; i < _hops; ++i) {
+                plugins_.emplace_back("hop_" + std::to_string(i), "");
+            }
+
+            for (int i = 0; i < _hops; ++i) {
+                auto* next = (i + 1 < _hops) ? &plugins_[i + 1] : nullptr;
+
+                std::function<irods::error(irods::plugin_context&, void*, int)> op =
+                    [this, next, _call_by_index](irods::plugin_context& _ctx, void* _buf, int _len) -> irods::error {
+                    if (!next) {
+                        std::memcpy(_buf, source_.data(), _len);
+                        return CODE(_len);
+                    }
+
+                    if (_call_by_index) {
+                        return next->call<void*, int>(_ctx.comm(), index_, _ctx.fco(), _buf, _len);
+                    }
+
+                    return next->call<void*, int>(_ctx.comm(), read_op, _ctx.fco(), _buf, _len);
+                };
+
+                plugins_[i].add_operation(read_op, op);
+            }
+        }
+
+        auto read(void* _buf, int _len) -> irods::error
+        {
+            return plugins_.front().call<void*, int>(nullptr, index_, nullptr, _buf, _len);
+        }
+
+      private:
+        std::vector<irods::plugin_base> plugins_;
+        irods::operation_index index_ = irods::get_operation_index(read_op);
+        std::array<char, 64> source_{};
+    }; // class plugin_chain
+} // anonymous namespace
+
+TEST_CASE("operation indices are shared by all plugins")
+{
+    const auto index = irods::get_operation_index("unit_test_op_a");
+
+    CHECK(irods::get_operation_index("unit_test_op_a") == index);
+    CHECK(irods::get_operation_index("unit_test_op_b") != index);
+    CHECK(irods::get_operation_name(index) == "unit_test_op_a");
+}
+
+TEST_CASE("plugins dispatch by name and by index")
+{
+    irods::plugin_base plugin{"instance", ""};
+
+    std::function<irods::error(irods::plugin_context&, int)> op = [](irods::plugin_context&, int _value) {
+        return CODE(_value * 2);
+    };
+    REQUIRE(plugin.add_operation("unit_test_double", op).ok());
+
+    CHECK(plugin.call<int>(nullptr, "unit_test_double", nullptr, 21).code() == 42);
+    CHECK(plugin.call<int>(nullptr, irods::get_operation_index("unit_test_double"), nullptr, 4).code() == 8);
+    CHECK(plugin.call_without_policy<int>(nullptr, "unit_test_double", nullptr, 5).code() == 10);
+
+    SECTION("copies keep their operations")
+    {
+        irods::plugin_base copy{plugin};
+        CHECK(copy.call<int>(nullptr, "unit_test_double", nullptr, 1).code() == 2);
+    }
+
+    SECTION("unknown operations and mismatched arguments are rejected")
+    {
+        CHECK(plugin.call<int>(nullptr, "unit_test_unknown", nullptr, 1).code() == INVALID_ANY_CAST);
+        CHECK(plugin.call<long>(nullptr, "unit_test_double", nullptr, 1L).code() == INVALID_ANY_CAST);
+    }
+
+    SECTION("operations can be replaced")
+    {
+        std::function<irods::error(irods::plugin_context&, int)> negate = [](irods::plugin_context&, int _value) {
+            return CODE(-_value);
+        };
+        REQUIRE(plugin.add_operation("unit_test_double", negate).ok());
+        CHECK(plugin.call<int>(nullptr, "unit_test_double", nullptr, 3).code() == -3);
+    }
+}
+
+TEST_CASE("plugin operations are forwarded through a hierarchy")
+{
+    std::array<char, 64> buffer{};
+
+    for (bool by_index : {false, true}) {
+        plugin_chain chain{3, by_index};
+        CHECK(chain.read(buffer.data(), buffer.size()).code() == static_cast<int>(buffer.size()));
+    }
+}
+
+TEST_CASE("plugin operation dispatch overhead", "[!benchmark]")
+{
+    // Each hop is one plugin_base::call. Compare the three-hop chains with the single hop to get
+    // the cost per hop. The buffer is kept small so the copy does not hide the dispatch cost.
+    std::array<char, 64> buffer{};
+
+    std::function<irods::error(void*, int)> direct = [&buffer](void* _buf, int _len) {
+        std::memcpy(_buf, buffer.data(), _len);
+        return CODE(_len);
+    };
+
+    plugin_chain one_hop{1, true};
+    plugin_chain three_hops_by_name{3, false};
+    plugin_chain three_hops_by_index{3, true};
+
+    BENCHMARK("direct call")
+    {
+        return direct(buffer.data(), buffer.size()).code();
+    };
+
+    BENCHMARK("1 hop")
+    {
+        return one_hop.read(buffer.data(), buffer.size()).code();
+    };
+
+    BENCHMARK("3 hops, operations called by name")
+    {
+        return three_hops_by_name.read(buffer.data(), buffer.size()).code();
+    };
+
+    BENCHMARK("3 hops, operations called by index")
+    {
+        return three_hops_by_index.read(buffer.data(), buffer.size()).code();
+    };
+}
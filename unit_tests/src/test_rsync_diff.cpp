@@ -0,0 +1,86 @@
+#include <catch2/catch.hpp>
+
+#include "irods/rsync_diff.hpp"
+
+#include <string>
+#include <vector>
+
+namespace rsync = irods::experimental::rsync;
+
+namespace
+{
+    auto make_file(std::int64_t _size, const std::string& _checksum = "") -> rsync::file_info
+    {
+        rsync::file_info info;
+        info.size = _size;
+        info.checksum = _checksum;
+        return info;
+    } // make_file
+
+    auto paths_of(const std::vector<rsync::file_change>& _changes, rsync::change_type _type)
+        -> std::vector<std::string>
+    {
+        std::vector<std::string> paths;
+
+        for (const auto& c : _changes) {
+            if (c.type == _type) {
+                paths.push_back(c.path);
+            }
+        }
+
+        return paths;
+    } // paths_of
+} // anonymous namespace
+
+TEST_CASE("rsync diff")
+{
+    rsync::tree source;
+    source.directories = {"a", "a/b", "c"};
+    source.files = {{"new.txt", make_file(10)},
+                    {"a/resized.txt", make_file(20)},
+                    {"a/b/same_size.txt", make_file(30)},
+                    {"c/same_checksum.txt", make_file(40, "sha2:AAAA")},
+                    {"c/other_checksum.txt", make_file(50, "sha2:BBBB")}};
+
+    rsync::tree target;
+    target.directories = {"a", "old"};
+    target.files = {{"a/resized.txt", make_file(21)},
+                    {"a/b/same_size.txt", make_file(30, "sha2:CCCC")},
+                    {"c/same_checksum.txt", make_file(40, "sha2:AAAA")},
+                    {"c/other_checksum.txt", make_file(50, "sha2:DDDD")},
+                    {"old/removed.txt", make_file(60)}};
+
+    SECTION("compare by checksum")
+    {
+        const auto diff = rsync::diff(source, target, rsync::compare_by::checksum);
+
+        CHECK(diff.directories_to_create == std::vector<std::string>{"a/b", "c"});
+        CHECK(paths_of(diff.files, rsync::change_type::create) == std::vector<std::string>{"new.txt"});
+        CHECK(paths_of(diff.files, rsync::change_type::update) ==
+              std::vector<std::string>{"a/resized.txt", "c/other_checksum.txt"});
+        CHECK(paths_of(diff.files, rsync::change_type::verify) == std::vector<std::string>{"a/b/same_size.txt"});
+        CHECK(diff.only_in_target == std::vector<std::string>{"old/removed.txt"});
+        CHECK(diff.unchanged == 1);
+    }
+
+    SECTION("compare by size")
+    {
+        const auto diff = rsync::diff(source, target, rsync::compare_by::size);
+
+        CHECK(paths_of(diff.files, rsync::change_type::create) == std::vector<std::string>{"new.txt"});
+        CHECK(paths_of(diff.files, rsync::change_type::update) == std::vector<std::string>{"a/resized.txt"});
+        CHECK(paths_of(diff.files, rsync::change_type::verify).empty());
+        CHECK(diff.unchanged == 3);
+    }
+
+    SECTION("identical trees")
+    {
+        const auto diff = rsync::diff(target, target, rsync::compare_by::checksum);
+
+        CHECK(diff.directories_to_create.empty());
+        CHECK(paths_of(diff.files, rsync::change_type::verify) ==
+              std::vector<std::string>{"a/resized.txt", "old/removed.txt"});
+        CHECK(diff.only_in_target.empty());
+        CHECK(diff.unchanged == 3);
+    }
+}
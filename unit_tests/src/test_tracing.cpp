@@ -0,0 +1,248 @@
+#include <catch2/catch.hpp>
+
+#include "irods/irods_at_scope_exit.hpp"
+#include "irods/tracing.hpp"
+
+#include <fmt/format.h>
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+namespace tracing = irods::experimental::tracing;
+
+namespace
+{
+    auto read_spans(const std::string& _path) -> std::vector<nlohmann::json>
+    {
+        std::vector<nlohmann::json> spans;
+        std::ifstream in{_path};
+
+        for (std::string line; std::getline(in, line);) {
+            const auto request = nlohmann::json::parse(line);
+            spans.push_back(request.at("resourceSpans").at(0).at("scopeSpans").at(0).at("spans").at(0));
+        }
+
+        return spans;
+    }
+} // anonymous namespace
+
+TEST_CASE("traceparent")
+{
+    const tracing::trace_context context{tracing::generate_trace_id(), tracing::generate_span_id()};
+    CHECK(context.trace_id.size() == 32);
+    CHECK(context.span_id.size() == 16);
+
+    const auto traceparent = tracing::to_traceparent(context);
+    CHECK(traceparent == "00-" + context.trace_id + "-" + context.span_id + "-01");
+
+    const auto parsed = tracing::from_traceparent(traceparent);
+    REQUIRE(parsed);
+    CHECK(parsed->trace_id == context.trace_id);
+    CHECK(parsed->span_id == context.span_id);
+
+    CHECK_FALSE(tracing::from_traceparent(""));
+    CHECK_FALSE(tracing::from_traceparent("00-0af7651916cd43dd8448eb211c80319c-b7ad6b7169203331"));
+    CHECK_FALSE(tracing::from_traceparent("01-0af7651916cd43dd8448eb211c80319c-b7ad6b7169203331-01"));
+    CHECK_FALSE(tracing::from_traceparent("00-0AF7651916CD43DD8448EB211C80319C-b7ad6b7169203331-01"));
+    CHECK_FALSE(tracing::from_traceparent("00-00000000000000000000000000000000-b7ad6b7169203331-01"));
+    CHECK_FALSE(tracing::from_traceparent("00-0af7651916cd43dd8448eb211c80319c-0000000000000000-01"));
+    CHECK(tracing::from_traceparent("00-0af7651916cd43dd8448eb211c80319c-b7ad6b7169203331-01"));
+}
+
+TEST_CASE("root context")
+{
+    tracing::set_root_context({});
+    irods::at_scope_exit reset_root{[] { tracing::set_root_context({}); }};
+
+    REQUIRE(tracing::current_context().trace_id.empty());
+
+    SECTION("threads racing to start a trace all join the same one")
+    {
+        std::vector<std::string> trace_ids(8);
+        std::vector<std::thread> threads;
+
+        for (auto& trace_id : trace_ids) {
+            threads.emplace_back([&trace_id] { trace_id = tracing::current_or_new_context().trace_id; });
+        }
+
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        CHECK_FALSE(trace_ids.front().empty());
+        CHECK(std::count(trace_ids.begin(), trace_ids.end(), trace_ids.front()) == 8);
+        CHECK(tracing::current_context().trace_id == trace_ids.front());
+    }
+
+    SECTION("a new trace is started after the root context is cleared")
+    {
+        const auto first = tracing::current_or_new_context().trace_id;
+        tracing::set_root_context({});
+        CHECK(tracing::current_context().trace_id.empty());
+
+        const auto second = tracing::current_or_new_context().trace_id;
+        CHECK_FALSE(second.empty());
+        CHECK(second != first);
+    }
+
+    SECTION("the root context can be replaced while other threads read it")
+    {
+        const tracing::trace_context first{"0af7651916cd43dd8448eb211c80319c", "b7ad6b7169203331"};
+        const tracing::trace_context second{"4bf92f3577b34da6a3ce929d0e0e4736", "00f067aa0ba902b7"};
+
+        tracing::set_root_context(first);
+
+        std::atomic<bool> done{false};
+        std::atomic<bool> mismatch{false};
+        std::vector<std::thread> readers;
+
+        for (int i = 0; i < 4; ++i) {
+            readers.emplace_back([&] {
+                while (!done.load()) {
+                    const auto& root = tracing::current_context();
+
+                    if (root.trace_id != first.trace_id && root.trace_id != second.trace_id) {
+                        mismatch = true;
+                    }
+                }
+            });
+        }
+
+        for (int i = 0; i < 1000; ++i) {
+            tracing::set_root_context(i % 2 == 0 ? second : first);
+        }
+
+        done = true;
+
+        for (auto& reader : readers) {
+            reader.join();
+        }
+
+        CHECK_FALSE(mismatch.load());
+        CHECK(tracing::current_context().trace_id == first.trace_id);
+    }
+}
+
+TEST_CASE("startup pack option")
+{
+    tracing::set_root_context({"0af7651916cd43dd8448eb211c80319c", "b7ad6b7169203331"});
+    irods::at_scope_exit reset_root{[] { tracing::set_root_context({}); }};
+
+    SECTION("the trace context follows the negotiation request and is removed by the server")
+    {
+        char option[256] = "iput;request_server_negotiation";
+        REQUIRE(tracing::append_to_startup_option(option, sizeof(option)));
+
+        std::string s = option;
+        CHECK(s == "iput;request_server_negotiation"
+                   "traceparent=00-0af7651916cd43dd8448eb211c80319c-b7ad6b7169203331-01");
+
+        const auto context = tracing::extract_from_startup_option(s);
+        REQUIRE(context);
+        CHECK(context->trace_id == "0af7651916cd43dd8448eb211c80319c");
+        CHECK(context->span_id == "b7ad6b7169203331");
+        CHECK(s == "iput;request_server_negotiation");
+    }
+
+    SECTION("nothing is appended when the option string is too small")
+    {
+        char option[64] = "iput";
+        CHECK_FALSE(tracing::append_to_startup_option(option, sizeof(option)));
+        CHECK(std::string{option} == "iput");
+    }
+
+    SECTION("option strings without a trace context are left unchanged")
+    {
+        std::string s = "iput;request_server_negotiation";
+        CHECK_FALSE(tracing::extract_from_startup_option(s));
+        CHECK(s == "iput;request_server_negotiation");
+    }
+
+    SECTION("a malformed trace context is removed and ignored")
+    {
+        std::string s = "iputtraceparent=00-xyz";
+        CHECK_FALSE(tracing::extract_from_startup_option(s));
+        CHECK(s == "iput");
+    }
+}
+
+TEST_CASE("spans")
+{
+    const auto path = fmt::format("/tmp/irods_test_tracing_{}.json", getpid());
+    std::remove(path.c_str());
+
+    irods::at_scope_exit cleanup{[&path] {
+        tracing::configure_sink("", "");
+        tracing::set_root_context({});
+        std::remove(path.c_str());
+    }};
+
+    SECTION("spans do nothing when no sink is configured")
+    {
+        REQUIRE(tracing::configure_sink("", "localhost"));
+        CHECK_FALSE(tracing::is_recording());
+
+        tracing::span s{"noop"};
+        CHECK(tracing::current_context().span_id.empty());
+    }
+
+    SECTION("unsupported sinks are rejected")
+    {
+        CHECK_FALSE(tracing::configure_sink("http://localhost:4318", "localhost"));
+        CHECK_FALSE(tracing::configure_sink("file://", "localhost"));
+        CHECK_FALSE(tracing::is_recording());
+    }
+
+    SECTION("nested spans are written to the file sink as OTLP/JSON")
+    {
+        REQUIRE(tracing::configure_sink("file://" + path, "localhost"));
+        REQUIRE(tracing::is_recording());
+
+        tracing::set_root_context({"0af7651916cd43dd8448eb211c80319c", "b7ad6b7169203331"});
+
+        {
+            tracing::span outer{"outer", tracing::span_kind::server};
+            const auto outer_span_id = tracing::current_context().span_id;
+            CHECK(outer_span_id != "b7ad6b7169203331");
+
+            {
+                tracing::span inner{"inner", tracing::span_kind::client};
+                inner.set_attribute("server.address", "localhost");
+                inner.set_error_code(-1);
+                CHECK(tracing::current_context().span_id != outer_span_id);
+            }
+
+            CHECK(tracing::current_context().span_id == outer_span_id);
+        }
+
+        CHECK(tracing::current_context().span_id == "b7ad6b7169203331");
+
+        const auto spans = read_spans(path);
+        REQUIRE(spans.size() == 2);
+
+        const auto& inner = spans[0];
+        const auto& outer = spans[1];
+
+        CHECK(outer.at("name") == "outer");
+        CHECK(outer.at("kind") == 2);
+        CHECK(outer.at("traceId") == "0af7651916cd43dd8448eb211c80319c");
+        CHECK(outer.at("parentSpanId") == "b7ad6b7169203331");
+        CHECK_FALSE(outer.contains("status"));
+
+        CHECK(inner.at("name") == "inner");
+        CHECK(inner.at("kind") == 3);
+        CHECK(inner.at("traceId") == "0af7651916cd43dd8448eb211c80319c");
+        CHECK(inner.at("parentSpanId") == outer.at("spanId"));
+        CHECK(inner.at("status").at("code") == 2);
+        CHECK(inner.at("attributes").at(0).at("value").at("stringValue") == "localhost");
+        CHECK(inner.at("attributes").at(1).at("value").at("intValue") == "-1");
+    }
+}